@@ -0,0 +1,810 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: foo.proto
+
+#include "foo.pb.h"
+
+#include <algorithm>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/reflection_ops.h>
+#include <google/protobuf/wire_format.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+
+PROTOBUF_PRAGMA_INIT_SEG
+
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
+
+PROTOBUF_CONSTEXPR Foo::Foo(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.numbers_)*/{}
+  , /*decltype(_impl_.text_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.number_)*/0} {}
+struct FooDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR FooDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~FooDefaultTypeInternal() {}
+  union {
+    Foo _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 FooDefaultTypeInternal _Foo_default_instance_;
+PROTOBUF_CONSTEXPR Bar::Bar(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.bar_numbers_)*/{}
+  , /*decltype(_impl_.bar_foos_)*/{}
+  , /*decltype(_impl_.bar_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.bar_foo_)*/nullptr
+  , /*decltype(_impl_.bar_number_)*/0} {}
+struct BarDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR BarDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~BarDefaultTypeInternal() {}
+  union {
+    Bar _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 BarDefaultTypeInternal _Bar_default_instance_;
+static ::_pb::Metadata file_level_metadata_foo_2eproto[2];
+static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_foo_2eproto = nullptr;
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_foo_2eproto = nullptr;
+
+const uint32_t TableStruct_foo_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  PROTOBUF_FIELD_OFFSET(::Foo, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::Foo, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::Foo, _impl_.text_),
+  PROTOBUF_FIELD_OFFSET(::Foo, _impl_.number_),
+  PROTOBUF_FIELD_OFFSET(::Foo, _impl_.numbers_),
+  0,
+  1,
+  ~0u,
+  PROTOBUF_FIELD_OFFSET(::Bar, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::Bar, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::Bar, _impl_.bar_name_),
+  PROTOBUF_FIELD_OFFSET(::Bar, _impl_.bar_number_),
+  PROTOBUF_FIELD_OFFSET(::Bar, _impl_.bar_foo_),
+  PROTOBUF_FIELD_OFFSET(::Bar, _impl_.bar_numbers_),
+  PROTOBUF_FIELD_OFFSET(::Bar, _impl_.bar_foos_),
+  0,
+  2,
+  1,
+  ~0u,
+  ~0u,
+};
+static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  { 0, 9, -1, sizeof(::Foo)},
+  { 12, 23, -1, sizeof(::Bar)},
+};
+
+static const ::_pb::Message* const file_default_instances[] = {
+  &::_Foo_default_instance_._instance,
+  &::_Bar_default_instance_._instance,
+};
+
+const char descriptor_table_protodef_foo_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
+  "\n\tfoo.proto\"4\n\003Foo\022\014\n\004text\030\001 \001(\t\022\016\n\006numb"
+  "er\030\002 \001(\005\022\017\n\007numbers\030\003 \003(\005\"o\n\003Bar\022\020\n\010bar_"
+  "name\030\001 \001(\t\022\022\n\nbar_number\030\002 \001(\005\022\025\n\007bar_fo"
+  "o\030\003 \001(\0132\004.Foo\022\023\n\013bar_numbers\030\004 \003(\005\022\026\n\010ba"
+  "r_foos\030\005 \003(\0132\004.Foo"
+  ;
+static ::_pbi::once_flag descriptor_table_foo_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_foo_2eproto = {
+    false, false, 178, descriptor_table_protodef_foo_2eproto,
+    "foo.proto",
+    &descriptor_table_foo_2eproto_once, nullptr, 0, 2,
+    schemas, file_default_instances, TableStruct_foo_2eproto::offsets,
+    file_level_metadata_foo_2eproto, file_level_enum_descriptors_foo_2eproto,
+    file_level_service_descriptors_foo_2eproto,
+};
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_foo_2eproto_getter() {
+  return &descriptor_table_foo_2eproto;
+}
+
+// Force running AddDescriptors() at dynamic initialization time.
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_foo_2eproto(&descriptor_table_foo_2eproto);
+
+// ===================================================================
+
+class Foo::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Foo>()._impl_._has_bits_);
+  static void set_has_text(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_number(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
+
+Foo::Foo(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:Foo)
+}
+Foo::Foo(const Foo& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Foo* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.numbers_){from._impl_.numbers_}
+    , decltype(_impl_.text_){}
+    , decltype(_impl_.number_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.text_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.text_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_text()) {
+    _this->_impl_.text_.Set(from._internal_text(), 
+      _this->GetArenaForAllocation());
+  }
+  _this->_impl_.number_ = from._impl_.number_;
+  // @@protoc_insertion_point(copy_constructor:Foo)
+}
+
+inline void Foo::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.numbers_){arena}
+    , decltype(_impl_.text_){}
+    , decltype(_impl_.number_){0}
+  };
+  _impl_.text_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.text_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+Foo::~Foo() {
+  // @@protoc_insertion_point(destructor:Foo)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Foo::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.numbers_.~RepeatedField();
+  _impl_.text_.Destroy();
+}
+
+void Foo::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Foo::Clear() {
+// @@protoc_insertion_point(message_clear_start:Foo)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.numbers_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    _impl_.text_.ClearNonDefaultToEmpty();
+  }
+  _impl_.number_ = 0;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Foo::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional string text = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_text();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "Foo.text");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      // optional int32 number = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_number(&has_bits);
+          _impl_.number_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated int32 numbers = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            _internal_add_numbers(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<24>(ptr));
+        } else if (static_cast<uint8_t>(tag) == 26) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedInt32Parser(_internal_mutable_numbers(), ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Foo::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:Foo)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional string text = 1;
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_text().data(), static_cast<int>(this->_internal_text().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "Foo.text");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_text(), target);
+  }
+
+  // optional int32 number = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(2, this->_internal_number(), target);
+  }
+
+  // repeated int32 numbers = 3;
+  for (int i = 0, n = this->_internal_numbers_size(); i < n; i++) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(3, this->_internal_numbers(i), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:Foo)
+  return target;
+}
+
+size_t Foo::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:Foo)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated int32 numbers = 3;
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      Int32Size(this->_impl_.numbers_);
+    total_size += 1 *
+                  ::_pbi::FromIntSize(this->_internal_numbers_size());
+    total_size += data_size;
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional string text = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_text());
+    }
+
+    // optional int32 number = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_number());
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Foo::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Foo::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Foo::GetClassData() const { return &_class_data_; }
+
+
+void Foo::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Foo*>(&to_msg);
+  auto& from = static_cast<const Foo&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:Foo)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.numbers_.MergeFrom(from._impl_.numbers_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_text(from._internal_text());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.number_ = from._impl_.number_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Foo::CopyFrom(const Foo& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:Foo)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Foo::IsInitialized() const {
+  return true;
+}
+
+void Foo::InternalSwap(Foo* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.numbers_.InternalSwap(&other->_impl_.numbers_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.text_, lhs_arena,
+      &other->_impl_.text_, rhs_arena
+  );
+  swap(_impl_.number_, other->_impl_.number_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Foo::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_foo_2eproto_getter, &descriptor_table_foo_2eproto_once,
+      file_level_metadata_foo_2eproto[0]);
+}
+
+// ===================================================================
+
+class Bar::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Bar>()._impl_._has_bits_);
+  static void set_has_bar_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_bar_number(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static const ::Foo& bar_foo(const Bar* msg);
+  static void set_has_bar_foo(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
+
+const ::Foo&
+Bar::_Internal::bar_foo(const Bar* msg) {
+  return *msg->_impl_.bar_foo_;
+}
+Bar::Bar(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:Bar)
+}
+Bar::Bar(const Bar& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Bar* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.bar_numbers_){from._impl_.bar_numbers_}
+    , decltype(_impl_.bar_foos_){from._impl_.bar_foos_}
+    , decltype(_impl_.bar_name_){}
+    , decltype(_impl_.bar_foo_){nullptr}
+    , decltype(_impl_.bar_number_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.bar_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.bar_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_bar_name()) {
+    _this->_impl_.bar_name_.Set(from._internal_bar_name(), 
+      _this->GetArenaForAllocation());
+  }
+  if (from._internal_has_bar_foo()) {
+    _this->_impl_.bar_foo_ = new ::Foo(*from._impl_.bar_foo_);
+  }
+  _this->_impl_.bar_number_ = from._impl_.bar_number_;
+  // @@protoc_insertion_point(copy_constructor:Bar)
+}
+
+inline void Bar::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.bar_numbers_){arena}
+    , decltype(_impl_.bar_foos_){arena}
+    , decltype(_impl_.bar_name_){}
+    , decltype(_impl_.bar_foo_){nullptr}
+    , decltype(_impl_.bar_number_){0}
+  };
+  _impl_.bar_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.bar_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+Bar::~Bar() {
+  // @@protoc_insertion_point(destructor:Bar)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Bar::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.bar_numbers_.~RepeatedField();
+  _impl_.bar_foos_.~RepeatedPtrField();
+  _impl_.bar_name_.Destroy();
+  if (this != internal_default_instance()) delete _impl_.bar_foo_;
+}
+
+void Bar::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Bar::Clear() {
+// @@protoc_insertion_point(message_clear_start:Bar)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.bar_numbers_.Clear();
+  _impl_.bar_foos_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.bar_name_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.bar_foo_ != nullptr);
+      _impl_.bar_foo_->Clear();
+    }
+  }
+  _impl_.bar_number_ = 0;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Bar::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional string bar_name = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_bar_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "Bar.bar_name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      // optional int32 bar_number = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_bar_number(&has_bits);
+          _impl_.bar_number_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .Foo bar_foo = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_bar_foo(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated int32 bar_numbers = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            _internal_add_bar_numbers(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<32>(ptr));
+        } else if (static_cast<uint8_t>(tag) == 34) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedInt32Parser(_internal_mutable_bar_numbers(), ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .Foo bar_foos = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 42)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_bar_foos(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<42>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Bar::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:Bar)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional string bar_name = 1;
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_bar_name().data(), static_cast<int>(this->_internal_bar_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "Bar.bar_name");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_bar_name(), target);
+  }
+
+  // optional int32 bar_number = 2;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(2, this->_internal_bar_number(), target);
+  }
+
+  // optional .Foo bar_foo = 3;
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, _Internal::bar_foo(this),
+        _Internal::bar_foo(this).GetCachedSize(), target, stream);
+  }
+
+  // repeated int32 bar_numbers = 4;
+  for (int i = 0, n = this->_internal_bar_numbers_size(); i < n; i++) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(4, this->_internal_bar_numbers(i), target);
+  }
+
+  // repeated .Foo bar_foos = 5;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_bar_foos_size()); i < n; i++) {
+    const auto& repfield = this->_internal_bar_foos(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(5, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:Bar)
+  return target;
+}
+
+size_t Bar::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:Bar)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated int32 bar_numbers = 4;
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      Int32Size(this->_impl_.bar_numbers_);
+    total_size += 1 *
+                  ::_pbi::FromIntSize(this->_internal_bar_numbers_size());
+    total_size += data_size;
+  }
+
+  // repeated .Foo bar_foos = 5;
+  total_size += 1UL * this->_internal_bar_foos_size();
+  for (const auto& msg : this->_impl_.bar_foos_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    // optional string bar_name = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_bar_name());
+    }
+
+    // optional .Foo bar_foo = 3;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.bar_foo_);
+    }
+
+    // optional int32 bar_number = 2;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_bar_number());
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Bar::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Bar::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Bar::GetClassData() const { return &_class_data_; }
+
+
+void Bar::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Bar*>(&to_msg);
+  auto& from = static_cast<const Bar&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:Bar)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.bar_numbers_.MergeFrom(from._impl_.bar_numbers_);
+  _this->_impl_.bar_foos_.MergeFrom(from._impl_.bar_foos_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_bar_name(from._internal_bar_name());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_bar_foo()->::Foo::MergeFrom(
+          from._internal_bar_foo());
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.bar_number_ = from._impl_.bar_number_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Bar::CopyFrom(const Bar& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:Bar)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Bar::IsInitialized() const {
+  return true;
+}
+
+void Bar::InternalSwap(Bar* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.bar_numbers_.InternalSwap(&other->_impl_.bar_numbers_);
+  _impl_.bar_foos_.InternalSwap(&other->_impl_.bar_foos_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.bar_name_, lhs_arena,
+      &other->_impl_.bar_name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Bar, _impl_.bar_number_)
+      + sizeof(Bar::_impl_.bar_number_)
+      - PROTOBUF_FIELD_OFFSET(Bar, _impl_.bar_foo_)>(
+          reinterpret_cast<char*>(&_impl_.bar_foo_),
+          reinterpret_cast<char*>(&other->_impl_.bar_foo_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Bar::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_foo_2eproto_getter, &descriptor_table_foo_2eproto_once,
+      file_level_metadata_foo_2eproto[1]);
+}
+
+// @@protoc_insertion_point(namespace_scope)
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::Foo*
+Arena::CreateMaybeMessage< ::Foo >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::Foo >(arena);
+}
+template<> PROTOBUF_NOINLINE ::Bar*
+Arena::CreateMaybeMessage< ::Bar >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::Bar >(arena);
+}
+PROTOBUF_NAMESPACE_CLOSE
+
+// @@protoc_insertion_point(global_scope)
+#include <google/protobuf/port_undef.inc>
@@ -0,0 +1,949 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: foo.proto
+
+#ifndef GOOGLE_PROTOBUF_INCLUDED_foo_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_foo_2eproto
+
+#include <limits>
+#include <string>
+
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please update
+#error your headers.
+#endif
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/arenastring.h>
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/metadata_lite.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/unknown_field_set.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_foo_2eproto
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
+
+// Internal implementation detail -- do not use these members.
+struct TableStruct_foo_2eproto {
+  static const uint32_t offsets[];
+};
+extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_foo_2eproto;
+class Bar;
+struct BarDefaultTypeInternal;
+extern BarDefaultTypeInternal _Bar_default_instance_;
+class Foo;
+struct FooDefaultTypeInternal;
+extern FooDefaultTypeInternal _Foo_default_instance_;
+PROTOBUF_NAMESPACE_OPEN
+template<> ::Bar* Arena::CreateMaybeMessage<::Bar>(Arena*);
+template<> ::Foo* Arena::CreateMaybeMessage<::Foo>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+
+// ===================================================================
+
+class Foo final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:Foo) */ {
+ public:
+  inline Foo() : Foo(nullptr) {}
+  ~Foo() override;
+  explicit PROTOBUF_CONSTEXPR Foo(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Foo(const Foo& from);
+  Foo(Foo&& from) noexcept
+    : Foo() {
+    *this = ::std::move(from);
+  }
+
+  inline Foo& operator=(const Foo& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Foo& operator=(Foo&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Foo& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Foo* internal_default_instance() {
+    return reinterpret_cast<const Foo*>(
+               &_Foo_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
+
+  friend void swap(Foo& a, Foo& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Foo* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Foo* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Foo* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Foo>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Foo& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Foo& from) {
+    Foo::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Foo* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "Foo";
+  }
+  protected:
+  explicit Foo(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kNumbersFieldNumber = 3,
+    kTextFieldNumber = 1,
+    kNumberFieldNumber = 2,
+  };
+  // repeated int32 numbers = 3;
+  int numbers_size() const;
+  private:
+  int _internal_numbers_size() const;
+  public:
+  void clear_numbers();
+  private:
+  int32_t _internal_numbers(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+      _internal_numbers() const;
+  void _internal_add_numbers(int32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+      _internal_mutable_numbers();
+  public:
+  int32_t numbers(int index) const;
+  void set_numbers(int index, int32_t value);
+  void add_numbers(int32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+      numbers() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+      mutable_numbers();
+
+  // optional string text = 1;
+  bool has_text() const;
+  private:
+  bool _internal_has_text() const;
+  public:
+  void clear_text();
+  const std::string& text() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_text(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_text();
+  PROTOBUF_NODISCARD std::string* release_text();
+  void set_allocated_text(std::string* text);
+  private:
+  const std::string& _internal_text() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_text(const std::string& value);
+  std::string* _internal_mutable_text();
+  public:
+
+  // optional int32 number = 2;
+  bool has_number() const;
+  private:
+  bool _internal_has_number() const;
+  public:
+  void clear_number();
+  int32_t number() const;
+  void set_number(int32_t value);
+  private:
+  int32_t _internal_number() const;
+  void _internal_set_number(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:Foo)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t > numbers_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr text_;
+    int32_t number_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_foo_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Bar final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:Bar) */ {
+ public:
+  inline Bar() : Bar(nullptr) {}
+  ~Bar() override;
+  explicit PROTOBUF_CONSTEXPR Bar(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Bar(const Bar& from);
+  Bar(Bar&& from) noexcept
+    : Bar() {
+    *this = ::std::move(from);
+  }
+
+  inline Bar& operator=(const Bar& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Bar& operator=(Bar&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Bar& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Bar* internal_default_instance() {
+    return reinterpret_cast<const Bar*>(
+               &_Bar_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(Bar& a, Bar& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Bar* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Bar* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Bar* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Bar>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Bar& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Bar& from) {
+    Bar::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Bar* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "Bar";
+  }
+  protected:
+  explicit Bar(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kBarNumbersFieldNumber = 4,
+    kBarFoosFieldNumber = 5,
+    kBarNameFieldNumber = 1,
+    kBarFooFieldNumber = 3,
+    kBarNumberFieldNumber = 2,
+  };
+  // repeated int32 bar_numbers = 4;
+  int bar_numbers_size() const;
+  private:
+  int _internal_bar_numbers_size() const;
+  public:
+  void clear_bar_numbers();
+  private:
+  int32_t _internal_bar_numbers(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+      _internal_bar_numbers() const;
+  void _internal_add_bar_numbers(int32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+      _internal_mutable_bar_numbers();
+  public:
+  int32_t bar_numbers(int index) const;
+  void set_bar_numbers(int index, int32_t value);
+  void add_bar_numbers(int32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+      bar_numbers() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+      mutable_bar_numbers();
+
+  // repeated .Foo bar_foos = 5;
+  int bar_foos_size() const;
+  private:
+  int _internal_bar_foos_size() const;
+  public:
+  void clear_bar_foos();
+  ::Foo* mutable_bar_foos(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Foo >*
+      mutable_bar_foos();
+  private:
+  const ::Foo& _internal_bar_foos(int index) const;
+  ::Foo* _internal_add_bar_foos();
+  public:
+  const ::Foo& bar_foos(int index) const;
+  ::Foo* add_bar_foos();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Foo >&
+      bar_foos() const;
+
+  // optional string bar_name = 1;
+  bool has_bar_name() const;
+  private:
+  bool _internal_has_bar_name() const;
+  public:
+  void clear_bar_name();
+  const std::string& bar_name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_bar_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_bar_name();
+  PROTOBUF_NODISCARD std::string* release_bar_name();
+  void set_allocated_bar_name(std::string* bar_name);
+  private:
+  const std::string& _internal_bar_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_bar_name(const std::string& value);
+  std::string* _internal_mutable_bar_name();
+  public:
+
+  // optional .Foo bar_foo = 3;
+  bool has_bar_foo() const;
+  private:
+  bool _internal_has_bar_foo() const;
+  public:
+  void clear_bar_foo();
+  const ::Foo& bar_foo() const;
+  PROTOBUF_NODISCARD ::Foo* release_bar_foo();
+  ::Foo* mutable_bar_foo();
+  void set_allocated_bar_foo(::Foo* bar_foo);
+  private:
+  const ::Foo& _internal_bar_foo() const;
+  ::Foo* _internal_mutable_bar_foo();
+  public:
+  void unsafe_arena_set_allocated_bar_foo(
+      ::Foo* bar_foo);
+  ::Foo* unsafe_arena_release_bar_foo();
+
+  // optional int32 bar_number = 2;
+  bool has_bar_number() const;
+  private:
+  bool _internal_has_bar_number() const;
+  public:
+  void clear_bar_number();
+  int32_t bar_number() const;
+  void set_bar_number(int32_t value);
+  private:
+  int32_t _internal_bar_number() const;
+  void _internal_set_bar_number(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:Bar)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t > bar_numbers_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Foo > bar_foos_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr bar_name_;
+    ::Foo* bar_foo_;
+    int32_t bar_number_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_foo_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// Foo
+
+// optional string text = 1;
+inline bool Foo::_internal_has_text() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Foo::has_text() const {
+  return _internal_has_text();
+}
+inline void Foo::clear_text() {
+  _impl_.text_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& Foo::text() const {
+  // @@protoc_insertion_point(field_get:Foo.text)
+  return _internal_text();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Foo::set_text(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.text_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:Foo.text)
+}
+inline std::string* Foo::mutable_text() {
+  std::string* _s = _internal_mutable_text();
+  // @@protoc_insertion_point(field_mutable:Foo.text)
+  return _s;
+}
+inline const std::string& Foo::_internal_text() const {
+  return _impl_.text_.Get();
+}
+inline void Foo::_internal_set_text(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.text_.Set(value, GetArenaForAllocation());
+}
+inline std::string* Foo::_internal_mutable_text() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.text_.Mutable(GetArenaForAllocation());
+}
+inline std::string* Foo::release_text() {
+  // @@protoc_insertion_point(field_release:Foo.text)
+  if (!_internal_has_text()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.text_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.text_.IsDefault()) {
+    _impl_.text_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void Foo::set_allocated_text(std::string* text) {
+  if (text != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.text_.SetAllocated(text, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.text_.IsDefault()) {
+    _impl_.text_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:Foo.text)
+}
+
+// optional int32 number = 2;
+inline bool Foo::_internal_has_number() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool Foo::has_number() const {
+  return _internal_has_number();
+}
+inline void Foo::clear_number() {
+  _impl_.number_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline int32_t Foo::_internal_number() const {
+  return _impl_.number_;
+}
+inline int32_t Foo::number() const {
+  // @@protoc_insertion_point(field_get:Foo.number)
+  return _internal_number();
+}
+inline void Foo::_internal_set_number(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.number_ = value;
+}
+inline void Foo::set_number(int32_t value) {
+  _internal_set_number(value);
+  // @@protoc_insertion_point(field_set:Foo.number)
+}
+
+// repeated int32 numbers = 3;
+inline int Foo::_internal_numbers_size() const {
+  return _impl_.numbers_.size();
+}
+inline int Foo::numbers_size() const {
+  return _internal_numbers_size();
+}
+inline void Foo::clear_numbers() {
+  _impl_.numbers_.Clear();
+}
+inline int32_t Foo::_internal_numbers(int index) const {
+  return _impl_.numbers_.Get(index);
+}
+inline int32_t Foo::numbers(int index) const {
+  // @@protoc_insertion_point(field_get:Foo.numbers)
+  return _internal_numbers(index);
+}
+inline void Foo::set_numbers(int index, int32_t value) {
+  _impl_.numbers_.Set(index, value);
+  // @@protoc_insertion_point(field_set:Foo.numbers)
+}
+inline void Foo::_internal_add_numbers(int32_t value) {
+  _impl_.numbers_.Add(value);
+}
+inline void Foo::add_numbers(int32_t value) {
+  _internal_add_numbers(value);
+  // @@protoc_insertion_point(field_add:Foo.numbers)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+Foo::_internal_numbers() const {
+  return _impl_.numbers_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+Foo::numbers() const {
+  // @@protoc_insertion_point(field_list:Foo.numbers)
+  return _internal_numbers();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+Foo::_internal_mutable_numbers() {
+  return &_impl_.numbers_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+Foo::mutable_numbers() {
+  // @@protoc_insertion_point(field_mutable_list:Foo.numbers)
+  return _internal_mutable_numbers();
+}
+
+// -------------------------------------------------------------------
+
+// Bar
+
+// optional string bar_name = 1;
+inline bool Bar::_internal_has_bar_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Bar::has_bar_name() const {
+  return _internal_has_bar_name();
+}
+inline void Bar::clear_bar_name() {
+  _impl_.bar_name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& Bar::bar_name() const {
+  // @@protoc_insertion_point(field_get:Bar.bar_name)
+  return _internal_bar_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Bar::set_bar_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.bar_name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:Bar.bar_name)
+}
+inline std::string* Bar::mutable_bar_name() {
+  std::string* _s = _internal_mutable_bar_name();
+  // @@protoc_insertion_point(field_mutable:Bar.bar_name)
+  return _s;
+}
+inline const std::string& Bar::_internal_bar_name() const {
+  return _impl_.bar_name_.Get();
+}
+inline void Bar::_internal_set_bar_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.bar_name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* Bar::_internal_mutable_bar_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.bar_name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* Bar::release_bar_name() {
+  // @@protoc_insertion_point(field_release:Bar.bar_name)
+  if (!_internal_has_bar_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.bar_name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.bar_name_.IsDefault()) {
+    _impl_.bar_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void Bar::set_allocated_bar_name(std::string* bar_name) {
+  if (bar_name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.bar_name_.SetAllocated(bar_name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.bar_name_.IsDefault()) {
+    _impl_.bar_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:Bar.bar_name)
+}
+
+// optional int32 bar_number = 2;
+inline bool Bar::_internal_has_bar_number() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool Bar::has_bar_number() const {
+  return _internal_has_bar_number();
+}
+inline void Bar::clear_bar_number() {
+  _impl_.bar_number_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline int32_t Bar::_internal_bar_number() const {
+  return _impl_.bar_number_;
+}
+inline int32_t Bar::bar_number() const {
+  // @@protoc_insertion_point(field_get:Bar.bar_number)
+  return _internal_bar_number();
+}
+inline void Bar::_internal_set_bar_number(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.bar_number_ = value;
+}
+inline void Bar::set_bar_number(int32_t value) {
+  _internal_set_bar_number(value);
+  // @@protoc_insertion_point(field_set:Bar.bar_number)
+}
+
+// optional .Foo bar_foo = 3;
+inline bool Bar::_internal_has_bar_foo() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.bar_foo_ != nullptr);
+  return value;
+}
+inline bool Bar::has_bar_foo() const {
+  return _internal_has_bar_foo();
+}
+inline void Bar::clear_bar_foo() {
+  if (_impl_.bar_foo_ != nullptr) _impl_.bar_foo_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const ::Foo& Bar::_internal_bar_foo() const {
+  const ::Foo* p = _impl_.bar_foo_;
+  return p != nullptr ? *p : reinterpret_cast<const ::Foo&>(
+      ::_Foo_default_instance_);
+}
+inline const ::Foo& Bar::bar_foo() const {
+  // @@protoc_insertion_point(field_get:Bar.bar_foo)
+  return _internal_bar_foo();
+}
+inline void Bar::unsafe_arena_set_allocated_bar_foo(
+    ::Foo* bar_foo) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.bar_foo_);
+  }
+  _impl_.bar_foo_ = bar_foo;
+  if (bar_foo) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:Bar.bar_foo)
+}
+inline ::Foo* Bar::release_bar_foo() {
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::Foo* temp = _impl_.bar_foo_;
+  _impl_.bar_foo_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::Foo* Bar::unsafe_arena_release_bar_foo() {
+  // @@protoc_insertion_point(field_release:Bar.bar_foo)
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::Foo* temp = _impl_.bar_foo_;
+  _impl_.bar_foo_ = nullptr;
+  return temp;
+}
+inline ::Foo* Bar::_internal_mutable_bar_foo() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  if (_impl_.bar_foo_ == nullptr) {
+    auto* p = CreateMaybeMessage<::Foo>(GetArenaForAllocation());
+    _impl_.bar_foo_ = p;
+  }
+  return _impl_.bar_foo_;
+}
+inline ::Foo* Bar::mutable_bar_foo() {
+  ::Foo* _msg = _internal_mutable_bar_foo();
+  // @@protoc_insertion_point(field_mutable:Bar.bar_foo)
+  return _msg;
+}
+inline void Bar::set_allocated_bar_foo(::Foo* bar_foo) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.bar_foo_;
+  }
+  if (bar_foo) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(bar_foo);
+    if (message_arena != submessage_arena) {
+      bar_foo = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, bar_foo, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.bar_foo_ = bar_foo;
+  // @@protoc_insertion_point(field_set_allocated:Bar.bar_foo)
+}
+
+// repeated int32 bar_numbers = 4;
+inline int Bar::_internal_bar_numbers_size() const {
+  return _impl_.bar_numbers_.size();
+}
+inline int Bar::bar_numbers_size() const {
+  return _internal_bar_numbers_size();
+}
+inline void Bar::clear_bar_numbers() {
+  _impl_.bar_numbers_.Clear();
+}
+inline int32_t Bar::_internal_bar_numbers(int index) const {
+  return _impl_.bar_numbers_.Get(index);
+}
+inline int32_t Bar::bar_numbers(int index) const {
+  // @@protoc_insertion_point(field_get:Bar.bar_numbers)
+  return _internal_bar_numbers(index);
+}
+inline void Bar::set_bar_numbers(int index, int32_t value) {
+  _impl_.bar_numbers_.Set(index, value);
+  // @@protoc_insertion_point(field_set:Bar.bar_numbers)
+}
+inline void Bar::_internal_add_bar_numbers(int32_t value) {
+  _impl_.bar_numbers_.Add(value);
+}
+inline void Bar::add_bar_numbers(int32_t value) {
+  _internal_add_bar_numbers(value);
+  // @@protoc_insertion_point(field_add:Bar.bar_numbers)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+Bar::_internal_bar_numbers() const {
+  return _impl_.bar_numbers_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+Bar::bar_numbers() const {
+  // @@protoc_insertion_point(field_list:Bar.bar_numbers)
+  return _internal_bar_numbers();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+Bar::_internal_mutable_bar_numbers() {
+  return &_impl_.bar_numbers_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+Bar::mutable_bar_numbers() {
+  // @@protoc_insertion_point(field_mutable_list:Bar.bar_numbers)
+  return _internal_mutable_bar_numbers();
+}
+
+// repeated .Foo bar_foos = 5;
+inline int Bar::_internal_bar_foos_size() const {
+  return _impl_.bar_foos_.size();
+}
+inline int Bar::bar_foos_size() const {
+  return _internal_bar_foos_size();
+}
+inline void Bar::clear_bar_foos() {
+  _impl_.bar_foos_.Clear();
+}
+inline ::Foo* Bar::mutable_bar_foos(int index) {
+  // @@protoc_insertion_point(field_mutable:Bar.bar_foos)
+  return _impl_.bar_foos_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Foo >*
+Bar::mutable_bar_foos() {
+  // @@protoc_insertion_point(field_mutable_list:Bar.bar_foos)
+  return &_impl_.bar_foos_;
+}
+inline const ::Foo& Bar::_internal_bar_foos(int index) const {
+  return _impl_.bar_foos_.Get(index);
+}
+inline const ::Foo& Bar::bar_foos(int index) const {
+  // @@protoc_insertion_point(field_get:Bar.bar_foos)
+  return _internal_bar_foos(index);
+}
+inline ::Foo* Bar::_internal_add_bar_foos() {
+  return _impl_.bar_foos_.Add();
+}
+inline ::Foo* Bar::add_bar_foos() {
+  ::Foo* _add = _internal_add_bar_foos();
+  // @@protoc_insertion_point(field_add:Bar.bar_foos)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Foo >&
+Bar::bar_foos() const {
+  // @@protoc_insertion_point(field_list:Bar.bar_foos)
+  return _impl_.bar_foos_;
+}
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+
+// @@protoc_insertion_point(global_scope)
+
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_foo_2eproto
@@ -0,0 +1,1489 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: planetary_system.proto
+
+#include "planetary_system.pb.h"
+
+#include <algorithm>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/reflection_ops.h>
+#include <google/protobuf/wire_format.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+
+PROTOBUF_PRAGMA_INIT_SEG
+
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
+
+namespace pbperftest {
+PROTOBUF_CONSTEXPR PlanetarySystem_Star::PlanetarySystem_Star(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.radius_km_)*/0
+  , /*decltype(_impl_.mass_kg_)*/0
+  , /*decltype(_impl_.age_billion_years_)*/0} {}
+struct PlanetarySystem_StarDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlanetarySystem_StarDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlanetarySystem_StarDefaultTypeInternal() {}
+  union {
+    PlanetarySystem_Star _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlanetarySystem_StarDefaultTypeInternal _PlanetarySystem_Star_default_instance_;
+PROTOBUF_CONSTEXPR PlanetarySystem_Planet_Moon::PlanetarySystem_Planet_Moon(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.radius_km_)*/0} {}
+struct PlanetarySystem_Planet_MoonDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlanetarySystem_Planet_MoonDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlanetarySystem_Planet_MoonDefaultTypeInternal() {}
+  union {
+    PlanetarySystem_Planet_Moon _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlanetarySystem_Planet_MoonDefaultTypeInternal _PlanetarySystem_Planet_Moon_default_instance_;
+PROTOBUF_CONSTEXPR PlanetarySystem_Planet::PlanetarySystem_Planet(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.moon_)*/{}
+  , /*decltype(_impl_.name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.radius_km_)*/0
+  , /*decltype(_impl_.mass_kg_)*/0
+  , /*decltype(_impl_.semi_major_axis_au_)*/0
+  , /*decltype(_impl_.age_billion_years_)*/0} {}
+struct PlanetarySystem_PlanetDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlanetarySystem_PlanetDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlanetarySystem_PlanetDefaultTypeInternal() {}
+  union {
+    PlanetarySystem_Planet _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlanetarySystem_PlanetDefaultTypeInternal _PlanetarySystem_Planet_default_instance_;
+PROTOBUF_CONSTEXPR PlanetarySystem::PlanetarySystem(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.star_)*/{}
+  , /*decltype(_impl_.planet_)*/{}
+  , /*decltype(_impl_.name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}} {}
+struct PlanetarySystemDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PlanetarySystemDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PlanetarySystemDefaultTypeInternal() {}
+  union {
+    PlanetarySystem _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlanetarySystemDefaultTypeInternal _PlanetarySystem_default_instance_;
+}  // namespace pbperftest
+static ::_pb::Metadata file_level_metadata_planetary_5fsystem_2eproto[4];
+static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_planetary_5fsystem_2eproto = nullptr;
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_planetary_5fsystem_2eproto = nullptr;
+
+const uint32_t TableStruct_planetary_5fsystem_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Star, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Star, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Star, _impl_.name_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Star, _impl_.radius_km_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Star, _impl_.mass_kg_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Star, _impl_.age_billion_years_),
+  0,
+  1,
+  2,
+  3,
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet_Moon, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet_Moon, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet_Moon, _impl_.name_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet_Moon, _impl_.radius_km_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet, _impl_.name_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet, _impl_.radius_km_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet, _impl_.mass_kg_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet, _impl_.semi_major_axis_au_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet, _impl_.age_billion_years_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem_Planet, _impl_.moon_),
+  0,
+  1,
+  2,
+  3,
+  4,
+  ~0u,
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem, _impl_.name_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem, _impl_.star_),
+  PROTOBUF_FIELD_OFFSET(::pbperftest::PlanetarySystem, _impl_.planet_),
+  0,
+  ~0u,
+  ~0u,
+};
+static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  { 0, 10, -1, sizeof(::pbperftest::PlanetarySystem_Star)},
+  { 14, 22, -1, sizeof(::pbperftest::PlanetarySystem_Planet_Moon)},
+  { 24, 36, -1, sizeof(::pbperftest::PlanetarySystem_Planet)},
+  { 42, 51, -1, sizeof(::pbperftest::PlanetarySystem)},
+};
+
+static const ::_pb::Message* const file_default_instances[] = {
+  &::pbperftest::_PlanetarySystem_Star_default_instance_._instance,
+  &::pbperftest::_PlanetarySystem_Planet_Moon_default_instance_._instance,
+  &::pbperftest::_PlanetarySystem_Planet_default_instance_._instance,
+  &::pbperftest::_PlanetarySystem_default_instance_._instance,
+};
+
+const char descriptor_table_protodef_planetary_5fsystem_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
+  "\n\026planetary_system.proto\022\npbperftest\"\254\003\n"
+  "\017PlanetarySystem\022\014\n\004name\030\001 \002(\t\022.\n\004star\030\002"
+  " \003(\0132 .pbperftest.PlanetarySystem.Star\0222"
+  "\n\006planet\030\003 \003(\0132\".pbperftest.PlanetarySys"
+  "tem.Planet\032S\n\004Star\022\014\n\004name\030\001 \002(\t\022\021\n\tradi"
+  "us_km\030\002 \001(\001\022\017\n\007mass_kg\030\003 \001(\001\022\031\n\021age_bill"
+  "ion_years\030\004 \001(\001\032\321\001\n\006Planet\022\014\n\004name\030\001 \002(\t"
+  "\022\021\n\tradius_km\030\002 \001(\001\022\017\n\007mass_kg\030\003 \001(\001\022\032\n\022"
+  "semi_major_axis_au\030\004 \001(\001\022\031\n\021age_billion_"
+  "years\030\005 \001(\001\0225\n\004moon\030\006 \003(\0132\'.pbperftest.P"
+  "lanetarySystem.Planet.Moon\032\'\n\004Moon\022\014\n\004na"
+  "me\030\001 \002(\t\022\021\n\tradius_km\030\002 \001(\001"
+  ;
+static ::_pbi::once_flag descriptor_table_planetary_5fsystem_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_planetary_5fsystem_2eproto = {
+    false, false, 467, descriptor_table_protodef_planetary_5fsystem_2eproto,
+    "planetary_system.proto",
+    &descriptor_table_planetary_5fsystem_2eproto_once, nullptr, 0, 4,
+    schemas, file_default_instances, TableStruct_planetary_5fsystem_2eproto::offsets,
+    file_level_metadata_planetary_5fsystem_2eproto, file_level_enum_descriptors_planetary_5fsystem_2eproto,
+    file_level_service_descriptors_planetary_5fsystem_2eproto,
+};
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_planetary_5fsystem_2eproto_getter() {
+  return &descriptor_table_planetary_5fsystem_2eproto;
+}
+
+// Force running AddDescriptors() at dynamic initialization time.
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_planetary_5fsystem_2eproto(&descriptor_table_planetary_5fsystem_2eproto);
+namespace pbperftest {
+
+// ===================================================================
+
+class PlanetarySystem_Star::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlanetarySystem_Star>()._impl_._has_bits_);
+  static void set_has_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_radius_km(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_mass_kg(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_age_billion_years(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
+
+PlanetarySystem_Star::PlanetarySystem_Star(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:pbperftest.PlanetarySystem.Star)
+}
+PlanetarySystem_Star::PlanetarySystem_Star(const PlanetarySystem_Star& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlanetarySystem_Star* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.radius_km_){}
+    , decltype(_impl_.mass_kg_){}
+    , decltype(_impl_.age_billion_years_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_name()) {
+    _this->_impl_.name_.Set(from._internal_name(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.radius_km_, &from._impl_.radius_km_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.age_billion_years_) -
+    reinterpret_cast<char*>(&_impl_.radius_km_)) + sizeof(_impl_.age_billion_years_));
+  // @@protoc_insertion_point(copy_constructor:pbperftest.PlanetarySystem.Star)
+}
+
+inline void PlanetarySystem_Star::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.radius_km_){0}
+    , decltype(_impl_.mass_kg_){0}
+    , decltype(_impl_.age_billion_years_){0}
+  };
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+PlanetarySystem_Star::~PlanetarySystem_Star() {
+  // @@protoc_insertion_point(destructor:pbperftest.PlanetarySystem.Star)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void PlanetarySystem_Star::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.name_.Destroy();
+}
+
+void PlanetarySystem_Star::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void PlanetarySystem_Star::Clear() {
+// @@protoc_insertion_point(message_clear_start:pbperftest.PlanetarySystem.Star)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    _impl_.name_.ClearNonDefaultToEmpty();
+  }
+  if (cached_has_bits & 0x0000000eu) {
+    ::memset(&_impl_.radius_km_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.age_billion_years_) -
+        reinterpret_cast<char*>(&_impl_.radius_km_)) + sizeof(_impl_.age_billion_years_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlanetarySystem_Star::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // required string name = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "pbperftest.PlanetarySystem.Star.name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double radius_km = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_radius_km(&has_bits);
+          _impl_.radius_km_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double mass_kg = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 25)) {
+          _Internal::set_has_mass_kg(&has_bits);
+          _impl_.mass_kg_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double age_billion_years = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 33)) {
+          _Internal::set_has_age_billion_years(&has_bits);
+          _impl_.age_billion_years_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* PlanetarySystem_Star::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:pbperftest.PlanetarySystem.Star)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // required string name = 1;
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_name().data(), static_cast<int>(this->_internal_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "pbperftest.PlanetarySystem.Star.name");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_name(), target);
+  }
+
+  // optional double radius_km = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_radius_km(), target);
+  }
+
+  // optional double mass_kg = 3;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(3, this->_internal_mass_kg(), target);
+  }
+
+  // optional double age_billion_years = 4;
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(4, this->_internal_age_billion_years(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:pbperftest.PlanetarySystem.Star)
+  return target;
+}
+
+size_t PlanetarySystem_Star::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:pbperftest.PlanetarySystem.Star)
+  size_t total_size = 0;
+
+  // required string name = 1;
+  if (_internal_has_name()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_name());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000eu) {
+    // optional double radius_km = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double mass_kg = 3;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double age_billion_years = 4;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += 1 + 8;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlanetarySystem_Star::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlanetarySystem_Star::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlanetarySystem_Star::GetClassData() const { return &_class_data_; }
+
+
+void PlanetarySystem_Star::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlanetarySystem_Star*>(&to_msg);
+  auto& from = static_cast<const PlanetarySystem_Star&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:pbperftest.PlanetarySystem.Star)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_name(from._internal_name());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.radius_km_ = from._impl_.radius_km_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.mass_kg_ = from._impl_.mass_kg_;
+    }
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.age_billion_years_ = from._impl_.age_billion_years_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void PlanetarySystem_Star::CopyFrom(const PlanetarySystem_Star& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:pbperftest.PlanetarySystem.Star)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PlanetarySystem_Star::IsInitialized() const {
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  return true;
+}
+
+void PlanetarySystem_Star::InternalSwap(PlanetarySystem_Star* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.name_, lhs_arena,
+      &other->_impl_.name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(PlanetarySystem_Star, _impl_.age_billion_years_)
+      + sizeof(PlanetarySystem_Star::_impl_.age_billion_years_)
+      - PROTOBUF_FIELD_OFFSET(PlanetarySystem_Star, _impl_.radius_km_)>(
+          reinterpret_cast<char*>(&_impl_.radius_km_),
+          reinterpret_cast<char*>(&other->_impl_.radius_km_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata PlanetarySystem_Star::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_planetary_5fsystem_2eproto_getter, &descriptor_table_planetary_5fsystem_2eproto_once,
+      file_level_metadata_planetary_5fsystem_2eproto[0]);
+}
+
+// ===================================================================
+
+class PlanetarySystem_Planet_Moon::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlanetarySystem_Planet_Moon>()._impl_._has_bits_);
+  static void set_has_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_radius_km(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
+
+PlanetarySystem_Planet_Moon::PlanetarySystem_Planet_Moon(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:pbperftest.PlanetarySystem.Planet.Moon)
+}
+PlanetarySystem_Planet_Moon::PlanetarySystem_Planet_Moon(const PlanetarySystem_Planet_Moon& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlanetarySystem_Planet_Moon* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.radius_km_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_name()) {
+    _this->_impl_.name_.Set(from._internal_name(), 
+      _this->GetArenaForAllocation());
+  }
+  _this->_impl_.radius_km_ = from._impl_.radius_km_;
+  // @@protoc_insertion_point(copy_constructor:pbperftest.PlanetarySystem.Planet.Moon)
+}
+
+inline void PlanetarySystem_Planet_Moon::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.radius_km_){0}
+  };
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+PlanetarySystem_Planet_Moon::~PlanetarySystem_Planet_Moon() {
+  // @@protoc_insertion_point(destructor:pbperftest.PlanetarySystem.Planet.Moon)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void PlanetarySystem_Planet_Moon::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.name_.Destroy();
+}
+
+void PlanetarySystem_Planet_Moon::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void PlanetarySystem_Planet_Moon::Clear() {
+// @@protoc_insertion_point(message_clear_start:pbperftest.PlanetarySystem.Planet.Moon)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    _impl_.name_.ClearNonDefaultToEmpty();
+  }
+  _impl_.radius_km_ = 0;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlanetarySystem_Planet_Moon::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // required string name = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "pbperftest.PlanetarySystem.Planet.Moon.name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double radius_km = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_radius_km(&has_bits);
+          _impl_.radius_km_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* PlanetarySystem_Planet_Moon::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:pbperftest.PlanetarySystem.Planet.Moon)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // required string name = 1;
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_name().data(), static_cast<int>(this->_internal_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "pbperftest.PlanetarySystem.Planet.Moon.name");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_name(), target);
+  }
+
+  // optional double radius_km = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_radius_km(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:pbperftest.PlanetarySystem.Planet.Moon)
+  return target;
+}
+
+size_t PlanetarySystem_Planet_Moon::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:pbperftest.PlanetarySystem.Planet.Moon)
+  size_t total_size = 0;
+
+  // required string name = 1;
+  if (_internal_has_name()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_name());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // optional double radius_km = 2;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000002u) {
+    total_size += 1 + 8;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlanetarySystem_Planet_Moon::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlanetarySystem_Planet_Moon::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlanetarySystem_Planet_Moon::GetClassData() const { return &_class_data_; }
+
+
+void PlanetarySystem_Planet_Moon::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlanetarySystem_Planet_Moon*>(&to_msg);
+  auto& from = static_cast<const PlanetarySystem_Planet_Moon&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:pbperftest.PlanetarySystem.Planet.Moon)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_name(from._internal_name());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.radius_km_ = from._impl_.radius_km_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void PlanetarySystem_Planet_Moon::CopyFrom(const PlanetarySystem_Planet_Moon& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:pbperftest.PlanetarySystem.Planet.Moon)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PlanetarySystem_Planet_Moon::IsInitialized() const {
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  return true;
+}
+
+void PlanetarySystem_Planet_Moon::InternalSwap(PlanetarySystem_Planet_Moon* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.name_, lhs_arena,
+      &other->_impl_.name_, rhs_arena
+  );
+  swap(_impl_.radius_km_, other->_impl_.radius_km_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata PlanetarySystem_Planet_Moon::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_planetary_5fsystem_2eproto_getter, &descriptor_table_planetary_5fsystem_2eproto_once,
+      file_level_metadata_planetary_5fsystem_2eproto[1]);
+}
+
+// ===================================================================
+
+class PlanetarySystem_Planet::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlanetarySystem_Planet>()._impl_._has_bits_);
+  static void set_has_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_radius_km(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_mass_kg(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_semi_major_axis_au(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_age_billion_years(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
+
+PlanetarySystem_Planet::PlanetarySystem_Planet(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:pbperftest.PlanetarySystem.Planet)
+}
+PlanetarySystem_Planet::PlanetarySystem_Planet(const PlanetarySystem_Planet& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlanetarySystem_Planet* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.moon_){from._impl_.moon_}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.radius_km_){}
+    , decltype(_impl_.mass_kg_){}
+    , decltype(_impl_.semi_major_axis_au_){}
+    , decltype(_impl_.age_billion_years_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_name()) {
+    _this->_impl_.name_.Set(from._internal_name(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.radius_km_, &from._impl_.radius_km_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.age_billion_years_) -
+    reinterpret_cast<char*>(&_impl_.radius_km_)) + sizeof(_impl_.age_billion_years_));
+  // @@protoc_insertion_point(copy_constructor:pbperftest.PlanetarySystem.Planet)
+}
+
+inline void PlanetarySystem_Planet::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.moon_){arena}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.radius_km_){0}
+    , decltype(_impl_.mass_kg_){0}
+    , decltype(_impl_.semi_major_axis_au_){0}
+    , decltype(_impl_.age_billion_years_){0}
+  };
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+PlanetarySystem_Planet::~PlanetarySystem_Planet() {
+  // @@protoc_insertion_point(destructor:pbperftest.PlanetarySystem.Planet)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void PlanetarySystem_Planet::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.moon_.~RepeatedPtrField();
+  _impl_.name_.Destroy();
+}
+
+void PlanetarySystem_Planet::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void PlanetarySystem_Planet::Clear() {
+// @@protoc_insertion_point(message_clear_start:pbperftest.PlanetarySystem.Planet)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.moon_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    _impl_.name_.ClearNonDefaultToEmpty();
+  }
+  if (cached_has_bits & 0x0000001eu) {
+    ::memset(&_impl_.radius_km_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.age_billion_years_) -
+        reinterpret_cast<char*>(&_impl_.radius_km_)) + sizeof(_impl_.age_billion_years_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlanetarySystem_Planet::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // required string name = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "pbperftest.PlanetarySystem.Planet.name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double radius_km = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_radius_km(&has_bits);
+          _impl_.radius_km_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double mass_kg = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 25)) {
+          _Internal::set_has_mass_kg(&has_bits);
+          _impl_.mass_kg_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double semi_major_axis_au = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 33)) {
+          _Internal::set_has_semi_major_axis_au(&has_bits);
+          _impl_.semi_major_axis_au_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double age_billion_years = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 41)) {
+          _Internal::set_has_age_billion_years(&has_bits);
+          _impl_.age_billion_years_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .pbperftest.PlanetarySystem.Planet.Moon moon = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_moon(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<50>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* PlanetarySystem_Planet::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:pbperftest.PlanetarySystem.Planet)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // required string name = 1;
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_name().data(), static_cast<int>(this->_internal_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "pbperftest.PlanetarySystem.Planet.name");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_name(), target);
+  }
+
+  // optional double radius_km = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_radius_km(), target);
+  }
+
+  // optional double mass_kg = 3;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(3, this->_internal_mass_kg(), target);
+  }
+
+  // optional double semi_major_axis_au = 4;
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(4, this->_internal_semi_major_axis_au(), target);
+  }
+
+  // optional double age_billion_years = 5;
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(5, this->_internal_age_billion_years(), target);
+  }
+
+  // repeated .pbperftest.PlanetarySystem.Planet.Moon moon = 6;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_moon_size()); i < n; i++) {
+    const auto& repfield = this->_internal_moon(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(6, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:pbperftest.PlanetarySystem.Planet)
+  return target;
+}
+
+size_t PlanetarySystem_Planet::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:pbperftest.PlanetarySystem.Planet)
+  size_t total_size = 0;
+
+  // required string name = 1;
+  if (_internal_has_name()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_name());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .pbperftest.PlanetarySystem.Planet.Moon moon = 6;
+  total_size += 1UL * this->_internal_moon_size();
+  for (const auto& msg : this->_impl_.moon_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000001eu) {
+    // optional double radius_km = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double mass_kg = 3;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double semi_major_axis_au = 4;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double age_billion_years = 5;
+    if (cached_has_bits & 0x00000010u) {
+      total_size += 1 + 8;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlanetarySystem_Planet::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlanetarySystem_Planet::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlanetarySystem_Planet::GetClassData() const { return &_class_data_; }
+
+
+void PlanetarySystem_Planet::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlanetarySystem_Planet*>(&to_msg);
+  auto& from = static_cast<const PlanetarySystem_Planet&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:pbperftest.PlanetarySystem.Planet)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.moon_.MergeFrom(from._impl_.moon_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000001fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_name(from._internal_name());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.radius_km_ = from._impl_.radius_km_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.mass_kg_ = from._impl_.mass_kg_;
+    }
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.semi_major_axis_au_ = from._impl_.semi_major_axis_au_;
+    }
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.age_billion_years_ = from._impl_.age_billion_years_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void PlanetarySystem_Planet::CopyFrom(const PlanetarySystem_Planet& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:pbperftest.PlanetarySystem.Planet)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PlanetarySystem_Planet::IsInitialized() const {
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (!::PROTOBUF_NAMESPACE_ID::internal::AllAreInitialized(_impl_.moon_))
+    return false;
+  return true;
+}
+
+void PlanetarySystem_Planet::InternalSwap(PlanetarySystem_Planet* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.moon_.InternalSwap(&other->_impl_.moon_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.name_, lhs_arena,
+      &other->_impl_.name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(PlanetarySystem_Planet, _impl_.age_billion_years_)
+      + sizeof(PlanetarySystem_Planet::_impl_.age_billion_years_)
+      - PROTOBUF_FIELD_OFFSET(PlanetarySystem_Planet, _impl_.radius_km_)>(
+          reinterpret_cast<char*>(&_impl_.radius_km_),
+          reinterpret_cast<char*>(&other->_impl_.radius_km_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata PlanetarySystem_Planet::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_planetary_5fsystem_2eproto_getter, &descriptor_table_planetary_5fsystem_2eproto_once,
+      file_level_metadata_planetary_5fsystem_2eproto[2]);
+}
+
+// ===================================================================
+
+class PlanetarySystem::_Internal {
+ public:
+  using HasBits = decltype(std::declval<PlanetarySystem>()._impl_._has_bits_);
+  static void set_has_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
+
+PlanetarySystem::PlanetarySystem(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:pbperftest.PlanetarySystem)
+}
+PlanetarySystem::PlanetarySystem(const PlanetarySystem& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  PlanetarySystem* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.star_){from._impl_.star_}
+    , decltype(_impl_.planet_){from._impl_.planet_}
+    , decltype(_impl_.name_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_name()) {
+    _this->_impl_.name_.Set(from._internal_name(), 
+      _this->GetArenaForAllocation());
+  }
+  // @@protoc_insertion_point(copy_constructor:pbperftest.PlanetarySystem)
+}
+
+inline void PlanetarySystem::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.star_){arena}
+    , decltype(_impl_.planet_){arena}
+    , decltype(_impl_.name_){}
+  };
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+PlanetarySystem::~PlanetarySystem() {
+  // @@protoc_insertion_point(destructor:pbperftest.PlanetarySystem)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void PlanetarySystem::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.star_.~RepeatedPtrField();
+  _impl_.planet_.~RepeatedPtrField();
+  _impl_.name_.Destroy();
+}
+
+void PlanetarySystem::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void PlanetarySystem::Clear() {
+// @@protoc_insertion_point(message_clear_start:pbperftest.PlanetarySystem)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.star_.Clear();
+  _impl_.planet_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    _impl_.name_.ClearNonDefaultToEmpty();
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* PlanetarySystem::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // required string name = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "pbperftest.PlanetarySystem.name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .pbperftest.PlanetarySystem.Star star = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_star(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<18>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .pbperftest.PlanetarySystem.Planet planet = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_planet(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<26>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* PlanetarySystem::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:pbperftest.PlanetarySystem)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // required string name = 1;
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_name().data(), static_cast<int>(this->_internal_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "pbperftest.PlanetarySystem.name");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_name(), target);
+  }
+
+  // repeated .pbperftest.PlanetarySystem.Star star = 2;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_star_size()); i < n; i++) {
+    const auto& repfield = this->_internal_star(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(2, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  // repeated .pbperftest.PlanetarySystem.Planet planet = 3;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_planet_size()); i < n; i++) {
+    const auto& repfield = this->_internal_planet(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(3, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:pbperftest.PlanetarySystem)
+  return target;
+}
+
+size_t PlanetarySystem::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:pbperftest.PlanetarySystem)
+  size_t total_size = 0;
+
+  // required string name = 1;
+  if (_internal_has_name()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_name());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .pbperftest.PlanetarySystem.Star star = 2;
+  total_size += 1UL * this->_internal_star_size();
+  for (const auto& msg : this->_impl_.star_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // repeated .pbperftest.PlanetarySystem.Planet planet = 3;
+  total_size += 1UL * this->_internal_planet_size();
+  for (const auto& msg : this->_impl_.planet_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PlanetarySystem::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    PlanetarySystem::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PlanetarySystem::GetClassData() const { return &_class_data_; }
+
+
+void PlanetarySystem::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<PlanetarySystem*>(&to_msg);
+  auto& from = static_cast<const PlanetarySystem&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:pbperftest.PlanetarySystem)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.star_.MergeFrom(from._impl_.star_);
+  _this->_impl_.planet_.MergeFrom(from._impl_.planet_);
+  if (from._internal_has_name()) {
+    _this->_internal_set_name(from._internal_name());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void PlanetarySystem::CopyFrom(const PlanetarySystem& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:pbperftest.PlanetarySystem)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PlanetarySystem::IsInitialized() const {
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (!::PROTOBUF_NAMESPACE_ID::internal::AllAreInitialized(_impl_.star_))
+    return false;
+  if (!::PROTOBUF_NAMESPACE_ID::internal::AllAreInitialized(_impl_.planet_))
+    return false;
+  return true;
+}
+
+void PlanetarySystem::InternalSwap(PlanetarySystem* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.star_.InternalSwap(&other->_impl_.star_);
+  _impl_.planet_.InternalSwap(&other->_impl_.planet_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.name_, lhs_arena,
+      &other->_impl_.name_, rhs_arena
+  );
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata PlanetarySystem::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_planetary_5fsystem_2eproto_getter, &descriptor_table_planetary_5fsystem_2eproto_once,
+      file_level_metadata_planetary_5fsystem_2eproto[3]);
+}
+
+// @@protoc_insertion_point(namespace_scope)
+}  // namespace pbperftest
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::pbperftest::PlanetarySystem_Star*
+Arena::CreateMaybeMessage< ::pbperftest::PlanetarySystem_Star >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::pbperftest::PlanetarySystem_Star >(arena);
+}
+template<> PROTOBUF_NOINLINE ::pbperftest::PlanetarySystem_Planet_Moon*
+Arena::CreateMaybeMessage< ::pbperftest::PlanetarySystem_Planet_Moon >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::pbperftest::PlanetarySystem_Planet_Moon >(arena);
+}
+template<> PROTOBUF_NOINLINE ::pbperftest::PlanetarySystem_Planet*
+Arena::CreateMaybeMessage< ::pbperftest::PlanetarySystem_Planet >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::pbperftest::PlanetarySystem_Planet >(arena);
+}
+template<> PROTOBUF_NOINLINE ::pbperftest::PlanetarySystem*
+Arena::CreateMaybeMessage< ::pbperftest::PlanetarySystem >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::pbperftest::PlanetarySystem >(arena);
+}
+PROTOBUF_NAMESPACE_CLOSE
+
+// @@protoc_insertion_point(global_scope)
+#include <google/protobuf/port_undef.inc>
@@ -0,0 +1,1570 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: planetary_system.proto
+
+#ifndef GOOGLE_PROTOBUF_INCLUDED_planetary_5fsystem_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_planetary_5fsystem_2eproto
+
+#include <limits>
+#include <string>
+
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please update
+#error your headers.
+#endif
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/arenastring.h>
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/metadata_lite.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/unknown_field_set.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_planetary_5fsystem_2eproto
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
+
+// Internal implementation detail -- do not use these members.
+struct TableStruct_planetary_5fsystem_2eproto {
+  static const uint32_t offsets[];
+};
+extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_planetary_5fsystem_2eproto;
+namespace pbperftest {
+class PlanetarySystem;
+struct PlanetarySystemDefaultTypeInternal;
+extern PlanetarySystemDefaultTypeInternal _PlanetarySystem_default_instance_;
+class PlanetarySystem_Planet;
+struct PlanetarySystem_PlanetDefaultTypeInternal;
+extern PlanetarySystem_PlanetDefaultTypeInternal _PlanetarySystem_Planet_default_instance_;
+class PlanetarySystem_Planet_Moon;
+struct PlanetarySystem_Planet_MoonDefaultTypeInternal;
+extern PlanetarySystem_Planet_MoonDefaultTypeInternal _PlanetarySystem_Planet_Moon_default_instance_;
+class PlanetarySystem_Star;
+struct PlanetarySystem_StarDefaultTypeInternal;
+extern PlanetarySystem_StarDefaultTypeInternal _PlanetarySystem_Star_default_instance_;
+}  // namespace pbperftest
+PROTOBUF_NAMESPACE_OPEN
+template<> ::pbperftest::PlanetarySystem* Arena::CreateMaybeMessage<::pbperftest::PlanetarySystem>(Arena*);
+template<> ::pbperftest::PlanetarySystem_Planet* Arena::CreateMaybeMessage<::pbperftest::PlanetarySystem_Planet>(Arena*);
+template<> ::pbperftest::PlanetarySystem_Planet_Moon* Arena::CreateMaybeMessage<::pbperftest::PlanetarySystem_Planet_Moon>(Arena*);
+template<> ::pbperftest::PlanetarySystem_Star* Arena::CreateMaybeMessage<::pbperftest::PlanetarySystem_Star>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+namespace pbperftest {
+
+// ===================================================================
+
+class PlanetarySystem_Star final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:pbperftest.PlanetarySystem.Star) */ {
+ public:
+  inline PlanetarySystem_Star() : PlanetarySystem_Star(nullptr) {}
+  ~PlanetarySystem_Star() override;
+  explicit PROTOBUF_CONSTEXPR PlanetarySystem_Star(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  PlanetarySystem_Star(const PlanetarySystem_Star& from);
+  PlanetarySystem_Star(PlanetarySystem_Star&& from) noexcept
+    : PlanetarySystem_Star() {
+    *this = ::std::move(from);
+  }
+
+  inline PlanetarySystem_Star& operator=(const PlanetarySystem_Star& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline PlanetarySystem_Star& operator=(PlanetarySystem_Star&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const PlanetarySystem_Star& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const PlanetarySystem_Star* internal_default_instance() {
+    return reinterpret_cast<const PlanetarySystem_Star*>(
+               &_PlanetarySystem_Star_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
+
+  friend void swap(PlanetarySystem_Star& a, PlanetarySystem_Star& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(PlanetarySystem_Star* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(PlanetarySystem_Star* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  PlanetarySystem_Star* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<PlanetarySystem_Star>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const PlanetarySystem_Star& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const PlanetarySystem_Star& from) {
+    PlanetarySystem_Star::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(PlanetarySystem_Star* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "pbperftest.PlanetarySystem.Star";
+  }
+  protected:
+  explicit PlanetarySystem_Star(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kNameFieldNumber = 1,
+    kRadiusKmFieldNumber = 2,
+    kMassKgFieldNumber = 3,
+    kAgeBillionYearsFieldNumber = 4,
+  };
+  // required string name = 1;
+  bool has_name() const;
+  private:
+  bool _internal_has_name() const;
+  public:
+  void clear_name();
+  const std::string& name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* name);
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(const std::string& value);
+  std::string* _internal_mutable_name();
+  public:
+
+  // optional double radius_km = 2;
+  bool has_radius_km() const;
+  private:
+  bool _internal_has_radius_km() const;
+  public:
+  void clear_radius_km();
+  double radius_km() const;
+  void set_radius_km(double value);
+  private:
+  double _internal_radius_km() const;
+  void _internal_set_radius_km(double value);
+  public:
+
+  // optional double mass_kg = 3;
+  bool has_mass_kg() const;
+  private:
+  bool _internal_has_mass_kg() const;
+  public:
+  void clear_mass_kg();
+  double mass_kg() const;
+  void set_mass_kg(double value);
+  private:
+  double _internal_mass_kg() const;
+  void _internal_set_mass_kg(double value);
+  public:
+
+  // optional double age_billion_years = 4;
+  bool has_age_billion_years() const;
+  private:
+  bool _internal_has_age_billion_years() const;
+  public:
+  void clear_age_billion_years();
+  double age_billion_years() const;
+  void set_age_billion_years(double value);
+  private:
+  double _internal_age_billion_years() const;
+  void _internal_set_age_billion_years(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:pbperftest.PlanetarySystem.Star)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+    double radius_km_;
+    double mass_kg_;
+    double age_billion_years_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_planetary_5fsystem_2eproto;
+};
+// -------------------------------------------------------------------
+
+class PlanetarySystem_Planet_Moon final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:pbperftest.PlanetarySystem.Planet.Moon) */ {
+ public:
+  inline PlanetarySystem_Planet_Moon() : PlanetarySystem_Planet_Moon(nullptr) {}
+  ~PlanetarySystem_Planet_Moon() override;
+  explicit PROTOBUF_CONSTEXPR PlanetarySystem_Planet_Moon(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  PlanetarySystem_Planet_Moon(const PlanetarySystem_Planet_Moon& from);
+  PlanetarySystem_Planet_Moon(PlanetarySystem_Planet_Moon&& from) noexcept
+    : PlanetarySystem_Planet_Moon() {
+    *this = ::std::move(from);
+  }
+
+  inline PlanetarySystem_Planet_Moon& operator=(const PlanetarySystem_Planet_Moon& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline PlanetarySystem_Planet_Moon& operator=(PlanetarySystem_Planet_Moon&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const PlanetarySystem_Planet_Moon& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const PlanetarySystem_Planet_Moon* internal_default_instance() {
+    return reinterpret_cast<const PlanetarySystem_Planet_Moon*>(
+               &_PlanetarySystem_Planet_Moon_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(PlanetarySystem_Planet_Moon& a, PlanetarySystem_Planet_Moon& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(PlanetarySystem_Planet_Moon* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(PlanetarySystem_Planet_Moon* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  PlanetarySystem_Planet_Moon* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<PlanetarySystem_Planet_Moon>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const PlanetarySystem_Planet_Moon& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const PlanetarySystem_Planet_Moon& from) {
+    PlanetarySystem_Planet_Moon::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(PlanetarySystem_Planet_Moon* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "pbperftest.PlanetarySystem.Planet.Moon";
+  }
+  protected:
+  explicit PlanetarySystem_Planet_Moon(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kNameFieldNumber = 1,
+    kRadiusKmFieldNumber = 2,
+  };
+  // required string name = 1;
+  bool has_name() const;
+  private:
+  bool _internal_has_name() const;
+  public:
+  void clear_name();
+  const std::string& name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* name);
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(const std::string& value);
+  std::string* _internal_mutable_name();
+  public:
+
+  // optional double radius_km = 2;
+  bool has_radius_km() const;
+  private:
+  bool _internal_has_radius_km() const;
+  public:
+  void clear_radius_km();
+  double radius_km() const;
+  void set_radius_km(double value);
+  private:
+  double _internal_radius_km() const;
+  void _internal_set_radius_km(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:pbperftest.PlanetarySystem.Planet.Moon)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+    double radius_km_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_planetary_5fsystem_2eproto;
+};
+// -------------------------------------------------------------------
+
+class PlanetarySystem_Planet final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:pbperftest.PlanetarySystem.Planet) */ {
+ public:
+  inline PlanetarySystem_Planet() : PlanetarySystem_Planet(nullptr) {}
+  ~PlanetarySystem_Planet() override;
+  explicit PROTOBUF_CONSTEXPR PlanetarySystem_Planet(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  PlanetarySystem_Planet(const PlanetarySystem_Planet& from);
+  PlanetarySystem_Planet(PlanetarySystem_Planet&& from) noexcept
+    : PlanetarySystem_Planet() {
+    *this = ::std::move(from);
+  }
+
+  inline PlanetarySystem_Planet& operator=(const PlanetarySystem_Planet& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline PlanetarySystem_Planet& operator=(PlanetarySystem_Planet&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const PlanetarySystem_Planet& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const PlanetarySystem_Planet* internal_default_instance() {
+    return reinterpret_cast<const PlanetarySystem_Planet*>(
+               &_PlanetarySystem_Planet_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(PlanetarySystem_Planet& a, PlanetarySystem_Planet& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(PlanetarySystem_Planet* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(PlanetarySystem_Planet* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  PlanetarySystem_Planet* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<PlanetarySystem_Planet>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const PlanetarySystem_Planet& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const PlanetarySystem_Planet& from) {
+    PlanetarySystem_Planet::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(PlanetarySystem_Planet* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "pbperftest.PlanetarySystem.Planet";
+  }
+  protected:
+  explicit PlanetarySystem_Planet(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  typedef PlanetarySystem_Planet_Moon Moon;
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kMoonFieldNumber = 6,
+    kNameFieldNumber = 1,
+    kRadiusKmFieldNumber = 2,
+    kMassKgFieldNumber = 3,
+    kSemiMajorAxisAuFieldNumber = 4,
+    kAgeBillionYearsFieldNumber = 5,
+  };
+  // repeated .pbperftest.PlanetarySystem.Planet.Moon moon = 6;
+  int moon_size() const;
+  private:
+  int _internal_moon_size() const;
+  public:
+  void clear_moon();
+  ::pbperftest::PlanetarySystem_Planet_Moon* mutable_moon(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Planet_Moon >*
+      mutable_moon();
+  private:
+  const ::pbperftest::PlanetarySystem_Planet_Moon& _internal_moon(int index) const;
+  ::pbperftest::PlanetarySystem_Planet_Moon* _internal_add_moon();
+  public:
+  const ::pbperftest::PlanetarySystem_Planet_Moon& moon(int index) const;
+  ::pbperftest::PlanetarySystem_Planet_Moon* add_moon();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Planet_Moon >&
+      moon() const;
+
+  // required string name = 1;
+  bool has_name() const;
+  private:
+  bool _internal_has_name() const;
+  public:
+  void clear_name();
+  const std::string& name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* name);
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(const std::string& value);
+  std::string* _internal_mutable_name();
+  public:
+
+  // optional double radius_km = 2;
+  bool has_radius_km() const;
+  private:
+  bool _internal_has_radius_km() const;
+  public:
+  void clear_radius_km();
+  double radius_km() const;
+  void set_radius_km(double value);
+  private:
+  double _internal_radius_km() const;
+  void _internal_set_radius_km(double value);
+  public:
+
+  // optional double mass_kg = 3;
+  bool has_mass_kg() const;
+  private:
+  bool _internal_has_mass_kg() const;
+  public:
+  void clear_mass_kg();
+  double mass_kg() const;
+  void set_mass_kg(double value);
+  private:
+  double _internal_mass_kg() const;
+  void _internal_set_mass_kg(double value);
+  public:
+
+  // optional double semi_major_axis_au = 4;
+  bool has_semi_major_axis_au() const;
+  private:
+  bool _internal_has_semi_major_axis_au() const;
+  public:
+  void clear_semi_major_axis_au();
+  double semi_major_axis_au() const;
+  void set_semi_major_axis_au(double value);
+  private:
+  double _internal_semi_major_axis_au() const;
+  void _internal_set_semi_major_axis_au(double value);
+  public:
+
+  // optional double age_billion_years = 5;
+  bool has_age_billion_years() const;
+  private:
+  bool _internal_has_age_billion_years() const;
+  public:
+  void clear_age_billion_years();
+  double age_billion_years() const;
+  void set_age_billion_years(double value);
+  private:
+  double _internal_age_billion_years() const;
+  void _internal_set_age_billion_years(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:pbperftest.PlanetarySystem.Planet)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Planet_Moon > moon_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+    double radius_km_;
+    double mass_kg_;
+    double semi_major_axis_au_;
+    double age_billion_years_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_planetary_5fsystem_2eproto;
+};
+// -------------------------------------------------------------------
+
+class PlanetarySystem final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:pbperftest.PlanetarySystem) */ {
+ public:
+  inline PlanetarySystem() : PlanetarySystem(nullptr) {}
+  ~PlanetarySystem() override;
+  explicit PROTOBUF_CONSTEXPR PlanetarySystem(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  PlanetarySystem(const PlanetarySystem& from);
+  PlanetarySystem(PlanetarySystem&& from) noexcept
+    : PlanetarySystem() {
+    *this = ::std::move(from);
+  }
+
+  inline PlanetarySystem& operator=(const PlanetarySystem& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline PlanetarySystem& operator=(PlanetarySystem&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const PlanetarySystem& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const PlanetarySystem* internal_default_instance() {
+    return reinterpret_cast<const PlanetarySystem*>(
+               &_PlanetarySystem_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    3;
+
+  friend void swap(PlanetarySystem& a, PlanetarySystem& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(PlanetarySystem* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(PlanetarySystem* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  PlanetarySystem* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<PlanetarySystem>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const PlanetarySystem& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const PlanetarySystem& from) {
+    PlanetarySystem::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(PlanetarySystem* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "pbperftest.PlanetarySystem";
+  }
+  protected:
+  explicit PlanetarySystem(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  typedef PlanetarySystem_Star Star;
+  typedef PlanetarySystem_Planet Planet;
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kStarFieldNumber = 2,
+    kPlanetFieldNumber = 3,
+    kNameFieldNumber = 1,
+  };
+  // repeated .pbperftest.PlanetarySystem.Star star = 2;
+  int star_size() const;
+  private:
+  int _internal_star_size() const;
+  public:
+  void clear_star();
+  ::pbperftest::PlanetarySystem_Star* mutable_star(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Star >*
+      mutable_star();
+  private:
+  const ::pbperftest::PlanetarySystem_Star& _internal_star(int index) const;
+  ::pbperftest::PlanetarySystem_Star* _internal_add_star();
+  public:
+  const ::pbperftest::PlanetarySystem_Star& star(int index) const;
+  ::pbperftest::PlanetarySystem_Star* add_star();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Star >&
+      star() const;
+
+  // repeated .pbperftest.PlanetarySystem.Planet planet = 3;
+  int planet_size() const;
+  private:
+  int _internal_planet_size() const;
+  public:
+  void clear_planet();
+  ::pbperftest::PlanetarySystem_Planet* mutable_planet(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Planet >*
+      mutable_planet();
+  private:
+  const ::pbperftest::PlanetarySystem_Planet& _internal_planet(int index) const;
+  ::pbperftest::PlanetarySystem_Planet* _internal_add_planet();
+  public:
+  const ::pbperftest::PlanetarySystem_Planet& planet(int index) const;
+  ::pbperftest::PlanetarySystem_Planet* add_planet();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Planet >&
+      planet() const;
+
+  // required string name = 1;
+  bool has_name() const;
+  private:
+  bool _internal_has_name() const;
+  public:
+  void clear_name();
+  const std::string& name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* name);
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(const std::string& value);
+  std::string* _internal_mutable_name();
+  public:
+
+  // @@protoc_insertion_point(class_scope:pbperftest.PlanetarySystem)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Star > star_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Planet > planet_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_planetary_5fsystem_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// PlanetarySystem_Star
+
+// required string name = 1;
+inline bool PlanetarySystem_Star::_internal_has_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Star::has_name() const {
+  return _internal_has_name();
+}
+inline void PlanetarySystem_Star::clear_name() {
+  _impl_.name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& PlanetarySystem_Star::name() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Star.name)
+  return _internal_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void PlanetarySystem_Star::set_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Star.name)
+}
+inline std::string* PlanetarySystem_Star::mutable_name() {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:pbperftest.PlanetarySystem.Star.name)
+  return _s;
+}
+inline const std::string& PlanetarySystem_Star::_internal_name() const {
+  return _impl_.name_.Get();
+}
+inline void PlanetarySystem_Star::_internal_set_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* PlanetarySystem_Star::_internal_mutable_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* PlanetarySystem_Star::release_name() {
+  // @@protoc_insertion_point(field_release:pbperftest.PlanetarySystem.Star.name)
+  if (!_internal_has_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void PlanetarySystem_Star::set_allocated_name(std::string* name) {
+  if (name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.name_.SetAllocated(name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:pbperftest.PlanetarySystem.Star.name)
+}
+
+// optional double radius_km = 2;
+inline bool PlanetarySystem_Star::_internal_has_radius_km() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Star::has_radius_km() const {
+  return _internal_has_radius_km();
+}
+inline void PlanetarySystem_Star::clear_radius_km() {
+  _impl_.radius_km_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline double PlanetarySystem_Star::_internal_radius_km() const {
+  return _impl_.radius_km_;
+}
+inline double PlanetarySystem_Star::radius_km() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Star.radius_km)
+  return _internal_radius_km();
+}
+inline void PlanetarySystem_Star::_internal_set_radius_km(double value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.radius_km_ = value;
+}
+inline void PlanetarySystem_Star::set_radius_km(double value) {
+  _internal_set_radius_km(value);
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Star.radius_km)
+}
+
+// optional double mass_kg = 3;
+inline bool PlanetarySystem_Star::_internal_has_mass_kg() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Star::has_mass_kg() const {
+  return _internal_has_mass_kg();
+}
+inline void PlanetarySystem_Star::clear_mass_kg() {
+  _impl_.mass_kg_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline double PlanetarySystem_Star::_internal_mass_kg() const {
+  return _impl_.mass_kg_;
+}
+inline double PlanetarySystem_Star::mass_kg() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Star.mass_kg)
+  return _internal_mass_kg();
+}
+inline void PlanetarySystem_Star::_internal_set_mass_kg(double value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.mass_kg_ = value;
+}
+inline void PlanetarySystem_Star::set_mass_kg(double value) {
+  _internal_set_mass_kg(value);
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Star.mass_kg)
+}
+
+// optional double age_billion_years = 4;
+inline bool PlanetarySystem_Star::_internal_has_age_billion_years() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Star::has_age_billion_years() const {
+  return _internal_has_age_billion_years();
+}
+inline void PlanetarySystem_Star::clear_age_billion_years() {
+  _impl_.age_billion_years_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline double PlanetarySystem_Star::_internal_age_billion_years() const {
+  return _impl_.age_billion_years_;
+}
+inline double PlanetarySystem_Star::age_billion_years() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Star.age_billion_years)
+  return _internal_age_billion_years();
+}
+inline void PlanetarySystem_Star::_internal_set_age_billion_years(double value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.age_billion_years_ = value;
+}
+inline void PlanetarySystem_Star::set_age_billion_years(double value) {
+  _internal_set_age_billion_years(value);
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Star.age_billion_years)
+}
+
+// -------------------------------------------------------------------
+
+// PlanetarySystem_Planet_Moon
+
+// required string name = 1;
+inline bool PlanetarySystem_Planet_Moon::_internal_has_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Planet_Moon::has_name() const {
+  return _internal_has_name();
+}
+inline void PlanetarySystem_Planet_Moon::clear_name() {
+  _impl_.name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& PlanetarySystem_Planet_Moon::name() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Planet.Moon.name)
+  return _internal_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void PlanetarySystem_Planet_Moon::set_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Planet.Moon.name)
+}
+inline std::string* PlanetarySystem_Planet_Moon::mutable_name() {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:pbperftest.PlanetarySystem.Planet.Moon.name)
+  return _s;
+}
+inline const std::string& PlanetarySystem_Planet_Moon::_internal_name() const {
+  return _impl_.name_.Get();
+}
+inline void PlanetarySystem_Planet_Moon::_internal_set_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* PlanetarySystem_Planet_Moon::_internal_mutable_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* PlanetarySystem_Planet_Moon::release_name() {
+  // @@protoc_insertion_point(field_release:pbperftest.PlanetarySystem.Planet.Moon.name)
+  if (!_internal_has_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void PlanetarySystem_Planet_Moon::set_allocated_name(std::string* name) {
+  if (name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.name_.SetAllocated(name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:pbperftest.PlanetarySystem.Planet.Moon.name)
+}
+
+// optional double radius_km = 2;
+inline bool PlanetarySystem_Planet_Moon::_internal_has_radius_km() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Planet_Moon::has_radius_km() const {
+  return _internal_has_radius_km();
+}
+inline void PlanetarySystem_Planet_Moon::clear_radius_km() {
+  _impl_.radius_km_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline double PlanetarySystem_Planet_Moon::_internal_radius_km() const {
+  return _impl_.radius_km_;
+}
+inline double PlanetarySystem_Planet_Moon::radius_km() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Planet.Moon.radius_km)
+  return _internal_radius_km();
+}
+inline void PlanetarySystem_Planet_Moon::_internal_set_radius_km(double value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.radius_km_ = value;
+}
+inline void PlanetarySystem_Planet_Moon::set_radius_km(double value) {
+  _internal_set_radius_km(value);
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Planet.Moon.radius_km)
+}
+
+// -------------------------------------------------------------------
+
+// PlanetarySystem_Planet
+
+// required string name = 1;
+inline bool PlanetarySystem_Planet::_internal_has_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Planet::has_name() const {
+  return _internal_has_name();
+}
+inline void PlanetarySystem_Planet::clear_name() {
+  _impl_.name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& PlanetarySystem_Planet::name() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Planet.name)
+  return _internal_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void PlanetarySystem_Planet::set_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Planet.name)
+}
+inline std::string* PlanetarySystem_Planet::mutable_name() {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:pbperftest.PlanetarySystem.Planet.name)
+  return _s;
+}
+inline const std::string& PlanetarySystem_Planet::_internal_name() const {
+  return _impl_.name_.Get();
+}
+inline void PlanetarySystem_Planet::_internal_set_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* PlanetarySystem_Planet::_internal_mutable_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* PlanetarySystem_Planet::release_name() {
+  // @@protoc_insertion_point(field_release:pbperftest.PlanetarySystem.Planet.name)
+  if (!_internal_has_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void PlanetarySystem_Planet::set_allocated_name(std::string* name) {
+  if (name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.name_.SetAllocated(name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:pbperftest.PlanetarySystem.Planet.name)
+}
+
+// optional double radius_km = 2;
+inline bool PlanetarySystem_Planet::_internal_has_radius_km() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Planet::has_radius_km() const {
+  return _internal_has_radius_km();
+}
+inline void PlanetarySystem_Planet::clear_radius_km() {
+  _impl_.radius_km_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline double PlanetarySystem_Planet::_internal_radius_km() const {
+  return _impl_.radius_km_;
+}
+inline double PlanetarySystem_Planet::radius_km() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Planet.radius_km)
+  return _internal_radius_km();
+}
+inline void PlanetarySystem_Planet::_internal_set_radius_km(double value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.radius_km_ = value;
+}
+inline void PlanetarySystem_Planet::set_radius_km(double value) {
+  _internal_set_radius_km(value);
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Planet.radius_km)
+}
+
+// optional double mass_kg = 3;
+inline bool PlanetarySystem_Planet::_internal_has_mass_kg() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Planet::has_mass_kg() const {
+  return _internal_has_mass_kg();
+}
+inline void PlanetarySystem_Planet::clear_mass_kg() {
+  _impl_.mass_kg_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline double PlanetarySystem_Planet::_internal_mass_kg() const {
+  return _impl_.mass_kg_;
+}
+inline double PlanetarySystem_Planet::mass_kg() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Planet.mass_kg)
+  return _internal_mass_kg();
+}
+inline void PlanetarySystem_Planet::_internal_set_mass_kg(double value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.mass_kg_ = value;
+}
+inline void PlanetarySystem_Planet::set_mass_kg(double value) {
+  _internal_set_mass_kg(value);
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Planet.mass_kg)
+}
+
+// optional double semi_major_axis_au = 4;
+inline bool PlanetarySystem_Planet::_internal_has_semi_major_axis_au() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Planet::has_semi_major_axis_au() const {
+  return _internal_has_semi_major_axis_au();
+}
+inline void PlanetarySystem_Planet::clear_semi_major_axis_au() {
+  _impl_.semi_major_axis_au_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline double PlanetarySystem_Planet::_internal_semi_major_axis_au() const {
+  return _impl_.semi_major_axis_au_;
+}
+inline double PlanetarySystem_Planet::semi_major_axis_au() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Planet.semi_major_axis_au)
+  return _internal_semi_major_axis_au();
+}
+inline void PlanetarySystem_Planet::_internal_set_semi_major_axis_au(double value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.semi_major_axis_au_ = value;
+}
+inline void PlanetarySystem_Planet::set_semi_major_axis_au(double value) {
+  _internal_set_semi_major_axis_au(value);
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Planet.semi_major_axis_au)
+}
+
+// optional double age_billion_years = 5;
+inline bool PlanetarySystem_Planet::_internal_has_age_billion_years() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
+}
+inline bool PlanetarySystem_Planet::has_age_billion_years() const {
+  return _internal_has_age_billion_years();
+}
+inline void PlanetarySystem_Planet::clear_age_billion_years() {
+  _impl_.age_billion_years_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline double PlanetarySystem_Planet::_internal_age_billion_years() const {
+  return _impl_.age_billion_years_;
+}
+inline double PlanetarySystem_Planet::age_billion_years() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Planet.age_billion_years)
+  return _internal_age_billion_years();
+}
+inline void PlanetarySystem_Planet::_internal_set_age_billion_years(double value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.age_billion_years_ = value;
+}
+inline void PlanetarySystem_Planet::set_age_billion_years(double value) {
+  _internal_set_age_billion_years(value);
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.Planet.age_billion_years)
+}
+
+// repeated .pbperftest.PlanetarySystem.Planet.Moon moon = 6;
+inline int PlanetarySystem_Planet::_internal_moon_size() const {
+  return _impl_.moon_.size();
+}
+inline int PlanetarySystem_Planet::moon_size() const {
+  return _internal_moon_size();
+}
+inline void PlanetarySystem_Planet::clear_moon() {
+  _impl_.moon_.Clear();
+}
+inline ::pbperftest::PlanetarySystem_Planet_Moon* PlanetarySystem_Planet::mutable_moon(int index) {
+  // @@protoc_insertion_point(field_mutable:pbperftest.PlanetarySystem.Planet.moon)
+  return _impl_.moon_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Planet_Moon >*
+PlanetarySystem_Planet::mutable_moon() {
+  // @@protoc_insertion_point(field_mutable_list:pbperftest.PlanetarySystem.Planet.moon)
+  return &_impl_.moon_;
+}
+inline const ::pbperftest::PlanetarySystem_Planet_Moon& PlanetarySystem_Planet::_internal_moon(int index) const {
+  return _impl_.moon_.Get(index);
+}
+inline const ::pbperftest::PlanetarySystem_Planet_Moon& PlanetarySystem_Planet::moon(int index) const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.Planet.moon)
+  return _internal_moon(index);
+}
+inline ::pbperftest::PlanetarySystem_Planet_Moon* PlanetarySystem_Planet::_internal_add_moon() {
+  return _impl_.moon_.Add();
+}
+inline ::pbperftest::PlanetarySystem_Planet_Moon* PlanetarySystem_Planet::add_moon() {
+  ::pbperftest::PlanetarySystem_Planet_Moon* _add = _internal_add_moon();
+  // @@protoc_insertion_point(field_add:pbperftest.PlanetarySystem.Planet.moon)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Planet_Moon >&
+PlanetarySystem_Planet::moon() const {
+  // @@protoc_insertion_point(field_list:pbperftest.PlanetarySystem.Planet.moon)
+  return _impl_.moon_;
+}
+
+// -------------------------------------------------------------------
+
+// PlanetarySystem
+
+// required string name = 1;
+inline bool PlanetarySystem::_internal_has_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool PlanetarySystem::has_name() const {
+  return _internal_has_name();
+}
+inline void PlanetarySystem::clear_name() {
+  _impl_.name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& PlanetarySystem::name() const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.name)
+  return _internal_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void PlanetarySystem::set_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:pbperftest.PlanetarySystem.name)
+}
+inline std::string* PlanetarySystem::mutable_name() {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:pbperftest.PlanetarySystem.name)
+  return _s;
+}
+inline const std::string& PlanetarySystem::_internal_name() const {
+  return _impl_.name_.Get();
+}
+inline void PlanetarySystem::_internal_set_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* PlanetarySystem::_internal_mutable_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* PlanetarySystem::release_name() {
+  // @@protoc_insertion_point(field_release:pbperftest.PlanetarySystem.name)
+  if (!_internal_has_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void PlanetarySystem::set_allocated_name(std::string* name) {
+  if (name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.name_.SetAllocated(name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:pbperftest.PlanetarySystem.name)
+}
+
+// repeated .pbperftest.PlanetarySystem.Star star = 2;
+inline int PlanetarySystem::_internal_star_size() const {
+  return _impl_.star_.size();
+}
+inline int PlanetarySystem::star_size() const {
+  return _internal_star_size();
+}
+inline void PlanetarySystem::clear_star() {
+  _impl_.star_.Clear();
+}
+inline ::pbperftest::PlanetarySystem_Star* PlanetarySystem::mutable_star(int index) {
+  // @@protoc_insertion_point(field_mutable:pbperftest.PlanetarySystem.star)
+  return _impl_.star_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Star >*
+PlanetarySystem::mutable_star() {
+  // @@protoc_insertion_point(field_mutable_list:pbperftest.PlanetarySystem.star)
+  return &_impl_.star_;
+}
+inline const ::pbperftest::PlanetarySystem_Star& PlanetarySystem::_internal_star(int index) const {
+  return _impl_.star_.Get(index);
+}
+inline const ::pbperftest::PlanetarySystem_Star& PlanetarySystem::star(int index) const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.star)
+  return _internal_star(index);
+}
+inline ::pbperftest::PlanetarySystem_Star* PlanetarySystem::_internal_add_star() {
+  return _impl_.star_.Add();
+}
+inline ::pbperftest::PlanetarySystem_Star* PlanetarySystem::add_star() {
+  ::pbperftest::PlanetarySystem_Star* _add = _internal_add_star();
+  // @@protoc_insertion_point(field_add:pbperftest.PlanetarySystem.star)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Star >&
+PlanetarySystem::star() const {
+  // @@protoc_insertion_point(field_list:pbperftest.PlanetarySystem.star)
+  return _impl_.star_;
+}
+
+// repeated .pbperftest.PlanetarySystem.Planet planet = 3;
+inline int PlanetarySystem::_internal_planet_size() const {
+  return _impl_.planet_.size();
+}
+inline int PlanetarySystem::planet_size() const {
+  return _internal_planet_size();
+}
+inline void PlanetarySystem::clear_planet() {
+  _impl_.planet_.Clear();
+}
+inline ::pbperftest::PlanetarySystem_Planet* PlanetarySystem::mutable_planet(int index) {
+  // @@protoc_insertion_point(field_mutable:pbperftest.PlanetarySystem.planet)
+  return _impl_.planet_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Planet >*
+PlanetarySystem::mutable_planet() {
+  // @@protoc_insertion_point(field_mutable_list:pbperftest.PlanetarySystem.planet)
+  return &_impl_.planet_;
+}
+inline const ::pbperftest::PlanetarySystem_Planet& PlanetarySystem::_internal_planet(int index) const {
+  return _impl_.planet_.Get(index);
+}
+inline const ::pbperftest::PlanetarySystem_Planet& PlanetarySystem::planet(int index) const {
+  // @@protoc_insertion_point(field_get:pbperftest.PlanetarySystem.planet)
+  return _internal_planet(index);
+}
+inline ::pbperftest::PlanetarySystem_Planet* PlanetarySystem::_internal_add_planet() {
+  return _impl_.planet_.Add();
+}
+inline ::pbperftest::PlanetarySystem_Planet* PlanetarySystem::add_planet() {
+  ::pbperftest::PlanetarySystem_Planet* _add = _internal_add_planet();
+  // @@protoc_insertion_point(field_add:pbperftest.PlanetarySystem.planet)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::pbperftest::PlanetarySystem_Planet >&
+PlanetarySystem::planet() const {
+  // @@protoc_insertion_point(field_list:pbperftest.PlanetarySystem.planet)
+  return _impl_.planet_;
+}
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace pbperftest
+
+// @@protoc_insertion_point(global_scope)
+
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_planetary_5fsystem_2eproto
@@ -0,0 +1,195 @@
+/*
+ * file name:           include/batch_expr.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 07:26:50 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_BATCH_EXPR_H_
+#define _SOLAR_WIND_LISP_BATCH_EXPR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "types.h"
+
+namespace SolarWindLisp
+{
+
+class InterpreterIF;
+
+/*
+ * The values of one input of a batch, one per row, an array of the caller,
+ * which is not copied, and MUST live as long as the Column is used.
+ */
+struct Column
+{
+    enum column_type_t
+    {
+        column_i64 = 0,
+        column_double,
+        column_bool,
+        column_string,
+    };
+
+    Column() :
+            type(column_i64), size(0), data(NULL)
+    {
+    }
+
+    Column(const int64_t * values, size_t rows) :
+            type(column_i64), size(rows), data(values)
+    {
+    }
+
+    Column(const double * values, size_t rows) :
+            type(column_double), size(rows), data(values)
+    {
+    }
+
+    Column(const bool * values, size_t rows) :
+            type(column_bool), size(rows), data(values)
+    {
+    }
+
+    Column(const std::string * values, size_t rows) :
+            type(column_string), size(rows), data(values)
+    {
+    }
+
+    const int64_t * i64() const
+    {
+        return static_cast<const int64_t *>(data);
+    }
+
+    const double * f64() const
+    {
+        return static_cast<const double *>(data);
+    }
+
+    const bool * bools() const
+    {
+        return static_cast<const bool *>(data);
+    }
+
+    const std::string * strings() const
+    {
+        return static_cast<const std::string *>(data);
+    }
+
+    column_type_t type;
+    size_t size;
+    const void * data;
+};
+
+/*
+ * The result of BatchExpr::evaluate(): a value for every row, and the
+ * selection, the rows which are valid and true (a number not 0, a string
+ * not empty), the ones `if' would take the consequent of, e.g. the rows
+ * matching a predicate. A row is not valid if its evaluation fails, e.g.
+ * a division by 0, its value is 0 (or empty) then.
+ */
+struct BatchResult
+{
+    BatchResult() :
+            type(Column::column_i64), rows(0), selected(0), invalid(0)
+    {
+    }
+
+    // a view of the values, valid until the next evaluate()
+    Column column() const;
+
+    bool is_selected(size_t row) const
+    {
+        return (selection[row / 64] >> (row % 64)) & 1;
+    }
+
+    Column::column_type_t type;
+    size_t rows;
+    // only the one of `type' is filled
+    std::vector<int64_t> i64;
+    std::vector<double> f64;
+    std::vector<uint8_t> bools;
+    std::vector<std::string> strings;
+    // bit `row % 64' of word `row / 64'
+    std::vector<uint64_t> selection;
+    size_t selected;
+    size_t invalid;
+};
+
+/*
+ * One expression evaluated over many rows at once, a column at a time: the
+ * names of the columns are bound to arrays of values, and every operation
+ * is a kernel over arrays (see VectorKernels), instead of the tree being
+ * walked, and atoms allocated, for every row. The rows are done in chunks,
+ * for the temporary arrays to stay in the cache.
+ *
+ * Only a subset of the language can be: numbers, booleans and strings,
+ * the names of the columns, the names bound to such atoms in the global
+ * env, the builtin `+ - * / = != < <= > >=', `inc', `dec', `not', `and',
+ * `or', `xor', and `if' with both branches. The builtin procedures are the
+ * ones of InterpreterIF::builtin_env(), not redefined in the global env.
+ *
+ * The results are the ones of evaluating the expression row by row, with
+ * the arguments of `and', `or' and of the branches of `if' only evaluated
+ * as needed, except:
+ *   - reals are `double', not `long double', and so are the integers
+ *     compared with reals;
+ *   - the branches of `if' MUST both be numbers, or be of the same type,
+ *     integers and reals mixed are reals;
+ *   - strings cannot be compared, nor added, which fails for every row
+ *     otherwise, evaluate() fails instead.
+ */
+class BatchExpr
+{
+public:
+    // rows of a chunk
+    static const size_t CHUNK_ROWS = 1024;
+
+    BatchExpr();
+    ~BatchExpr();
+
+    /*
+     * Description:
+     *   Parse and compile `str', one form, over the columns `names', the
+     *   other names are looked up in the global env of `interpreter', once.
+     * Return value:
+     *   false on parse error, or if the form is not in the subset above.
+     */
+    bool compile(InterpreterIF * interpreter, const char * str,
+            const std::vector<std::string> &names, ssize_t len = -1);
+
+    /*
+     * Description:
+     *   Evaluate the expression over `columns', in the order of the names,
+     *   all of the same size.
+     * Return value:
+     *   false if not compiled, if the columns do not match the names, or if
+     *   the types of the columns are not the ones of the expression, e.g. a
+     *   string added.
+     */
+    bool evaluate(const std::vector<Column> &columns, BatchResult &result);
+
+    bool compiled() const
+    {
+        return _root != NULL;
+    }
+
+    struct Node;
+
+private:
+    BatchExpr(const BatchExpr &);
+    BatchExpr & operator=(const BatchExpr &);
+
+    Node * _compile(const MatterPtr &form, InterpreterIF * interpreter,
+            const std::vector<std::string> &names);
+
+    Node * _root;
+    size_t _columns;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_BATCH_EXPR_H_
@@ -0,0 +1,125 @@
+/*
+ * file name:           include/cycle_collector.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 21:30:48 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_CYCLE_COLLECTOR_H_
+#define _SOLAR_WIND_LISP_CYCLE_COLLECTOR_H_
+
+#include <stdint.h>
+#include <vector>
+#include <boost/weak_ptr.hpp>
+#include "types.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * Reclaims reference cycles among environments, procedures and futures,
+ * e.g. a procedure defined by `defn' is saved in its own defining env, or
+ * a closure returned from `let' holds the env which holds the closure.
+ *
+ * Every tracked object is registered with a weak pointer when created (see
+ * SimpleMatterFactory). A collection is a trial deletion, like the one used
+ * by Python:
+ *   1. for every tracked object, count the references from other tracked
+ *      objects, and subtract them from its reference count;
+ *   2. objects with references left are referenced from outside (e.g. the
+ *      global env held by the interpreter, or a result held by the caller),
+ *      they and everything reachable from them are alive;
+ *   3. the rest are garbage, their references are released, which breaks
+ *      the cycles.
+ * Only references held directly by tracked objects are followed, a cycle
+ * through a list or a map is not reclaimed (it is kept alive, never freed
+ * too early).
+ *
+ * Collections are run at safe points only, between two top level forms,
+ * when `threshold' objects have been tracked since the last collection, and
+ * at least as many as the objects which survived it, so the cost of
+ * collections stays proportional to the allocations.
+ *
+ * Not thread-safe, every interpreter has its own collector.
+ */
+class CycleCollector
+{
+public:
+    static const size_t DEFAULT_THRESHOLD = 10000;
+
+    struct Stats
+    {
+        size_t collections;
+        size_t collected;           // objects reclaimed, in total
+        size_t tracked;             // objects tracked after the last collection
+        uint64_t last_pause_usec;
+        uint64_t max_pause_usec;
+        uint64_t total_pause_usec;
+    };
+
+    explicit CycleCollector(size_t threshold = DEFAULT_THRESHOLD);
+
+    void track(const ScopedEnvPtr &env);
+    void track(const ProcPtr &proc);
+    void track(const FuturePtr &future);
+
+    /*
+     * Description:
+     *   0 disables collections at safe points, collect() still works.
+     */
+    void set_threshold(size_t threshold)
+    {
+        _threshold = threshold;
+    }
+
+    size_t threshold() const
+    {
+        return _threshold;
+    }
+
+    bool should_collect() const
+    {
+        return _threshold && _allocated >= _threshold
+                && _allocated >= _survivors;
+    }
+
+    /*
+     * Description:
+     *   MUST NOT be called while evaluating.
+     *
+     * Return value:
+     *   number of objects reclaimed.
+     */
+    size_t collect();
+
+    /*
+     * Description:
+     *   Stop tracking all the objects tracked so far, they are never
+     *   collected, nor is the memory of their reference counts written to
+     *   by a collection.
+     */
+    void forget();
+
+    const Stats & stats() const
+    {
+        return _stats;
+    }
+
+private:
+    CycleCollector(const CycleCollector &);
+    CycleCollector & operator=(const CycleCollector &);
+
+    std::vector<boost::weak_ptr<ScopedEnv> > _envs;
+    std::vector<boost::weak_ptr<Proc> > _procs;
+    std::vector<boost::weak_ptr<Future> > _futures;
+
+    size_t _threshold;
+    size_t _allocated;  // tracked since the last collection
+    size_t _survivors;  // tracked objects alive after the last collection
+    Stats _stats;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_CYCLE_COLLECTOR_H_
@@ -11,8 +11,8 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <sstream>
-#include <deque>
 
 #include "matter.h"
 #include "utils.h"
@@ -93,13 +93,43 @@ bool is_##name() const {                \
     {
     }
 
-    static AtomPtr create(const char * buf = NULL, size_t length = 0);
+    /*
+     * Description:
+     *   Parse `buf' into a new atom, the text of a symbol (an unquoted name)
+     *   is shared with its other atoms if `symbols' is given.
+     */
+    static AtomPtr create(const char * buf = NULL, size_t length = 0,
+            SymbolTable * symbols = NULL);
+
+    /*
+     * Description:
+     *   The first byte of `buf' decides which kind of literal it may be,
+     *   common integers and reals are converted by hand, everything else
+     *   falls back to parse_generic(). `buf' needs not be NUL terminated.
+     */
+    bool parse(const char * buf, size_t length, SymbolTable * symbols = NULL);
+
+    /*
+     * Description:
+     *   Try every kind of literal in turn with the C library conversions,
+     *   `buf' MUST be NUL terminated.
+     */
+    bool parse_generic(const char * buf, size_t length,
+            SymbolTable * symbols = NULL);
 
-    bool parse(const char * buf, size_t length);
     bool parse_bool(const char * buf, size_t length);
     bool parse_integer(const char * buf, size_t length);
     bool parse_real(const char * buf, size_t length);
-    bool parse_cstr(const char * buf, size_t length);
+    bool parse_cstr(const char * buf, size_t length,
+            SymbolTable * symbols = NULL);
+
+    /*
+     * Description:
+     *   Set the text as is, without looking for quotes, `quoted' tells if it
+     *   is a string or a symbol, only symbols are interned in `symbols'.
+     */
+    bool set_cstr(const char * buf, size_t length, bool quoted,
+            SymbolTable * symbols = NULL);
 
     void set_bool(bool v);
     void set_i32(int32_t v);
@@ -122,6 +152,11 @@ bool is_##name() const {                \
         return is_cstr() ? _atom_data.str.buffer : NULL;
     }
 
+    size_t cstr_length() const
+    {
+        return is_cstr() ? _atom_data.str.length : 0;
+    }
+
 #if 0
     // TODO: unsafe (overflow or underflow) but faster
     bool to_i32_unsafe(int32_t &v) const;
@@ -147,7 +182,7 @@ bool is_##name() const {                \
 
         ~AtomData()
         {
-            if (str.buffer) {
+            if (str.buffer && !str.interned) {
                 free(str.buffer);
             }
         }
@@ -159,7 +194,12 @@ bool is_##name() const {                \
             str.quoted = false;
         }
 
-        bool set_string(const char * buf, size_t length);
+        bool set_string(const char * buf, size_t length,
+                SymbolTable * symbols = NULL);
+
+        // the text as is, no quote removed
+        bool set_text(const char * buf, size_t length, bool quoted,
+                SymbolTable * symbols = NULL);
 
         union
         {
@@ -178,6 +218,7 @@ bool is_##name() const {                \
             size_t length;
             size_t size;
             bool quoted;
+            bool interned;  // `buffer' is of a SymbolTable, not ours
         } str;
     };
 
@@ -195,11 +236,24 @@ private:
     AtomData _atom_data;
 };
 
+/*
+ * Children are kept in a small inline array, which is large enough for most
+ * forms (e.g. `(inc x)', `(+ a b)', `(if p a b)'), longer forms spill over to
+ * a contiguous heap array. Use create(capacity) whenever the number of
+ * children is known in advance, so the array is allocated exactly once.
+ *
+ * There is no iteration state inside, once built by the parser (or by the
+ * interpreter) a CompositeExpr is never modified, so the same tree can be
+ * walked re-entrantly, or by several threads at the same time.
+ */
 class CompositeExpr: public MatterIF
 {
 public:
+    typedef const MatterPtr * const_iterator;
+
     ~CompositeExpr()
     {
+        _release_children();
         _destroy();
     }
 
@@ -208,34 +262,45 @@ public:
         return matter_composite_expr;
     }
 
-    static CompositeExprPtr create();
+    static CompositeExprPtr create(size_t capacity = 0);
 
     bool append_expr(MatterPtr expr);
+    bool reserve(size_t capacity);
 
     size_t size() const
     {
-        return _items.size();
+        return _size;
     }
 
-    bool rewind() const
+    size_t capacity() const
     {
-        _cursor = 0;
-        return true;
+        return _capacity;
     }
 
-    bool has_next() const
+    bool is_inline() const
     {
-        return _cursor < _items.size();
+        return _items == _inline_items;
     }
 
-    MatterPtr get_next() const
+    const_iterator begin() const
     {
-        return (_cursor < _items.size()) ? _items[_cursor++] : MatterPtr();
+        return _items;
+    }
+
+    const_iterator end() const
+    {
+        return _items + _size;
     }
 
     MatterPtr get(size_t idx) const
     {
-        return (idx < _items.size()) ? _items[idx] : MatterPtr();
+        return (idx < _size) ? _items[idx] : MatterPtr();
+    }
+
+    // unchecked version of get(), `idx' MUST be less than size()
+    const MatterPtr & operator[](size_t idx) const
+    {
+        return _items[idx];
     }
 
     std::string debug_string(bool compact = true, int level = 0,
@@ -243,20 +308,37 @@ public:
     std::string to_string() const;
 
 private:
-    static const size_t _INITIAL_CAPACITY = 10;
-    static const size_t _CAPACITY_DELTA = 10;
+    static const size_t _INLINE_CAPACITY = 4;
 
     CompositeExpr() :
-        _cursor(0)
+            _items(_inline_items), _size(0), _capacity(_INLINE_CAPACITY)
     {
     }
 
+    CompositeExpr(const CompositeExpr &);
+    CompositeExpr & operator=(const CompositeExpr &);
+
+    /*
+     * Description:
+     *   Release the nested lists iteratively, a deeply nested one would
+     *   overflow the stack by recursive destruction.
+     */
+    void _release_children();
+
     void _destroy()
     {
+        if (!is_inline()) {
+            delete[] _items;
+            _items = _inline_items;
+        }
+        _size = 0;
+        _capacity = _INLINE_CAPACITY;
     }
 
-    std::deque<MatterPtr> _items;
-    mutable size_t _cursor;
+    MatterPtr * _items;
+    uint32_t _size;
+    uint32_t _capacity;
+    MatterPtr _inline_items[_INLINE_CAPACITY];
 };
 
 } // namespace SolarWindLisp
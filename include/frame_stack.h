@@ -0,0 +1,201 @@
+/*
+ * file name:           include/frame_stack.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 22:41:07 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_FRAME_STACK_H_
+#define _SOLAR_WIND_LISP_FRAME_STACK_H_
+
+#include <stddef.h>
+#include <new>
+#include <utility>
+#include <vector>
+#include "types.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * LIFO region for the frames of procedures whose bodies never capture them
+ * (see InterpreterIF::_captures_frame()). The env, its bindings and the
+ * reference count of the shared pointer are all carved from the current
+ * chunk by bumping a pointer, and the whole frame is released at once by
+ * rewinding to the mark taken before the call.
+ *
+ * A frame may still escape through an unrealized Future created in it,
+ * e.g. when the result of the body is a Future. If a frame is still
+ * referenced when the call returns, retire() is called: the chunks in use
+ * are never reused, every chunk is freed when the last object in it is
+ * released, and new frames go to a fresh chunk.
+ *
+ * Not thread-safe, every interpreter has its own stack, and the objects
+ * allocated from it MUST be released by the same thread.
+ */
+class FrameStack
+{
+public:
+    static const size_t CHUNK_SIZE = 64 * 1024;
+
+    struct Mark
+    {
+        void * chunk;
+        char * top;
+        size_t retirements;
+    };
+
+    struct Stats
+    {
+        size_t frames;          // frames created
+        size_t retirements;     // calls of retire(), i.e. escaped frames
+        size_t chunks;          // chunks allocated from the heap
+    };
+
+    /*
+     * Allocator of the bindings of a frame, and of the reference count. A
+     * default constructed one allocates from the heap, which is used by the
+     * envs not on the stack.
+     */
+    template<typename T>
+    class Allocator
+    {
+    public:
+        typedef T value_type;
+        typedef T * pointer;
+        typedef const T * const_pointer;
+        typedef T & reference;
+        typedef const T & const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template<typename U>
+        struct rebind
+        {
+            typedef Allocator<U> other;
+        };
+
+        Allocator(FrameStack * stack = NULL) :
+                _stack(stack)
+        {
+        }
+
+        template<typename U>
+        Allocator(const Allocator<U> &other) :
+                _stack(other.stack())
+        {
+        }
+
+        FrameStack * stack() const
+        {
+            return _stack;
+        }
+
+        T * allocate(size_t n, const void * hint = NULL)
+        {
+            void * p = _stack ? _stack->allocate(n * sizeof(T))
+                    : ::operator new(n * sizeof(T), std::nothrow);
+            if (!p) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(p);
+        }
+
+        void deallocate(T * p, size_t n)
+        {
+            if (_stack) {
+                FrameStack::deallocate(p);
+            }
+            else {
+                ::operator delete(p);
+            }
+        }
+
+        template<typename U, typename... Args>
+        void construct(U * p, Args&&... args)
+        {
+            ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+        }
+
+        template<typename U>
+        void destroy(U * p)
+        {
+            p->~U();
+        }
+
+        size_t max_size() const
+        {
+            return static_cast<size_t>(-1) / sizeof(T);
+        }
+
+        template<typename U>
+        bool operator==(const Allocator<U> &other) const
+        {
+            return _stack == other.stack();
+        }
+
+        template<typename U>
+        bool operator!=(const Allocator<U> &other) const
+        {
+            return _stack != other.stack();
+        }
+
+    private:
+        FrameStack * _stack;
+    };
+
+    FrameStack();
+    ~FrameStack();
+
+    /*
+     * Return value:
+     *   a new env on the stack, or NULL if out of memory.
+     */
+    ScopedEnvPtr create_env(const ScopedEnvPtr &ext);
+
+    Mark mark() const;
+
+    /*
+     * Description:
+     *   Release everything allocated after `m' was taken, the objects MUST
+     *   have been destroyed, or retire() called since then.
+     */
+    void rewind(const Mark &m);
+
+    /*
+     * Description:
+     *   Stop reusing the chunks in use, called when a frame escaped.
+     */
+    void retire();
+
+    const Stats & stats() const
+    {
+        return _stats;
+    }
+
+    /*
+     * Return value:
+     *   `size' bytes aligned on 16, or NULL if out of memory.
+     */
+    void * allocate(size_t size);
+
+    static void deallocate(void * p);
+
+private:
+    FrameStack(const FrameStack &);
+    FrameStack & operator=(const FrameStack &);
+
+    struct Chunk;
+
+    Chunk * _new_chunk(size_t size);
+    static void _release(Chunk * chunk);
+
+    std::vector<Chunk *> _chunks;   // in use, the last one is the top
+    Chunk * _spare;
+    Stats _stats;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_FRAME_STACK_H_
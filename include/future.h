@@ -20,6 +20,7 @@ class InterpreterIF;
 
 class Future: public MatterIF
 {
+    friend class CycleCollector;
 public:
     matter_type_t matter_type() const
     {
@@ -0,0 +1,134 @@
+/*
+ * file name:           include/hash_map.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 18:40:17 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_HASH_MAP_H_
+#define _SOLAR_WIND_LISP_HASH_MAP_H_
+
+#include <stdint.h>
+#include "matter.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * Keys of maps are atoms: integers, real numbers, strings ("abc") and
+ * symbols (unquoted names, e.g. the result of (quote abc)). Integers are
+ * compared by value whatever their width is, 1 and 1.0 are different keys,
+ * so are the string "abc" and the symbol abc.
+ */
+class AtomKey
+{
+public:
+    static bool is_valid(const MatterPtr &key);
+
+    /*
+     * Return value:
+     *   hash value of a valid key, never 0.
+     */
+    static uint64_t hash(const MatterPtr &key);
+
+    static bool equal(const MatterPtr &lhs, const MatterPtr &rhs);
+};
+
+/*
+ * A mutable hash map, keyed by atoms.
+ *
+ * Open addressing with linear probing. The (non-zero) hash of every key is
+ * cached in a separate array, probing scans this array only, and keys are
+ * compared only when the cached hashes are equal. Removal shifts the
+ * following entries backward, so there are no tombstones. The table grows
+ * when it is 3/4 full.
+ */
+class HashMap: public MatterIF
+{
+public:
+    matter_type_t matter_type() const
+    {
+        return matter_hash_map;
+    }
+
+    /*
+     * Description:
+     *   Create a map large enough for `expected' entries.
+     */
+    static HashMapPtr create(size_t expected = 0);
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    /*
+     * Return value:
+     *   the value of `key', or NULL if not found.
+     */
+    const MatterPtr * find(const MatterPtr &key) const;
+
+    /*
+     * Description:
+     *   Insert or replace, `key' MUST be a valid key.
+     *
+     * Return value:
+     *   false if out of memory.
+     */
+    bool insert(const MatterPtr &key, const MatterPtr &value);
+
+    /*
+     * Return value:
+     *   true if `key' was found and removed.
+     */
+    bool erase(const MatterPtr &key);
+
+    /*
+     * Description:
+     *   Call `func(key, value, arg)' on every entry, in no particular order,
+     *   stop when `func' returns false.
+     */
+    void for_each(bool (*func)(const MatterPtr &key, const MatterPtr &value,
+            void * arg), void * arg) const;
+
+    std::string debug_string(bool compact = true, int level = 0,
+            const char * indent_seq = DEFAULT_INDENT_SEQ) const;
+    std::string to_string() const;
+
+    virtual ~HashMap();
+
+private:
+    HashMap() :
+            _hashes(NULL), _entries(NULL), _size(0), _capacity(0)
+    {
+    }
+
+    HashMap(const HashMap &);
+    HashMap & operator=(const HashMap &);
+
+    struct Entry
+    {
+        MatterPtr key;
+        MatterPtr value;
+    };
+
+    static const size_t _MIN_CAPACITY = 8;
+
+    size_t _find_slot(uint64_t hash, const MatterPtr &key) const;
+    bool _rehash(size_t capacity);
+
+    uint64_t * _hashes; // 0 marks an empty slot
+    Entry * _entries;
+    size_t _size;
+    size_t _capacity;   // always a power of 2
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_HASH_MAP_H_
@@ -0,0 +1,113 @@
+/*
+ * file name:           include/heap_snapshot.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 02:17:36 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_HEAP_SNAPSHOT_H_
+#define _SOLAR_WIND_LISP_HEAP_SNAPSHOT_H_
+
+#include <stdint.h>
+#include "types.h"
+
+namespace SolarWindLisp
+{
+
+class MatterFactoryIF;
+
+/*
+ * Heap images: an env, and everything reachable from it (atoms, forms,
+ * procedures, the envs of the closures, lists, vectors and maps), saved in
+ * a binary file, and restored in a single pass, so an interpreter with
+ * thousands of definitions is ready without executing any of them again,
+ * see InterpreterIF::save_snapshot() and InterpreterIF::initialize().
+ *
+ * Every object is a record, the objects shared or in cycles are saved only
+ * once, and referred to by their numbers. The envs and the hash maps are
+ * the only objects modified after they are created, so they are the only
+ * ones in cycles, e.g. a procedure defined by `defn' is saved in its own
+ * env. They are created empty as soon as they are reached, the other
+ * objects after everything they refer to (in postorder), and the bindings
+ * and the entries are added at the end, so every record refers only to the
+ * objects created before it.
+ *
+ * The futures are realized, and saved as their values. Primitive procedures
+ * are saved by name, and restored from an env which binds them, e.g. the
+ * one of InterpreterIF::builtin_env(), which is not saved either.
+ *
+ * Like a ScriptCache, a snapshot is in the byte order and the number formats
+ * of the machine which wrote it, and has a hash of the whole file, a
+ * snapshot of another machine, or a corrupted one, is never restored.
+ */
+class HeapSnapshot
+{
+public:
+    static const uint32_t VERSION = 2;
+
+    /*
+     * Description:
+     *   Save `env' to the snapshot `filename'. It is written to a temporary
+     *   file first, and renamed, like a ScriptCache. The env `base' (e.g.
+     *   InterpreterIF::builtin_env()), which `env' may be chained onto, is
+     *   not saved, but referred to, it is the `prims' of restore().
+     * Return value:
+     *   false on I/O error, if a future cannot be realized, or if an object
+     *   cannot be saved, e.g. a primitive procedure without a name.
+     */
+    static bool save(const char * filename, const ScopedEnvPtr &env,
+            const ScopedEnvPtr &base = NULL);
+
+    /*
+     * Description:
+     *   Restore the env of the snapshot `filename', the objects are created
+     *   by `factory', the primitive procedures are looked up in `prims',
+     *   which is the base env of the snapshot too, never modified. The
+     *   symbols are interned in `symbols' if not NULL, which MUST live as
+     *   long as the objects do.
+     * Return value:
+     *   the env, NULL if there is no snapshot, or it is corrupted, or of
+     *   another machine, or refers to a primitive procedure not in `prims'.
+     */
+    static ScopedEnvPtr restore(const char * filename,
+            MatterFactoryIF * factory, const ScopedEnvPtr &prims,
+            SymbolTable * symbols = default_symbol_table());
+
+    /*
+     * Description:
+     *   A frozen copy of `env', and of everything reachable from it, for the
+     *   processes forked to share it (see WorkerPool).
+     *
+     *   The reference counts of boost::shared_ptr are in control blocks all
+     *   over the heap, and every copy of a pointer writes to one, e.g. the
+     *   lookup of a name, or a child of a form. After fork() every page
+     *   written to is copied, so the hot objects of the shared heap soon end
+     *   up copied in every process. The pointers to the objects of a frozen
+     *   env are aliases of one shared pointer, all the copies write to the
+     *   same reference count, which is one page copied, and the objects
+     *   themselves are only read, but for the first call of a procedure,
+     *   which records where its frames go. The copy is made like a snapshot
+     *   is saved and restored, the objects end up packed together too, and
+     *   `prims' is its base env, not copied. The other primitive procedures
+     *   (see InterpreterIF::register_fn()) are not copied either, the frozen
+     *   env refers to the same ones.
+     *
+     *   A frozen env is never released, nor are its objects, it is meant to
+     *   live as long as the process does. Neither is `env': freed, its memory
+     *   would be all over the pages shared, and the allocator of every
+     *   process forked would write to them as it reuses it. The objects are
+     *   not tracked by a CycleCollector, the ones created later still are.
+     * Return value:
+     *   the frozen copy, NULL on error, as save() and restore().
+     */
+    static ScopedEnvPtr freeze(const ScopedEnvPtr &env,
+            const ScopedEnvPtr &prims,
+            SymbolTable * symbols = default_symbol_table());
+
+    static SymbolTable * default_symbol_table();
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_HEAP_SNAPSHOT_H_
@@ -9,6 +9,9 @@
 #ifndef _SOLAR_WIND_LISP_INTERPRETER_H_
 #define _SOLAR_WIND_LISP_INTERPRETER_H_
 
+#include <functional>
+#include <string>
+#include <vector>
 #include "gnu_attributes.h"
 #include "types.h"
 #include "expr.h"
@@ -18,6 +21,11 @@
 #include "future.h"
 #include "utils.h"
 #include "matter_factory.h"
+#include "cycle_collector.h"
+#include "frame_stack.h"
+#include "prepared_expr.h"
+#include "parse_cache.h"
+#include "native_proc.h"
 #include "pretty_message.h"
 
 namespace SolarWindLisp
@@ -32,6 +40,72 @@ public:
     virtual ~InterpreterIF();
     bool initialize();
 
+    /*
+     * Description:
+     *   Same as initialize(), but the global env, with all the definitions
+     *   in it, is restored from the heap snapshot `snapshot' (see
+     *   HeapSnapshot), instead of being built, nothing is executed. There
+     *   MUST NOT be a global env given to the constructor.
+     * Return value:
+     *   false if the snapshot is missing, stale or corrupted, initialize()
+     *   may be called then.
+     */
+    bool initialize(const char * snapshot);
+
+    /*
+     * Description:
+     *   Save the global env, and everything reachable from it, to the heap
+     *   snapshot `filename', the futures in it are realized. A snapshot with
+     *   procedures of register_fn() in it cannot be loaded.
+     */
+    bool save_snapshot(const char * filename);
+
+    /*
+     * Description:
+     *   Replace the global env with a frozen copy of it, for the processes
+     *   forked to share it, see HeapSnapshot::freeze(), the procedures of
+     *   register_fn() are the same objects in it. The old env is kept
+     *   as it is, and the objects created before are no longer tracked by
+     *   the collector, the garbage is collected first.
+     */
+    bool freeze();
+
+    /*
+     * Description:
+     *   The env of the primitive procedures and of the prelude, shared by all
+     *   the interpreters of the process, the global env of every one is
+     *   chained onto it, so an interpreter is ready without creating or
+     *   executing anything. It is built by the first call, thread-safe, and
+     *   never modified afterwards, the definitions go to the global envs,
+     *   and may shadow the builtin ones.
+     */
+    static ScopedEnvPtr builtin_env();
+
+    /*
+     * Description:
+     *   A new env like the one of builtin_env(), not shared.
+     */
+    static ScopedEnvPtr create_builtin_env();
+
+    /*
+     * Description:
+     *   Keep the global env as it is now for reset(), the definitions made
+     *   afterwards go to a new env chained onto it.
+     */
+    bool checkpoint();
+
+    /*
+     * Description:
+     *   Drop the definitions made since the last checkpoint(), the global
+     *   env is a new empty one chained onto it, and the stream of the parser
+     *   is reset. Objects of the checkpoint modified in place (e.g. a hash
+     *   map by `assoc!') stay modified. The cycles left are collected as
+     *   usual, at the next safe point due.
+     * Return value:
+     *   false if there is no checkpoint.
+     */
+    bool reset();
+
     static const char * prompt(bool primary = true)
     {
         return primary
@@ -54,6 +128,27 @@ public:
         return _factory;
     }
 
+    /*
+     * Description:
+     *   Cycles are collected automatically between top level forms, use
+     *   collector().set_threshold() to tune it, collector().stats() for the
+     *   number of collections and the pause times.
+     */
+    CycleCollector & collector()
+    {
+        return _collector;
+    }
+
+    /*
+     * Description:
+     *   Frames of the procedures which never capture them, see
+     *   _captures_frame().
+     */
+    const FrameStack & frames() const
+    {
+        return _frames;
+    }
+
 protected:
     typedef bool (*pred_func_t)(const MatterPtr &expr);
     typedef bool (*eval_func_t)(const MatterPtr &exrp, ScopedEnvPtr &env,
@@ -61,6 +156,9 @@ protected:
 
     ScopedEnvPtr create_minimum_env();
     void _expand();
+    bool _create_parser_and_factory();
+    static bool _decide_frame_kind(const std::string &name,
+            const MatterPtr &value, void * arg);
 
     /*
      * Description:
@@ -84,7 +182,9 @@ protected:
             }
         }
 
-        return expr->is_prim_proc();
+        return expr->is_prim_proc() || expr->is_pair()
+                || expr->is_vector() || expr->is_hash_map()
+                || expr->is_persistent_map();
     }
 
     static bool _eval_prim(const MatterPtr &expr, ScopedEnvPtr &scope,
@@ -93,6 +193,14 @@ protected:
     // helper
     static bool _is_special_form(const MatterPtr &expr, const char * keyword);
 
+    /*
+     * Description:
+     *   The truth of the value of a predicate, of `if', `cond' and `when':
+     *   atoms not empty (see Atom::not_empty()), primitive procedures, and
+     *   lists, vectors and maps not empty.
+     */
+    static bool _is_true(const MatterPtr &value);
+
     // if
     static bool _is_if(const MatterPtr &expr)
     {
@@ -125,6 +233,17 @@ protected:
     static bool _eval_name(const MatterPtr &expr, ScopedEnvPtr &scope,
             InterpreterIF * interpreter UNUSED, MatterPtr &result);
 
+    // quote
+    static bool _is_quote(const MatterPtr &expr)
+    {
+        return _is_special_form(expr, "quote");
+    }
+
+    static bool _eval_quote(const MatterPtr &expr, ScopedEnvPtr &scope UNUSED,
+            InterpreterIF * interpreter, MatterPtr &result);
+    static bool _quote(const MatterPtr &expr, InterpreterIF * interpreter,
+            MatterPtr &result);
+
     // time
     static bool _is_time(const MatterPtr &expr)
     {
@@ -143,6 +262,40 @@ protected:
     static bool _eval_lambda(const MatterPtr &expr, ScopedEnvPtr &scope,
             InterpreterIF * interpreter, MatterPtr &result);
 
+    /*
+     * Description:
+     *   Closure conversion of `(lambda params body)' evaluated in `scope'.
+     *   The free variables of `body' bound in the local envs of `scope' are
+     *   copied into a new env, whose external env is the global one, so the
+     *   closure does not keep the whole chain alive, and the lookups of the
+     *   global names skip the local envs.
+     *
+     *   Not possible if `body' defines names (`define', `defn'), or if a
+     *   local env may still bind a name looked up beyond it, e.g. the
+     *   recursive lambda of a `let', or a name defined later in the body of
+     *   a procedure, see ScopedEnv::set_code().
+     * Return value:
+     *   true if success, `result' is the env to create the closure with.
+     */
+    static bool _flatten(const CompositeExpr * params, const MatterPtr &body,
+            ScopedEnvPtr &scope, InterpreterIF * interpreter,
+            ScopedEnvPtr &result);
+
+    /*
+     * Description:
+     *   If `name' may be bound in `env' later, by the code evaluated in it.
+     */
+    static bool _may_bind(const ScopedEnvPtr &env, const std::string &name);
+
+    /*
+     * Description:
+     *   If evaluating `expr' may define `name' in the env it is evaluated
+     *   in, the bodies of `lambda', `defn' and `let' have envs of their own.
+     */
+    static bool _may_define(const MatterPtr &expr, const std::string &name);
+    static bool _free_names(const MatterPtr &expr,
+            std::vector<std::string> &bound, std::vector<std::string> &names);
+
     static bool _is_defn(const MatterPtr &expr)
     {
         return _is_special_form(expr, "defn");
@@ -208,16 +361,133 @@ protected:
             const MatterPtr &proc_operands,
             InterpreterIF * interpreter, MatterPtr &result);
 
+    static bool _bind_params(const CompositeExpr * params,
+            const CompositeExpr * operands, ScopedEnvPtr &env);
+
+    /*
+     * Description:
+     *   Escape analysis of the body of a procedure. A frame is captured by
+     *   procedures created in it (`lambda' and `defn'), and by `define',
+     *   which may save a Future created in it into itself. Quoted forms are
+     *   data, and skipped.
+     *
+     *   Futures created for the operands of applications refer to the frame
+     *   as well, but they are realized or released by the time the call
+     *   returns, except in rare cases (e.g. an unrealized Future returned),
+     *   which are handled by FrameStack::retire().
+     * Return value:
+     *   true if the frames MUST be allocated from the heap.
+     */
+    static bool _captures_frame(const MatterPtr &body);
+
+    bool _is_param_name(const std::string &name) const;
+    bool _register_native(const char * name, const PrimProcPtr &proc);
+
 public:
+    /*
+     * Description:
+     *   Execute all the forms of `str', the forms of the same input executed
+     *   lately are reused if the parse cache is enabled.
+     */
     bool execute(MatterPtr &result, const char * str, ssize_t len = -1);
+
+    /*
+     * Description:
+     *   Cache the forms of the last `capacity' inputs of execute(), up to
+     *   `max_input' bytes each, 0 (the default) for no cache, see ParseCache.
+     */
+    void set_parse_cache(size_t capacity,
+            size_t max_input = ParseCache::DEFAULT_MAX_INPUT)
+    {
+        _parse_cache = ParseCache(capacity, max_input);
+    }
+
+    const ParseCache & parse_cache() const
+    {
+        return _parse_cache;
+    }
+
     bool execute_multi_expr(MatterPtr &result, const MatterPtr &expr);
     bool execute_expr(MatterPtr &result, const MatterPtr &expr);
-    // REPL
+
+    /*
+     * Description:
+     *   Parse and analyze the forms of `str' once, `params' the names of the
+     *   arguments of eval().
+     * Return value:
+     *   an empty PreparedExpr on parse error, if there is no form, or if a
+     *   parameter is not a name, or repeated.
+     */
+    PreparedExpr prepare(const char * str,
+            const std::vector<std::string> &params, ssize_t len = -1);
+
+    /*
+     * Description:
+     *   Evaluate the forms of `prepared', `args' bound to its parameters in a
+     *   new frame, `result' is the value of the last form.
+     * Return value:
+     *   false on error, if the number of `args' is not the one of the
+     *   parameters, or if prepared by another interpreter.
+     */
+    bool eval(const PreparedExpr &prepared, MatterPtr &result,
+            const std::vector<MatterPtr> &args);
+
+    /*
+     * Description:
+     *   Define `name' in the global env as a primitive procedure calling
+     *   `fn', a function, or a lambda, e.g.
+     *     register_fn("clamp", [](double x, double lo, double hi) {...});
+     *   the operands are checked and converted by the types of its
+     *   parameters, see NativeProc. It is kept as it is by freeze(), but
+     *   a heap snapshot of the global env with it cannot be loaded, only the
+     *   builtin primitive procedures can be restored from a file.
+     * Return value:
+     *   false if not initialized, if `name' is not a name, or if it is
+     *   defined in the global env already.
+     */
+    template<typename F>
+    bool register_fn(const char * name, F fn)
+    {
+        return _register_native(name, NativeProc<F>::create(name, fn));
+    }
+    // REPL, script files of this size or larger are parsed in parallel, see
+    // ParallelLoader, script files are cached if enabled, see ScriptCache
+    static const size_t PARALLEL_LOAD_SIZE = 4 * 1024 * 1024;
     void cmd_help() const;
     static void banner();
     static void cmd_doc();
     static void cmd_names();
     static void _repl(InterpreterIF * interpreter, const char * filename = NULL);
+    /*
+     * Description:
+     *   Execute the whole of a script file, mapped at `script', with the
+     *   forms of its cache if enabled and valid (see ScriptCache), parsing
+     *   it otherwise, and saving the forms to the cache if enabled and there
+     *   is no parse error.
+     */
+    static bool _run_script_file(ParserIF * parser, const char * filename,
+            const char * script, size_t length,
+            const std::function<bool(const MatterPtr &)> &execute);
+    /*
+     * Description:
+     *   Execute all the forms of the file `filename', of the standard input
+     *   if NULL, with `execute', as soon as they are complete. The file is
+     *   one stream, not split into statements, so it stops at the first
+     *   parse error: the forms completed before it are executed, those
+     *   after it are not.
+     * Return value:
+     *   false if the file cannot be read, or on parse error.
+     */
+    static bool _run_file(InterpreterIF * interpreter, const char * filename,
+            const std::function<bool(const MatterPtr &)> &execute);
+    /*
+     * Description:
+     *   Execute all the forms of the script file `filename', like the REPL,
+     *   but the results are not printed.
+     * Return value:
+     *   false if the file cannot be read or parsed, or a form fails.
+     */
+    bool load_script(const char * filename);
     void interactive(const char * filename = NULL);
     static void repl(const char * filename = NULL);
 
@@ -225,7 +495,11 @@ private:
     bool _initialized;
     ParserIF * _parser;
     ScopedEnvPtr _env;
+    std::vector<ScopedEnvPtr> _checkpoints;
     MatterFactoryIF * _factory;
+    CycleCollector _collector;
+    FrameStack _frames;
+    ParseCache _parse_cache;
 };
 
 class SimpleInterpreter: public InterpreterIF
@@ -0,0 +1,198 @@
+/*
+ * file name:           include/interpreter_pool.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 05:12:48 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_INTERPRETER_POOL_H_
+#define _SOLAR_WIND_LISP_INTERPRETER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace SolarWindLisp
+{
+
+class InterpreterIF;
+
+/*
+ * Interpreters for the threads of a server to share: all of them are
+ * created and initialized up front, the `setup' script executed by each,
+ * and checkpointed (see InterpreterIF::checkpoint()), a thread leases one
+ * for a request, and it is reset when returned, so every request starts
+ * from the setup, without the definitions of the ones before it.
+ *
+ * The idle interpreters are on a lock-free stack, acquiring and releasing
+ * is a compare-and-swap each, unless the pool is exhausted, then acquire()
+ * sleeps until one is released.
+ */
+class InterpreterPool
+{
+public:
+    struct Stats
+    {
+        uint64_t acquisitions;
+        // acquisitions which had to wait, and for how long
+        uint64_t waits;
+        uint64_t total_wait_usec;
+        uint64_t max_wait_usec;
+        size_t in_use;
+        size_t max_in_use;
+        // leased time of all the interpreters, over the pool's capacity
+        // (size() times the time since initialize()), 0 to 1
+        double utilization;
+    };
+
+    /*
+     * Holds an interpreter of the pool, which is returned by release(), or
+     * by the destructor.
+     */
+    class Lease
+    {
+    public:
+        Lease() :
+                _pool(NULL), _index(0)
+        {
+        }
+
+        Lease(Lease &&other) :
+                _pool(other._pool), _index(other._index)
+        {
+            other._pool = NULL;
+        }
+
+        Lease & operator=(Lease &&other)
+        {
+            if (this != &other) {
+                release();
+                _pool = other._pool;
+                _index = other._index;
+                other._pool = NULL;
+            }
+            return *this;
+        }
+
+        ~Lease()
+        {
+            release();
+        }
+
+        InterpreterIF * get() const;
+
+        InterpreterIF * operator->() const
+        {
+            return get();
+        }
+
+        explicit operator bool() const
+        {
+            return _pool != NULL;
+        }
+
+        void release();
+
+    private:
+        friend class InterpreterPool;
+
+        Lease(const Lease &);
+        Lease & operator=(const Lease &);
+
+        Lease(InterpreterPool * pool, uint32_t index) :
+                _pool(pool), _index(index)
+        {
+        }
+
+        InterpreterPool * _pool;
+        uint32_t _index;
+    };
+
+    /*
+     * Description:
+     *   `size' interpreters, `setup' (if not NULL) is executed by each of
+     *   them, MUST be a string literal, or live as long as the pool does.
+     */
+    explicit InterpreterPool(size_t size, const char * setup = NULL);
+
+    /*
+     * Description:
+     *   MUST NOT be called while any interpreter is leased.
+     */
+    ~InterpreterPool();
+
+    /*
+     * Return value:
+     *   false if already initialized, or if an interpreter cannot be
+     *   initialized, or fails the setup script.
+     */
+    bool initialize();
+
+    /*
+     * Description:
+     *   Lease an idle interpreter, waits for one if there is none.
+     * Return value:
+     *   an empty lease if the pool is not initialized.
+     */
+    Lease acquire();
+
+    /*
+     * Description:
+     *   Lease an idle interpreter, never waits.
+     * Return value:
+     *   an empty lease if there is none.
+     */
+    Lease try_acquire();
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    Stats stats() const;
+
+private:
+    InterpreterPool(const InterpreterPool &);
+    InterpreterPool & operator=(const InterpreterPool &);
+
+    struct Slot
+    {
+        InterpreterIF * interpreter;
+        // index + 1 of the next idle slot, 0 for none
+        std::atomic<uint32_t> next;
+        // when it was leased, 0 if idle
+        std::atomic<int64_t> leased_usec;
+    };
+
+    bool _pop(uint32_t &index);
+    void _push(uint32_t index);
+    Lease _lease(uint32_t index, uint64_t wait_usec);
+    void _release(uint32_t index);
+
+    size_t _size;
+    const char * _setup;
+    Slot * _slots;
+    int64_t _initialized_usec;
+
+    // (ABA tag << 32) | (index + 1) of the top slot
+    std::atomic<uint64_t> _head;
+
+    std::mutex _lock;
+    std::condition_variable _released;
+    std::atomic<size_t> _waiters;
+
+    std::atomic<uint64_t> _acquisitions;
+    std::atomic<uint64_t> _waits;
+    std::atomic<uint64_t> _total_wait_usec;
+    std::atomic<uint64_t> _max_wait_usec;
+    std::atomic<size_t> _in_use;
+    std::atomic<size_t> _max_in_use;
+    std::atomic<uint64_t> _leased_usec;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_INTERPRETER_POOL_H_
@@ -25,6 +25,10 @@ public:
         matter_prim_proc,
         matter_proc,
         matter_future,
+        matter_pair,
+        matter_vector,
+        matter_hash_map,
+        matter_persistent_map,
         NUM_OF_MATTER_TYPES,
     };
 
@@ -41,6 +45,14 @@ public:
                 return "proc";
             case matter_future:
                 return "future";
+            case matter_pair:
+                return "pair";
+            case matter_vector:
+                return "vector";
+            case matter_hash_map:
+                return "hash_map";
+            case matter_persistent_map:
+                return "persistent_map";
             default:
                 return "ANTIMATTER";
         }
@@ -73,6 +85,26 @@ public:
         return matter_future == matter_type();
     }
 
+    bool is_pair() const
+    {
+        return matter_pair == matter_type();
+    }
+
+    bool is_vector() const
+    {
+        return matter_vector == matter_type();
+    }
+
+    bool is_hash_map() const
+    {
+        return matter_hash_map == matter_type();
+    }
+
+    bool is_persistent_map() const
+    {
+        return matter_persistent_map == matter_type();
+    }
+
     const char * matter_type_name() const
     {
         return MatterIF::matter_type_name(matter_type());
@@ -14,7 +14,12 @@
 #include "prim_proc.h"
 #include "proc.h"
 #include "future.h"
+#include "pair.h"
+#include "vector.h"
+#include "hash_map.h"
+#include "persistent_map.h"
 #include "scoped_env.h"
+#include "cycle_collector.h"
 
 namespace SolarWindLisp
 {
@@ -28,43 +33,103 @@ public:
     {
     }
 
+    /*
+     * Description:
+     *   Environments, procedures and futures created afterwards are tracked
+     *   by `collector', if not NULL.
+     */
+    virtual void set_collector(CycleCollector * collector)
+    {
+    }
+
     virtual AtomPtr create_atom() = 0;
-    virtual CompositeExprPtr create_composite_expr() = 0;
+    virtual CompositeExprPtr create_composite_expr(size_t capacity = 0) = 0;
     virtual FuturePtr create_future(MatterPtr expr, ScopedEnvPtr env,
             InterpreterIF * interpreter) = 0;
     virtual ProcPtr create_proc(MatterPtr params, MatterPtr body,
             ScopedEnvPtr env) = 0;
     virtual ScopedEnvPtr create_env(ScopedEnvPtr ext = NULL) = 0;
+    virtual PairPtr create_pair(const MatterPtr &car,
+            const MatterPtr &cdr) = 0;
+    virtual VectorPtr create_vector(Vector::elem_type_t elem_type,
+            size_t size) = 0;
+    virtual HashMapPtr create_hash_map(size_t expected = 0) = 0;
+    virtual PersistentMapPtr create_persistent_map() = 0;
 };
 
 class SimpleMatterFactory: public MatterFactoryIF
 {
 public:
+    SimpleMatterFactory() :
+            _collector(NULL)
+    {
+    }
+
+    void set_collector(CycleCollector * collector)
+    {
+        _collector = collector;
+    }
+
     AtomPtr create_atom()
     {
         return Atom::create();
     }
 
-    CompositeExprPtr create_composite_expr()
+    CompositeExprPtr create_composite_expr(size_t capacity = 0)
     {
-        return CompositeExpr::create();
+        return CompositeExpr::create(capacity);
     }
 
     ProcPtr create_proc(MatterPtr params , MatterPtr body, ScopedEnvPtr env)
     {
-        return Proc::create(params, body, env);
+        ProcPtr p = Proc::create(params, body, env);
+        if (p && _collector) {
+            _collector->track(p);
+        }
+        return p;
     }
 
     FuturePtr create_future(MatterPtr expr, ScopedEnvPtr env,
             InterpreterIF * interpreter)
     {
-        return Future::create(expr, env, interpreter);
+        FuturePtr f = Future::create(expr, env, interpreter);
+        if (f && _collector) {
+            _collector->track(f);
+        }
+        return f;
     }
 
     ScopedEnvPtr create_env(ScopedEnvPtr ext = NULL)
     {
-        return ScopedEnv::create(ext);
+        ScopedEnvPtr e = ScopedEnv::create(ext);
+        if (e && _collector) {
+            _collector->track(e);
+        }
+        return e;
+    }
+
+    PairPtr create_pair(const MatterPtr &car, const MatterPtr &cdr)
+    {
+        return Pair::create(car, cdr);
+    }
+
+    VectorPtr create_vector(Vector::elem_type_t elem_type, size_t size)
+    {
+        return Vector::create(elem_type, size);
     }
+
+    HashMapPtr create_hash_map(size_t expected = 0)
+    {
+        return HashMap::create(expected);
+    }
+
+    PersistentMapPtr create_persistent_map()
+    {
+        return PersistentMap::create();
+    }
+
+private:
+    CycleCollector * _collector;
 };
 
 } // namespace SolarWindLisp
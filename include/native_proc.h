@@ -0,0 +1,398 @@
+/*
+ * file name:           include/native_proc.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 08:14:36 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_NATIVE_PROC_H_
+#define _SOLAR_WIND_LISP_NATIVE_PROC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include "matter.h"
+#include "expr.h"
+#include "prim_proc.h"
+#include "matter_factory.h"
+#include "pretty_message.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * Primitive procedures made of C++ functions, see
+ * InterpreterIF::register_fn(): the number of the operands, their types,
+ * the conversions from the atoms and of the result back to an atom are all
+ * decided by the signature of the function, at compile time.
+ *
+ * Parameters and return values may be:
+ *   - integers (but bool), of integer atoms only, in the range of the type;
+ *   - `float', `double' and `long double', of integer or real atoms;
+ *   - `bool', of boolean atoms only;
+ *   - `std::string', of strings (quoted), not of names;
+ *   - `MatterPtr', any object as it is, a NULL one returned is an error.
+ * A function returning `void' returns nothing, like `define'.
+ */
+namespace Native
+{
+
+// std::index_sequence of C++14
+template<size_t ... I>
+struct IndexSeq
+{
+};
+
+template<size_t N, size_t ... I>
+struct MakeIndexSeq: MakeIndexSeq<N - 1, N - 1, I ...>
+{
+};
+
+template<size_t ... I>
+struct MakeIndexSeq<0, I ...>
+{
+    typedef IndexSeq<I ...> type;
+};
+
+// result and parameters of lambdas, functors and functions
+template<typename F>
+struct Signature: Signature<decltype(&F::operator())>
+{
+};
+
+template<typename R, typename ... A>
+struct Signature<R(A ...)>
+{
+    typedef R result_type;
+    typedef std::tuple<typename std::decay<A>::type ...> args_type;
+    static const size_t arity = sizeof...(A);
+};
+
+template<typename R, typename ... A>
+struct Signature<R (*)(A ...)>: Signature<R(A ...)>
+{
+};
+
+template<typename C, typename R, typename ... A>
+struct Signature<R (C::*)(A ...)>: Signature<R(A ...)>
+{
+};
+
+template<typename C, typename R, typename ... A>
+struct Signature<R (C::*)(A ...) const>: Signature<R(A ...)>
+{
+};
+
+template<typename T>
+struct DependentFalse: std::false_type
+{
+};
+
+/*
+ * Conversions of the atoms to `T', and of `T' to atoms.
+ */
+template<typename T, typename Enable = void>
+struct Convert
+{
+    static_assert(DependentFalse<T>::value,
+            "type not supported by native procedures");
+};
+
+template<typename T>
+struct Convert<T, typename std::enable_if<std::is_integral<T>::value
+        && !std::is_same<T, bool>::value>::type>
+{
+    static const char * type_name()
+    {
+        return "an integer in range";
+    }
+
+    static bool unbox(const MatterPtr &m, T &v)
+    {
+        if (!m || !m->is_atom()) {
+            return false;
+        }
+        const Atom * a = static_cast<const Atom *>(m.get());
+        if (!a->is_integer() || a->is_bool()) {
+            return false;
+        }
+        if (a->is_u64()) {
+            uint64_t u = 0;
+            if (!a->to_u64(u) || u > static_cast<uint64_t>(
+                    std::numeric_limits<T>::max())) {
+                return false;
+            }
+            v = static_cast<T>(u);
+            return true;
+        }
+        int64_t i = 0;
+        if (!a->to_i64(i)) {
+            return false;
+        }
+        if (std::is_signed<T>::value
+                ? (i < static_cast<int64_t>(std::numeric_limits<T>::min())
+                        || i > static_cast<int64_t>(
+                                std::numeric_limits<T>::max()))
+                : (i < 0 || static_cast<uint64_t>(i) > static_cast<uint64_t>(
+                        std::numeric_limits<T>::max()))) {
+            return false;
+        }
+        v = static_cast<T>(i);
+        return true;
+    }
+
+    static bool box(T v, MatterPtr &result, MatterFactoryIF * factory)
+    {
+        AtomPtr atom = factory->create_atom();
+        if (!atom) {
+            return false;
+        }
+        if (std::is_signed<T>::value) {
+            atom->set_i64(static_cast<int64_t>(v));
+        }
+        else {
+            atom->set_u64(static_cast<uint64_t>(v));
+        }
+        result = atom;
+        return true;
+    }
+};
+
+template<typename T>
+struct Convert<T,
+        typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    static const char * type_name()
+    {
+        return "a number";
+    }
+
+    static bool unbox(const MatterPtr &m, T &v)
+    {
+        if (!m || !m->is_atom()) {
+            return false;
+        }
+        const Atom * a = static_cast<const Atom *>(m.get());
+        long double ld = 0;
+        if (!a->is_numeric() || a->is_bool() || !a->to_long_double(ld)) {
+            return false;
+        }
+        v = static_cast<T>(ld);
+        return true;
+    }
+
+    static bool box(T v, MatterPtr &result, MatterFactoryIF * factory)
+    {
+        AtomPtr atom = factory->create_atom();
+        if (!atom) {
+            return false;
+        }
+        if (std::is_same<T, long double>::value) {
+            atom->set_long_double(v);
+        }
+        else {
+            atom->set_double(v);
+        }
+        result = atom;
+        return true;
+    }
+};
+
+template<>
+struct Convert<bool>
+{
+    static const char * type_name()
+    {
+        return "a boolean";
+    }
+
+    static bool unbox(const MatterPtr &m, bool &v)
+    {
+        return m && m->is_atom()
+                && static_cast<const Atom *>(m.get())->is_bool()
+                && static_cast<const Atom *>(m.get())->to_bool(v);
+    }
+
+    static bool box(bool v, MatterPtr &result, MatterFactoryIF * factory)
+    {
+        AtomPtr atom = factory->create_atom();
+        if (!atom) {
+            return false;
+        }
+        atom->set_bool(v);
+        result = atom;
+        return true;
+    }
+};
+
+template<>
+struct Convert<std::string>
+{
+    static const char * type_name()
+    {
+        return "a string";
+    }
+
+    static bool unbox(const MatterPtr &m, std::string &v)
+    {
+        if (!m || !m->is_atom()) {
+            return false;
+        }
+        const Atom * a = static_cast<const Atom *>(m.get());
+        if (!a->is_quoted_cstr()) {
+            return false;
+        }
+        v.assign(a->to_cstr(), a->cstr_length());
+        return true;
+    }
+
+    static bool box(const std::string &v, MatterPtr &result,
+            MatterFactoryIF * factory)
+    {
+        AtomPtr atom = factory->create_atom();
+        if (!atom || !atom->set_cstr(v.data(), v.size(), true)) {
+            return false;
+        }
+        result = atom;
+        return true;
+    }
+};
+
+template<>
+struct Convert<MatterPtr>
+{
+    static const char * type_name()
+    {
+        return "an object";
+    }
+
+    static bool unbox(const MatterPtr &m, MatterPtr &v)
+    {
+        v = m;
+        return m != NULL;
+    }
+
+    static bool box(const MatterPtr &v, MatterPtr &result,
+            MatterFactoryIF * factory UNUSED)
+    {
+        result = v;
+        return v != NULL;
+    }
+};
+
+template<typename R>
+struct Call
+{
+    template<typename F, typename Args, size_t ... I>
+    static bool invoke(F &fn, Args &args, IndexSeq<I ...>,
+            MatterPtr &result, MatterFactoryIF * factory)
+    {
+        return Convert<typename std::decay<R>::type>::box(
+                fn(std::get<I>(args) ...), result, factory);
+    }
+};
+
+template<>
+struct Call<void>
+{
+    template<typename F, typename Args, size_t ... I>
+    static bool invoke(F &fn, Args &args, IndexSeq<I ...>,
+            MatterPtr &result, MatterFactoryIF * factory UNUSED)
+    {
+        fn(std::get<I>(args) ...);
+        result = NULL;
+        return true;
+    }
+};
+
+} // namespace Native
+
+template<typename F>
+class NativeProc: public PrimProcIF
+{
+public:
+    typedef Native::Signature<F> signature;
+    typedef typename signature::args_type args_type;
+
+    static PrimProcPtr create(const char * name, F fn)
+    {
+        return PrimProcPtr(new (std::nothrow) NativeProc(name, fn));
+    }
+
+    bool run(const MatterPtr &ops, MatterPtr &result,
+            MatterFactoryIF * factory)
+    {
+        args_type args;
+        typename Native::MakeIndexSeq<signature::arity>::type seq;
+        const CompositeExpr * ce =
+                static_cast<const CompositeExpr *>(ops.get());
+        return _unbox(*ce, args, seq)
+                && Native::Call<typename signature::result_type>::invoke(
+                        _fn, args, seq, result, factory);
+    }
+
+    bool check_operands(const MatterPtr &ops) const
+    {
+        return ops->is_composite_expr()
+                && static_cast<const CompositeExpr *>(ops.get())->size()
+                        == signature::arity;
+    }
+
+    const char * name() const
+    {
+        return _name.c_str();
+    }
+
+    std::string debug_string(bool compact UNUSED = true, int level UNUSED = 0,
+            const char * indent_seq UNUSED = DEFAULT_INDENT_SEQ) const
+    {
+        return "NativeProc{" + _name + "}";
+    }
+
+    std::string to_string() const
+    {
+        return "instance of NativeProc `" + _name + "'";
+    }
+
+private:
+    NativeProc(const char * name, F fn) :
+            _name(name ? name : ""), _fn(fn)
+    {
+    }
+
+    template<size_t ... I>
+    bool _unbox(const CompositeExpr &ops, args_type &args,
+            Native::IndexSeq<I ...>) const
+    {
+        // in order, up to the first mismatch, which is reported
+        bool ok = true;
+        int unused[] = { 0, (ok = ok && _unbox_one<I>(ops, args), 0) ... };
+        (void) unused;
+        return ok;
+    }
+
+    template<size_t I>
+    bool _unbox_one(const CompositeExpr &ops, args_type &args) const
+    {
+        typedef typename std::tuple_element<I, args_type>::type arg_type;
+        if (Native::Convert<arg_type>::unbox(ops[I], std::get<I>(args))) {
+            return true;
+        }
+        PRETTY_MESSAGE(stderr, "%s: operand %zu is not %s", _name.c_str(),
+                I + 1, Native::Convert<arg_type>::type_name());
+        return false;
+    }
+
+    std::string _name;
+    F _fn;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_NATIVE_PROC_H_
@@ -0,0 +1,77 @@
+/*
+ * file name:           include/pair.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 14:02:47 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_PAIR_H_
+#define _SOLAR_WIND_LISP_PAIR_H_
+
+#include <new>
+#include <sys/types.h>
+#include "matter.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * An immutable cons cell. Lists are chains of pairs terminated by nil(),
+ * the shared empty list, which is the only pair with both slots NULL.
+ */
+class Pair: public MatterIF
+{
+public:
+    matter_type_t matter_type() const
+    {
+        return matter_pair;
+    }
+
+    static PairPtr create(const MatterPtr &car, const MatterPtr &cdr)
+    {
+        return PairPtr(new (std::nothrow) Pair(car, cdr));
+    }
+
+    static const PairPtr & nil();
+
+    bool is_nil() const
+    {
+        return !_car && !_cdr;
+    }
+
+    const MatterPtr & car() const
+    {
+        return _car;
+    }
+
+    const MatterPtr & cdr() const
+    {
+        return _cdr;
+    }
+
+    /*
+     * Return value:
+     *   number of elements if this is a proper list, -1 otherwise.
+     */
+    ssize_t length() const;
+
+    std::string debug_string(bool compact = true, int level = 0,
+            const char * indent_seq = DEFAULT_INDENT_SEQ) const;
+    std::string to_string() const;
+
+    virtual ~Pair();
+
+private:
+    Pair(const MatterPtr &car, const MatterPtr &cdr) :
+            _car(car), _cdr(cdr)
+    {
+    }
+
+    MatterPtr _car;
+    MatterPtr _cdr;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_PAIR_H_
@@ -0,0 +1,115 @@
+/*
+ * file name:           include/parallel_loader.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 00:21:07 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_PARALLEL_LOADER_H_
+#define _SOLAR_WIND_LISP_PARALLEL_LOADER_H_
+
+#include <stddef.h>
+#include <functional>
+#include <vector>
+#include "types.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * Parses a large script with several threads: ParserIF::split() cuts it at
+ * top level form boundaries into batches, the worker threads parse the
+ * batches into independent forms, interning the symbols in a SymbolTable
+ * safe for concurrent insertion, and the calling thread receives the forms
+ * in source order, as soon as the batches before them are done. So the
+ * forms can be evaluated while the rest of the script is being parsed.
+ *
+ * The workers do not wait for the forms to be consumed, a slow consumer may
+ * end up with the whole script parsed in memory.
+ */
+class ParallelLoader
+{
+public:
+    static const size_t MIN_BATCH_SIZE = 256 * 1024;
+    // batches per thread, for the threads to finish at about the same time
+    static const size_t BATCHES_PER_THREAD = 8;
+
+    /*
+     * Return value:
+     *   false to stop loading.
+     */
+    typedef std::function<bool(const MatterPtr &form)> form_handler;
+
+    /*
+     * Description:
+     *   `threads' 0 for the number of CPUs, 1 to parse on the calling thread
+     *   only. The symbols are interned in `symbols' if not NULL, which MUST
+     *   live as long as the forms do.
+     */
+    explicit ParallelLoader(size_t threads = 0,
+            SymbolTable * symbols = default_symbol_table());
+
+    /*
+     * Description:
+     *   Parse all the forms of `input', `;' comment lines included, like the
+     *   REPL does, and pass them to `handler' in source order, on the
+     *   calling thread.
+     * Return value:
+     *   true if all the forms are parsed and handled, false on error (see
+     *   error_offset() and error_message()), or if stopped by `handler'.
+     */
+    bool load(const char * input, size_t length, const form_handler &handler);
+
+    /*
+     * Description:
+     *   Same as above, all the forms appended to `forms'.
+     */
+    bool load(const char * input, size_t length,
+            std::vector<MatterPtr> &forms);
+
+    size_t threads() const
+    {
+        return _threads;
+    }
+
+    // number of batches of the last load()
+    size_t batches() const
+    {
+        return _batches;
+    }
+
+    /*
+     * Return value:
+     *   byte offset of the parse error in the input of the last load().
+     */
+    size_t error_offset() const
+    {
+        return _error_offset;
+    }
+
+    /*
+     * Return value:
+     *   description of the parse error of the last load(), NULL if none.
+     */
+    const char * error_message() const
+    {
+        return _error_message;
+    }
+
+    static SymbolTable * default_symbol_table();
+
+private:
+    ParallelLoader(const ParallelLoader &);
+    ParallelLoader & operator=(const ParallelLoader &);
+
+    size_t _threads;
+    SymbolTable * _symbols;
+    size_t _batches;
+    size_t _error_offset;
+    const char * _error_message;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_PARALLEL_LOADER_H_
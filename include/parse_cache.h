@@ -0,0 +1,124 @@
+/*
+ * file name:           include/parse_cache.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 06:41:15 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_PARSE_CACHE_H_
+#define _SOLAR_WIND_LISP_PARSE_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "types.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * The forms of the inputs executed lately, so the same small strings
+ * executed over and over are parsed only once, see
+ * InterpreterIF::set_parse_cache(). The forms are never modified by
+ * evaluation, so they are reused as they are.
+ *
+ * Entries are found by ScriptCache::content_hash() of the input, and the
+ * input itself is kept and compared too, an input with the hash of another
+ * is a miss, and replaces it. The least recently used entry is evicted when
+ * the cache is full, inputs longer than `max_input' are never cached.
+ *
+ * Not thread-safe, every interpreter has its own.
+ */
+class ParseCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        size_t entries;
+        size_t bytes;           // of the inputs cached
+    };
+
+    static const size_t DEFAULT_MAX_INPUT = 4096;
+
+    /*
+     * Description:
+     *   `capacity' 0 for no cache.
+     */
+    explicit ParseCache(size_t capacity = 0,
+            size_t max_input = DEFAULT_MAX_INPUT);
+
+    /*
+     * Description:
+     *   The forms of `str', a CompositeExpr like the result of
+     *   ParserIF::parse(), the entry is the most recently used then.
+     * Return value:
+     *   false if not cached, a miss if it may be.
+     */
+    bool find(const char * str, size_t len, MatterPtr &forms);
+
+    /*
+     * Description:
+     *   Cache the `forms' of `str', the least recently used entry is evicted
+     *   if the cache is full.
+     */
+    void insert(const char * str, size_t len, const MatterPtr &forms);
+
+    /*
+     * Description:
+     *   Change the capacity, the entries over it are evicted, 0 to disable
+     *   the cache. The counters are kept.
+     */
+    void set_capacity(size_t capacity);
+
+    void clear();
+
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    size_t max_input() const
+    {
+        return _max_input;
+    }
+
+    // whether inputs of `len' bytes may be cached
+    bool accepts(size_t len) const
+    {
+        return _capacity && len <= _max_input;
+    }
+
+    Stats stats() const;
+
+private:
+    struct Entry
+    {
+        uint64_t hash;
+        std::string input;
+        MatterPtr forms;
+    };
+
+    typedef std::list<Entry> entry_list;
+
+    void _evict();
+
+    size_t _capacity;
+    size_t _max_input;
+    // most recently used first
+    entry_list _entries;
+    std::unordered_map<uint64_t, entry_list::iterator> _index;
+    size_t _bytes;
+    uint64_t _hits;
+    uint64_t _misses;
+    uint64_t _evictions;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_PARSE_CACHE_H_
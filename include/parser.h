@@ -10,8 +10,10 @@
 #define _SOLAR_WIND_LISP_PARSER_H_
 
 #include <stddef.h>
+#include <stdint.h>
 #include <string>
 #include <queue>
+#include <vector>
 
 #include "expr.h"
 
@@ -24,20 +26,161 @@ public:
 
     typedef std::deque<std::string> lexical_tokens;
 
+    /*
+     * An escaped paren alone in quotes, e.g. the `\)' of "(\)", is a
+     * token_escaped_atom, but it is parsed as a paren, by its text.
+     */
+    enum token_kind_t
+    {
+        token_lparen = 0,
+        token_rparen,
+        token_atom,         // the text is the bytes of the input
+        token_escaped_atom, // with escape sequences, see token_text()
+    };
+
+    /*
+     * A token as a view of the input, no copy is made.
+     */
+    struct Token
+    {
+        size_t offset;
+        uint32_t length;
+        uint8_t kind;
+        char quote;         // quote char opened before the token starts, or 0
+    };
+
+    typedef std::vector<Token> token_views;
+
     ParserIF() :
-            _form_str(NULL), _form_len(0)
+            _symbols(NULL), _error_offset(0), _error_message(NULL)
     {
+        _stream.comments = true;
     }
 
     virtual ~ParserIF()
     {
     }
 
+    /*
+     * Description:
+     *   Split `input' into tokens, appended to `result' (cleared first), the
+     *   capacity of `result' is reused, so there is no allocation per token.
+     * Return value:
+     *   true if any token found, false if none, or a token is too long.
+     */
+    static bool tokenize(token_views *result, const char * input,
+            ssize_t input_length = -1);
+
+    /*
+     * Description:
+     *   The text of `token' of `input', with the escape sequences resolved.
+     */
+    static void token_text(const char * input, const Token &token,
+            std::string &result);
+
+    /*
+     * Description:
+     *   Same as above, each token copied to a string.
+     */
     static bool tokenize(lexical_tokens *result, const char * input,
             ssize_t input_length = -1);
+    /*
+     * Description:
+     *   Split `input' into pieces of at least `piece_size' bytes (but the
+     *   last one), which can be parsed independently, e.g. by several
+     *   threads, giving the same forms as the whole input: every piece
+     *   starts at the beginning of a line, outside of any list, string or
+     *   comment. Only the parens, quotes and newlines are looked at, with
+     *   the rules of the tokenizer, nothing is converted. An unmatched `)'
+     *   ends the splitting, the parser reports it.
+     *
+     *   The offsets of the pieces are appended to `starts', the first is 0.
+     */
+    static void split(const char * input, size_t length, size_t piece_size,
+            std::vector<size_t> &starts);
+
+    /*
+     * Description:
+     *   Intern the symbols of the atoms created from now on in `symbols',
+     *   which MUST live as long as the atoms do, NULL to stop it.
+     */
+    void set_symbol_table(SymbolTable * symbols)
+    {
+        _symbols = symbols;
+    }
+
+    SymbolTable * symbol_table() const
+    {
+        return _symbols;
+    }
+
+    /*
+     * Description:
+     *   Parse all the forms of `input' in a single pass, nesting depth is
+     *   limited by memory only.
+     * Return value:
+     *   a CompositeExpr of the forms, or NULL on error (see error_offset()
+     *   and error_message()), or if there is no form at all.
+     */
     MatterPtr parse(const char * input, ssize_t input_length = -1);
+
+    /*
+     * Description:
+     *   Parse the next chunk of a stream, which may end anywhere, e.g. in
+     *   the middle of an atom or a string. The state of the tokenizer and
+     *   the lists still open are kept for the next chunk, the bytes already
+     *   consumed are never scanned again, only those of an unfinished atom
+     *   are kept. Lines starting with `;' are comments, like in script
+     *   files. A parse() in between abandons the stream.
+     * Return value:
+     *   false on error, the stream is reset then, offsets of the errors are
+     *   from the start of the stream. In both cases the top level forms
+     *   completed so far are appended to `forms'.
+     */
+    bool feed(const char * input, size_t length, std::vector<MatterPtr> &forms);
+
+    /*
+     * Description:
+     *   End of the stream, complete the last atom, and start a new stream.
+     * Return value:
+     *   false if a list is still open, or on error, see feed().
+     */
+    bool finish(std::vector<MatterPtr> &forms);
+
+    void reset_stream();
+
+    /*
+     * Return value:
+     *   true if a form of the stream is not complete yet, e.g. to choose the
+     *   prompt of the REPL.
+     */
+    bool in_progress() const
+    {
+        return !_open.empty() || _stream.carrying || _stream.quote_char;
+    }
+
     virtual const char * name() const = 0;
 
+    /*
+     * Return value:
+     *   byte offset of the error in the input of the last parse(), or in
+     *   the stream.
+     */
+    size_t error_offset() const
+    {
+        return _error_offset;
+    }
+
+    /*
+     * Return value:
+     *   description of the error of the last parse(), NULL if none, or the
+     *   input had no form.
+     */
+    const char * error_message() const
+    {
+        return _error_message;
+    }
+
 private:
 
     static const char * S_TERM;
@@ -54,11 +197,70 @@ private:
     static const char C_LP = '(';
     static const char C_RP = ')';
 
-    MatterPtr _parse_tokens(bool inner);
+    // the tokenizer state between the chunks of a stream
+    struct ScanState
+    {
+        size_t offset;          // in the stream, of the chunk being scanned
+        bool carrying;          // a token is continued by the next chunk
+        std::string carried;    // its bytes so far
+        size_t carried_offset;
+        char start_quote;
+        bool escaped;
+        char quote_char;
+        bool escape_mode;
+        bool comments;          // skip `;' comment lines
+        bool in_comment;
+        bool line_blank;        // only spaces since the last newline
+
+        ScanState() :
+                offset(0), carrying(false), carried_offset(0),
+                start_quote(C_TERM), escaped(false), quote_char(C_TERM),
+                escape_mode(false), comments(false), in_comment(false),
+                line_blank(true)
+        {
+        }
+    };
+
+    /*
+     * Description:
+     *   Split `input', a chunk of a stream described by `st', into tokens,
+     *   pass each to `sink.token()' with its bytes, which may return false
+     *   to stop, `sink.error()' is called if a token is too long. Unless
+     *   `last', a token reaching the end of `input' is left in `st'.
+     * Return value:
+     *   true if the whole input is scanned.
+     */
+    template<typename Sink>
+    static bool _scan(ScanState &st, const char * input,
+            ssize_t input_length, Sink &sink, bool last);
+
+    static void _token_text(const char * raw, const Token &token,
+            std::string &result);
+
+    // sink of _scan() used by parse() and feed()
+    bool token(const Token &t, const char * raw);
+    void error(size_t offset, const char * message);
+
+    void _take_forms(std::vector<MatterPtr> &forms);
+    void _reset_stream_state();
+
+    CompositeExprPtr _collect_children(size_t base);
+
+    struct OpenList
+    {
+        size_t base;        // index in `_scratch' of the first child
+        size_t offset;      // of the open parenthesis
+    };
 
-    const char * _form_str;
-    ssize_t _form_len;
-    lexical_tokens _tokens;
+    SymbolTable * _symbols;
+    ScanState _stream;
+    std::vector<OpenList> _open;    // the lists being parsed, inner most last
+    std::string _text;              // unescaped text of the current atom
+    size_t _error_offset;
+    const char * _error_message;
+    // children of the lists being parsed, the inner most list on top, so
+    // each CompositeExpr can be created with the exact capacity it needs.
+    std::vector<MatterPtr> _scratch;
 };
 
 class SimpleParser: public ParserIF
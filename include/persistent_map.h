@@ -0,0 +1,164 @@
+/*
+ * file name:           include/persistent_map.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 20:05:33 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_PERSISTENT_MAP_H_
+#define _SOLAR_WIND_LISP_PERSISTENT_MAP_H_
+
+#include <stdint.h>
+#include <vector>
+#include "matter.h"
+#include "hash_map.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * An immutable map keyed by atoms (see AtomKey), implemented as a hash array
+ * mapped trie. Every node covers 5 bits of the 64-bit key hash, a bitmap
+ * tells which of the 32 positions are used, and the slots are stored densely,
+ * the slot of a position is found by counting the bits below it (popcount).
+ * Keys whose hashes are identical end up in a collision node.
+ *
+ * assoc() and dissoc() return a new version, which copies the nodes along the
+ * path to the key only, everything else is shared with the original. Since
+ * nothing is ever modified, versions can be shared by threads freely.
+ *
+ * Use a Transient to build a map with many updates: nodes created by the
+ * transient are owned by it and updated in place, until persistent() is
+ * called.
+ */
+class PersistentMap: public MatterIF
+{
+public:
+    class Transient;
+
+    matter_type_t matter_type() const
+    {
+        return matter_persistent_map;
+    }
+
+    /*
+     * Return value:
+     *   an empty map.
+     */
+    static PersistentMapPtr create();
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /*
+     * Return value:
+     *   the value of `key', or NULL if not found.
+     */
+    const MatterPtr * find(const MatterPtr &key) const;
+
+    /*
+     * Return value:
+     *   a new version with `key' set to `value' (`key' MUST be a valid key),
+     *   or NULL if out of memory.
+     */
+    PersistentMapPtr assoc(const MatterPtr &key, const MatterPtr &value) const;
+
+    /*
+     * Return value:
+     *   a new version without `key', or NULL if out of memory.
+     */
+    PersistentMapPtr dissoc(const MatterPtr &key) const;
+
+    void for_each(bool (*func)(const MatterPtr &key, const MatterPtr &value,
+            void * arg), void * arg) const;
+
+    std::string debug_string(bool compact = true, int level = 0,
+            const char * indent_seq = DEFAULT_INDENT_SEQ) const;
+    std::string to_string() const;
+
+    virtual ~PersistentMap()
+    {
+    }
+
+    struct Node;
+    typedef boost::shared_ptr<Node> NodePtr;
+
+    struct Slot
+    {
+        uint64_t hash;
+        MatterPtr key;      // NULL if this slot holds a child node
+        MatterPtr value;
+        NodePtr child;
+    };
+
+    struct Node
+    {
+        uint32_t bitmap;
+        bool collision;     // slots are all keys of the same hash
+        uint64_t edit;      // id of the owning transient, 0 if none
+        std::vector<Slot> slots;
+
+        Node(uint64_t edit_id) :
+                bitmap(0), collision(false), edit(edit_id)
+        {
+        }
+    };
+
+    /*
+     * Statistics of the trie, for tests and benchmarks.
+     */
+    size_t node_count() const;
+    size_t depth() const;
+
+private:
+    PersistentMap(const NodePtr &root, size_t size) :
+            _root(root), _size(size)
+    {
+    }
+
+    PersistentMap(const PersistentMap &);
+    PersistentMap & operator=(const PersistentMap &);
+
+    NodePtr _root; // NULL if empty
+    size_t _size;
+};
+
+/*
+ * Mutable builder of a PersistentMap. The map it was created from is not
+ * affected, a transient is not thread-safe, and can not be used any more
+ * after persistent() was called.
+ */
+class PersistentMap::Transient
+{
+public:
+    explicit Transient(const PersistentMapPtr &from);
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /*
+     * Return value:
+     *   false if out of memory, or persistent() has been called.
+     */
+    bool assoc(const MatterPtr &key, const MatterPtr &value);
+    bool dissoc(const MatterPtr &key);
+
+    PersistentMapPtr persistent();
+
+private:
+    Transient(const Transient &);
+    Transient & operator=(const Transient &);
+
+    NodePtr _root;
+    size_t _size;
+    uint64_t _edit;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_PERSISTENT_MAP_H_
@@ -0,0 +1,69 @@
+/*
+ * file name:           include/prepared_expr.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 06:03:27 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_PREPARED_EXPR_H_
+#define _SOLAR_WIND_LISP_PREPARED_EXPR_H_
+
+#include <string>
+#include <vector>
+#include "types.h"
+
+namespace SolarWindLisp
+{
+
+class InterpreterIF;
+
+/*
+ * One or more forms parsed and analyzed once by InterpreterIF::prepare(),
+ * with named parameters, evaluated many times by InterpreterIF::eval(), the
+ * arguments bound to the parameters in a new frame, like the ones of a
+ * procedure call, so the global env is never modified.
+ *
+ * The other names are looked up when evaluated, in the global env of the
+ * interpreter as it was prepared, a prepared expression is valid as long
+ * as that env is, e.g. until the next InterpreterIF::reset() if prepared
+ * after the checkpoint, or forever if prepared before it.
+ */
+class PreparedExpr
+{
+    friend class InterpreterIF;
+public:
+    PreparedExpr() :
+            _interpreter(NULL), _forms(NULL), _env(NULL), _heap_frame(false)
+    {
+    }
+
+    explicit operator bool() const
+    {
+        return _interpreter != NULL;
+    }
+
+    const std::vector<std::string> & params() const
+    {
+        return _params;
+    }
+
+    // the interpreter which prepared it, the only one to evaluate it
+    InterpreterIF * interpreter() const
+    {
+        return _interpreter;
+    }
+
+private:
+    InterpreterIF * _interpreter;
+    std::vector<std::string> _params;
+    // CompositeExpr, the forms to evaluate in order
+    MatterPtr _forms;
+    ScopedEnvPtr _env;
+    // the forms capture their frame, see InterpreterIF::_captures_frame()
+    bool _heap_frame;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_PREPARED_EXPR_H_
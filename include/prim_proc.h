@@ -139,6 +139,143 @@ PROC_DECLARATION_EXACT_TWO_MACRO(Gt,  ">",    "PrimProcGt{}")
 PROC_DECLARATION_EXACT_TWO_MACRO(Ge,  ">=",   "PrimProcGe{}")
 #undef PROC_DECLARATION_EXACT_TWO_MACRO
 
+/*
+ * Every operator requires at least `min_ops', and at most `max_ops' operands.
+ */
+#define PROC_DECLARATION_RANGE_MACRO(cls_name, cls_repr, cls_repr2,     \
+        min_ops, max_ops)                                               \
+class PrimProc##cls_name: public PrimProcIF                             \
+{                                                                       \
+public:                                                                 \
+    bool run(const MatterPtr &ops, MatterPtr &result,                   \
+            MatterFactoryIF * factory);                                 \
+                                                                        \
+    bool check_operands(const MatterPtr &ops) const                     \
+    {                                                                   \
+        if (!ops->is_composite_expr()) {                                \
+            return false;                                               \
+        }                                                               \
+        size_t n = static_cast<const CompositeExpr *>(ops.get())->size();\
+        return n >= (min_ops) && n <= (max_ops);                        \
+    }                                                                   \
+                                                                        \
+    const char * name() const                                           \
+    {                                                                   \
+        return cls_repr;                                                \
+    }                                                                   \
+                                                                        \
+    std::string debug_string(bool compact = true, int level = 0,        \
+            const char * indent_seq = DEFAULT_INDENT_SEQ) const         \
+    {                                                                   \
+        return cls_repr2;                                               \
+    }                                                                   \
+                                                                        \
+    std::string to_string() const                                       \
+    {                                                                   \
+        return "instance of PrimProcIF";                                \
+    }                                                                   \
+                                                                        \
+    static PrimProcPtr create()                                         \
+    {                                                                   \
+        return PrimProcPtr(new (std::nothrow) PrimProc##cls_name());    \
+    }                                                                   \
+};
+#define UNLIMITED_OPS static_cast<size_t>(-1)
+
+/*
+ * List Operations:
+ *   cons car cdr list length nth reverse
+ *
+ * Notes:
+ *   Lists are immutable, the result either is a new list, or shares the tail
+ *   of an existing one.
+ *     (cons 1 (list 2 3))  => (1 2 3)
+ *     (cdr (list 1 2 3))   => (2 3)
+ *     (nth (list 1 2 3) 0) => 1
+ *     (list)               => ()
+ */
+PROC_DECLARATION_RANGE_MACRO(Cons,    "cons",    "PrimProcCons{}",    2, 2)
+PROC_DECLARATION_RANGE_MACRO(Car,     "car",     "PrimProcCar{}",     1, 1)
+PROC_DECLARATION_RANGE_MACRO(Cdr,     "cdr",     "PrimProcCdr{}",     1, 1)
+PROC_DECLARATION_RANGE_MACRO(List,    "list",    "PrimProcList{}",    0, UNLIMITED_OPS)
+PROC_DECLARATION_RANGE_MACRO(Length,  "length",  "PrimProcLength{}",  1, 1)
+PROC_DECLARATION_RANGE_MACRO(Nth,     "nth",     "PrimProcNth{}",     2, 2)
+PROC_DECLARATION_RANGE_MACRO(Reverse, "reverse", "PrimProcReverse{}", 1, 1)
+
+/*
+ * Vector Operations:
+ *   vector make-vector list->vector vec-len vec-ref
+ *   vec-sum vec-dot vec-min vec-max vec-map+ vec-scale
+ *
+ * Notes:
+ *   A vector holds either int64_t or double elements, it holds doubles if
+ *   any of the initial values is a real number. Reductions and element-wise
+ *   operations are done by the SIMD kernels in vector_kernels.h, operations
+ *   on an integer vector and a real vector (or number) produce doubles.
+ *     (vector 1 2 3)                       => [1 2 3]
+ *     (make-vector 3 0.5)                  => [0.5 0.5 0.5]
+ *     (vec-sum (vector 1 2 3))             => 6
+ *     (vec-dot (vector 1 2) (vector 3 4))  => 11
+ *     (vec-map+ (vector 1 2) (vector 3 4)) => [4 6]
+ *     (vec-scale (vector 1 2) 0.5)         => [0.5 1]
+ *     (vec-min (vector))                   => error
+ */
+PROC_DECLARATION_RANGE_MACRO(Vector,       "vector",       "PrimProcVector{}",       0, UNLIMITED_OPS)
+PROC_DECLARATION_RANGE_MACRO(MakeVector,   "make-vector",  "PrimProcMakeVector{}",   1, 2)
+PROC_DECLARATION_RANGE_MACRO(ListToVector, "list->vector", "PrimProcListToVector{}", 1, 1)
+PROC_DECLARATION_RANGE_MACRO(VecLen,       "vec-len",      "PrimProcVecLen{}",       1, 1)
+PROC_DECLARATION_RANGE_MACRO(VecRef,       "vec-ref",      "PrimProcVecRef{}",       2, 2)
+PROC_DECLARATION_RANGE_MACRO(VecSum,       "vec-sum",      "PrimProcVecSum{}",       1, 1)
+PROC_DECLARATION_RANGE_MACRO(VecDot,       "vec-dot",      "PrimProcVecDot{}",       2, 2)
+PROC_DECLARATION_RANGE_MACRO(VecMin,       "vec-min",      "PrimProcVecMin{}",       1, 1)
+PROC_DECLARATION_RANGE_MACRO(VecMax,       "vec-max",      "PrimProcVecMax{}",       1, 1)
+PROC_DECLARATION_RANGE_MACRO(VecMapAdd,    "vec-map+",     "PrimProcVecMapAdd{}",    2, 2)
+PROC_DECLARATION_RANGE_MACRO(VecScale,     "vec-scale",    "PrimProcVecScale{}",     2, 2)
+
+/*
+ * Hash Map Operations:
+ *   hash-map get assoc! dissoc! contains? count
+ *
+ * Notes:
+ *   Keys are numbers, strings or symbols, see AtomKey in hash_map.h. assoc!
+ *   and dissoc! modify the map in place, and return it. get returns the
+ *   default value (the empty list if not specified) if the key is missing.
+ *   count also accepts lists and vectors.
+ *     (define m (hash-map "a" 1 (quote b) 2))
+ *     (get m "a")             => 1
+ *     (get m "c" 0)           => 0
+ *     (assoc! m 3 4 5 6)      => m, with 4 entries now
+ *     (contains? m (quote b)) => true
+ *     (count m)               => 4
+ */
+PROC_DECLARATION_RANGE_MACRO(HashMap,     "hash-map",  "PrimProcHashMap{}",     0, UNLIMITED_OPS)
+PROC_DECLARATION_RANGE_MACRO(Get,         "get",       "PrimProcGet{}",         2, 3)
+PROC_DECLARATION_RANGE_MACRO(AssocBang,   "assoc!",    "PrimProcAssocBang{}",   3, UNLIMITED_OPS)
+PROC_DECLARATION_RANGE_MACRO(DissocBang,  "dissoc!",   "PrimProcDissocBang{}",  2, UNLIMITED_OPS)
+PROC_DECLARATION_RANGE_MACRO(Contains,    "contains?", "PrimProcContains{}",    2, 2)
+PROC_DECLARATION_RANGE_MACRO(Count,       "count",     "PrimProcCount{}",       1, 1)
+
+/*
+ * Persistent Map Operations:
+ *   persistent-map assoc dissoc
+ *
+ * Notes:
+ *   A persistent map is never modified, assoc and dissoc return new versions
+ *   sharing most of the structure with the original. get, contains? and
+ *   count accept persistent maps too.
+ *     (define base (persistent-map "a" 1 "b" 2))
+ *     (define derived (assoc base "c" 3))
+ *     (count base)                => 2
+ *     (count derived)             => 3
+ *     (get (dissoc base "a") "a") => ()
+ */
+PROC_DECLARATION_RANGE_MACRO(PersistentMap, "persistent-map", "PrimProcPersistentMap{}", 0, UNLIMITED_OPS)
+PROC_DECLARATION_RANGE_MACRO(Assoc,         "assoc",          "PrimProcAssoc{}",         3, UNLIMITED_OPS)
+PROC_DECLARATION_RANGE_MACRO(Dissoc,        "dissoc",         "PrimProcDissoc{}",        2, UNLIMITED_OPS)
+
+#undef UNLIMITED_OPS
+#undef PROC_DECLARATION_RANGE_MACRO
+
 #if 0
 // not
 static bool _prim_not(const MatterIF * operands, MatterIF &result);
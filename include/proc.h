@@ -19,7 +19,15 @@ namespace SolarWindLisp
 
 class Proc: public MatterIF
 {
+    friend class CycleCollector;
 public:
+    enum frame_kind_t
+    {
+        frame_unknown = 0,  // not analyzed yet
+        frame_stack,        // the body never captures its frame
+        frame_heap,
+    };
+
     matter_type_t matter_type() const
     {
         return matter_proc;
@@ -48,6 +56,21 @@ public:
         return true;
     }
 
+    /*
+     * Description:
+     *   Where the frames of this procedure are allocated, decided by the
+     *   interpreter when it is applied for the first time.
+     */
+    frame_kind_t frame_kind() const
+    {
+        return _frame_kind;
+    }
+
+    void set_frame_kind(frame_kind_t kind)
+    {
+        _frame_kind = kind;
+    }
+
     std::string debug_string(bool compact = true, int level = 0,
             const char * indent_seq = DEFAULT_INDENT_SEQ) const
     {
@@ -66,13 +89,14 @@ public:
 
 private:
     Proc(MatterPtr params, MatterPtr body, ScopedEnvPtr env) :
-            _params(params), _body(body), _env(env)
+            _params(params), _body(body), _env(env), _frame_kind(frame_unknown)
     {
     }
 
     MatterPtr _params;
     MatterPtr _body;
     ScopedEnvPtr _env;
+    frame_kind_t _frame_kind;
 };
 
 } // namespace SolarWindLisp
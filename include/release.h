@@ -0,0 +1,47 @@
+/* AUTO GENERATED, DO NOT EDIT */
+#ifndef _Brian_Yi_ZHANG_RELEASE_H_20261019_090521_
+#define _Brian_Yi_ZHANG_RELEASE_H_20261019_090521_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SVN_COMMIT_ID    "unknown"
+#define SVN_DIRTY        "unknown"
+#define GIT_COMMIT_ID    "gd0e64b4"
+#define GIT_DIRTY        "35"
+#define GIT_TAG          "v0.0.0-0-g0000000"
+#define BUILD_TIME       "2026-10-19 09:05:21 UTC"
+#define BUILD_HOST       "vm"
+#define BUILD_USER       ""
+#define BUILD_COPYRIGHT  "Copyright (C) 2012 Brian Yi ZHANG (brianlions@gmail.com)"
+
+__inline__ void print_release_info(
+        int ec = EXIT_SUCCESS,
+        const char * message = BUILD_COPYRIGHT)
+{
+  (void) fprintf(ec == 0 ? stdout : stderr,
+         "Release Info:\n"
+         "  svn commit id: %s\n"
+         "  svn dirty:     %s\n"
+         "  git tag:       %s\n"
+         "  git commit id: %s\n"
+         "  git dirty:     %s\n"
+         "  build time:    %s\n"
+         "  build on host: %s\n"
+         "  build by user: %s\n"
+         "\n"
+         "%s\n"
+         , SVN_COMMIT_ID
+         , SVN_DIRTY
+         , GIT_TAG
+         , GIT_COMMIT_ID
+         , GIT_DIRTY
+         , BUILD_TIME
+         , BUILD_HOST
+         , BUILD_USER
+         , message ? message : ""
+         );
+  exit(ec);
+}
+#endif /* _Brian_Yi_ZHANG_RELEASE_H_20261019_090521_ */
+
@@ -12,16 +12,32 @@
 #include <new>
 #include <map>
 #include "matter.h"
+#include "frame_stack.h"
 
 namespace SolarWindLisp
 {
 
 class ScopedEnv
 {
-    typedef std::map<std::string, MatterPtr>::iterator ITER;
-    typedef std::map<std::string, MatterPtr>::const_iterator CONST_ITER;
+    friend class CycleCollector;
+    friend class FrameStack;
+    typedef FrameStack::Allocator<std::pair<const std::string, MatterPtr> >
+            ALLOCATOR;
+    typedef std::map<std::string, MatterPtr, std::less<std::string>,
+            ALLOCATOR> BINDINGS;
+    typedef BINDINGS::iterator ITER;
+    typedef BINDINGS::const_iterator CONST_ITER;
 
 public:
+    // what may still add bindings to the env, see InterpreterIF::_flatten()
+    enum binds_t
+    {
+        binds_unknown = 0,  // anything
+        binds_code,         // the defines of the code evaluated in it
+        binds_let,          // the names and the defines of a `let' form
+        binds_none,
+    };
+
     static ScopedEnvPtr create(ScopedEnvPtr ext = NULL)
     {
         return ScopedEnvPtr(new (std::nothrow) ScopedEnv(ext));
@@ -49,9 +65,82 @@ public:
         return _external.get() ? _external->lookup(name, result) : false;
     }
 
+    /*
+     * Description:
+     *   Look up `name' in this env only, not in the external ones.
+     */
+    bool lookup_local(const std::string& name, MatterPtr &result) const
+    {
+        CONST_ITER it = _current.find(name);
+        if (it == _current.end()) {
+            return false;
+        }
+
+        result = it->second;
+        return true;
+    }
+
+    ScopedEnvPtr external() const
+    {
+        return _external;
+    }
+
+    size_t size() const
+    {
+        return _current.size();
+    }
+
+    /*
+     * Description:
+     *   `code' is evaluated in this env, and adds bindings to it by `kind'
+     *   only, until seal() is called, once nothing is evaluated in it any
+     *   more.
+     */
+    void set_code(const MatterPtr &code, binds_t kind)
+    {
+        _code = code;
+        _binds = kind;
+    }
+
+    void seal()
+    {
+        _code.reset();
+        _binds = binds_none;
+    }
+
+    binds_t binds() const
+    {
+        return _binds;
+    }
+
+    const MatterPtr & code() const
+    {
+        return _code;
+    }
+
+    /*
+     * Description:
+     *   Call `func(name, value, arg)' on every binding of this env, not of
+     *   the external ones, in the order of the names, stop when `func'
+     *   returns false.
+     */
+    void for_each(bool (*func)(const std::string &name,
+            const MatterPtr &value, void * arg), void * arg) const
+    {
+        for (CONST_ITER it = _current.begin(); it != _current.end(); ++it) {
+            if (!func(it->first, it->second, arg)) {
+                break;
+            }
+        }
+    }
+
+    /*
+     * Description:
+     *   Release all the references, used to break reference cycles, see
+     *   CycleCollector.
+     */
     void clear()
     {
-        // XXX remove circular reference
         for (ITER it = _current.begin(); it != _current.end(); ++it) {
             it->second.reset();
         }
@@ -64,13 +153,17 @@ public:
     }
 
 private:
-    ScopedEnv(ScopedEnvPtr ext = NULL) :
-            _external(ext)
+    ScopedEnv(ScopedEnvPtr ext = NULL, FrameStack * stack = NULL) :
+            _external(ext),
+            _current(std::less<std::string>(), ALLOCATOR(stack)),
+            _binds(binds_unknown)
     {
     }
 
     ScopedEnvPtr _external;
-    std::map<std::string, MatterPtr> _current;
+    BINDINGS _current;
+    MatterPtr _code;
+    binds_t _binds;
 };
 
 } // namespace SolarWindLisp
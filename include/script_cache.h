@@ -0,0 +1,102 @@
+/*
+ * file name:           include/script_cache.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 01:04:52 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_SCRIPT_CACHE_H_
+#define _SOLAR_WIND_LISP_SCRIPT_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "types.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * Precompiled scripts: the parsed forms of a script saved in a compact
+ * binary file (`.swlc') next to it, so the next process loads them without
+ * tokenizing or converting anything.
+ *
+ * A cache file has a header, a pool of the texts, the table of the distinct
+ * symbols, the pool of the distinct constants (numbers, booleans, strings),
+ * and the nodes of all the forms in postorder, each a 32-bit reference to a
+ * symbol or a constant, or a list with the number of its children. It is
+ * mapped into memory, and the forms are rebuilt in a single pass over the
+ * nodes with an explicit stack, one atom per distinct symbol or constant
+ * shared by all its occurrences, as atoms of the forms are never modified.
+ *
+ * The header keeps the length and a hash of the content of the script, the
+ * cache is used only if they match. It is in the byte order and the number
+ * formats of the machine which wrote it, the header tells them too, on any
+ * other machine the cache is stale. The whole cache has a hash of its own,
+ * and every offset and index is checked too, so a corrupted cache is stale,
+ * never trusted.
+ *
+ * Scripts run by InterpreterIF are cached only if enabled, see
+ * set_enabled(), so nothing is written next to a script unless asked for.
+ */
+class ScriptCache
+{
+public:
+    static const uint32_t VERSION = 1;
+
+    /*
+     * Description:
+     *   Whether the script files run by InterpreterIF (the REPL, and
+     *   load_script()) are loaded from and saved to their caches, for the
+     *   whole process. Disabled by default.
+     */
+    static void set_enabled(bool enabled);
+    static bool enabled();
+
+    /*
+     * Return value:
+     *   name of the cache of the script `filename', e.g. `rules.swlc' of
+     *   `rules.swl', other names get the suffix appended.
+     */
+    static std::string cache_filename(const char * filename);
+
+    /*
+     * Return value:
+     *   64-bit hash of the content of a script, at memory speed.
+     */
+    static uint64_t content_hash(const char * data, size_t length);
+
+    /*
+     * Description:
+     *   Save `forms', all parsed from `source', to the cache `filename'. It
+     *   is written to a temporary file first, and renamed, so a concurrent
+     *   reader sees the old cache or the new one, never a part of it.
+     *   Nothing is reported on error, a cache is an optimization only, e.g.
+     *   a script in a read-only directory is just not cached.
+     * Return value:
+     *   false on I/O error, or if a form is not made of atoms and lists.
+     */
+    static bool write(const char * filename, const char * source,
+            size_t source_length, const std::vector<MatterPtr> &forms);
+
+    /*
+     * Description:
+     *   Load the forms of `source' from the cache `filename', appended to
+     *   `forms'. The symbols are interned in `symbols' if not NULL, which
+     *   MUST live as long as the forms do.
+     * Return value:
+     *   false if there is no cache, or it is stale or corrupted, nothing is
+     *   appended then.
+     */
+    static bool load(const char * filename, const char * source,
+            size_t source_length, std::vector<MatterPtr> &forms,
+            SymbolTable * symbols = default_symbol_table());
+
+    static SymbolTable * default_symbol_table();
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_SCRIPT_CACHE_H_
@@ -11,28 +11,80 @@
 
 #include <stdio.h>
 #include <stddef.h>
+#include <sys/types.h>
+#include <string>
+#include <utility>
+#include <vector>
 #include "pretty_message.h"
+#include "structural_index.h"
 
 namespace SolarWindLisp
 {
 
+/*
+ * Splits a script into statements. Regular files are mapped into memory,
+ * pipes and terminals (e.g. stdin) are read with read(2) in large chunks
+ * into a buffer which grows when a statement does not fit.
+ *
+ * next_statement() returns views of the input without copying it.
+ * get_next_statement() is the original interface, it copies each statement
+ * into a buffer of the caller, removing the indentation of every line.
+ */
 class ScriptFileReader
 {
 public:
+    static const size_t READ_CHUNK_SIZE = 1024 * 1024;
+
     ScriptFileReader() :
-            _filename(NULL), _line_number(0), _filehandle(NULL), //
-            _line_buf(NULL), _line_buf_size(0), _line_buf_offset(0)
+            _filename(NULL), _line_number(0), _newlines(0), _fd(-1), //
+            _mapped(false), //
+            _data(NULL), _size(0), _pos(0), _buf(NULL), _buf_size(0), //
+            _end_of_input(false), _line(NULL), _line_length(0), //
+            _line_buf_offset(0)
     {
     }
 
     bool initialize(const char * filename = NULL);
+
+    /*
+     * Description:
+     *   Find the next statement, i.e. a balanced list, or an atom (or
+     *   atoms) ending at a newline. Spaces and `;' comments between the
+     *   statements are skipped, comment lines inside a list are removed.
+     *
+     * Return value:
+     *   length of the statement, and `*stmt' set to its first char, which is
+     *   not NUL terminated. It is a view of the input, or of a copy if
+     *   comment lines were removed, valid until the next call.
+     *   -1 at the end of input (see eof()), on an unmatched `)' which is
+     *   left unconsumed, or if the input ended inside a list.
+     */
+    ssize_t next_statement(const char ** stmt);
+
     ssize_t get_next_statement(char ** stmt_buf, ssize_t * stmt_buf_size);
 
+    /*
+     * Description:
+     *   Raw input for a streaming parser (see ParserIF::feed()): the rest of
+     *   a mapped file at once, or what the next read(2) returns.
+     *   `primary_prompt' selects the prompt printed before reading stdin.
+     *
+     * Return value:
+     *   length of the chunk, valid until the next call, 0 at the end of
+     *   input.
+     */
+    ssize_t next_chunk(const char ** chunk, bool primary_prompt = true);
+
     const char * filename() const
     {
         return _filename;
     }
 
+    /*
+     * Return value:
+     *   line number of the end of the last statement, or of the last line
+     *   read by get_next_statement().
+     */
     size_t line_number() const
     {
         return _line_number;
@@ -40,25 +92,21 @@ public:
 
     bool eof() const
     {
-        return feof(_filehandle);
+        return _end_of_input && _pos >= _size
+                && _line_buf_offset >= _line_length;
     }
 
-    ~ScriptFileReader()
+    bool is_mapped() const
     {
-        if (_filename) {
-            free(_filename);
-        }
-
-        if (_filehandle != stdin) {
-            fclose(_filehandle);
-        }
-
-        if (_line_buf) {
-            free(_line_buf);
-        }
+        return _mapped;
     }
 
+    ~ScriptFileReader();
+
 private:
+    ScriptFileReader(const ScriptFileReader &);
+    ScriptFileReader & operator=(const ScriptFileReader &);
+
     /*
      * Description:
      *   Save `c' into buffer `stmt_buf' at `offset', reallocate buffer if
@@ -69,18 +117,77 @@ private:
     int save_char(int c, char ** stmt_buf, ssize_t * stmt_buf_size,
             ssize_t * offset);
 
+    /*
+     * Description:
+     *   Save `n' chars at once, like save_char().
+     * Return value:
+     *   0 if OK, -1 on error.
+     */
+    int save_chars(const char * chars, size_t n, char ** stmt_buf,
+            ssize_t * stmt_buf_size, ssize_t * offset);
+
     /*
      * Return value:
      *   -1 on error, or next char from input stream.
      */
     int get_next_char(bool skip_comment, int num_left_paren);
 
+    enum scan_result_t
+    {
+        scan_done = 0,
+        scan_more,      // reached the end of the data read so far
+        scan_error,     // unmatched `)'
+    };
+
+    /*
+     * Description:
+     *   Scan the statement at `_pos', set `*start' and `*end' to its range,
+     *   and `*next' to where the following one may start. `*open' tells if
+     *   the statement is a list, which is not complete yet if scan_more is
+     *   returned.
+     */
+    scan_result_t _scan_statement(size_t * start, size_t * end,
+            size_t * next, bool * open);
+
+    /*
+     * Description:
+     *   Read more input, keeping everything from `_pos' on, the data read
+     *   so far may be moved.
+     * Return value:
+     *   false at the end of input, or on error, or if mapped.
+     */
+    bool _fill(bool primary_prompt);
+
+    /*
+     * Description:
+     *   Move on to `next', the current statement ends at `end'.
+     */
+    void _consume(size_t end, size_t next);
+
     char * _filename;
     size_t _line_number;
-    FILE * _filehandle;
-    char * _line_buf;
-    size_t _line_buf_size;
-    ssize_t _line_buf_offset;
+    size_t _newlines;   // before `_pos'
+    int _fd;
+    bool _mapped;
+
+    // the input read so far, `_pos' is where the next statement starts
+    const char * _data;
+    size_t _size;
+    size_t _pos;
+    char * _buf;        // of the chunked backend
+    size_t _buf_size;
+    bool _end_of_input;
+    StructuralIndex _index;     // of `_data'
+
+    // comment lines found in the current statement, and its copy without them
+    std::vector<std::pair<size_t, size_t> > _comments;
+    std::string _copy;
+
+    // the current line of get_next_statement()
+    const char * _line;
+    size_t _line_length;
+    size_t _line_buf_offset;
+    StructuralIndex _line_index;
 };
 
 } // namespace ScriptFileReader
@@ -13,10 +13,28 @@
 #include "matter.h"
 #include "expr.h"
 #include "future.h"
+#include "pair.h"
 #include "proc.h"
 #include "prim_proc.h"
+#include "native_proc.h"
+#include "vector.h"
+#include "vector_kernels.h"
+#include "batch_expr.h"
+#include "hash_map.h"
+#include "persistent_map.h"
 #include "scoped_env.h"
+#include "frame_stack.h"
+#include "prepared_expr.h"
+#include "cycle_collector.h"
+#include "structural_index.h"
+#include "symbol_table.h"
 #include "parser.h"
+#include "parallel_loader.h"
+#include "script_cache.h"
+#include "parse_cache.h"
+#include "heap_snapshot.h"
+#include "worker_pool.h"
+#include "interpreter_pool.h"
 #include "interpreter.h"
 #include "matter_factory.h"
 #include "utils.h"
@@ -0,0 +1,139 @@
+/*
+ * file name:           include/structural_index.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 23:52:16 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_STRUCTURAL_INDEX_H_
+#define _SOLAR_WIND_LISP_STRUCTURAL_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "vector_kernels.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * Locates the bytes meaningful to the tokenizer and the script reader, in
+ * the style of the first stage of simdjson: the input is classified 64 bytes
+ * at a time with SSE2 or AVX2 compares, into one bit mask per class, and the
+ * scanners jump from one interesting byte to the next with a count of
+ * trailing zeros, instead of testing every byte.
+ *
+ * Only the bytes are classified, the quoting and escaping rules are left to
+ * the scanners. Blocks are classified lazily, when find() or find_not()
+ * reaches them, so a scanner stopping early pays only for what it looked at.
+ */
+class StructuralIndex
+{
+public:
+    enum class_t
+    {
+        class_paren = 0,    // ( )
+        class_quote,        // ' " and the escape char
+        class_space,        // like isspace() in the C locale
+        class_newline,      // \r \n, also in class_space
+        class_comment,      // ;
+        NUM_OF_CLASSES
+    };
+
+    static const size_t BLOCK_SIZE = 64;
+
+    enum
+    {
+        PAREN = 1 << class_paren,
+        QUOTE = 1 << class_quote,
+        SPACE = 1 << class_space,
+        NEWLINE = 1 << class_newline,
+        COMMENT = 1 << class_comment,
+    };
+
+    /*
+     * Classify the 64 bytes at `block', bit i of `masks[k]' is set if byte i
+     * is of class k.
+     */
+    typedef void (*classify_func)(const char * block,
+            uint64_t masks[NUM_OF_CLASSES]);
+
+    /*
+     * Return value:
+     *   classifier of `isa' if supported, of the best one otherwise.
+     */
+    static classify_func classifier(
+            VectorKernels::isa_t isa = VectorKernels::NUM_OF_ISAS);
+
+    StructuralIndex(const char * input = NULL, size_t length = 0,
+            VectorKernels::isa_t isa = VectorKernels::NUM_OF_ISAS) :
+            _classify(classifier(isa))
+    {
+        reset(input, length);
+    }
+
+    void reset(const char * input, size_t length)
+    {
+        _input = input;
+        _length = length;
+        _base = static_cast<size_t>(-1);
+    }
+
+    /*
+     * Return value:
+     *   offset of the first byte at or after `from' of any of `classes' (a
+     *   combination of PAREN, QUOTE etc.), or the length of the input.
+     */
+    size_t find(size_t from, unsigned classes)
+    {
+        return _find(from, classes, 0);
+    }
+
+    /*
+     * Return value:
+     *   offset of the first byte at or after `from' of none of `classes', or
+     *   the length of the input.
+     */
+    size_t find_not(size_t from, unsigned classes)
+    {
+        return _find(from, classes, ~static_cast<uint64_t>(0));
+    }
+
+private:
+    size_t _find(size_t from, unsigned classes, uint64_t flip)
+    {
+        while (from < _length) {
+            size_t base = from & ~(BLOCK_SIZE - 1);
+            if (base != _base) {
+                _load(base);
+            }
+
+            uint64_t m = 0;
+            for (int k = 0; k < NUM_OF_CLASSES; ++k) {
+                if (classes & (1U << k)) {
+                    m |= _masks[k];
+                }
+            }
+            m = (m ^ flip) & (~static_cast<uint64_t>(0) << (from - base));
+            if (m) {
+                size_t found = base + __builtin_ctzll(m);
+                return found < _length ? found : _length;
+            }
+            from = base + BLOCK_SIZE;
+        }
+
+        return _length;
+    }
+
+    void _load(size_t base);
+
+    classify_func _classify;
+    const char * _input;
+    size_t _length;
+    size_t _base;   // offset of the block classified in `_masks'
+    uint64_t _masks[NUM_OF_CLASSES];
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_STRUCTURAL_INDEX_H_
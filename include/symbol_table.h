@@ -0,0 +1,98 @@
+/*
+ * file name:           include/symbol_table.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 23:58:41 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_SYMBOL_TABLE_H_
+#define _SOLAR_WIND_LISP_SYMBOL_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include <vector>
+
+namespace SolarWindLisp
+{
+
+/*
+ * Interned symbols: one copy of the text of every distinct name, shared by
+ * all the atoms of that name, so parsing a symbol seen before allocates
+ * nothing.
+ *
+ * Safe for concurrent insertion. The table is split into shards by the high
+ * bits of the hash, each with its own lock, so threads parsing different
+ * parts of a script rarely wait for each other. Every shard is an open
+ * addressing table like HashMap, and the texts are allocated from large
+ * blocks, which are never moved nor released before the table is.
+ */
+class SymbolTable
+{
+public:
+    static const size_t NUM_OF_SHARDS = 64;
+
+    /*
+     * Return value:
+     *   the table of the process, which is never destroyed, as the atoms
+     *   referring to it may live as long as the process.
+     */
+    static SymbolTable & global();
+
+    SymbolTable();
+    ~SymbolTable();
+
+    /*
+     * Description:
+     *   Find `text' of `length' bytes, which needs not be NUL terminated, or
+     *   add a copy of it.
+     * Return value:
+     *   the NUL terminated copy, valid as long as the table is, NULL if out
+     *   of memory.
+     */
+    const char * intern(const char * text, size_t length);
+
+    // number of distinct symbols
+    size_t size() const;
+
+    // memory used by the texts and the slots
+    size_t bytes() const;
+
+private:
+    SymbolTable(const SymbolTable &);
+    SymbolTable & operator=(const SymbolTable &);
+
+    static const size_t _MIN_CAPACITY = 64;
+    static const size_t _BLOCK_SIZE = 64 * 1024;
+
+    struct Shard
+    {
+        mutable std::mutex lock;
+        uint64_t * hashes;      // 0 marks an empty slot
+        const char ** texts;
+        uint32_t * lengths;
+        size_t size;
+        size_t capacity;
+        std::vector<char *> blocks;
+        size_t block_used;      // bytes of the last block
+        size_t bytes;
+
+        Shard() :
+                hashes(NULL), texts(NULL), lengths(NULL), size(0),
+                capacity(0), block_used(_BLOCK_SIZE), bytes(0)
+        {
+        }
+
+        const char * find_or_add(uint64_t hash, const char * text,
+                uint32_t length);
+        bool rehash(size_t capacity);
+        char * allocate(size_t n);
+    };
+
+    Shard _shards[NUM_OF_SHARDS];
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_SYMBOL_TABLE_H_
@@ -21,6 +21,11 @@ class PrimProcIF;
 class Proc;
 class Future;
 class ScopedEnv;
+class Pair;
+class Vector;
+class HashMap;
+class PersistentMap;
+class SymbolTable;
 
 typedef boost::shared_ptr<MatterIF> MatterPtr;
 typedef boost::shared_ptr<Atom> AtomPtr;
@@ -29,6 +34,10 @@ typedef boost::shared_ptr<Proc> ProcPtr;
 typedef boost::shared_ptr<Future> FuturePtr;
 typedef boost::shared_ptr<PrimProcIF> PrimProcPtr;
 typedef boost::shared_ptr<ScopedEnv> ScopedEnvPtr;
+typedef boost::shared_ptr<Pair> PairPtr;
+typedef boost::shared_ptr<Vector> VectorPtr;
+typedef boost::shared_ptr<HashMap> HashMapPtr;
+typedef boost::shared_ptr<PersistentMap> PersistentMapPtr;
 
 } // namespace SolarWindLisp
 
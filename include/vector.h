@@ -0,0 +1,120 @@
+/*
+ * file name:           include/vector.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 16:25:09 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_VECTOR_H_
+#define _SOLAR_WIND_LISP_VECTOR_H_
+
+#include <stdint.h>
+#include "matter.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * A packed, homogeneous array of numbers (all int64_t or all double). The
+ * elements are stored contiguously and aligned to VECTOR_ALIGNMENT bytes, so
+ * the kernels in vector_kernels.h can process them with SIMD instructions.
+ *
+ * A vector is filled right after creation, and never modified once it is
+ * visible to scripts, primitives always return new vectors.
+ */
+class Vector: public MatterIF
+{
+public:
+    enum elem_type_t
+    {
+        elem_i64 = 0,
+        elem_double,
+    };
+
+    static const size_t VECTOR_ALIGNMENT = 32;
+
+    matter_type_t matter_type() const
+    {
+        return matter_vector;
+    }
+
+    /*
+     * Description:
+     *   Create a vector of `size' elements, all of them are 0.
+     */
+    static VectorPtr create(elem_type_t elem_type, size_t size);
+
+    elem_type_t elem_type() const
+    {
+        return _elem_type;
+    }
+
+    bool is_i64() const
+    {
+        return _elem_type == elem_i64;
+    }
+
+    bool is_double() const
+    {
+        return _elem_type == elem_double;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    int64_t * i64_data()
+    {
+        return static_cast<int64_t *>(_data);
+    }
+
+    const int64_t * i64_data() const
+    {
+        return static_cast<const int64_t *>(_data);
+    }
+
+    double * double_data()
+    {
+        return static_cast<double *>(_data);
+    }
+
+    const double * double_data() const
+    {
+        return static_cast<const double *>(_data);
+    }
+
+    /*
+     * Description:
+     *   Element at `idx' converted to double, `idx' is not checked.
+     */
+    double as_double(size_t idx) const
+    {
+        return is_i64() ? static_cast<double>(i64_data()[idx])
+                : double_data()[idx];
+    }
+
+    std::string debug_string(bool compact = true, int level = 0,
+            const char * indent_seq = DEFAULT_INDENT_SEQ) const;
+    std::string to_string() const;
+
+    virtual ~Vector();
+
+private:
+    Vector(elem_type_t elem_type) :
+            _elem_type(elem_type), _size(0), _data(NULL)
+    {
+    }
+
+    Vector(const Vector &);
+    Vector & operator=(const Vector &);
+
+    elem_type_t _elem_type;
+    size_t _size;
+    void * _data;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_VECTOR_H_
@@ -0,0 +1,106 @@
+/*
+ * file name:           include/vector_kernels.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 16:25:09 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_VECTOR_KERNELS_H_
+#define _SOLAR_WIND_LISP_VECTOR_KERNELS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace SolarWindLisp
+{
+
+/*
+ * Reduction and element-wise kernels over packed arrays, there is one table
+ * for each instruction set, the best one supported by the CPU is selected at
+ * runtime. Reductions over empty arrays return 0, min/max MUST NOT be called
+ * with empty arrays. Every version returns the same results, 64-bit integers
+ * wrap around on overflow, min/max of doubles return the first NaN of the
+ * array if there is any.
+ */
+struct VectorKernels
+{
+    enum isa_t
+    {
+        isa_scalar = 0,
+        isa_sse2,
+        isa_avx2,
+        NUM_OF_ISAS
+    };
+
+    enum cmp_op_t
+    {
+        cmp_eq = 0,
+        cmp_ne,
+        cmp_lt,
+        cmp_le,
+        cmp_gt,
+        cmp_ge,
+        NUM_OF_CMP_OPS
+    };
+
+    static const char * isa_name(isa_t isa);
+
+    /*
+     * Return value:
+     *   the best instruction set supported by this CPU, detected only once.
+     */
+    static isa_t best_isa();
+
+    static bool is_supported(isa_t isa)
+    {
+        return isa <= best_isa();
+    }
+
+    /*
+     * Return value:
+     *   kernels of `isa' if supported, kernels of best_isa() otherwise.
+     */
+    static const VectorKernels & get(isa_t isa = NUM_OF_ISAS);
+
+    isa_t isa;
+
+    int64_t (*sum_i64)(const int64_t * a, size_t n);
+    double (*sum_f64)(const double * a, size_t n);
+    int64_t (*dot_i64)(const int64_t * a, const int64_t * b, size_t n);
+    double (*dot_f64)(const double * a, const double * b, size_t n);
+    int64_t (*min_i64)(const int64_t * a, size_t n);
+    double (*min_f64)(const double * a, size_t n);
+    int64_t (*max_i64)(const int64_t * a, size_t n);
+    double (*max_f64)(const double * a, size_t n);
+
+    // out[i] = a[i] + b[i]
+    void (*add_i64)(const int64_t * a, const int64_t * b, int64_t * out,
+            size_t n);
+    void (*add_f64)(const double * a, const double * b, double * out,
+            size_t n);
+    // out[i] = a[i] * k
+    void (*scale_i64)(const int64_t * a, int64_t k, int64_t * out, size_t n);
+    void (*scale_f64)(const double * a, double k, double * out, size_t n);
+
+    // out[i] = a[i] - b[i], a[i] * b[i], a[i] / b[i], `out' may be `a' or `b'
+    void (*sub_i64)(const int64_t * a, const int64_t * b, int64_t * out,
+            size_t n);
+    void (*sub_f64)(const double * a, const double * b, double * out,
+            size_t n);
+    void (*mul_i64)(const int64_t * a, const int64_t * b, int64_t * out,
+            size_t n);
+    void (*mul_f64)(const double * a, const double * b, double * out,
+            size_t n);
+    void (*div_f64)(const double * a, const double * b, double * out,
+            size_t n);
+    // out[i] = a[i] `op' b[i], 1 or 0, NaN is not equal to anything
+    void (*cmp_i64)(const int64_t * a, const int64_t * b, cmp_op_t op,
+            uint8_t * out, size_t n);
+    void (*cmp_f64)(const double * a, const double * b, cmp_op_t op,
+            uint8_t * out, size_t n);
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_VECTOR_KERNELS_H_
@@ -0,0 +1,139 @@
+/*
+ * file name:           include/worker_pool.h
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 03:05:41 2026 CST
+ */
+
+#ifndef _SOLAR_WIND_LISP_WORKER_POOL_H_
+#define _SOLAR_WIND_LISP_WORKER_POOL_H_
+
+#include <signal.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <string>
+#include <vector>
+
+namespace SolarWindLisp
+{
+
+class InterpreterIF;
+
+/*
+ * Pre-initialized worker processes: the interpreter is initialized once,
+ * prelude and scripts included, and start() forks the workers, which share
+ * its heap copy-on-write, instead of building everything again in every
+ * process. The parent only dispatches the requests to the idle workers, over
+ * a socket pair each, and never executes anything itself, so its heap stays
+ * as forked.
+ *
+ * Every request is executed by one of the workers, the definitions it makes
+ * stay in that worker, and are not seen by the others. A worker which dies is
+ * forked again from the parent, as initialized, its request fails.
+ *
+ * Sharing is page by page, and the reference counts are written to whenever
+ * a pointer is copied, even by a lookup, so the pages of the objects used
+ * are soon copied in every worker, see HeapSnapshot::freeze() and
+ * InterpreterIF::freeze() to keep them shared.
+ *
+ * Responses are lines too: `ok', followed by a space and the value of the
+ * last form if there is one, or `error' and the reason, new lines and
+ * backslashes in them escaped as `\n' and `\\'.
+ */
+class WorkerPool
+{
+public:
+    /*
+     * Description:
+     *   `workers' 0 for the number of CPUs. `interpreter' MUST be initialized
+     *   before start(), and live as long as the pool does.
+     */
+    explicit WorkerPool(InterpreterIF * interpreter, size_t workers = 0);
+    ~WorkerPool();
+
+    /*
+     * Description:
+     *   Fork the workers, MUST be called before any other thread is created,
+     *   like every fork().
+     * Return value:
+     *   false if already started, or if a worker cannot be forked, the ones
+     *   forked are stopped then.
+     */
+    bool start();
+
+    /*
+     * Description:
+     *   Stop the workers, the ones busy are killed.
+     */
+    void stop();
+
+    /*
+     * Description:
+     *   Execute all the `requests', one expression or more each, on the
+     *   workers, in parallel.
+     * Return value:
+     *   false if the workers are not started, otherwise the `responses' are
+     *   in the order of the requests.
+     */
+    bool execute(const std::vector<std::string> &requests,
+            std::vector<std::string> &responses);
+
+    /*
+     * Description:
+     *   Listen on the Unix socket `path', which is replaced if it exists,
+     *   every line a client sends is a request, and gets one line back, in
+     *   the order of the requests of the client, blank lines excepted.
+     *   Returns when `*stopped' is set (e.g. by a signal handler), after the
+     *   requests being executed are done, and the socket is removed.
+     * Return value:
+     *   false if the workers are not started, or on error.
+     */
+    bool serve(const char * path,
+            const volatile sig_atomic_t * stopped = NULL);
+
+    size_t workers() const
+    {
+        return _size;
+    }
+
+    pid_t worker_pid(size_t index) const
+    {
+        return index < _workers.size() ? _workers[index].pid : -1;
+    }
+
+    // poll() timeout, to check `*stopped' of serve()
+    static const int POLL_TIMEOUT_MS = 100;
+    // requests longer are refused, the client is disconnected
+    static const size_t MAX_REQUEST_SIZE = 16 * 1024 * 1024;
+
+private:
+    WorkerPool(const WorkerPool &);
+    WorkerPool & operator=(const WorkerPool &);
+
+    struct Worker
+    {
+        pid_t pid;
+        int fd;
+    };
+
+    struct Dispatch;
+
+    /*
+     * Description:
+     *   Fork the worker `index', which closes the descriptors of the parent,
+     *   the ones in `inherited' too.
+     */
+    bool _spawn(size_t index, const std::vector<int> &inherited);
+    void _reap(size_t index);
+    void _work(int fd);
+    bool _dispatch(Dispatch &dispatch);
+
+    InterpreterIF * _interpreter;
+    size_t _size;
+    std::vector<Worker> _workers;
+};
+
+} // namespace SolarWindLisp
+
+#endif // _SOLAR_WIND_LISP_WORKER_POOL_H_
@@ -0,0 +1,829 @@
+/*
+ * file name:           src/batch_expr.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 07:26:50 2026 CST
+ */
+
+#include <string.h>
+#include <new>
+#include "batch_expr.h"
+#include "interpreter.h"
+#include "expr.h"
+#include "prim_proc.h"
+#include "vector_kernels.h"
+#include "pretty_message.h"
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+// the values of a node for the rows of a chunk, in its own buffers, or in
+// the ones of the columns
+struct Chunk
+{
+    Column::column_type_t type;
+    const int64_t * i64;
+    const double * f64;
+    const uint8_t * b;
+    const std::string * const * s;
+    // NULL if all the rows are valid
+    const uint8_t * valid;
+};
+
+bool is_number(Column::column_type_t type)
+{
+    return type != Column::column_string;
+}
+
+} // namespace
+
+struct BatchExpr::Node
+{
+    enum kind_t
+    {
+        node_const = 0,
+        node_column,
+        node_add,
+        node_sub,
+        node_mul,
+        node_div,
+        node_cmp,
+        node_not,
+        node_and,
+        node_or,
+        node_xor,
+        node_if,
+    };
+
+    explicit Node(kind_t k) :
+            kind(k), op(VectorKernels::cmp_eq), column(0),
+            type(Column::column_i64), const_i64(0), const_f64(0)
+    {
+    }
+
+    ~Node()
+    {
+        for (size_t i = 0; i < args.size(); ++i) {
+            delete args[i];
+        }
+    }
+
+    kind_t kind;
+    VectorKernels::cmp_op_t op;
+    std::vector<Node *> args;
+    size_t column;
+
+    // of the values, decided by evaluate(), before the constants
+    Column::column_type_t type;
+    int64_t const_i64;
+    double const_f64;
+    std::string const_str;
+
+    // CHUNK_ROWS each, the ones needed by `kind' and `type'
+    std::vector<int64_t> i64;
+    std::vector<double> f64;
+    std::vector<uint8_t> b;
+    std::vector<const std::string *> s;
+    // an argument converted, or its truth values
+    std::vector<int64_t> conv_i64;
+    std::vector<double> conv_f64;
+    std::vector<uint8_t> truth;
+    std::vector<uint8_t> valid;
+};
+
+namespace
+{
+
+typedef BatchExpr::Node Node;
+
+/*
+ * Description:
+ *   Decide the types of `node' and of its arguments for `columns', and
+ *   allocate the buffers of the chunks.
+ */
+bool decide_types(Node * node, const std::vector<Column> &columns)
+{
+    for (size_t i = 0; i < node->args.size(); ++i) {
+        if (!decide_types(node->args[i], columns)) {
+            return false;
+        }
+    }
+
+    const size_t rows = BatchExpr::CHUNK_ROWS;
+    const std::vector<Node *> &args = node->args;
+    bool reals = false;
+    switch (node->kind) {
+        case Node::node_const:
+            // filled once, every chunk the same
+            node->i64.assign(rows, node->const_i64);
+            node->f64.assign(rows, node->const_f64);
+            node->b.assign(rows, node->const_i64 != 0);
+            node->s.assign(rows, &node->const_str);
+            return true;
+        case Node::node_column:
+            node->type = columns[node->column].type;
+            if (node->type == Column::column_string) {
+                node->s.resize(rows);
+            }
+            return true;
+        case Node::node_add:
+        case Node::node_sub:
+        case Node::node_mul:
+        case Node::node_div:
+            for (size_t i = 0; i < args.size(); ++i) {
+                if (!is_number(args[i]->type)) {
+                    PRETTY_MESSAGE(stderr, "operand is not numeric");
+                    return false;
+                }
+                reals = reals || args[i]->type == Column::column_double;
+            }
+            if (node->kind == Node::node_div || reals) {
+                node->type = Column::column_double;
+                node->f64.resize(rows);
+                node->conv_f64.resize(rows);
+            }
+            else {
+                node->type = Column::column_i64;
+                node->i64.resize(rows);
+                node->conv_i64.resize(rows);
+            }
+            node->valid.resize(rows);
+            return true;
+        case Node::node_cmp:
+            if (!is_number(args[0]->type) || !is_number(args[1]->type)) {
+                PRETTY_MESSAGE(stderr, "operand is not numeric");
+                return false;
+            }
+            node->type = Column::column_bool;
+            node->b.resize(rows);
+            node->conv_i64.resize(rows);
+            node->conv_f64.resize(rows);
+            node->i64.resize(rows);
+            node->f64.resize(rows);
+            node->valid.resize(rows);
+            return true;
+        case Node::node_not:
+        case Node::node_and:
+        case Node::node_or:
+        case Node::node_xor:
+            node->type = Column::column_bool;
+            node->b.resize(rows);
+            node->truth.resize(rows);
+            node->valid.resize(rows);
+            return true;
+        case Node::node_if:
+            if (args[1]->type == args[2]->type) {
+                node->type = args[1]->type;
+            }
+            else if ((args[1]->type == Column::column_i64
+                    || args[1]->type == Column::column_double)
+                    && (args[2]->type == Column::column_i64
+                    || args[2]->type == Column::column_double)) {
+                node->type = Column::column_double;
+            }
+            else {
+                PRETTY_MESSAGE(stderr, "branches of different types");
+                return false;
+            }
+            node->i64.resize(rows);
+            node->f64.resize(rows);
+            node->b.resize(rows);
+            node->s.resize(rows);
+            node->truth.resize(rows);
+            node->conv_f64.resize(rows);
+            node->valid.resize(rows);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// `chunk' as integers, booleans converted into `buffer'
+const int64_t * as_i64(const Chunk &chunk, int64_t * buffer, size_t n)
+{
+    if (chunk.type == Column::column_i64) {
+        return chunk.i64;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        buffer[i] = chunk.b[i];
+    }
+    return buffer;
+}
+
+// `chunk' as reals, integers and booleans converted into `buffer'
+const double * as_f64(const Chunk &chunk, double * buffer, size_t n)
+{
+    if (chunk.type == Column::column_double) {
+        return chunk.f64;
+    }
+    if (chunk.type == Column::column_i64) {
+        for (size_t i = 0; i < n; ++i) {
+            buffer[i] = static_cast<double>(chunk.i64[i]);
+        }
+    }
+    else {
+        for (size_t i = 0; i < n; ++i) {
+            buffer[i] = chunk.b[i];
+        }
+    }
+    return buffer;
+}
+
+// truth values of `chunk', like `if' takes them
+void truth_of(const Chunk &chunk, uint8_t * out, size_t n)
+{
+    switch (chunk.type) {
+        case Column::column_i64:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = chunk.i64[i] != 0;
+            }
+            break;
+        case Column::column_double:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = chunk.f64[i] != 0;
+            }
+            break;
+        case Column::column_bool:
+            memcpy(out, chunk.b, n);
+            break;
+        default:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = !chunk.s[i]->empty();
+            }
+            break;
+    }
+}
+
+// valid[i] &= `chunk' valid, `valid' NULL before the first one which may
+// be invalid
+void and_valid(const Chunk &chunk, Node * node, uint8_t * &valid, size_t n)
+{
+    if (!chunk.valid) {
+        return;
+    }
+    if (!valid) {
+        valid = &node->valid[0];
+        memcpy(valid, chunk.valid, n);
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        valid[i] &= chunk.valid[i];
+    }
+}
+
+uint8_t * all_valid(Node * node, size_t n)
+{
+    memset(&node->valid[0], 1, n);
+    return &node->valid[0];
+}
+
+/*
+ * Description:
+ *   Evaluate `node' for the rows [`row', `row' + `n') of `columns'.
+ */
+Chunk evaluate_chunk(Node * node, const std::vector<Column> &columns,
+        size_t row, size_t n, const VectorKernels &k)
+{
+    Chunk out;
+    memset(&out, 0, sizeof(out));
+    out.type = node->type;
+    const std::vector<Node *> &args = node->args;
+    uint8_t * valid = NULL;
+
+    switch (node->kind) {
+        case Node::node_const:
+            out.i64 = &node->i64[0];
+            out.f64 = &node->f64[0];
+            out.b = &node->b[0];
+            out.s = &node->s[0];
+            break;
+
+        case Node::node_column:
+        {
+            const Column &c = columns[node->column];
+            switch (c.type) {
+                case Column::column_i64:
+                    out.i64 = c.i64() + row;
+                    break;
+                case Column::column_double:
+                    out.f64 = c.f64() + row;
+                    break;
+                case Column::column_bool:
+                    out.b = reinterpret_cast<const uint8_t *>(c.bools() + row);
+                    break;
+                default:
+                    for (size_t i = 0; i < n; ++i) {
+                        node->s[i] = c.strings() + row + i;
+                    }
+                    out.s = &node->s[0];
+                    break;
+            }
+            break;
+        }
+
+        case Node::node_add:
+        case Node::node_sub:
+        case Node::node_mul:
+        case Node::node_div:
+        {
+            bool reals = node->type == Column::column_double;
+            int64_t * ri = reals ? NULL : &node->i64[0];
+            double * rf = reals ? &node->f64[0] : NULL;
+            for (size_t a = 0; a < args.size(); ++a) {
+                Chunk arg = evaluate_chunk(args[a], columns, row, n, k);
+                and_valid(arg, node, valid, n);
+                if (reals) {
+                    const double * x = as_f64(arg, &node->conv_f64[0], n);
+                    if (node->kind == Node::node_div
+                            && (a || args.size() == 1)) {
+                        // divided by 0
+                        if (!valid) {
+                            valid = all_valid(node, n);
+                        }
+                        for (size_t i = 0; i < n; ++i) {
+                            valid[i] &= x[i] != 0;
+                        }
+                    }
+                    if (!a && args.size() > 1) {
+                        memcpy(rf, x, n * sizeof(double));
+                        continue;
+                    }
+                    if (!a) {
+                        // alone, negated or inverted
+                        for (size_t i = 0; i < n; ++i) {
+                            rf[i] = node->kind == Node::node_sub ? -x[i]
+                                    : node->kind == Node::node_div
+                                    ? 1.0 / x[i] : x[i];
+                        }
+                        continue;
+                    }
+                    switch (node->kind) {
+                        case Node::node_add:
+                            k.add_f64(rf, x, rf, n);
+                            break;
+                        case Node::node_sub:
+                            k.sub_f64(rf, x, rf, n);
+                            break;
+                        case Node::node_mul:
+                            k.mul_f64(rf, x, rf, n);
+                            break;
+                        default:
+                            k.div_f64(rf, x, rf, n);
+                            break;
+                    }
+                }
+                else {
+                    const int64_t * x = as_i64(arg, &node->conv_i64[0], n);
+                    if (!a) {
+                        for (size_t i = 0; i < n; ++i) {
+                            ri[i] = node->kind == Node::node_sub
+                                    && args.size() == 1 ? -x[i] : x[i];
+                        }
+                        continue;
+                    }
+                    switch (node->kind) {
+                        case Node::node_add:
+                            k.add_i64(ri, x, ri, n);
+                            break;
+                        case Node::node_sub:
+                            k.sub_i64(ri, x, ri, n);
+                            break;
+                        default:
+                            k.mul_i64(ri, x, ri, n);
+                            break;
+                    }
+                }
+            }
+            out.i64 = ri;
+            out.f64 = rf;
+            break;
+        }
+
+        case Node::node_cmp:
+        {
+            Chunk x = evaluate_chunk(args[0], columns, row, n, k);
+            and_valid(x, node, valid, n);
+            Chunk y = evaluate_chunk(args[1], columns, row, n, k);
+            and_valid(y, node, valid, n);
+            if (x.type == Column::column_double
+                    || y.type == Column::column_double) {
+                k.cmp_f64(as_f64(x, &node->f64[0], n),
+                        as_f64(y, &node->conv_f64[0], n), node->op,
+                        &node->b[0], n);
+            }
+            else {
+                k.cmp_i64(as_i64(x, &node->i64[0], n),
+                        as_i64(y, &node->conv_i64[0], n), node->op,
+                        &node->b[0], n);
+            }
+            out.b = &node->b[0];
+            break;
+        }
+
+        case Node::node_not:
+        case Node::node_and:
+        case Node::node_or:
+        case Node::node_xor:
+        {
+            uint8_t * r = &node->b[0];
+            uint8_t * t = &node->truth[0];
+            Chunk x = evaluate_chunk(args[0], columns, row, n, k);
+            truth_of(x, r, n);
+            if (node->kind == Node::node_not) {
+                for (size_t i = 0; i < n; ++i) {
+                    r[i] = !r[i];
+                }
+                out.b = r;
+                out.valid = x.valid;
+                return out;
+            }
+
+            Chunk y = evaluate_chunk(args[1], columns, row, n, k);
+            truth_of(y, t, n);
+            // the second one only matters if it is evaluated
+            if (x.valid || y.valid) {
+                valid = all_valid(node, n);
+                for (size_t i = 0; i < n; ++i) {
+                    bool needed = node->kind == Node::node_xor
+                            || (node->kind == Node::node_and ? r[i] : !r[i]);
+                    valid[i] = (!x.valid || x.valid[i])
+                            && (!needed || !y.valid || y.valid[i]);
+                }
+            }
+            for (size_t i = 0; i < n; ++i) {
+                r[i] = node->kind == Node::node_and ? r[i] & t[i]
+                        : node->kind == Node::node_or ? r[i] | t[i]
+                        : r[i] ^ t[i];
+            }
+            out.b = r;
+            break;
+        }
+
+        case Node::node_if:
+        {
+            uint8_t * t = &node->truth[0];
+            Chunk p = evaluate_chunk(args[0], columns, row, n, k);
+            truth_of(p, t, n);
+            Chunk c = evaluate_chunk(args[1], columns, row, n, k);
+            Chunk a = evaluate_chunk(args[2], columns, row, n, k);
+            if (p.valid || c.valid || a.valid) {
+                valid = all_valid(node, n);
+                for (size_t i = 0; i < n; ++i) {
+                    const uint8_t * v = t[i] ? c.valid : a.valid;
+                    valid[i] = (!p.valid || p.valid[i]) && (!v || v[i]);
+                }
+            }
+            switch (node->type) {
+                case Column::column_i64:
+                    for (size_t i = 0; i < n; ++i) {
+                        node->i64[i] = t[i] ? c.i64[i] : a.i64[i];
+                    }
+                    out.i64 = &node->i64[0];
+                    break;
+                case Column::column_double:
+                {
+                    const double * cf = as_f64(c, &node->f64[0], n);
+                    const double * af = as_f64(a, &node->conv_f64[0], n);
+                    for (size_t i = 0; i < n; ++i) {
+                        node->f64[i] = t[i] ? cf[i] : af[i];
+                    }
+                    out.f64 = &node->f64[0];
+                    break;
+                }
+                case Column::column_bool:
+                    for (size_t i = 0; i < n; ++i) {
+                        node->b[i] = t[i] ? c.b[i] : a.b[i];
+                    }
+                    out.b = &node->b[0];
+                    break;
+                default:
+                    for (size_t i = 0; i < n; ++i) {
+                        node->s[i] = t[i] ? c.s[i] : a.s[i];
+                    }
+                    out.s = &node->s[0];
+                    break;
+            }
+            break;
+        }
+    }
+
+    out.valid = valid;
+    return out;
+}
+
+} // namespace
+
+Column BatchResult::column() const
+{
+    switch (type) {
+        case Column::column_i64:
+            return Column(i64.empty() ? NULL : &i64[0], rows);
+        case Column::column_double:
+            return Column(f64.empty() ? NULL : &f64[0], rows);
+        case Column::column_bool:
+            return Column(bools.empty() ? NULL
+                    : reinterpret_cast<const bool *>(&bools[0]), rows);
+        default:
+            return Column(strings.empty() ? NULL : &strings[0], rows);
+    }
+}
+
+BatchExpr::BatchExpr() :
+        _root(NULL), _columns(0)
+{
+}
+
+BatchExpr::~BatchExpr()
+{
+    delete _root;
+}
+
+bool BatchExpr::compile(InterpreterIF * interpreter, const char * str,
+        const std::vector<std::string> &names, ssize_t len)
+{
+    delete _root;
+    _root = NULL;
+    _columns = 0;
+    if (!interpreter || !interpreter->parser() || !interpreter->env()) {
+        return false;
+    }
+
+    MatterPtr forms = interpreter->parser()->parse(str, len);
+    if (!forms || !forms->is_composite_expr()
+            || static_cast<const CompositeExpr *>(forms.get())->size() != 1) {
+        PRETTY_MESSAGE(stderr, "not one form");
+        return false;
+    }
+
+    _root = _compile((*static_cast<const CompositeExpr *>(forms.get()))[0],
+            interpreter, names);
+    _columns = names.size();
+    return _root != NULL;
+}
+
+BatchExpr::Node * BatchExpr::_compile(const MatterPtr &form,
+        InterpreterIF * interpreter, const std::vector<std::string> &names)
+{
+    if (form->is_atom()) {
+        const Atom * atom = static_cast<const Atom *>(form.get());
+        MatterPtr value = form;
+        if (atom->is_cstr() && !atom->is_quoted_cstr()) {
+            std::string name(atom->to_cstr(), atom->cstr_length());
+            for (size_t i = 0; i < names.size(); ++i) {
+                if (names[i] == name) {
+                    Node * node = new (std::nothrow) Node(Node::node_column);
+                    if (node) {
+                        node->column = i;
+                    }
+                    return node;
+                }
+            }
+            // a constant of the global env
+            if (!interpreter->env()->lookup(name, value)
+                    || !value || !value->is_atom()) {
+                PRETTY_MESSAGE(stderr, "`%s' is not a column nor an atom",
+                        name.c_str());
+                return NULL;
+            }
+            atom = static_cast<const Atom *>(value.get());
+            if (atom->is_cstr() && !atom->is_quoted_cstr()) {
+                return NULL;
+            }
+        }
+
+        Node * node = new (std::nothrow) Node(Node::node_const);
+        if (!node) {
+            return NULL;
+        }
+        bool ok = true;
+        if (atom->is_bool()) {
+            bool v = false;
+            ok = atom->to_bool(v);
+            node->type = Column::column_bool;
+            node->const_i64 = v;
+        }
+        else if (atom->is_integer()) {
+            ok = atom->to_i64(node->const_i64);
+            node->type = Column::column_i64;
+        }
+        else if (atom->is_real()) {
+            ok = atom->to_double(node->const_f64);
+            node->type = Column::column_double;
+        }
+        else if (atom->is_quoted_cstr()) {
+            node->const_str.assign(atom->to_cstr(), atom->cstr_length());
+            node->const_i64 = !node->const_str.empty();
+            node->type = Column::column_string;
+        }
+        else {
+            ok = false;
+        }
+        if (!ok) {
+            delete node;
+            return NULL;
+        }
+        return node;
+    }
+
+    if (!form->is_composite_expr()) {
+        return NULL;
+    }
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(form.get());
+    if (!ce->size() || !(*ce)[0]->is_atom()) {
+        return NULL;
+    }
+    const Atom * head = static_cast<const Atom *>((*ce)[0].get());
+    if (!head->is_cstr() || head->is_quoted_cstr()) {
+        return NULL;
+    }
+    std::string name(head->to_cstr(), head->cstr_length());
+    size_t argc = ce->size() - 1;
+
+    static const struct
+    {
+        const char * name;
+        Node::kind_t kind;
+        VectorKernels::cmp_op_t op;
+        // number of arguments, 0 for one or more
+        size_t argc;
+        bool prim;
+    } ops[] = {
+        { "if",  Node::node_if,  VectorKernels::cmp_eq, 3, false },
+        { "+",   Node::node_add, VectorKernels::cmp_eq, 0, true },
+        { "-",   Node::node_sub, VectorKernels::cmp_eq, 0, true },
+        { "*",   Node::node_mul, VectorKernels::cmp_eq, 0, true },
+        { "/",   Node::node_div, VectorKernels::cmp_eq, 0, true },
+        { "=",   Node::node_cmp, VectorKernels::cmp_eq, 2, true },
+        { "!=",  Node::node_cmp, VectorKernels::cmp_ne, 2, true },
+        { "<",   Node::node_cmp, VectorKernels::cmp_lt, 2, true },
+        { "<=",  Node::node_cmp, VectorKernels::cmp_le, 2, true },
+        { ">",   Node::node_cmp, VectorKernels::cmp_gt, 2, true },
+        { ">=",  Node::node_cmp, VectorKernels::cmp_ge, 2, true },
+        { "inc", Node::node_add, VectorKernels::cmp_eq, 1, false },
+        { "dec", Node::node_sub, VectorKernels::cmp_eq, 1, false },
+        { "not", Node::node_not, VectorKernels::cmp_eq, 1, false },
+        { "and", Node::node_and, VectorKernels::cmp_eq, 2, false },
+        { "or",  Node::node_or,  VectorKernels::cmp_eq, 2, false },
+        { "xor", Node::node_xor, VectorKernels::cmp_eq, 2, false },
+    };
+    size_t i = 0;
+    while (i < array_size(ops) && name != ops[i].name) {
+        ++i;
+    }
+    if (i == array_size(ops) || (ops[i].argc ? argc != ops[i].argc : !argc)) {
+        PRETTY_MESSAGE(stderr, "`%s' cannot be evaluated in batch",
+                name.c_str());
+        return NULL;
+    }
+    for (size_t c = 0; c < names.size(); ++c) {
+        if (names[c] == name) {
+            return NULL;
+        }
+    }
+
+    // `if' is a special form, the others MUST be the builtin ones
+    if (ops[i].kind != Node::node_if) {
+        MatterPtr value = NULL;
+        MatterPtr builtin = NULL;
+        if (!interpreter->env()->lookup(name, value) || !value) {
+            return NULL;
+        }
+        if (ops[i].prim) {
+            // a primitive procedure of the same name, maybe of an env of
+            // its own, see InterpreterIF::create_builtin_env()
+            if (!value->is_prim_proc() || static_cast<PrimProcIF *>(
+                    value.get())->name() != name) {
+                return NULL;
+            }
+        }
+        else if (!InterpreterIF::builtin_env()->lookup_local(name, builtin)
+                || builtin != value) {
+            return NULL;
+        }
+    }
+
+    Node * node = new (std::nothrow) Node(ops[i].kind);
+    if (!node) {
+        return NULL;
+    }
+    node->op = ops[i].op;
+    for (size_t a = 1; a < ce->size(); ++a) {
+        Node * arg = _compile((*ce)[a], interpreter, names);
+        if (!arg) {
+            delete node;
+            return NULL;
+        }
+        node->args.push_back(arg);
+    }
+    if (name == "inc" || name == "dec") {
+        Node * one = new (std::nothrow) Node(Node::node_const);
+        if (!one) {
+            delete node;
+            return NULL;
+        }
+        one->type = Column::column_i64;
+        one->const_i64 = 1;
+        node->args.push_back(one);
+    }
+    return node;
+}
+
+bool BatchExpr::evaluate(const std::vector<Column> &columns,
+        BatchResult &result)
+{
+    if (!_root || columns.size() != _columns) {
+        return false;
+    }
+    size_t rows = columns.empty() ? 0 : columns[0].size;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (columns[i].size != rows || (rows && !columns[i].data)) {
+            PRETTY_MESSAGE(stderr, "column %zu of %zu rows, %zu expected", i,
+                    columns[i].size, rows);
+            return false;
+        }
+    }
+    if (!decide_types(_root, columns)) {
+        return false;
+    }
+
+    result.type = _root->type;
+    result.rows = rows;
+    result.i64.clear();
+    result.f64.clear();
+    result.bools.clear();
+    result.strings.clear();
+    switch (result.type) {
+        case Column::column_i64:
+            result.i64.resize(rows);
+            break;
+        case Column::column_double:
+            result.f64.resize(rows);
+            break;
+        case Column::column_bool:
+            result.bools.resize(rows);
+            break;
+        default:
+            result.strings.resize(rows);
+            break;
+    }
+    result.selection.assign((rows + 63) / 64, 0);
+    result.selected = 0;
+    result.invalid = 0;
+
+    const VectorKernels &k = VectorKernels::get();
+    std::vector<uint8_t> truth(CHUNK_ROWS);
+    for (size_t row = 0; row < rows; row += CHUNK_ROWS) {
+        size_t n = rows - row < CHUNK_ROWS ? rows - row : CHUNK_ROWS;
+        Chunk chunk = evaluate_chunk(_root, columns, row, n, k);
+        switch (result.type) {
+            case Column::column_i64:
+                memcpy(&result.i64[row], chunk.i64, n * sizeof(int64_t));
+                break;
+            case Column::column_double:
+                memcpy(&result.f64[row], chunk.f64, n * sizeof(double));
+                break;
+            case Column::column_bool:
+                memcpy(&result.bools[row], chunk.b, n);
+                break;
+            default:
+                for (size_t i = 0; i < n; ++i) {
+                    result.strings[row + i] = *chunk.s[i];
+                }
+                break;
+        }
+
+        truth_of(chunk, &truth[0], n);
+        for (size_t i = 0; i < n; ++i) {
+            if (chunk.valid && !chunk.valid[i]) {
+                ++result.invalid;
+                switch (result.type) {
+                    case Column::column_i64:
+                        result.i64[row + i] = 0;
+                        break;
+                    case Column::column_double:
+                        result.f64[row + i] = 0;
+                        break;
+                    case Column::column_bool:
+                        result.bools[row + i] = 0;
+                        break;
+                    default:
+                        result.strings[row + i].clear();
+                        break;
+                }
+                continue;
+            }
+            if (truth[i]) {
+                result.selection[(row + i) / 64] |=
+                        static_cast<uint64_t>(1) << ((row + i) % 64);
+                ++result.selected;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace SolarWindLisp
@@ -0,0 +1,2025 @@
+/*
+ * file name:           src/bench_main.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 10:12:31 2026 CST
+ */
+
+/*
+ * Micro benchmarks, usage:
+ *
+ *   swl-bench                  list all benchmarks
+ *   swl-bench <name> [args]    run one of them
+ *   swl-bench all              run all of them with default arguments
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <new>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "solarwindlisp.h"
+#include "script_reader.h"
+#include "stop_watch.h"
+#include "random.h"
+
+#define REPORT(fmt, ...) \
+do { \
+    (void) fprintf(stdout, fmt "\n", ## __VA_ARGS__); \
+} while (0)
+
+//----------------------------------------------------------------------------
+// allocation accounting, every benchmark may use it to report memory usage
+
+namespace
+{
+
+size_t g_alloc_count = 0;
+size_t g_alloc_bytes = 0;
+
+struct AllocSnapshot
+{
+    size_t count;
+    size_t bytes;
+
+    AllocSnapshot() :
+            count(g_alloc_count), bytes(g_alloc_bytes)
+    {
+    }
+
+    size_t count_since() const
+    {
+        return g_alloc_count - count;
+    }
+
+    size_t bytes_since() const
+    {
+        return g_alloc_bytes - bytes;
+    }
+};
+
+} // anonymous namespace
+
+void * operator new(size_t size)
+{
+    ++g_alloc_count;
+    g_alloc_bytes += size;
+    void * p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void * operator new(size_t size, const std::nothrow_t &) throw ()
+{
+    ++g_alloc_count;
+    g_alloc_bytes += size;
+    return malloc(size ? size : 1);
+}
+
+#if defined(__GNUC__) && __GNUC__ >= 11
+// memory returned by the replaced operator new comes from malloc()
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void * p) throw ()
+{
+    free(p);
+}
+
+void operator delete(void * p, const std::nothrow_t &) throw ()
+{
+    free(p);
+}
+
+namespace SolarWindLisp
+{
+namespace Bench
+{
+
+//----------------------------------------------------------------------------
+// helpers
+
+static double mb_per_sec(size_t bytes, double seconds)
+{
+    return seconds > 0 ? bytes / seconds / (1024.0 * 1024.0) : 0;
+}
+
+static size_t size_arg(int argc, char ** argv, int idx, size_t default_value)
+{
+    if (argc > idx) {
+        char * endptr = NULL;
+        unsigned long v = strtoul(argv[idx], &endptr, 10);
+        if (endptr && *endptr == '\0' && v) {
+            return v;
+        }
+    }
+    return default_value;
+}
+
+/*
+ * Description:
+ *   Generate a script of (roughly) `size' bytes, made up of procedure
+ *   definitions and calls, similar to what users write.
+ */
+static std::string generate_script(size_t size, unsigned int seed = 1)
+{
+    static const char * ops[] = { "+", "-", "*", "max2", "min2", };
+    Utils::Prng prng(seed);
+    std::string script;
+    script.reserve(size + 256);
+
+    char buf[512];
+    for (uint32_t idx = 0; script.size() < size; ++idx) {
+        uint32_t r = prng.random_u32();
+        const char * op = ops[r % array_size(ops)];
+        snprintf(buf, sizeof(buf),
+                "(defn generated-proc-%u (alpha beta)\n"
+                "    (if (> alpha beta)\n"
+                "        (%s alpha (* beta %u))\n"
+                "        (%s beta %u.%u \"label %u\")))\n"
+                "(generated-proc-%u %u %d)\n",
+                idx, op, r % 1000, op, (r >> 10) % 100, (r >> 3) % 1000, idx,
+                idx, r % 10000, -static_cast<int>((r >> 7) % 5000));
+        script += buf;
+    }
+
+    return script;
+}
+
+//----------------------------------------------------------------------------
+// parse: token views and CompositeExpr storage, compared with the original
+// tokenizer and the std::deque based storage
+
+/*
+ * The original storage of CompositeExpr, kept here as the baseline.
+ */
+class DequeExpr: public MatterIF
+{
+public:
+    matter_type_t matter_type() const
+    {
+        return matter_composite_expr;
+    }
+
+    void append_expr(const MatterPtr &expr)
+    {
+        _items.push_back(expr);
+    }
+
+    std::string debug_string(bool compact = true, int level = 0,
+            const char * indent_seq = DEFAULT_INDENT_SEQ) const
+    {
+        return "DequeExpr{}";
+    }
+
+    std::string to_string() const
+    {
+        return "instance of DequeExpr";
+    }
+
+private:
+    std::deque<MatterPtr> _items;
+};
+
+static MatterPtr deque_parse_tokens(ParserIF::lexical_tokens &tokens,
+        bool inner)
+{
+    std::string current;
+    boost::shared_ptr<DequeExpr> result(new DequeExpr());
+    while (tokens.size() > 0) {
+        current.swap(tokens.front());
+        tokens.pop_front();
+        if (current == "(") {
+            MatterPtr expr = deque_parse_tokens(tokens, true);
+            if (!expr) {
+                return NULL;
+            }
+            result->append_expr(expr);
+        }
+        else if (current == ")") {
+            return inner ? result : MatterPtr();
+        }
+        else {
+            AtomPtr expr = Atom::create(current.c_str(), current.length());
+            if (!expr) {
+                return NULL;
+            }
+            result->append_expr(expr);
+        }
+    }
+    return inner ? MatterPtr() : result;
+}
+
+static int bench_parse(int argc, char ** argv)
+{
+    size_t script_size = size_arg(argc, argv, 1, 4 * 1024 * 1024);
+    size_t rounds = size_arg(argc, argv, 2, 5);
+    std::string script = generate_script(script_size);
+
+    REPORT("parse: script of %zu bytes, %zu rounds", script.size(), rounds);
+    REPORT("  sizeof(CompositeExpr): %zu, sizeof(std::deque<MatterPtr>): %zu",
+            sizeof(CompositeExpr), sizeof(std::deque<MatterPtr>));
+
+    SimpleParser parser;
+    ParserIF::lexical_tokens tokens;
+    ParserIF::token_views views;
+
+    // tokenizer only, copies of the tokens vs views of the input
+    StopWatch sw;
+    for (int c = 0; c < 2; ++c) {
+        AllocSnapshot snapshot;
+        sw.reset();
+        sw.start();
+        for (size_t i = 0; i < rounds; ++i) {
+            if (c == 0) {
+                ParserIF::tokenize(&tokens, script.c_str(), script.size());
+            }
+            else {
+                ParserIF::tokenize(&views, script.c_str(), script.size());
+            }
+        }
+        sw.stop();
+        REPORT("  %-24s %10.2f MB/s, %zu tokens, %.1f allocations per round",
+                c == 0 ? "tokenize (strings):" : "tokenize (views):",
+                mb_per_sec(script.size() * rounds, sw.timecost()),
+                c == 0 ? tokens.size() : views.size(),
+                static_cast<double>(snapshot.count_since()) / rounds);
+    }
+
+    struct {
+        const char * name;
+        bool use_deque;
+    } cases[] = {
+        { "parse (strings, deque):", true },
+        { "parse (views):", false },
+    };
+
+    for (size_t c = 0; c < array_size(cases); ++c) {
+        size_t alloc_count = 0;
+        size_t alloc_bytes = 0;
+        sw.reset();
+        sw.start();
+        for (size_t i = 0; i < rounds; ++i) {
+            MatterPtr forms;
+            AllocSnapshot snapshot;
+            if (cases[c].use_deque) {
+                ParserIF::tokenize(&tokens, script.c_str(), script.size());
+                forms = deque_parse_tokens(tokens, false);
+            }
+            else {
+                forms = parser.parse(script.c_str(), script.size());
+            }
+            alloc_count = snapshot.count_since();
+            alloc_bytes = snapshot.bytes_since();
+            if (!forms) {
+                REPORT("  failed parsing the generated script!");
+                return EXIT_FAILURE;
+            }
+        }
+        sw.stop();
+        REPORT("  %-24s %10.2f MB/s, %zu allocations, %.2f MB allocated per parse",
+                cases[c].name, mb_per_sec(script.size() * rounds, sw.timecost()),
+                alloc_count, alloc_bytes / (1024.0 * 1024.0));
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+// vector: SIMD kernels of each instruction set, and vec-sum compared with the
+// equivalent recursive Lisp over a list
+
+static volatile double g_sink = 0;
+
+static int bench_vector(int argc, char ** argv)
+{
+    size_t length = size_arg(argc, argv, 1, 4096);
+    size_t rounds = size_arg(argc, argv, 2, 200);
+
+    REPORT("vector: %zu elements, %zu rounds, best instruction set: %s",
+            length, rounds, VectorKernels::isa_name(VectorKernels::best_isa()));
+
+    VectorPtr a = Vector::create(Vector::elem_double, length);
+    VectorPtr b = Vector::create(Vector::elem_double, length);
+    VectorPtr out = Vector::create(Vector::elem_double, length);
+    if (!a || !b || !out) {
+        REPORT("  out of memory!");
+        return EXIT_FAILURE;
+    }
+
+    Utils::Prng prng(1);
+    for (size_t i = 0; i < length; ++i) {
+        a->double_data()[i] = (prng.random_u32() % 20000) / 100.0 - 100.0;
+        b->double_data()[i] = (prng.random_u32() % 20000) / 100.0 - 100.0;
+    }
+
+    // enough repetitions for the kernels to be measurable
+    size_t kernel_rounds = rounds * 100;
+    double elements = static_cast<double>(length) * kernel_rounds;
+    StopWatch sw;
+    for (int isa = 0; isa < VectorKernels::NUM_OF_ISAS; ++isa) {
+        VectorKernels::isa_t t = static_cast<VectorKernels::isa_t>(isa);
+        if (!VectorKernels::is_supported(t)) {
+            REPORT("  %-8s not supported by this CPU", VectorKernels::isa_name(t));
+            continue;
+        }
+
+        const VectorKernels &k = VectorKernels::get(t);
+        struct {
+            const char * name;
+            double seconds;
+        } results[4] = { { "sum", 0 }, { "dot", 0 }, { "max", 0 }, { "map+", 0 } };
+        for (size_t c = 0; c < array_size(results); ++c) {
+            sw.reset();
+            sw.start();
+            for (size_t r = 0; r < kernel_rounds; ++r) {
+                switch (c) {
+                    case 0:
+                        g_sink += k.sum_f64(a->double_data(), length);
+                        break;
+                    case 1:
+                        g_sink += k.dot_f64(a->double_data(), b->double_data(), length);
+                        break;
+                    case 2:
+                        g_sink += k.max_f64(a->double_data(), length);
+                        break;
+                    default:
+                        k.add_f64(a->double_data(), b->double_data(),
+                                out->double_data(), length);
+                        g_sink += out->double_data()[r % length];
+                        break;
+                }
+            }
+            sw.stop();
+            results[c].seconds = sw.timecost();
+        }
+
+        REPORT("  %-8s %s %8.0f M/s, %s %8.0f M/s, %s %8.0f M/s, %s %8.0f M/s",
+                VectorKernels::isa_name(t),
+                results[0].name, elements / results[0].seconds / 1e6,
+                results[1].name, elements / results[1].seconds / 1e6,
+                results[2].name, elements / results[2].seconds / 1e6,
+                results[3].name, elements / results[3].seconds / 1e6);
+    }
+
+    // the same reduction from scripts
+    SimpleInterpreter interpreter;
+    if (!interpreter.initialize()) {
+        REPORT("  failed initializing interpreter!");
+        return EXIT_FAILURE;
+    }
+
+    std::string setup = "(define data (list";
+    char buf[64];
+    for (size_t i = 0; i < length; ++i) {
+        snprintf(buf, sizeof(buf), " %.2f", a->double_data()[i]);
+        setup += buf;
+    }
+    setup += "))"
+            "(define packed (list->vector data))"
+            "(defn sum-list (l) (if l (+ (car l) (sum-list (cdr l))) 0))";
+
+    MatterPtr result;
+    if (!interpreter.execute(result, setup.c_str(), setup.size())) {
+        REPORT("  failed evaluating the setup script!");
+        return EXIT_FAILURE;
+    }
+
+    struct {
+        const char * name;
+        const char * script;
+        size_t rounds;
+    } scripts[] = {
+        { "recursive sum-list:", "(sum-list data)", rounds / 10 + 1 },
+        { "vec-sum:", "(vec-sum packed)", rounds * 10 },
+    };
+
+    for (size_t c = 0; c < array_size(scripts); ++c) {
+        sw.reset();
+        sw.start();
+        for (size_t r = 0; r < scripts[c].rounds; ++r) {
+            if (!interpreter.execute(result, scripts[c].script,
+                    strlen(scripts[c].script))) {
+                REPORT("  failed evaluating `%s'!", scripts[c].script);
+                return EXIT_FAILURE;
+            }
+        }
+        sw.stop();
+        REPORT("  %-24s %10.2f M elements/s, result %s", scripts[c].name,
+                static_cast<double>(length) * scripts[c].rounds / sw.timecost() / 1e6,
+                result ? result->to_string().c_str() : "NULL");
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+// hashmap: keyed lookups, HashMap compared with std::map, and from scripts,
+// get compared with the equivalent cond chain
+
+static int bench_hashmap(int argc, char ** argv)
+{
+    size_t entries = size_arg(argc, argv, 1, 10000);
+    size_t lookups = size_arg(argc, argv, 2, 1000 * 1000);
+
+    REPORT("hashmap: %zu entries, %zu lookups", entries, lookups);
+
+    std::vector<MatterPtr> keys;
+    std::vector<std::string> names;
+    HashMapPtr m = HashMap::create();
+    std::map<std::string, MatterPtr> tree;
+    char buf[64];
+    for (size_t i = 0; i < entries; ++i) {
+        int n = snprintf(buf, sizeof(buf), "\"reference-key-%zu\"", i);
+        AtomPtr key = Atom::create(buf, n);
+        if (!key || !m->insert(key, key)) {
+            REPORT("  out of memory!");
+            return EXIT_FAILURE;
+        }
+        keys.push_back(key);
+        names.push_back(static_cast<const Atom *>(key.get())->to_cstr());
+        tree[names.back()] = key;
+    }
+
+    Utils::Prng prng(1);
+    std::vector<size_t> order(lookups);
+    for (size_t i = 0; i < lookups; ++i) {
+        order[i] = prng.random_u32() % entries;
+    }
+
+    size_t found = 0;
+    StopWatch sw;
+    sw.start();
+    for (size_t i = 0; i < lookups; ++i) {
+        found += m->find(keys[order[i]]) != NULL;
+    }
+    sw.stop();
+    REPORT("  %-24s %10.2f M lookups/s, %zu found", "HashMap::find:",
+            lookups / sw.timecost() / 1e6, found);
+
+    found = 0;
+    sw.reset();
+    sw.start();
+    for (size_t i = 0; i < lookups; ++i) {
+        found += tree.find(names[order[i]]) != tree.end();
+    }
+    sw.stop();
+    REPORT("  %-24s %10.2f M lookups/s, %zu found", "std::map::find:",
+            lookups / sw.timecost() / 1e6, found);
+
+    // from scripts, integer keys
+    SimpleInterpreter interpreter;
+    if (!interpreter.initialize()) {
+        REPORT("  failed initializing interpreter!");
+        return EXIT_FAILURE;
+    }
+
+    std::string setup = "(define table (hash-map";
+    std::string chain = "(defn lookup (k) (cond";
+    for (size_t i = 0; i < entries; ++i) {
+        snprintf(buf, sizeof(buf), " %zu %zu", i, i * 2);
+        setup += buf;
+        snprintf(buf, sizeof(buf), " (= k %zu) %zu", i, i * 2);
+        chain += buf;
+    }
+    setup += "))";
+    chain += "))";
+
+    MatterPtr result;
+    if (!interpreter.execute(result, setup.c_str(), setup.size())
+            || !interpreter.execute(result, chain.c_str(), chain.size())) {
+        REPORT("  failed evaluating the setup script!");
+        return EXIT_FAILURE;
+    }
+
+    struct {
+        const char * name;
+        const char * fmt;
+        size_t rounds;
+    } scripts[] = {
+        { "cond chain:", "(lookup %zu)", lookups / entries + 1 },
+        { "hash-map get:", "(get table %zu)", lookups / 100 + 1 },
+    };
+
+    for (size_t c = 0; c < array_size(scripts); ++c) {
+        sw.reset();
+        sw.start();
+        for (size_t r = 0; r < scripts[c].rounds; ++r) {
+            int n = snprintf(buf, sizeof(buf), scripts[c].fmt, order[r]);
+            if (!interpreter.execute(result, buf, n)) {
+                REPORT("  failed evaluating `%s'!", buf);
+                return EXIT_FAILURE;
+            }
+        }
+        sw.stop();
+        REPORT("  %-24s %10.2f K lookups/s", scripts[c].name,
+                scripts[c].rounds / sw.timecost() / 1e3);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+// maps: deriving slightly modified versions of a context map, a persistent
+// map compared with copying a hash map
+
+static bool copy_entry(const MatterPtr &key, const MatterPtr &value,
+        void * arg)
+{
+    return static_cast<HashMap *>(arg)->insert(key, value);
+}
+
+static int bench_maps(int argc, char ** argv)
+{
+    size_t entries = size_arg(argc, argv, 1, 10000);
+    size_t versions = size_arg(argc, argv, 2, 2000);
+    static const size_t UPDATES = 3; // per derived version
+
+    REPORT("maps: %zu entries, %zu derived versions, %zu updates each",
+            entries, versions, UPDATES);
+
+    std::vector<MatterPtr> keys;
+    char buf[64];
+    for (size_t i = 0; i < entries; ++i) {
+        int n = snprintf(buf, sizeof(buf), "\"context-key-%zu\"", i);
+        keys.push_back(Atom::create(buf, n));
+    }
+
+    Utils::Prng prng(1);
+    std::vector<size_t> order(versions * UPDATES);
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = prng.random_u32() % entries;
+    }
+
+    // bulk construction
+    StopWatch sw;
+    HashMapPtr hash_base;
+    PersistentMapPtr persistent_base;
+    for (int c = 0; c < 3; ++c) {
+        AllocSnapshot snapshot;
+        sw.reset();
+        sw.start();
+        if (c == 0) {
+            hash_base = HashMap::create();
+            for (size_t i = 0; i < entries; ++i) {
+                hash_base->insert(keys[i], keys[i]);
+            }
+        }
+        else if (c == 1) {
+            PersistentMapPtr m = PersistentMap::create();
+            for (size_t i = 0; i < entries; ++i) {
+                m = m->assoc(keys[i], keys[i]);
+            }
+        }
+        else {
+            PersistentMap::Transient transient(PersistentMap::create());
+            for (size_t i = 0; i < entries; ++i) {
+                transient.assoc(keys[i], keys[i]);
+            }
+            persistent_base = transient.persistent();
+        }
+        sw.stop();
+
+        static const char * names[] = {
+            "build HashMap:", "build assoc:", "build transient:",
+        };
+        REPORT("  %-24s %10.2f M inserts/s, %.2f MB allocated", names[c],
+                entries / sw.timecost() / 1e6,
+                snapshot.bytes_since() / (1024.0 * 1024.0));
+    }
+
+    // derived versions, all of them are kept alive, like in-flight requests
+    for (int c = 0; c < 2; ++c) {
+        std::vector<MatterPtr> derived;
+        derived.reserve(versions);
+        AllocSnapshot snapshot;
+        sw.reset();
+        sw.start();
+        for (size_t v = 0; v < versions; ++v) {
+            const size_t * updates = &order[v * UPDATES];
+            if (c == 0) {
+                HashMapPtr m = HashMap::create(hash_base->size());
+                hash_base->for_each(copy_entry, m.get());
+                for (size_t u = 0; u < UPDATES; ++u) {
+                    m->insert(keys[updates[u]], keys[0]);
+                }
+                derived.push_back(m);
+            }
+            else {
+                PersistentMapPtr m = persistent_base;
+                for (size_t u = 0; u < UPDATES; ++u) {
+                    m = m->assoc(keys[updates[u]], keys[0]);
+                }
+                derived.push_back(m);
+            }
+        }
+        sw.stop();
+
+        REPORT("  %-24s %10.2f K versions/s, %.2f KB allocated per version",
+                c == 0 ? "copy HashMap:" : "PersistentMap assoc:",
+                versions / sw.timecost() / 1e3,
+                snapshot.bytes_since() / 1024.0 / versions);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static int bench_frames(int argc, char ** argv)
+{
+    size_t depth = size_arg(argc, argv, 1, 100);
+    size_t rounds = size_arg(argc, argv, 2, 2000);
+
+    REPORT("frames: recursion depth %zu, %zu rounds", depth, rounds);
+
+    SimpleInterpreter interpreter;
+    if (!interpreter.initialize()) {
+        REPORT("  failed initializing interpreter!");
+        return EXIT_FAILURE;
+    }
+
+    // the same function, the unused closure makes the frames captured
+    const char * setup =
+        "(defn count-stack (n) (if (> n 0) (count-stack (- n 1)) 0))"
+        "(defn count-heap (n)"
+        "    (if (> n 0) (count-heap (- n 1)) (cond 0 (lambda () n) 1 0)))";
+    MatterPtr result;
+    if (!interpreter.execute(result, setup, strlen(setup))) {
+        REPORT("  failed evaluating the setup script!");
+        return EXIT_FAILURE;
+    }
+
+    static const char * names[] = { "count-stack", "count-heap" };
+    StopWatch sw;
+    char script[64];
+    for (size_t c = 0; c < array_size(names); ++c) {
+        int len = snprintf(script, sizeof(script), "(%s %zu)", names[c], depth);
+        size_t frames = interpreter.frames().stats().frames;
+        AllocSnapshot snapshot;
+        sw.reset();
+        sw.start();
+        for (size_t r = 0; r < rounds; ++r) {
+            if (!interpreter.execute(result, script, len)) {
+                REPORT("  failed evaluating `%s'!", script);
+                return EXIT_FAILURE;
+            }
+        }
+        sw.stop();
+
+        size_t calls = (depth + 1) * rounds;
+        REPORT("  %-24s %10.2f M calls/s, %5.1f allocations, %6.1f bytes per call,"
+                " %zu stack frames",
+                names[c], calls / sw.timecost() / 1e6,
+                static_cast<double>(snapshot.count_since()) / calls,
+                static_cast<double>(snapshot.bytes_since()) / calls,
+                interpreter.frames().stats().frames - frames);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static int bench_gc(int argc, char ** argv)
+{
+    size_t forms = size_arg(argc, argv, 1, 200000);
+
+    REPORT("gc: %zu forms, each leaves a cycle of a closure and its env", forms);
+
+    static const char * script =
+            "(let (loop (lambda (n) (if (> n 0) (loop (- n 1)) n))) (loop 3))";
+    static const size_t thresholds[] = {
+        0, 1000, CycleCollector::DEFAULT_THRESHOLD, 100000,
+    };
+
+    StopWatch sw;
+    for (size_t c = 0; c < array_size(thresholds); ++c) {
+        SimpleInterpreter interpreter;
+        if (!interpreter.initialize()) {
+            REPORT("  failed initializing interpreter!");
+            return EXIT_FAILURE;
+        }
+        interpreter.collector().set_threshold(thresholds[c]);
+
+        MatterPtr result;
+        sw.reset();
+        sw.start();
+        for (size_t i = 0; i < forms; ++i) {
+            if (!interpreter.execute(result, script, strlen(script))) {
+                REPORT("  failed evaluating `%s'!", script);
+                return EXIT_FAILURE;
+            }
+        }
+        sw.stop();
+
+        // count what is left, without reclaiming it when disabled
+        const CycleCollector::Stats &stats = interpreter.collector().stats();
+        size_t collections = stats.collections;
+        uint64_t max_pause = stats.max_pause_usec;
+        uint64_t total_pause = stats.total_pause_usec;
+        size_t leaked = interpreter.collector().collect();
+
+        char name[32];
+        snprintf(name, sizeof(name), "threshold %zu:", thresholds[c]);
+        REPORT("  %-24s %10.2f K forms/s, %6zu collections, "
+                "pause max %6llu us avg %6.1f us, %zu garbage left",
+                name, forms / sw.timecost() / 1e3, collections,
+                static_cast<unsigned long long>(max_pause),
+                collections ? static_cast<double>(total_pause) / collections : 0.0,
+                leaked);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+// scan: the structural index of each instruction set, raw classification and
+// walking every structural byte, then the tokenizer built on it
+
+static int bench_scan(int argc, char ** argv)
+{
+    size_t script_size = size_arg(argc, argv, 1, 16 * 1024 * 1024);
+    size_t rounds = size_arg(argc, argv, 2, 10);
+    std::string script = generate_script(script_size);
+
+    REPORT("scan: script of %zu bytes, %zu rounds", script.size(), rounds);
+
+    double bytes = static_cast<double>(script.size()) * rounds;
+    StopWatch sw;
+    for (int isa = 0; isa < VectorKernels::NUM_OF_ISAS; ++isa) {
+        VectorKernels::isa_t t = static_cast<VectorKernels::isa_t>(isa);
+        if (!VectorKernels::is_supported(t)) {
+            REPORT("  %-8s not supported by this CPU", VectorKernels::isa_name(t));
+            continue;
+        }
+
+        // classification only
+        StructuralIndex::classify_func classify = StructuralIndex::classifier(t);
+        uint64_t masks[StructuralIndex::NUM_OF_CLASSES];
+        size_t found = 0;
+        sw.reset();
+        sw.start();
+        for (size_t i = 0; i < rounds; ++i) {
+            for (size_t off = 0; off + StructuralIndex::BLOCK_SIZE <= script.size();
+                    off += StructuralIndex::BLOCK_SIZE) {
+                classify(script.c_str() + off, masks);
+                found += __builtin_popcountll(masks[StructuralIndex::class_paren]
+                        | masks[StructuralIndex::class_quote]);
+            }
+        }
+        sw.stop();
+        double classify_rate = bytes / sw.timecost() / 1e9;
+
+        // visiting every paren, quote and space
+        StructuralIndex index(script.c_str(), script.size(), t);
+        size_t visited = 0;
+        sw.reset();
+        sw.start();
+        for (size_t i = 0; i < rounds; ++i) {
+            index.reset(script.c_str(), script.size());
+            for (size_t pos = index.find(0, StructuralIndex::PAREN
+                    | StructuralIndex::QUOTE | StructuralIndex::SPACE);
+                    pos < script.size(); ++visited) {
+                pos = index.find(pos + 1, StructuralIndex::PAREN
+                        | StructuralIndex::QUOTE | StructuralIndex::SPACE);
+            }
+        }
+        sw.stop();
+
+        REPORT("  %-8s classify %6.2f GB/s, walk %6.2f GB/s, %zu structural bytes",
+                VectorKernels::isa_name(t), classify_rate,
+                bytes / sw.timecost() / 1e9, visited / rounds);
+        g_sink += found;
+    }
+
+    // short atoms in the generated script, long ones in rule files
+    std::string rules;
+    rules.reserve(script.size() + 256);
+    while (rules.size() < script.size()) {
+        rules += "(define-rule rule-with-a-long-descriptive-name\n"
+                "    \"matches when the request carries a forwarded header\"\n"
+                "    (when (header-contains request \"x-forwarded-for\") (deny)))\n";
+    }
+
+    const std::string * corpora[] = { &script, &rules };
+    static const char * corpus_names[] = {
+        "tokenize (script):", "tokenize (rules):",
+    };
+    ParserIF::token_views views;
+    for (size_t c = 0; c < array_size(corpora); ++c) {
+        const std::string &text = *corpora[c];
+        sw.reset();
+        sw.start();
+        for (size_t i = 0; i < rounds; ++i) {
+            ParserIF::tokenize(&views, text.c_str(), text.size());
+        }
+        sw.stop();
+        REPORT("  %-24s %10.2f MB/s, %zu tokens", corpus_names[c],
+                mb_per_sec(text.size() * rounds, sw.timecost()), views.size());
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+// reader: splitting a script file into statements, copied line by line by
+// get_next_statement(), or as views of the mapped file by next_statement()
+
+static int bench_reader(int argc, char ** argv)
+{
+    size_t script_size = size_arg(argc, argv, 1, 64 * 1024 * 1024);
+    std::string script = generate_script(script_size);
+
+    char filename[] = "/tmp/swl-bench-reader-XXXXXX";
+    int fd = mkstemp(filename);
+    if (fd < 0) {
+        REPORT("  cannot create a temporary file!");
+        return EXIT_FAILURE;
+    }
+    bool written = write(fd, script.data(), script.size())
+            == static_cast<ssize_t>(script.size());
+    close(fd);
+    if (!written) {
+        REPORT("  cannot write the temporary file!");
+        unlink(filename);
+        return EXIT_FAILURE;
+    }
+
+    REPORT("reader: script file of %zu bytes", script.size());
+
+    StopWatch sw;
+    for (int c = 0; c < 2; ++c) {
+        ScriptFileReader reader;
+        if (!reader.initialize(filename)) {
+            unlink(filename);
+            return EXIT_FAILURE;
+        }
+
+        size_t statements = 0;
+        AllocSnapshot snapshot;
+        sw.reset();
+        sw.start();
+        if (c == 0) {
+            ssize_t buf_size = 4096;
+            char * buf = (char *) malloc(buf_size);
+            while (buf && reader.get_next_statement(&buf, &buf_size) >= 0) {
+                ++statements;
+            }
+            free(buf);
+        }
+        else {
+            const char * stmt = NULL;
+            while (reader.next_statement(&stmt) >= 0) {
+                ++statements;
+            }
+        }
+        sw.stop();
+        REPORT("  %-24s %10.2f MB/s, %zu statements, %zu allocations",
+                c == 0 ? "get_next_statement:" : "next_statement (views):",
+                mb_per_sec(script.size(), sw.timecost()), statements,
+                snapshot.count_since());
+    }
+
+    unlink(filename);
+    return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+// atoms: Atom::parse() with its first byte classifier, compared with the
+// C library based Atom::parse_generic(), on symbols and on numbers
+
+static int bench_atoms(int argc, char ** argv)
+{
+    size_t count = size_arg(argc, argv, 1, 100000);
+    size_t rounds = size_arg(argc, argv, 2, 20);
+
+    REPORT("atoms: %zu atoms per corpus, %zu rounds", count, rounds);
+
+    static const char * symbols[] = {
+        "define", "lambda", "if", "let", "alpha", "beta", "+", "-", "*",
+        "max2", "vec-sum", "hash-map-get", "true", "false", "\"label\"",
+        "nil", "fib", "inner-loop",
+    };
+
+    Utils::Prng prng(1);
+    std::vector<std::string> corpora[2];
+    char buf[64];
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t r = prng.random_u32();
+        corpora[0].push_back(symbols[r % array_size(symbols)]);
+        switch (r % 4) {
+            case 0:
+                snprintf(buf, sizeof(buf), "%u", r % 1000);
+                break;
+            case 1:
+                snprintf(buf, sizeof(buf), "%d", -static_cast<int>(r));
+                break;
+            case 2:
+                snprintf(buf, sizeof(buf), "%u.%u", (r >> 3) % 1000, r % 100);
+                break;
+            default:
+                snprintf(buf, sizeof(buf), "%.6e", r / 7.0);
+                break;
+        }
+        corpora[1].push_back(buf);
+    }
+
+    static const char * corpus_names[] = { "symbols", "numbers" };
+    AtomPtr atom = Atom::create();
+    if (!atom) {
+        REPORT("  out of memory!");
+        return EXIT_FAILURE;
+    }
+
+    StopWatch sw;
+    for (int corpus = 0; corpus < 2; ++corpus) {
+        const std::vector<std::string> &atoms = corpora[corpus];
+        double rates[2] = { 0, 0 };
+        for (int c = 0; c < 2; ++c) {
+            sw.reset();
+            sw.start();
+            for (size_t i = 0; i < rounds; ++i) {
+                for (size_t j = 0; j < atoms.size(); ++j) {
+                    bool done = c == 0
+                            ? atom->parse_generic(atoms[j].c_str(), atoms[j].size())
+                            : atom->parse(atoms[j].c_str(), atoms[j].size());
+                    if (!done) {
+                        REPORT("  failed parsing `%s'!", atoms[j].c_str());
+                        return EXIT_FAILURE;
+                    }
+                }
+            }
+            sw.stop();
+            rates[c] = atoms.size() * rounds / sw.timecost() / 1e6;
+        }
+
+        REPORT("  %-8s parse_generic %8.2f M atoms/s, parse %8.2f M atoms/s, "
+                "%.2fx", corpus_names[corpus], rates[0], rates[1],
+                rates[0] > 0 ? rates[1] / rates[0] : 0.0);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+
+struct BenchCase
+{
+    const char * name;
+    const char * args;
+    const char * desc;
+    int (*func)(int argc, char ** argv);
+};
+
+/*
+ * Count the complete top-level forms of `pending' the way a caller without
+ * feed() has to: tokenize everything buffered so far, parse the complete
+ * forms, and keep the rest for the next chunk.
+ */
+static size_t reparse_pending(SimpleParser &parser, std::string &pending,
+        ParserIF::token_views &views)
+{
+    if (!ParserIF::tokenize(&views, pending.data(), pending.size())) {
+        return 0;
+    }
+
+    int depth = 0;
+    size_t end = 0;
+    for (size_t i = 0; i < views.size(); ++i) {
+        if (views[i].kind == ParserIF::token_lparen) {
+            ++depth;
+        }
+        else if (views[i].kind == ParserIF::token_rparen && --depth == 0) {
+            end = views[i].offset + 1;
+        }
+    }
+    if (end == 0) {
+        return 0;
+    }
+
+    MatterPtr forms = parser.parse(pending.data(), end);
+    pending.erase(0, end);
+    return forms ? static_cast<const CompositeExpr *>(forms.get())->size() : 0;
+}
+
+static int bench_stream(int argc, char ** argv)
+{
+    size_t script_size = size_arg(argc, argv, 1, 8 * 1024 * 1024);
+    std::string script = generate_script(script_size);
+    static const size_t chunk_sizes[] = { 64, 4096, 65536, };
+
+    REPORT("stream: script of %zu bytes, in chunks", script.size());
+
+    StopWatch sw;
+    for (size_t k = 0; k < array_size(chunk_sizes); ++k) {
+        size_t chunk = chunk_sizes[k];
+        for (int c = 0; c < 2; ++c) {
+            SimpleParser parser;
+            std::vector<MatterPtr> forms;
+            std::string pending;
+            ParserIF::token_views views;
+            size_t count = 0;
+
+            sw.reset();
+            sw.start();
+            for (size_t off = 0; off < script.size(); off += chunk) {
+                size_t n = std::min(chunk, script.size() - off);
+                if (c == 0) {
+                    pending.append(script, off, n);
+                    count += reparse_pending(parser, pending, views);
+                }
+                else {
+                    parser.feed(script.data() + off, n, forms);
+                    count += forms.size();
+                    forms.clear();
+                }
+            }
+            if (c != 0 && parser.finish(forms)) {
+                count += forms.size();
+            }
+            sw.stop();
+            REPORT("  %6zu bytes, %-20s %10.2f MB/s, %zu forms", chunk,
+                    c == 0 ? "buffer and reparse:" : "feed:",
+                    mb_per_sec(script.size(), sw.timecost()), count);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static int bench_load(int argc, char ** argv)
+{
+    size_t script_size = size_arg(argc, argv, 1, 100 * 1024 * 1024);
+    size_t max_threads = size_arg(argc, argv, 2, 8);
+    std::string script = generate_script(script_size);
+
+    REPORT("load: script of %zu bytes, %u CPUs", script.size(),
+            std::thread::hardware_concurrency());
+
+    // a single thread without interning last
+    std::vector<size_t> configs;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        configs.push_back(threads);
+    }
+    configs.push_back(0);
+
+    StopWatch sw;
+    double serial = 0;
+    for (size_t c = 0; c < configs.size(); ++c) {
+        size_t threads = configs[c];
+        SymbolTable symbols;
+        ParallelLoader loader(threads ? threads : 1, threads ? &symbols : NULL);
+        size_t forms = 0;
+        sw.reset();
+        sw.start();
+        bool ok = loader.load(script.data(), script.size(),
+                [&forms](const MatterPtr &form) {
+                    ++forms;
+                    return true;
+                });
+        sw.stop();
+        if (!ok) {
+            REPORT("  load failed: %s", loader.error_message());
+            return EXIT_FAILURE;
+        }
+
+        if (threads == 1) {
+            serial = sw.timecost();
+        }
+        REPORT("  %2zu thread(s)%-16s %8.3f s, %8.2f MB/s, x%.2f, "
+                "%zu batches, %zu forms, %zu symbols", threads ? threads : 1,
+                threads ? "," : ", no interning,", sw.timecost(),
+                mb_per_sec(script.size(), sw.timecost()),
+                serial / sw.timecost(), loader.batches(), forms,
+                symbols.size());
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Description:
+ *   Run `measure' in a child process, whose heap is that of the parent, so
+ *   the measurements are as in a process just started, not affected by each
+ *   other, `measure' fills in the seconds, the forms, and the allocations.
+ * Return value:
+ *   false if the child failed.
+ */
+static bool measure_in_child(const std::function<bool(double &, size_t &,
+        size_t &)> &measure, double &seconds, size_t &forms, size_t &allocs)
+{
+    int fds[2];
+    if (pipe(fds) < 0) {
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        close(fds[0]);
+        double result[3] = { 0, 0, 0 };
+        if (measure(seconds, forms, allocs)) {
+            result[0] = seconds;
+            result[1] = static_cast<double>(forms);
+            result[2] = static_cast<double>(allocs);
+        }
+        else {
+            result[0] = -1;
+        }
+        ssize_t ignored = write(fds[1], result, sizeof(result));
+        (void) ignored;
+        _exit(EXIT_SUCCESS);
+    }
+
+    close(fds[1]);
+    double result[3];
+    bool ok = read(fds[0], result, sizeof(result))
+            == static_cast<ssize_t>(sizeof(result)) && result[0] >= 0;
+    close(fds[0]);
+    waitpid(pid, NULL, 0);
+
+    seconds = result[0];
+    forms = static_cast<size_t>(result[1]);
+    allocs = static_cast<size_t>(result[2]);
+    return ok;
+}
+
+static int bench_cache(int argc, char ** argv)
+{
+    size_t script_size = size_arg(argc, argv, 1, 16 * 1024 * 1024);
+    std::string script = generate_script(script_size);
+
+    char filename[] = "/tmp/swl-bench-cache-XXXXXX";
+    int fd = mkstemp(filename);
+    if (fd < 0) {
+        REPORT("  cannot create a temporary file!");
+        return EXIT_FAILURE;
+    }
+    close(fd);
+
+    REPORT("cache: script of %zu bytes, each step in a new process",
+            script.size());
+
+    // 0: parse, 1: parse and write the cache, 2: load the cache
+    auto step = [&script, &filename](int what, double &seconds,
+            size_t &forms, size_t &allocs) {
+        std::vector<MatterPtr> result;
+        SimpleParser parser;
+        StopWatch sw;
+        AllocSnapshot snapshot;
+        bool ok = true;
+        sw.start();
+        if (what != 2) {
+            ok = parser.feed(script.data(), script.size(), result)
+                    && parser.finish(result);
+        }
+        if (what == 1) {
+            sw.stop();
+            sw.reset();
+            sw.start();
+            ok = ok && ScriptCache::write(filename, script.data(),
+                    script.size(), result);
+        }
+        else if (what == 2) {
+            ok = ScriptCache::load(filename, script.data(), script.size(),
+                    result);
+        }
+        sw.stop();
+
+        seconds = sw.timecost();
+        allocs = snapshot.count_since();
+        forms = result.size();
+        return ok;
+    };
+
+    static const char * names[] = { "parse:", "write cache:", "load cache:", };
+    for (int what = 0; what < 3; ++what) {
+        double seconds = 0;
+        size_t forms = 0;
+        size_t allocs = 0;
+        bool ok = measure_in_child([&step, what](double &s, size_t &f,
+                size_t &a) {
+            return step(what, s, f, a);
+        }, seconds, forms, allocs);
+        if (!ok) {
+            REPORT("  %s failed!", names[what]);
+            unlink(filename);
+            return EXIT_FAILURE;
+        }
+
+        if (what == 1) {
+            struct stat st;
+            REPORT("  %-22s %8.3f s, %zu bytes of cache", names[what],
+                    seconds, stat(filename, &st) == 0
+                            ? static_cast<size_t>(st.st_size) : 0);
+        }
+        else {
+            REPORT("  %-22s %8.3f s, %10.2f MB/s, %zu forms, %zu allocations",
+                    names[what], seconds, mb_per_sec(script.size(), seconds),
+                    forms, allocs);
+        }
+    }
+
+    StopWatch sw;
+    sw.start();
+    uint64_t hash = ScriptCache::content_hash(script.data(), script.size());
+    sw.stop();
+    g_sink += static_cast<double>(hash);
+    REPORT("  %-22s %8.3f s, %10.2f MB/s", "content hash:", sw.timecost(),
+            mb_per_sec(script.size(), sw.timecost()));
+
+    unlink(filename);
+    return EXIT_SUCCESS;
+}
+
+// procedures `f<i>', values computed by them `v<i + 1>', lists, and closures
+static std::string generate_definitions(size_t definitions)
+{
+    std::string defs;
+    char form[256];
+    for (size_t i = 0; i < definitions; ++i) {
+        switch (i % 4) {
+            case 0:
+                snprintf(form, sizeof(form), "(defn f%zu (x) (+ (* x %zu) 1))\n",
+                        i, i);
+                break;
+            case 1:
+                snprintf(form, sizeof(form), "(define v%zu (f%zu %zu))\n",
+                        i, i - 1, i);
+                break;
+            case 2:
+                snprintf(form, sizeof(form),
+                        "(define l%zu (list %zu \"s%zu\" (quote (a b c))))\n",
+                        i, i, i);
+                break;
+            default:
+                snprintf(form, sizeof(form),
+                        "(define c%zu (let (k %zu) (lambda (y) (* y k))))\n",
+                        i, i);
+                break;
+        }
+        defs += form;
+    }
+    return defs;
+}
+
+static int bench_snapshot(int argc, char ** argv)
+{
+    size_t definitions = size_arg(argc, argv, 1, 20000);
+    std::string defs = generate_definitions(definitions);
+
+    char filename[] = "/tmp/swl-bench-snapshot-XXXXXX";
+    int fd = mkstemp(filename);
+    if (fd < 0) {
+        REPORT("  cannot create a temporary file!");
+        return EXIT_FAILURE;
+    }
+    close(fd);
+
+    REPORT("snapshot: %zu definitions, %zu bytes, each step in a new process",
+            definitions, defs.size());
+
+    // 0: initialize and execute, 1: save the snapshot, 2: restore it
+    auto step = [&defs, &filename](int what, double &seconds,
+            size_t &names, size_t &allocs) {
+        SimpleInterpreter interpreter;
+        StopWatch sw;
+        AllocSnapshot snapshot;
+        MatterPtr result = NULL;
+        bool ok = true;
+        sw.start();
+        if (what != 2) {
+            ok = interpreter.initialize()
+                    && interpreter.execute(result, defs.data(), defs.size());
+        }
+        if (what == 1) {
+            sw.stop();
+            sw.reset();
+            sw.start();
+            ok = ok && interpreter.save_snapshot(filename);
+        }
+        else if (what == 2) {
+            ok = interpreter.initialize(filename);
+        }
+        sw.stop();
+
+        seconds = sw.timecost();
+        allocs = snapshot.count_since();
+        names = ok ? interpreter.env()->size() : 0;
+        return ok;
+    };
+
+    static const char * names[] = { "execute definitions:", "save snapshot:",
+            "restore snapshot:", };
+    double startup = 0;
+    for (int what = 0; what < 3; ++what) {
+        double seconds = 0;
+        size_t bound = 0;
+        size_t allocs = 0;
+        bool ok = measure_in_child([&step, what](double &s, size_t &b,
+                size_t &a) {
+            return step(what, s, b, a);
+        }, seconds, bound, allocs);
+        if (!ok) {
+            REPORT("  %s failed!", names[what]);
+            unlink(filename);
+            return EXIT_FAILURE;
+        }
+
+        if (what == 1) {
+            struct stat st;
+            REPORT("  %-22s %8.3f s, %zu bytes of snapshot", names[what],
+                    seconds, stat(filename, &st) == 0
+                            ? static_cast<size_t>(st.st_size) : 0);
+            continue;
+        }
+
+        startup = what == 0 ? seconds : startup;
+        REPORT("  %-22s %8.3f s, %6.2fx, %zu names, %zu allocations",
+                names[what], seconds, startup / seconds, bound, allocs);
+    }
+
+    unlink(filename);
+    return EXIT_SUCCESS;
+}
+
+static int bench_interpreters(int argc, char ** argv)
+{
+    size_t count = size_arg(argc, argv, 1, 20000);
+
+    REPORT("interpreters: %zu interpreters created, and destroyed", count);
+
+    // 0: the builtin env of its own, as every interpreter had before,
+    // 1: chained onto the shared one
+    static const char * names[] = { "private builtin env:",
+            "shared builtin env:" };
+    StopWatch sw;
+    double baseline = 0;
+    for (int shared = 0; shared < 2; ++shared) {
+        SimpleInterpreter::builtin_env();
+        AllocSnapshot snapshot;
+        sw.reset();
+        sw.start();
+        for (size_t i = 0; i < count; ++i) {
+            if (shared) {
+                SimpleInterpreter interpreter;
+                if (!interpreter.initialize()) {
+                    REPORT("  failed initializing interpreter!");
+                    return EXIT_FAILURE;
+                }
+            }
+            else {
+                InterpreterIF interpreter(new SimpleParser(),
+                        InterpreterIF::create_builtin_env(),
+                        new SimpleMatterFactory());
+                if (!interpreter.initialize()) {
+                    REPORT("  failed initializing interpreter!");
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+        sw.stop();
+
+        double per_second = count / sw.timecost();
+        baseline = shared ? baseline : per_second;
+        REPORT("  %-22s %10.0f interpreters/s, %6.2fx, %6.1f allocations, "
+                "%8.1f bytes per interpreter", names[shared], per_second,
+                per_second / baseline,
+                static_cast<double>(snapshot.count_since()) / count,
+                static_cast<double>(snapshot.bytes_since()) / count);
+    }
+
+    SimpleInterpreter interpreter;
+    MatterPtr result = NULL;
+    if (!interpreter.initialize()
+            || !interpreter.execute(result, "(max3 (inc 1) math-e 0)")) {
+        REPORT("  the builtin env does not work!");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static int bench_pool(int argc, char ** argv)
+{
+    size_t definitions = size_arg(argc, argv, 1, 200);
+    size_t requests = size_arg(argc, argv, 2, 4000);
+    size_t threads = size_arg(argc, argv, 3, 8);
+    size_t interpreters = size_arg(argc, argv, 4, 4);
+    if (!threads || !interpreters) {
+        REPORT("  threads and interpreters MUST NOT be 0!");
+        return EXIT_FAILURE;
+    }
+    std::string setup = generate_definitions(definitions);
+
+    REPORT("pool: %zu requests on %zu threads, setup of %zu definitions",
+            requests, threads, definitions);
+
+    // 0: an interpreter created, and set up, for every request,
+    // 1: leased from a pool of `interpreters', reset when returned
+    static const char * names[] = { "interpreter per request:",
+            "interpreter pool:" };
+    InterpreterPool pool(interpreters, setup.c_str());
+    StopWatch sw;
+    double baseline = 0;
+    for (int pooled = 0; pooled < 2; ++pooled) {
+        // initialized here, for the utilization of this round only
+        if (pooled && !pool.initialize()) {
+            REPORT("  failed initializing the pool!");
+            return EXIT_FAILURE;
+        }
+        std::vector<size_t> failures(threads, 0);
+        std::vector<std::thread> workers;
+        sw.reset();
+        sw.start();
+        for (size_t t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([=, &pool, &setup, &failures]() {
+                for (size_t i = t; i < requests; i += threads) {
+                    char request[64];
+                    snprintf(request, sizeof(request),
+                            "(define r %zu) (f0 r)", i);
+                    MatterPtr result = NULL;
+                    if (pooled) {
+                        InterpreterPool::Lease lease = pool.acquire();
+                        if (!lease || !lease->execute(result, request)) {
+                            ++failures[t];
+                        }
+                    }
+                    else {
+                        SimpleInterpreter interpreter;
+                        if (!interpreter.initialize()
+                                || !interpreter.execute(result, setup.c_str())
+                                || !interpreter.execute(result, request)) {
+                            ++failures[t];
+                        }
+                    }
+                }
+            }));
+        }
+        for (size_t t = 0; t < threads; ++t) {
+            workers[t].join();
+            if (failures[t]) {
+                REPORT("  %zu requests failed!", failures[t]);
+                return EXIT_FAILURE;
+            }
+        }
+        sw.stop();
+
+        double per_second = requests / sw.timecost();
+        baseline = pooled ? baseline : per_second;
+        REPORT("  %-26s %10.0f requests/s, %6.2fx", names[pooled],
+                per_second, per_second / baseline);
+    }
+
+    InterpreterPool::Stats stats = pool.stats();
+    REPORT("  %zu interpreters: %llu acquisitions, %llu waited, "
+            "%.1f us average wait, %llu us max, %zu in use at most, "
+            "%.1f%% utilization", pool.size(),
+            (unsigned long long) stats.acquisitions,
+            (unsigned long long) stats.waits,
+            stats.waits ? static_cast<double>(stats.total_wait_usec)
+                    / stats.waits : 0.0,
+            (unsigned long long) stats.max_wait_usec, stats.max_in_use,
+            stats.utilization * 100);
+    return EXIT_SUCCESS;
+}
+
+static int bench_prepared(int argc, char ** argv)
+{
+    size_t count = size_arg(argc, argv, 1, 200000);
+    static const char * rule = "(if (> (+ (* price quantity) fee) limit) "
+            "(- limit fee) (+ (* price quantity) fee))";
+
+    REPORT("prepared: a rule of 3 inputs evaluated %zu times", count);
+
+    SimpleInterpreter interpreter;
+    MatterPtr result = NULL;
+    if (!interpreter.initialize()
+            || !interpreter.execute(result, "(define limit 5000)")) {
+        REPORT("  failed initializing interpreter!");
+        return EXIT_FAILURE;
+    }
+    std::vector<std::string> params;
+    params.push_back("price");
+    params.push_back("quantity");
+    params.push_back("fee");
+    PreparedExpr prepared = interpreter.prepare(rule, params);
+    if (!prepared) {
+        REPORT("  failed preparing the rule!");
+        return EXIT_FAILURE;
+    }
+
+    // 0: the inputs bound by a `let' around the rule, parsed every time,
+    // 1: prepared once, the inputs bound by eval()
+    static const char * names[] = { "execute, let bindings:",
+            "prepare once, eval:" };
+    StopWatch sw;
+    double baseline = 0;
+    int64_t sums[2] = { 0, 0 };
+    for (int mode = 0; mode < 2; ++mode) {
+        std::string text;
+        char bindings[96];
+        std::vector<MatterPtr> args(3);
+        AllocSnapshot snapshot;
+        sw.reset();
+        sw.start();
+        for (size_t i = 0; i < count; ++i) {
+            int64_t price = i % 97, quantity = i % 89, fee = i % 7;
+            bool ok;
+            if (mode) {
+                for (size_t a = 0; a < 3; ++a) {
+                    AtomPtr atom = Atom::create();
+                    atom->set_i64(a == 0 ? price : a == 1 ? quantity : fee);
+                    args[a] = atom;
+                }
+                ok = interpreter.eval(prepared, result, args);
+            }
+            else {
+                snprintf(bindings, sizeof(bindings),
+                        "(let (price %lld quantity %lld fee %lld) ",
+                        (long long) price, (long long) quantity,
+                        (long long) fee);
+                text = bindings;
+                text += rule;
+                text += ")";
+                ok = interpreter.execute(result, text.data(), text.size());
+            }
+            int64_t value = 0;
+            if (!ok || !result || !result->is_atom()
+                    || !static_cast<Atom *>(result.get())->to_i64(value)) {
+                REPORT("  failed evaluating the rule!");
+                return EXIT_FAILURE;
+            }
+            sums[mode] += value;
+        }
+        sw.stop();
+
+        double per_second = count / sw.timecost();
+        baseline = mode ? baseline : per_second;
+        REPORT("  %-24s %10.0f evaluations/s, %6.2fx, %6.1f allocations "
+                "per evaluation", names[mode], per_second,
+                per_second / baseline,
+                static_cast<double>(snapshot.count_since()) / count);
+    }
+    if (sums[0] != sums[1]) {
+        REPORT("  results differ!");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static int bench_parse_cache(int argc, char ** argv)
+{
+    size_t count = size_arg(argc, argv, 1, 200000);
+    size_t distinct = size_arg(argc, argv, 2, 64);
+    size_t capacity = size_arg(argc, argv, 3, 128);
+    if (!distinct) {
+        REPORT("  distinct inputs MUST NOT be 0!");
+        return EXIT_FAILURE;
+    }
+
+    REPORT("parse cache: %zu executions of %zu distinct inputs, "
+            "%zu entries", count, distinct, capacity);
+
+    std::vector<std::string> inputs;
+    char input[128];
+    for (size_t i = 0; i < distinct; ++i) {
+        snprintf(input, sizeof(input), "(if (> (* x %zu) 100) "
+                "(- (* x %zu) 100) (+ x %zu))", i, i, i);
+        inputs.push_back(input);
+    }
+
+    static const char * names[] = { "parse every time:", "parse cache:" };
+    StopWatch sw;
+    double baseline = 0;
+    for (int cached = 0; cached < 2; ++cached) {
+        SimpleInterpreter interpreter;
+        MatterPtr result = NULL;
+        if (!interpreter.initialize()
+                || !interpreter.execute(result, "(define x 7)")) {
+            REPORT("  failed initializing interpreter!");
+            return EXIT_FAILURE;
+        }
+        interpreter.set_parse_cache(cached ? capacity : 0);
+
+        sw.reset();
+        sw.start();
+        for (size_t i = 0; i < count; ++i) {
+            const std::string &text = inputs[i % distinct];
+            if (!interpreter.execute(result, text.data(), text.size())) {
+                REPORT("  failed executing `%s'!", text.c_str());
+                return EXIT_FAILURE;
+            }
+        }
+        sw.stop();
+
+        double per_second = count / sw.timecost();
+        baseline = cached ? baseline : per_second;
+        ParseCache::Stats stats = interpreter.parse_cache().stats();
+        REPORT("  %-18s %10.0f executions/s, %6.2fx, %llu hits, %llu misses, "
+                "%llu evictions", names[cached], per_second,
+                per_second / baseline, (unsigned long long) stats.hits,
+                (unsigned long long) stats.misses,
+                (unsigned long long) stats.evictions);
+    }
+    return EXIT_SUCCESS;
+}
+
+static int bench_batch(int argc, char ** argv)
+{
+    size_t rows = size_arg(argc, argv, 1, 200000);
+    static const char * expr = "(and (> (- (* price quantity) discount) "
+            "limit) (not flagged))";
+
+    REPORT("batch: a predicate of 4 columns over %zu rows, %s kernels",
+            rows, VectorKernels::isa_name(VectorKernels::best_isa()));
+
+    SimpleInterpreter interpreter;
+    MatterPtr result = NULL;
+    if (!interpreter.initialize()
+            || !interpreter.execute(result, "(define limit 1000.0)")) {
+        REPORT("  failed initializing interpreter!");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> names;
+    names.push_back("price");
+    names.push_back("quantity");
+    names.push_back("discount");
+    names.push_back("flagged");
+    std::vector<double> price(rows);
+    std::vector<int64_t> quantity(rows);
+    std::vector<int64_t> discount(rows);
+    bool * flagged = new (std::nothrow) bool[rows ? rows : 1];
+    if (!flagged) {
+        return EXIT_FAILURE;
+    }
+    Utils::Prng prng(1);
+    for (size_t i = 0; i < rows; ++i) {
+        // exact in binary, for the products to be the same as in `long
+        // double', which the row at a time evaluation uses
+        price[i] = (prng.random_u32() % 400) * 0.25;
+        quantity[i] = prng.random_u32() % 50;
+        discount[i] = prng.random_u32() % 200;
+        flagged[i] = prng.random_u32() % 10 == 0;
+    }
+
+    // 0: a prepared expression evaluated for every row, atoms bound,
+    // 1: compiled once, evaluated a chunk of every column at a time
+    static const char * labels[] = { "row at a time:", "column at a time:" };
+    StopWatch sw;
+    double baseline = 0;
+    size_t selected[2] = { 0, 0 };
+    for (int batch = 0; batch < 2; ++batch) {
+        sw.reset();
+        sw.start();
+        if (batch) {
+            BatchExpr compiled;
+            std::vector<Column> columns;
+            columns.push_back(Column(&price[0], rows));
+            columns.push_back(Column(&quantity[0], rows));
+            columns.push_back(Column(&discount[0], rows));
+            columns.push_back(Column(flagged, rows));
+            BatchResult out;
+            if (!compiled.compile(&interpreter, expr, names)
+                    || !compiled.evaluate(columns, out)) {
+                REPORT("  failed evaluating in batch!");
+                delete[] flagged;
+                return EXIT_FAILURE;
+            }
+            selected[batch] = out.selected;
+        }
+        else {
+            PreparedExpr prepared = interpreter.prepare(expr, names);
+            std::vector<MatterPtr> args(4);
+            for (size_t i = 0; prepared && i < rows; ++i) {
+                AtomPtr atoms[4] = { Atom::create(), Atom::create(),
+                        Atom::create(), Atom::create() };
+                atoms[0]->set_double(price[i]);
+                atoms[1]->set_i64(quantity[i]);
+                atoms[2]->set_i64(discount[i]);
+                atoms[3]->set_bool(flagged[i]);
+                for (size_t a = 0; a < 4; ++a) {
+                    args[a] = atoms[a];
+                }
+                if (!interpreter.eval(prepared, result, args)) {
+                    break;
+                }
+                selected[batch] += static_cast<Atom *>(result.get())
+                        ->not_empty();
+            }
+        }
+        sw.stop();
+
+        double per_second = rows / sw.timecost();
+        baseline = batch ? baseline : per_second;
+        REPORT("  %-18s %12.0f rows/s, %7.2fx, %zu selected", labels[batch],
+                per_second, per_second / baseline, selected[batch]);
+    }
+    delete[] flagged;
+
+    if (selected[0] != selected[1]) {
+        REPORT("  selections differ!");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static int bench_native(int argc, char ** argv)
+{
+    size_t count = size_arg(argc, argv, 1, 200000);
+
+    REPORT("native: clamp of 3 operands called %zu times", count);
+
+    SimpleInterpreter interpreter;
+    MatterPtr result = NULL;
+    if (!interpreter.initialize()
+            || !interpreter.execute(result, "(defn lisp-clamp (x lo hi) "
+                    "(if (< x lo) lo (if (> x hi) hi x)))")
+            || !interpreter.register_fn("native-clamp",
+                    [](double x, double lo, double hi) {
+                        return x < lo ? lo : (x > hi ? hi : x);
+                    })) {
+        REPORT("  failed initializing interpreter!");
+        return EXIT_FAILURE;
+    }
+
+    static const char * names[] = { "lisp defn:", "register_fn():" };
+    static const char * calls[] = { "(lisp-clamp x 10 90)",
+            "(native-clamp x 10 90)" };
+    std::vector<std::string> params(1, "x");
+    StopWatch sw;
+    double baseline = 0;
+    double sums[2] = { 0, 0 };
+    for (int mode = 0; mode < 2; ++mode) {
+        PreparedExpr call = interpreter.prepare(calls[mode], params);
+        if (!call) {
+            REPORT("  failed preparing the call!");
+            return EXIT_FAILURE;
+        }
+        std::vector<MatterPtr> args(1);
+        AllocSnapshot snapshot;
+        sw.reset();
+        sw.start();
+        for (size_t i = 0; i < count; ++i) {
+            AtomPtr x = Atom::create();
+            x->set_double((i % 400) * 0.25);
+            args[0] = x;
+            long double value = 0;
+            if (!interpreter.eval(call, result, args) || !result
+                    || !result->is_atom()
+                    || !static_cast<Atom *>(result.get())->to_long_double(
+                            value)) {
+                REPORT("  failed calling clamp!");
+                return EXIT_FAILURE;
+            }
+            sums[mode] += static_cast<double>(value);
+        }
+        sw.stop();
+
+        double per_second = count / sw.timecost();
+        baseline = mode ? baseline : per_second;
+        REPORT("  %-24s %10.0f calls/s, %6.2fx, %6.1f allocations per call",
+                names[mode], per_second, per_second / baseline,
+                static_cast<double>(snapshot.count_since()) / count);
+    }
+    if (sums[0] != sums[1]) {
+        REPORT("  results differ!");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Description:
+ *   Memory of the process `pid', in KB, the pages not shared with any other
+ *   process, and the proportional set size (shared pages divided by the
+ *   number of processes sharing them).
+ */
+static bool process_memory(pid_t pid, size_t &private_kb, size_t &pss_kb)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/smaps_rollup", (int) pid);
+    FILE * fp = fopen(path, "r");
+    if (!fp) {
+        return false;
+    }
+
+    private_kb = 0;
+    pss_kb = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+        size_t kb = 0;
+        if (sscanf(line, "Private_Clean: %zu kB", &kb) == 1
+                || sscanf(line, "Private_Dirty: %zu kB", &kb) == 1) {
+            private_kb += kb;
+        }
+        else if (sscanf(line, "Pss: %zu kB", &kb) == 1) {
+            pss_kb = kb;
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+static int bench_workers(int argc, char ** argv)
+{
+    size_t definitions = size_arg(argc, argv, 1, 20000);
+    size_t requests = size_arg(argc, argv, 2, 20000);
+    size_t workers = size_arg(argc, argv, 3, 4);
+    std::string defs = generate_definitions(definitions);
+
+    // every request calls a procedure, and reads a value, all over the heap
+    std::vector<std::string> batch;
+    char form[128];
+    for (size_t i = 0; i < 1000 && definitions >= 4; ++i) {
+        size_t k = (i * 7919 % (definitions / 4)) * 4;
+        snprintf(form, sizeof(form), "(+ (f%zu 3) v%zu)", k, k + 1);
+        batch.push_back(form);
+    }
+    if (batch.empty()) {
+        REPORT("  at least 4 definitions!");
+        return EXIT_FAILURE;
+    }
+
+    REPORT("workers: %zu definitions, %zu requests, %zu workers", definitions,
+            requests, workers);
+
+    StopWatch sw;
+    static const char * names[] = { "forked:", "forked, frozen:" };
+    for (int frozen = 0; frozen < 2; ++frozen) {
+        SimpleInterpreter interpreter;
+        MatterPtr result = NULL;
+        sw.reset();
+        sw.start();
+        bool ok = interpreter.initialize()
+                && interpreter.execute(result, defs.data(), defs.size());
+        sw.stop();
+        double initialize = sw.timecost();
+        if (frozen) {
+            sw.reset();
+            sw.start();
+            ok = ok && interpreter.freeze();
+            sw.stop();
+            REPORT("  freeze: %.3f s", sw.timecost());
+        }
+
+        WorkerPool pool(&interpreter, workers);
+        sw.reset();
+        sw.start();
+        ok = ok && pool.start();
+        sw.stop();
+        double start = sw.timecost();
+        if (!ok) {
+            REPORT("  %s cannot start the workers!", names[frozen]);
+            return EXIT_FAILURE;
+        }
+
+        sw.reset();
+        sw.start();
+        size_t failed = 0;
+        for (size_t done = 0; done < requests; done += batch.size()) {
+            std::vector<std::string> responses;
+            if (!pool.execute(batch, responses)) {
+                REPORT("  %s execute() failed!", names[frozen]);
+                return EXIT_FAILURE;
+            }
+            for (size_t i = 0; i < responses.size(); ++i) {
+                failed += responses[i].compare(0, 2, "ok") ? 1 : 0;
+            }
+        }
+        sw.stop();
+        size_t executed = (requests + batch.size() - 1) / batch.size()
+                * batch.size();
+
+        size_t private_kb = 0;
+        size_t pss_kb = 0;
+        for (size_t i = 0; i < pool.workers(); ++i) {
+            size_t kb = 0;
+            size_t pss = 0;
+            if (process_memory(pool.worker_pid(i), kb, pss)) {
+                private_kb += kb;
+                pss_kb += pss;
+            }
+        }
+        size_t parent_private = 0;
+        size_t parent_pss = 0;
+        process_memory(getpid(), parent_private, parent_pss);
+
+        REPORT("  %-16s initialize %.3f s (once, not per worker), fork %.3f s",
+                names[frozen], initialize, start);
+        REPORT("  %-16s %10.0f requests/s, %zu failed", "", executed
+                / sw.timecost(), failed);
+        REPORT("  %-16s per worker: %zu KB private, %zu KB pss, parent: "
+                "%zu KB pss", "", private_kb / pool.workers(),
+                pss_kb / pool.workers(), parent_pss);
+    }
+    return EXIT_SUCCESS;
+}
+
+static const BenchCase cases[] = {
+    { "parse", "[script-bytes] [rounds]",
+      "parse throughput and memory, views vs strings, small-vector vs std::deque",
+      bench_parse },
+    { "vector", "[elements] [rounds]",
+      "SIMD vector kernels, and vec-sum vs recursive Lisp", bench_vector },
+    { "hashmap", "[entries] [lookups]",
+      "keyed lookups, HashMap vs std::map, get vs cond", bench_hashmap },
+    { "maps", "[entries] [versions]",
+      "derived map versions, PersistentMap vs copying HashMap", bench_maps },
+    { "frames", "[depth] [rounds]",
+      "procedure calls, frames on the stack vs on the heap", bench_frames },
+    { "gc", "[forms]",
+      "cycle collector throughput and pauses vs threshold", bench_gc },
+    { "scan", "[script-bytes] [rounds]",
+      "structural index GB/s per instruction set, and tokenizer", bench_scan },
+    { "reader", "[script-bytes]",
+      "script file statements, copied lines vs mapped views", bench_reader },
+    { "stream", "[script-bytes]",
+      "parsing chunked input, feed() vs buffer and reparse", bench_stream },
+    { "load", "[script-bytes] [max-threads]",
+      "parallel parsing of a large script vs thread count", bench_load },
+    { "cache", "[script-bytes]",
+      "startup from a precompiled cache vs parsing the script", bench_cache },
+    { "snapshot", "[definitions]",
+      "startup from a heap snapshot vs executing the definitions",
+      bench_snapshot },
+    { "interpreters", "[interpreters]",
+      "interpreter construction, shared vs private builtin env",
+      bench_interpreters },
+    { "pool", "[definitions] [requests] [threads] [size]",
+      "interpreter pool leases vs an interpreter per request", bench_pool },
+    { "prepared", "[evaluations]",
+      "prepared expression vs parsing the rule every time",
+      bench_prepared },
+    { "parse-cache", "[executions] [distinct] [entries]",
+      "execute() of repeated inputs, LRU parse cache vs none",
+      bench_parse_cache },
+    { "batch", "[rows]",
+      "columnar batch evaluation vs row at a time", bench_batch },
+    { "native", "[calls]",
+      "typed native procedure vs the same procedure in lisp", bench_native },
+    { "workers", "[definitions] [requests] [workers]",
+      "forked worker pool, heap shared copy-on-write, frozen or not",
+      bench_workers },
+    { "atoms", "[atoms] [rounds]",
+      "literal conversion, first byte classifier vs C library", bench_atoms },
+};
+
+static void usage(const char * prog)
+{
+    REPORT("usage: %s <all | benchmark> [args ...]", prog);
+    REPORT("benchmarks:");
+    for (size_t i = 0; i < array_size(cases); ++i) {
+        REPORT("  %-8s %-28s %s", cases[i].name, cases[i].args, cases[i].desc);
+    }
+}
+
+} // namespace Bench
+} // namespace SolarWindLisp
+
+int main(int argc, char ** argv)
+{
+    using SolarWindLisp::Bench::cases;
+
+    if (argc < 2) {
+        SolarWindLisp::Bench::usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    int ret = EXIT_SUCCESS;
+    bool found = false;
+    for (size_t i = 0; i < array_size(cases); ++i) {
+        if (!strcmp(argv[1], "all")) {
+            char * args[] = { const_cast<char *>(cases[i].name), NULL };
+            found = true;
+            if (cases[i].func(1, args) != EXIT_SUCCESS) {
+                ret = EXIT_FAILURE;
+            }
+        }
+        else if (!strcmp(argv[1], cases[i].name)) {
+            found = true;
+            ret = cases[i].func(argc - 1, argv + 1);
+        }
+    }
+
+    if (!found) {
+        SolarWindLisp::Bench::usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    exit(ret);
+}
@@ -0,0 +1,210 @@
+/*
+ * file name:           src/cycle_collector.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 21:30:48 2026 CST
+ */
+
+#include <string.h>
+#include <functional>
+#include <unordered_map>
+#include "cycle_collector.h"
+#include "scoped_env.h"
+#include "proc.h"
+#include "future.h"
+#include "utils.h"
+
+namespace SolarWindLisp
+{
+
+CycleCollector::CycleCollector(size_t threshold) :
+        _threshold(threshold), _allocated(0), _survivors(0)
+{
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void CycleCollector::track(const ScopedEnvPtr &env)
+{
+    _envs.push_back(env);
+    ++_allocated;
+}
+
+void CycleCollector::track(const ProcPtr &proc)
+{
+    _procs.push_back(proc);
+    ++_allocated;
+}
+
+void CycleCollector::track(const FuturePtr &future)
+{
+    _futures.push_back(future);
+    ++_allocated;
+}
+
+void CycleCollector::forget()
+{
+    _envs.clear();
+    _procs.clear();
+    _futures.clear();
+    _allocated = 0;
+    _survivors = 0;
+    _stats.tracked = 0;
+}
+
+namespace
+{
+
+/*
+ * Lock the live objects of `registry', and drop the dead ones.
+ */
+template<typename T>
+void lock_all(std::vector<boost::weak_ptr<T> > &registry,
+        std::vector<boost::shared_ptr<T> > &live)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < registry.size(); ++i) {
+        boost::shared_ptr<T> p = registry[i].lock();
+        if (p) {
+            live.push_back(p);
+            registry[kept++].swap(registry[i]);
+        }
+    }
+    registry.resize(kept);
+}
+
+} // anonymous namespace
+
+size_t CycleCollector::collect()
+{
+    int64_t start = Utils::Time::timestamp_usec();
+
+    std::vector<ScopedEnvPtr> envs;
+    std::vector<ProcPtr> procs;
+    std::vector<FuturePtr> futures;
+    lock_all(_envs, envs);
+    lock_all(_procs, procs);
+    lock_all(_futures, futures);
+
+    // objects are numbered: envs first, then procs, then futures
+    size_t n_envs = envs.size();
+    size_t n_procs = procs.size();
+    size_t total = n_envs + n_procs + futures.size();
+
+    std::unordered_map<const void *, size_t> index;
+    index.reserve(total);
+    std::vector<long> refs(total);
+    for (size_t i = 0; i < n_envs; ++i) {
+        index[envs[i].get()] = i;
+        refs[i] = envs[i].use_count() - 1; // minus the one locked above
+    }
+    for (size_t i = 0; i < n_procs; ++i) {
+        index[static_cast<const MatterIF *>(procs[i].get())] = n_envs + i;
+        refs[n_envs + i] = procs[i].use_count() - 1;
+    }
+    for (size_t i = 0; i < futures.size(); ++i) {
+        index[static_cast<const MatterIF *>(futures[i].get())] =
+                n_envs + n_procs + i;
+        refs[n_envs + n_procs + i] = futures[i].use_count() - 1;
+    }
+
+    // call `visit(idx)' on every tracked object referenced by object `i'
+    auto for_each_ref = [&](size_t i, const std::function<void(size_t)> &visit) {
+        std::unordered_map<const void *, size_t>::const_iterator found;
+        auto follow = [&](const void * p) {
+            if (p && (found = index.find(p)) != index.end()) {
+                visit(found->second);
+            }
+        };
+        auto follow_matter = [&](const MatterPtr &m) {
+            if (m && (m->is_proc() || m->is_future())) {
+                follow(m.get());
+            }
+        };
+
+        if (i < n_envs) {
+            const ScopedEnv * env = envs[i].get();
+            follow(env->_external.get());
+            for (ScopedEnv::CONST_ITER it = env->_current.begin();
+                    it != env->_current.end(); ++it) {
+                follow_matter(it->second);
+            }
+        }
+        else if (i < n_envs + n_procs) {
+            follow(procs[i - n_envs]->_env.get());
+        }
+        else {
+            const Future * future = futures[i - n_envs - n_procs].get();
+            follow(future->_env.get());
+            follow_matter(future->_value);
+        }
+    };
+
+    // 1. subtract internal references
+    for (size_t i = 0; i < total; ++i) {
+        for_each_ref(i, [&](size_t t) { --refs[t]; });
+    }
+
+    // 2. everything reachable from an externally referenced object is alive
+    std::vector<bool> alive(total, false);
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < total; ++i) {
+        if (refs[i] > 0) {
+            alive[i] = true;
+            pending.push_back(i);
+        }
+    }
+    while (!pending.empty()) {
+        size_t i = pending.back();
+        pending.pop_back();
+        for_each_ref(i, [&](size_t t) {
+            if (!alive[t]) {
+                alive[t] = true;
+                pending.push_back(t);
+            }
+        });
+    }
+
+    // 3. break the cycles among the rest
+    size_t collected = 0;
+    for (size_t i = 0; i < total; ++i) {
+        if (alive[i]) {
+            continue;
+        }
+
+        ++collected;
+        if (i < n_envs) {
+            envs[i]->clear();
+        }
+        else if (i < n_envs + n_procs) {
+            procs[i - n_envs]->_env.reset();
+        }
+        else {
+            Future * future = futures[i - n_envs - n_procs].get();
+            future->_env.reset();
+            future->_value.reset();
+        }
+    }
+
+    // garbage is released with the locked pointers
+    envs.clear();
+    procs.clear();
+    futures.clear();
+
+    _survivors = total - collected;
+    _allocated = 0;
+
+    uint64_t pause = static_cast<uint64_t>(Utils::Time::timestamp_usec() - start);
+    ++_stats.collections;
+    _stats.collected += collected;
+    _stats.tracked = _survivors;
+    _stats.last_pause_usec = pause;
+    _stats.total_pause_usec += pause;
+    if (pause > _stats.max_pause_usec) {
+        _stats.max_pause_usec = pause;
+    }
+
+    return collected;
+}
+
+} // namespace SolarWindLisp
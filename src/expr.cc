@@ -7,10 +7,14 @@
  */
 
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <new>
 #include <limits>
+#include <vector>
 #include "expr.h"
+#include "symbol_table.h"
 
 namespace SolarWindLisp
 {
@@ -42,7 +46,8 @@ const char * Atom::atom_type_name(Atom::atom_type_t t)
 const char Atom::AtomData::C_SQ;
 const char Atom::AtomData::C_DQ;
 
-bool Atom::AtomData::set_string(const char * buf, size_t length)
+bool Atom::AtomData::set_string(const char * buf, size_t length,
+        SymbolTable * symbols)
 {
     size_t actual_length = length;
     const char * actual_pos = buf;
@@ -57,6 +62,34 @@ bool Atom::AtomData::set_string(const char * buf, size_t length)
         }
     }
 
+    return set_text(actual_pos, actual_length, is_quoted, symbols);
+}
+
+bool Atom::AtomData::set_text(const char * actual_pos, size_t actual_length,
+        bool is_quoted, SymbolTable * symbols)
+{
+    if (str.interned) {
+        // not ours to reuse or free
+        str.buffer = NULL;
+        str.size = 0;
+        str.interned = false;
+    }
+
+    if (symbols && !is_quoted) {
+        const char * text = symbols->intern(actual_pos, actual_length);
+        if (!text) {
+            return false;
+        }
+
+        free(str.buffer);
+        str.buffer = const_cast<char *>(text);
+        str.size = 0;
+        str.length = actual_length;
+        str.quoted = false;
+        str.interned = true;
+        return true;
+    }
+
     if (str.size >= actual_length + 1) {
         // reuse existing buffer
         str.length = 0;
@@ -85,11 +118,11 @@ bool Atom::AtomData::set_string(const char * buf, size_t length)
     return true;
 }
 
-AtomPtr Atom::create(const char * buf, size_t length)
+AtomPtr Atom::create(const char * buf, size_t length, SymbolTable * symbols)
 {
     Atom * result = new (std::nothrow) Atom();
     if (result) {
-        if (!buf || result->parse(buf, length)) {
+        if (!buf || result->parse(buf, length, symbols)) {
             return AtomPtr(result);
         }
 
@@ -100,10 +133,290 @@ AtomPtr Atom::create(const char * buf, size_t length)
     return AtomPtr(result);
 }
 
-bool Atom::parse(const char * buf, size_t length)
+namespace
+{
+
+enum literal_class_t
+{
+    literal_symbol = 0,     // symbols and strings, never numbers
+    literal_number,         // digits, signs and the decimal point
+    literal_bool,           // `t' and `f'
+    literal_special,        // inf, nan, leading spaces, see parse_generic()
+};
+
+struct LiteralClasses
+{
+    unsigned char table[256];
+
+    LiteralClasses()
+    {
+        memset(table, literal_symbol, sizeof(table));
+        for (int c = '0'; c <= '9'; ++c) {
+            table[c] = literal_number;
+        }
+        table['+'] = table['-'] = table['.'] = literal_number;
+        table['t'] = table['f'] = literal_bool;
+        table['i'] = table['I'] = table['n'] = table['N'] = literal_special;
+        const char * spaces = " \t\n\v\f\r";
+        for (const char * p = spaces; *p; ++p) {
+            table[static_cast<unsigned char>(*p)] = literal_special;
+        }
+    }
+};
+
+const LiteralClasses g_literal_classes;
+
+enum number_result_t
+{
+    number_none = 0,    // not a number, but a symbol
+    number_done,
+    number_unsure,      // e.g. overflow, left to the C library
+};
+
+inline bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline int hex_digit(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    c |= 0x20;
+    return (c >= 'a' && c <= 'f') ? c - 'a' + 10 : -1;
+}
+
+const double g_exact_powers_of_10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+    1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+} // anonymous namespace
+
+/*
+ * Same results as parse_integer() then parse_real(), which are based on
+ * strtol(), strtoul() and strtod(), for the usual forms:
+ *   [+-]digits             i32 or i64
+ *   0x hex-digits          u32 or u64
+ *   0 octal-digits         u32 or u64
+ *   [+-]digits.digits e[+-]digits, as long as exact in double (the fast path
+ *   of Clinger), like 3.14159, -0.5 or 1e10
+ */
+static number_result_t parse_number(const char * buf, size_t length,
+        Atom &atom)
+{
+    const char * p = buf;
+    const char * end = buf + length;
+    bool negative = false;
+    if (*p == '+' || *p == '-') {
+        negative = *p == '-';
+        if (++p == end) {
+            return number_none;
+        }
+        if (g_literal_classes.table[static_cast<unsigned char>(*p)]
+                == literal_special) {
+            return number_unsure; // e.g. -inf
+        }
+    }
+
+    // hexadecimal or octal, no sign allowed
+    bool octal_failed = false;
+    if (p == buf && *p == '0' && length > 1) {
+        uint64_t v = 0;
+        if (length > 2 && (p[1] == 'x' || p[1] == 'X')) {
+            if (length > 2 + 16) {
+                return number_unsure;
+            }
+            for (p += 2; p < end; ++p) {
+                int d = hex_digit(*p);
+                if (d < 0) {
+                    return number_unsure; // e.g. 0x1p3, a real in hex
+                }
+                v = (v << 4) | d;
+            }
+        }
+        else {
+            if (p[1] == '+' || p[1] == '-' || g_literal_classes.table[
+                    static_cast<unsigned char>(p[1])] == literal_special) {
+                return number_unsure; // accepted by strtoul(), e.g. 0-1
+            }
+            for (++p; p < end && *p >= '0' && *p <= '7'; ++p) {
+                v = (v << 3) | (*p - '0');
+            }
+            if (p == end && length <= 1 + 21) {
+                if (v <= UINT32_MAX) {
+                    atom.set_u32(static_cast<uint32_t>(v));
+                }
+                else {
+                    atom.set_u64(v);
+                }
+                return number_done;
+            }
+            else if (p == end) {
+                return number_unsure;
+            }
+
+            // not octal, e.g. 0.5 or 09 which are reals
+            p = buf;
+            v = 0;
+            octal_failed = true;
+        }
+
+        if (p == end) {
+            if (v <= UINT32_MAX) {
+                atom.set_u32(static_cast<uint32_t>(v));
+            }
+            else {
+                atom.set_u64(v);
+            }
+            return number_done;
+        }
+    }
+
+    // [digits][.digits][e[+-]digits]
+    uint64_t mantissa = 0;
+    int digits = 0;         // significant digits in `mantissa'
+    int exponent = 0;
+    bool any_digit = false;
+    for (; p < end && is_digit(*p); ++p) {
+        any_digit = true;
+        if (mantissa || *p != '0') {
+            if (++digits > 19) {
+                return number_unsure;
+            }
+            mantissa = mantissa * 10 + (*p - '0');
+        }
+    }
+
+    if (p == end) {
+        if (!any_digit) {
+            return number_none;
+        }
+
+        if (octal_failed) {
+            // e.g. 09, left to strtod()
+            if (mantissa > (static_cast<uint64_t>(1) << 53)) {
+                return number_unsure;
+            }
+            atom.set_double(static_cast<double>(mantissa));
+            return number_done;
+        }
+
+        // an integer, same ranges as strtol()
+        if (negative ? mantissa > static_cast<uint64_t>(INT64_MAX) + 1
+                : mantissa > static_cast<uint64_t>(INT64_MAX)) {
+            return number_unsure;
+        }
+
+        int64_t v = negative ? static_cast<int64_t>(0 - mantissa)
+                : static_cast<int64_t>(mantissa);
+        if (v >= INT32_MIN && v <= INT32_MAX) {
+            atom.set_i32(static_cast<int32_t>(v));
+        }
+        else {
+            atom.set_i64(v);
+        }
+        return number_done;
+    }
+
+    if (*p == '.') {
+        for (++p; p < end && is_digit(*p); ++p) {
+            any_digit = true;
+            if (mantissa || *p != '0') {
+                if (++digits > 19) {
+                    return number_unsure;
+                }
+                mantissa = mantissa * 10 + (*p - '0');
+            }
+            --exponent;
+        }
+    }
+
+    if (!any_digit) {
+        return number_none;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char * q = p + 1;
+        bool negative_exponent = false;
+        if (q < end && (*q == '+' || *q == '-')) {
+            negative_exponent = *q == '-';
+            ++q;
+        }
+        if (q == end || !is_digit(*q)) {
+            return number_none; // e.g. 1e, strtod() stops before `e'
+        }
+
+        int e = 0;
+        for (; q < end && is_digit(*q); ++q) {
+            if (e > 10000) {
+                return number_unsure;
+            }
+            e = e * 10 + (*q - '0');
+        }
+        exponent += negative_exponent ? -e : e;
+        p = q;
+    }
+
+    if (p != end) {
+        // e.g. -0x1p3, a real in hex, or 12abc which is not a number
+        return (*p == 'x' || *p == 'X') ? number_unsure : number_none;
+    }
+
+    // exact operands, so rounded once, like strtod()
+    if (mantissa > (static_cast<uint64_t>(1) << 53)
+            || exponent < -22 || exponent > 22) {
+        return number_unsure;
+    }
+
+    double d = static_cast<double>(mantissa);
+    if (exponent < 0) {
+        d /= g_exact_powers_of_10[-exponent];
+    }
+    else {
+        d *= g_exact_powers_of_10[exponent];
+    }
+    atom.set_double(negative ? -d : d);
+    return number_done;
+}
+
+bool Atom::parse(const char * buf, size_t length, SymbolTable * symbols)
+{
+    if (!length) {
+        return parse_cstr(buf, length, symbols);
+    }
+
+    switch (g_literal_classes.table[static_cast<unsigned char>(buf[0])]) {
+        case literal_number:
+            switch (parse_number(buf, length, *this)) {
+                case number_done:
+                    return true;
+                case number_none:
+                    return parse_cstr(buf, length, symbols);
+                default:
+                    break;
+            }
+            break;
+        case literal_bool:
+            return parse_bool(buf, length)
+                    || parse_cstr(buf, length, symbols);
+        case literal_special:
+            break;
+        default:
+            return parse_cstr(buf, length, symbols);
+    }
+
+    // the C library needs NUL terminated text
+    std::string text(buf, length);
+    return parse_generic(text.c_str(), length, symbols);
+}
+
+bool Atom::parse_generic(const char * buf, size_t length,
+        SymbolTable * symbols)
 {
     if (parse_bool(buf, length) || parse_integer(buf, length)
-            || parse_real(buf, length) || parse_cstr(buf, length)) {
+            || parse_real(buf, length) || parse_cstr(buf, length, symbols)) {
         return true;
     }
 
@@ -112,13 +425,13 @@ bool Atom::parse(const char * buf, size_t length)
 
 bool Atom::parse_bool(const char * buf, size_t length)
 {
-    if (length == 4 && !strcmp(buf, "true")) {
+    if (length == 4 && !memcmp(buf, "true", 4)) {
         _atom_type = atom_bool;
         _atom_data.num.b = true;
         return true;
     }
 
-    if (length == 5 && !strcmp(buf, "false")) {
+    if (length == 5 && !memcmp(buf, "false", 5)) {
         _atom_type = atom_bool;
         _atom_data.num.b = false;
         return true;
@@ -221,9 +534,21 @@ bool Atom::parse_real(const char * buf, size_t length)
     return false;
 }
 
-bool Atom::parse_cstr(const char * buf, size_t length)
+bool Atom::parse_cstr(const char * buf, size_t length,
+        SymbolTable * symbols)
 {
-    if (_atom_data.set_string(buf, length)) {
+    if (_atom_data.set_string(buf, length, symbols)) {
+        _atom_type = atom_cstr;
+        return true;
+    }
+    return false;
+}
+
+bool Atom::set_cstr(const char * buf, size_t length, bool quoted,
+        SymbolTable * symbols)
+{
+    _atom_data.reset();
+    if (_atom_data.set_text(buf, length, quoted, symbols)) {
         _atom_type = atom_cstr;
         return true;
     }
@@ -575,17 +900,92 @@ std::string Atom::to_string() const
     return ss.str();
 }
 
-CompositeExprPtr CompositeExpr::create()
+CompositeExprPtr CompositeExpr::create(size_t capacity)
 {
-    return CompositeExprPtr(new (std::nothrow) CompositeExpr());
+    CompositeExpr * result = new (std::nothrow) CompositeExpr();
+    if (result && !result->reserve(capacity)) {
+        delete result;
+        result = NULL;
+    }
+
+    return CompositeExprPtr(result);
+}
+
+const size_t CompositeExpr::_INLINE_CAPACITY;
+
+namespace
+{
+
+// lists to be released by the outer most ~CompositeExpr() of this thread
+thread_local std::vector<MatterPtr> t_pending_lists;
+thread_local bool t_releasing_lists = false;
+
+} // anonymous namespace
+
+void CompositeExpr::_release_children()
+{
+    for (size_t i = 0; i < _size; ++i) {
+        MatterPtr &item = _items[i];
+        if (item && item->is_composite_expr() && item.unique()) {
+            try {
+                t_pending_lists.push_back(MatterPtr());
+                t_pending_lists.back().swap(item);
+            }
+            catch (const std::bad_alloc &) {
+                // released recursively
+            }
+        }
+    }
+
+    if (t_releasing_lists) {
+        return;
+    }
+
+    t_releasing_lists = true;
+    MatterPtr list = NULL;
+    while (!t_pending_lists.empty()) {
+        list.swap(t_pending_lists.back());
+        t_pending_lists.pop_back();
+        list.reset();
+    }
+    t_releasing_lists = false;
 }
 
-const size_t CompositeExpr::_INITIAL_CAPACITY;
-const size_t CompositeExpr::_CAPACITY_DELTA;
+bool CompositeExpr::reserve(size_t capacity)
+{
+    if (capacity <= _capacity) {
+        return true;
+    }
+
+    if (capacity > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+
+    MatterPtr * items = new (std::nothrow) MatterPtr[capacity];
+    if (!items) {
+        return false;
+    }
+
+    for (size_t i = 0; i < _size; ++i) {
+        items[i].swap(_items[i]);
+    }
+
+    if (!is_inline()) {
+        delete[] _items;
+    }
+
+    _items = items;
+    _capacity = static_cast<uint32_t>(capacity);
+    return true;
+}
 
 bool CompositeExpr::append_expr(MatterPtr expr)
 {
-    _items.push_back(expr);
+    if (_size == _capacity && !reserve(2 * static_cast<size_t>(_capacity))) {
+        return false;
+    }
+
+    _items[_size++].swap(expr);
     return true;
 }
 
@@ -600,13 +1000,13 @@ std::string CompositeExpr::debug_string(bool compact, int level,
 
     std::stringstream ss;
     ss << indent << "CompositeExpr{" << first_sep //
-        << "size:" << (compact ? "" : " ") << _items.size() << sep //
+        << "size:" << (compact ? "" : " ") << _size << sep //
         << "elem:" << (compact ? "[" : " [");
-    if (_items.size()) {
+    if (_size) {
         ss << (compact ? "" : "\n");
-        for (size_t i = 0; i < _items.size(); ++i) {
+        for (size_t i = 0; i < _size; ++i) {
             ss << _items[i]->debug_string(compact, level + 2, indent_seq);
-            if (i < _items.size() - 1) {
+            if (i < _size - 1) {
                 ss << (compact ? "," : ",\n");
             }
         }
@@ -0,0 +1,185 @@
+/*
+ * file name:           src/frame_stack.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 22:41:07 2026 CST
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "frame_stack.h"
+#include "scoped_env.h"
+
+namespace SolarWindLisp
+{
+
+/*
+ * Chunks are followed by their data. Every allocation is preceded by the
+ * address of its chunk, and counted in `live', which also holds 1 while the
+ * chunk is owned by the stack (in use, or spare). The chunk is freed when it
+ * drops to 0.
+ */
+struct FrameStack::Chunk
+{
+    char * top;
+    char * end;
+    size_t live;
+};
+
+namespace
+{
+
+const size_t ALIGNMENT = 16;
+const size_t HEADER_SIZE = ALIGNMENT;
+const size_t CHUNK_HEADER_SIZE = 2 * ALIGNMENT;
+
+inline size_t align_up(size_t size)
+{
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+void destroy_env(ScopedEnv * env)
+{
+    env->~ScopedEnv();
+    FrameStack::deallocate(env);
+}
+
+} // anonymous namespace
+
+FrameStack::FrameStack() :
+        _spare(NULL)
+{
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+FrameStack::~FrameStack()
+{
+    retire();
+    if (_spare) {
+        _release(_spare);
+    }
+}
+
+ScopedEnvPtr FrameStack::create_env(const ScopedEnvPtr &ext)
+{
+    void * mem = allocate(sizeof(ScopedEnv));
+    if (!mem) {
+        return NULL;
+    }
+
+    ScopedEnv * env = new (mem) ScopedEnv(ext, this);
+    try {
+        ScopedEnvPtr result(env, destroy_env, Allocator<ScopedEnv>(this));
+        ++_stats.frames;
+        return result;
+    }
+    catch (const std::bad_alloc &) {
+        // `env' has been destroyed by the shared pointer
+        return NULL;
+    }
+}
+
+FrameStack::Mark FrameStack::mark() const
+{
+    Mark m;
+    m.chunk = _chunks.empty() ? NULL : _chunks.back();
+    m.top = _chunks.empty() ? NULL : _chunks.back()->top;
+    m.retirements = _stats.retirements;
+    return m;
+}
+
+void FrameStack::rewind(const Mark &m)
+{
+    // everything in the chunks in use was allocated after `m' if retired
+    Chunk * target = m.retirements == _stats.retirements
+            ? static_cast<Chunk *>(m.chunk) : NULL;
+    while (!_chunks.empty() && _chunks.back() != target) {
+        Chunk * c = _chunks.back();
+        _chunks.pop_back();
+        c->top = reinterpret_cast<char *>(c) + CHUNK_HEADER_SIZE;
+        if (!_spare) {
+            _spare = c;
+        }
+        else if (c->end - c->top > _spare->end - _spare->top) {
+            _release(_spare);
+            _spare = c;
+        }
+        else {
+            _release(c);
+        }
+    }
+
+    if (target) {
+        target->top = m.top;
+    }
+}
+
+void FrameStack::retire()
+{
+    for (size_t i = 0; i < _chunks.size(); ++i) {
+        _release(_chunks[i]);
+    }
+    _chunks.clear();
+    ++_stats.retirements;
+}
+
+void * FrameStack::allocate(size_t size)
+{
+    size = HEADER_SIZE + align_up(size);
+
+    Chunk * c = _chunks.empty() ? NULL : _chunks.back();
+    if (!c || static_cast<size_t>(c->end - c->top) < size) {
+        if (_spare && static_cast<size_t>(_spare->end - _spare->top) >= size) {
+            c = _spare;
+            _spare = NULL;
+        }
+        else if (!(c = _new_chunk(size > CHUNK_SIZE ? size : CHUNK_SIZE))) {
+            return NULL;
+        }
+
+        try {
+            _chunks.push_back(c);
+        }
+        catch (const std::bad_alloc &) {
+            _release(c);
+            return NULL;
+        }
+    }
+
+    char * p = c->top;
+    c->top += size;
+    ++c->live;
+    *reinterpret_cast<Chunk **>(p) = c;
+    return p + HEADER_SIZE;
+}
+
+void FrameStack::deallocate(void * p)
+{
+    _release(*reinterpret_cast<Chunk **>(static_cast<char *>(p) - HEADER_SIZE));
+}
+
+FrameStack::Chunk * FrameStack::_new_chunk(size_t size)
+{
+    static_assert(sizeof(Chunk) <= CHUNK_HEADER_SIZE, "chunk header too small");
+    void * mem = malloc(CHUNK_HEADER_SIZE + size);
+    if (!mem) {
+        return NULL;
+    }
+
+    Chunk * c = static_cast<Chunk *>(mem);
+    c->top = static_cast<char *>(mem) + CHUNK_HEADER_SIZE;
+    c->end = c->top + size;
+    c->live = 1;
+    ++_stats.chunks;
+    return c;
+}
+
+void FrameStack::_release(Chunk * chunk)
+{
+    if (!--chunk->live) {
+        free(chunk);
+    }
+}
+
+} // namespace SolarWindLisp
@@ -18,6 +18,8 @@ bool Future::value(MatterPtr &result)
         if (!InterpreterIF::_force_eval(_expr, _env, _interpreter, _value)) {
             return false;
         }
+        // not needed any more, do not keep the env (and its cycles) alive
+        _env.reset();
     }
 
     result = _value;
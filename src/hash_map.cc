@@ -0,0 +1,321 @@
+/*
+ * file name:           src/hash_map.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 18:40:17 2026 CST
+ */
+
+#include <string.h>
+#include <new>
+#include <sstream>
+#include "expr.h"
+#include "hash_map.h"
+#include "utils.h"
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+enum key_kind_t
+{
+    key_invalid = 0,
+    key_int,        // fits in int64_t
+    key_big_uint,   // uint64_t larger than INT64_MAX
+    key_real,
+    key_string,
+    key_symbol,
+};
+
+key_kind_t key_kind(const MatterPtr &key, int64_t &i64, double &d)
+{
+    if (!key || !key->is_atom()) {
+        return key_invalid;
+    }
+
+    const Atom * a = static_cast<const Atom *>(key.get());
+    if (a->is_integer()) {
+        if (a->to_i64(i64)) {
+            return key_int;
+        }
+        uint64_t u64 = 0;
+        a->to_u64(u64);
+        i64 = static_cast<int64_t>(u64);
+        return key_big_uint;
+    }
+    else if (a->is_real()) {
+        if (!a->to_double(d) || d != d) {
+            return key_invalid; // NaN never equals itself
+        }
+        if (d == 0) {
+            d = 0; // -0.0 and 0.0 are the same key
+        }
+        return key_real;
+    }
+    else if (a->is_cstr()) {
+        return a->is_quoted_cstr() ? key_string : key_symbol;
+    }
+
+    return key_invalid;
+}
+
+inline uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+} // anonymous namespace
+
+bool AtomKey::is_valid(const MatterPtr &key)
+{
+    int64_t i64 = 0;
+    double d = 0;
+    return key_kind(key, i64, d) != key_invalid;
+}
+
+uint64_t AtomKey::hash(const MatterPtr &key)
+{
+    int64_t i64 = 0;
+    double d = 0;
+    uint64_t h = 0;
+    key_kind_t kind = key_kind(key, i64, d);
+    switch (kind) {
+        case key_int:
+        case key_big_uint:
+            h = mix64(static_cast<uint64_t>(i64) + kind);
+            break;
+        case key_real:
+            memcpy(&h, &d, sizeof(h));
+            h = mix64(h + kind);
+            break;
+        case key_string:
+        case key_symbol: {
+            // FNV-1a
+            const Atom * a = static_cast<const Atom *>(key.get());
+            const unsigned char * p =
+                    reinterpret_cast<const unsigned char *>(a->to_cstr());
+            h = 0xcbf29ce484222325ULL ^ kind;
+            for (size_t i = 0; i < a->cstr_length(); ++i) {
+                h = (h ^ p[i]) * 0x100000001b3ULL;
+            }
+            h = mix64(h);
+            break;
+        }
+        default:
+            break;
+    }
+
+    return h ? h : 1;
+}
+
+bool AtomKey::equal(const MatterPtr &lhs, const MatterPtr &rhs)
+{
+    if (lhs == rhs) {
+        return true;
+    }
+
+    int64_t li = 0, ri = 0;
+    double ld = 0, rd = 0;
+    key_kind_t kind = key_kind(lhs, li, ld);
+    if (kind == key_invalid || kind != key_kind(rhs, ri, rd)) {
+        return false;
+    }
+
+    switch (kind) {
+        case key_int:
+        case key_big_uint:
+            return li == ri;
+        case key_real:
+            return ld == rd;
+        default: {
+            const Atom * l = static_cast<const Atom *>(lhs.get());
+            const Atom * r = static_cast<const Atom *>(rhs.get());
+            return l->cstr_length() == r->cstr_length()
+                    && !memcmp(l->to_cstr(), r->to_cstr(), l->cstr_length());
+        }
+    }
+}
+
+HashMapPtr HashMap::create(size_t expected)
+{
+    HashMap * result = new (std::nothrow) HashMap();
+    if (!result) {
+        return NULL;
+    }
+
+    size_t capacity = _MIN_CAPACITY;
+    while (capacity / 4 * 3 < expected) {
+        capacity *= 2;
+    }
+
+    if (!result->_rehash(capacity)) {
+        delete result;
+        return NULL;
+    }
+
+    return HashMapPtr(result);
+}
+
+HashMap::~HashMap()
+{
+    delete[] _hashes;
+    delete[] _entries;
+}
+
+size_t HashMap::_find_slot(uint64_t hash, const MatterPtr &key) const
+{
+    size_t mask = _capacity - 1;
+    size_t idx = static_cast<size_t>(hash) & mask;
+    while (_hashes[idx]) {
+        if (_hashes[idx] == hash && AtomKey::equal(_entries[idx].key, key)) {
+            break;
+        }
+        idx = (idx + 1) & mask;
+    }
+    return idx;
+}
+
+const MatterPtr * HashMap::find(const MatterPtr &key) const
+{
+    if (!AtomKey::is_valid(key)) {
+        return NULL;
+    }
+
+    size_t idx = _find_slot(AtomKey::hash(key), key);
+    return _hashes[idx] ? &_entries[idx].value : NULL;
+}
+
+bool HashMap::insert(const MatterPtr &key, const MatterPtr &value)
+{
+    if ((_size + 1) > _capacity / 4 * 3 && !_rehash(_capacity * 2)) {
+        return false;
+    }
+
+    uint64_t hash = AtomKey::hash(key);
+    size_t idx = _find_slot(hash, key);
+    if (!_hashes[idx]) {
+        _hashes[idx] = hash;
+        _entries[idx].key = key;
+        ++_size;
+    }
+    _entries[idx].value = value;
+    return true;
+}
+
+bool HashMap::erase(const MatterPtr &key)
+{
+    if (!AtomKey::is_valid(key)) {
+        return false;
+    }
+
+    size_t mask = _capacity - 1;
+    size_t hole = _find_slot(AtomKey::hash(key), key);
+    if (!_hashes[hole]) {
+        return false;
+    }
+
+    // move back every following entry which may not be reached otherwise
+    size_t idx = hole;
+    for (;;) {
+        idx = (idx + 1) & mask;
+        if (!_hashes[idx]) {
+            break;
+        }
+
+        size_t home = static_cast<size_t>(_hashes[idx]) & mask;
+        if (((idx - home) & mask) >= ((idx - hole) & mask)) {
+            _hashes[hole] = _hashes[idx];
+            _entries[hole].key.swap(_entries[idx].key);
+            _entries[hole].value.swap(_entries[idx].value);
+            hole = idx;
+        }
+    }
+
+    _hashes[hole] = 0;
+    _entries[hole].key = NULL;
+    _entries[hole].value = NULL;
+    --_size;
+    return true;
+}
+
+bool HashMap::_rehash(size_t capacity)
+{
+    uint64_t * hashes = new (std::nothrow) uint64_t[capacity];
+    Entry * entries = new (std::nothrow) Entry[capacity];
+    if (!hashes || !entries) {
+        delete[] hashes;
+        delete[] entries;
+        return false;
+    }
+    memset(hashes, 0, capacity * sizeof(uint64_t));
+
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < _capacity; ++i) {
+        if (_hashes[i]) {
+            size_t idx = static_cast<size_t>(_hashes[i]) & mask;
+            while (hashes[idx]) {
+                idx = (idx + 1) & mask;
+            }
+            hashes[idx] = _hashes[i];
+            entries[idx].key.swap(_entries[i].key);
+            entries[idx].value.swap(_entries[i].value);
+        }
+    }
+
+    delete[] _hashes;
+    delete[] _entries;
+    _hashes = hashes;
+    _entries = entries;
+    _capacity = capacity;
+    return true;
+}
+
+void HashMap::for_each(bool (*func)(const MatterPtr &key,
+        const MatterPtr &value, void * arg), void * arg) const
+{
+    for (size_t i = 0; i < _capacity; ++i) {
+        if (_hashes[i] && !func(_entries[i].key, _entries[i].value, arg)) {
+            break;
+        }
+    }
+}
+
+std::string HashMap::debug_string(bool compact, int level,
+        const char * indent_seq) const
+{
+    std::string indent = compact ? "" : Utils::Misc::repeat(indent_seq, level);
+
+    std::stringstream ss;
+    ss << indent << "HashMap{" << _size << "/" << _capacity << ","
+            << to_string() << "}";
+    return ss.str();
+}
+
+std::string HashMap::to_string() const
+{
+    std::stringstream ss;
+    ss << "{";
+    bool first = true;
+    for (size_t i = 0; i < _capacity; ++i) {
+        if (_hashes[i]) {
+            if (!first) {
+                ss << ", ";
+            }
+            first = false;
+            ss << _entries[i].key->to_string() << " "
+                    << (_entries[i].value ? _entries[i].value->to_string()
+                            : "NULL");
+        }
+    }
+    ss << "}";
+    return ss.str();
+}
+
+} // namespace SolarWindLisp
@@ -0,0 +1,1158 @@
+/*
+ * file name:           src/heap_snapshot.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 02:17:36 2026 CST
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "heap_snapshot.h"
+#include "matter_factory.h"
+#include "script_cache.h"
+#include "symbol_table.h"
+#include "pretty_message.h"
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct FileHeader
+{
+    char magic[4];              // SWLS
+    uint32_t version;
+    uint32_t byte_order;        // BYTE_ORDER_MARK, as written
+    uint16_t long_double_size;
+    uint16_t reserved;
+    uint64_t snapshot_hash;     // of the whole file, see file_hash()
+    uint64_t num_envs;
+    uint64_t num_objects;       // envs not included
+    uint64_t num_hash_maps;
+    uint64_t root_env;          // reference of the env saved
+};
+
+/*
+ * After the header, the records of the envs and of the objects, in the
+ * order they are created, then the bindings of every env, and the entries
+ * of every hash map, in the same order. A reference is the number of an env
+ * or an object, counted from 1, 0 is NULL.
+ */
+enum record_kind_t
+{
+    record_env = 0,             // external env
+    record_base_env,            // not saved, see HeapSnapshot::save()
+    record_atom,                // type, value
+    record_list,                // count, children
+    record_prim_proc,           // name
+    record_proc,                // params, body, env, frame kind
+    record_nil,
+    record_pair,                // car, cdr
+    record_vector,              // element type, size, elements
+    record_hash_map,            // size, the entries are added at the end
+    record_persistent_map,      // size, keys and values
+    record_native_proc,         // index, see HeapSnapshot::freeze()
+};
+
+const uint32_t NO_REF = 0;
+
+typedef unsigned char LongDouble[16];
+
+static_assert(sizeof(long double) <= sizeof(LongDouble),
+        "long double does not fit");
+
+template<typename T>
+inline void put(std::string &out, T value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+inline void put_text(std::string &out, const char * text, size_t length)
+{
+    put<uint32_t>(out, static_cast<uint32_t>(length));
+    out.append(text, length);
+}
+
+/*
+ * Return value:
+ *   hash of the snapshot `file', its header included, with `snapshot_hash'
+ *   as 0.
+ */
+uint64_t file_hash(const char * file, size_t file_size)
+{
+    FileHeader h;
+    memcpy(&h, file, sizeof(h));
+    h.snapshot_hash = 0;
+    return ScriptCache::content_hash(reinterpret_cast<const char *>(&h),
+            sizeof(h)) ^ (ScriptCache::content_hash(file + sizeof(h),
+                    file_size - sizeof(h)) * 31);
+}
+
+/*
+ * The records of a snapshot being saved. The graph is walked with an
+ * explicit stack, deeply nested forms and long lists are common.
+ */
+class Writer
+{
+public:
+    /*
+     * The primitive procedures not bound to their names in `base' are
+     * appended to `natives' if not NULL, and referred to by index, they are
+     * saved by name otherwise.
+     */
+    explicit Writer(const ScopedEnvPtr &base,
+            std::vector<MatterPtr> * natives = NULL) :
+            num_objects(0), _count(0), _natives(natives)
+    {
+        if (base) {
+            put<uint8_t>(records, record_base_env);
+            envs.push_back(base);
+            _env_refs[base.get()] = static_cast<uint32_t>(envs.size());
+            _base = base;
+        }
+    }
+
+    bool add_root(const ScopedEnvPtr &env, uint32_t &ref);
+    bool add_fixups();
+
+    std::string records;
+    std::string fixups;
+    size_t num_objects;
+    std::vector<ScopedEnvPtr> envs;
+    std::vector<HashMapPtr> hash_maps;
+
+private:
+    struct Pending
+    {
+        MatterPtr matter;
+        bool expanded;          // its children have been pushed
+    };
+
+    bool _add_env(const ScopedEnvPtr &env, uint32_t &ref);
+    bool _visit(size_t idx);
+    void _children(const MatterPtr &matter, std::vector<MatterPtr> &result);
+    bool _add_record(const MatterPtr &matter);
+    bool _add_atom(const Atom * atom);
+    uint32_t _new_ref(const MatterPtr &matter);
+
+    bool _recorded(const MatterPtr &matter) const
+    {
+        return !matter || _refs.find(matter.get()) != _refs.end();
+    }
+
+    uint32_t _ref(const MatterPtr &matter) const
+    {
+        return matter ? _refs.find(matter.get())->second : NO_REF;
+    }
+
+    void _push(const MatterPtr &matter)
+    {
+        if (!_recorded(matter)) {
+            Pending p = { matter, false };
+            _stack.push_back(p);
+        }
+    }
+
+    static bool _push_value(const std::string &name, const MatterPtr &value,
+            void * arg)
+    {
+        static_cast<Writer *>(arg)->_push(value);
+        return true;
+    }
+
+    static bool _push_entry(const MatterPtr &key, const MatterPtr &value,
+            void * arg)
+    {
+        static_cast<Writer *>(arg)->_push(key);
+        static_cast<Writer *>(arg)->_push(value);
+        return true;
+    }
+
+    static bool _append_entry(const MatterPtr &key, const MatterPtr &value,
+            void * arg)
+    {
+        static_cast<std::vector<MatterPtr> *>(arg)->push_back(key);
+        static_cast<std::vector<MatterPtr> *>(arg)->push_back(value);
+        return true;
+    }
+
+    std::unordered_map<const MatterIF *, uint32_t> _refs;
+    std::unordered_map<const ScopedEnv *, uint32_t> _env_refs;
+    std::vector<MatterPtr> _alive;  // the futures may release their values
+    std::vector<Pending> _stack;
+    size_t _count;              // of the fixups of an env or a hash map
+    ScopedEnvPtr _base;
+    std::vector<MatterPtr> * _natives;
+};
+
+bool Writer::add_root(const ScopedEnvPtr &env, uint32_t &ref)
+{
+    if (!_add_env(env, ref)) {
+        return false;
+    }
+
+    while (!_stack.empty()) {
+        if (!_visit(_stack.size() - 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Writer::_add_env(const ScopedEnvPtr &env, uint32_t &ref)
+{
+    // the external envs first, they are created before
+    std::vector<ScopedEnvPtr> chain;
+    for (ScopedEnvPtr e = env; e && _env_refs.find(e.get()) == _env_refs.end();
+            e = e->external()) {
+        chain.push_back(e);
+    }
+
+    for (size_t i = chain.size(); i > 0; --i) {
+        const ScopedEnvPtr &e = chain[i - 1];
+        ScopedEnvPtr external = e->external();
+        put<uint8_t>(records, record_env);
+        put<uint32_t>(records, external ? _env_refs[external.get()] : NO_REF);
+        envs.push_back(e);
+        _env_refs[e.get()] = static_cast<uint32_t>(envs.size());
+        e->for_each(_push_value, this);
+    }
+
+    ref = _env_refs[env.get()];
+    return envs.size() < UINT32_MAX;
+}
+
+uint32_t Writer::_new_ref(const MatterPtr &matter)
+{
+    uint32_t ref = static_cast<uint32_t>(++num_objects);
+    _refs[matter.get()] = ref;
+    _alive.push_back(matter);
+    return ref;
+}
+
+void Writer::_children(const MatterPtr &matter, std::vector<MatterPtr> &result)
+{
+    switch (matter->matter_type()) {
+        case MatterIF::matter_composite_expr: {
+            const CompositeExpr * ce =
+                    static_cast<const CompositeExpr *>(matter.get());
+            result.insert(result.end(), ce->begin(), ce->end());
+            break;
+        }
+        case MatterIF::matter_proc: {
+            Proc * proc = static_cast<Proc *>(matter.get());
+            MatterPtr m = NULL;
+            proc->get_params(m);
+            result.push_back(m);
+            proc->get_body(m);
+            result.push_back(m);
+            break;
+        }
+        case MatterIF::matter_pair: {
+            const Pair * pair = static_cast<const Pair *>(matter.get());
+            result.push_back(pair->car());
+            result.push_back(pair->cdr());
+            break;
+        }
+        case MatterIF::matter_persistent_map:
+            static_cast<const PersistentMap *>(matter.get())->for_each(
+                    _append_entry, &result);
+            break;
+        default:
+            break;
+    }
+}
+
+bool Writer::_visit(size_t idx)
+{
+    MatterPtr matter = _stack[idx].matter;
+    if (_recorded(matter)) {
+        _stack.pop_back();
+        return true;
+    }
+
+    if (matter->is_future()) {
+        // saved as its value
+        MatterPtr value = NULL;
+        if (!static_cast<Future *>(matter.get())->value(value)) {
+            PRETTY_MESSAGE(stderr, "failed realizing a future");
+            return false;
+        }
+
+        if (_recorded(value)) {
+            _refs[matter.get()] = _ref(value);
+            _alive.push_back(matter);
+            _stack.pop_back();
+            return true;
+        }
+
+        if (_stack[idx].expanded) {
+            return false;
+        }
+        _stack[idx].expanded = true;
+        _push(value);
+        return true;
+    }
+
+    if (matter->is_hash_map()) {
+        // created empty, before the keys and the values
+        _stack.pop_back();
+        hash_maps.push_back(boost::static_pointer_cast<HashMap>(matter));
+        put<uint8_t>(records, record_hash_map);
+        put<uint64_t>(records, hash_maps.back()->size());
+        _new_ref(matter);
+        hash_maps.back()->for_each(_push_entry, this);
+        return true;
+    }
+
+    std::vector<MatterPtr> children;
+    _children(matter, children);
+    if (!_stack[idx].expanded) {
+        _stack[idx].expanded = true;
+        if (matter->is_proc()) {
+            ScopedEnvPtr env = NULL;
+            uint32_t ref = NO_REF;
+            static_cast<Proc *>(matter.get())->get_env(env);
+            if (env && !_add_env(env, ref)) {
+                return false;
+            }
+        }
+
+        size_t depth = _stack.size();
+        for (size_t i = children.size(); i > 0; --i) {
+            _push(children[i - 1]);
+        }
+        if (_stack.size() > depth) {
+            return true;
+        }
+    }
+
+    for (size_t i = 0; i < children.size(); ++i) {
+        if (!_recorded(children[i])) {
+            // a cycle without an env or a hash map, not possible
+            PRETTY_MESSAGE(stderr, "unexpected cycle through a %s",
+                    matter->matter_type_name());
+            return false;
+        }
+    }
+
+    _stack.pop_back();
+    return _add_record(matter);
+}
+
+bool Writer::_add_record(const MatterPtr &matter)
+{
+    switch (matter->matter_type()) {
+        case MatterIF::matter_atom:
+            if (!_add_atom(static_cast<const Atom *>(matter.get()))) {
+                return false;
+            }
+            break;
+        case MatterIF::matter_composite_expr: {
+            const CompositeExpr * ce =
+                    static_cast<const CompositeExpr *>(matter.get());
+            put<uint8_t>(records, record_list);
+            put<uint32_t>(records, static_cast<uint32_t>(ce->size()));
+            for (size_t i = 0; i < ce->size(); ++i) {
+                put<uint32_t>(records, _ref((*ce)[i]));
+            }
+            break;
+        }
+        case MatterIF::matter_prim_proc: {
+            const char * name =
+                    static_cast<const PrimProcIF *>(matter.get())->name();
+            MatterPtr bound = NULL;
+            if (_natives && (!name || !_base
+                    || !_base->lookup_local(name, bound) || bound != matter)) {
+                // e.g. of InterpreterIF::register_fn(), kept as it is
+                put<uint8_t>(records, record_native_proc);
+                put<uint32_t>(records,
+                        static_cast<uint32_t>(_natives->size()));
+                _natives->push_back(matter);
+                break;
+            }
+            if (!name) {
+                return false;
+            }
+            put<uint8_t>(records, record_prim_proc);
+            put_text(records, name, strlen(name));
+            break;
+        }
+        case MatterIF::matter_proc: {
+            Proc * proc = static_cast<Proc *>(matter.get());
+            MatterPtr params = NULL;
+            MatterPtr body = NULL;
+            ScopedEnvPtr env = NULL;
+            proc->get_params(params);
+            proc->get_body(body);
+            proc->get_env(env);
+            put<uint8_t>(records, record_proc);
+            put<uint32_t>(records, _ref(params));
+            put<uint32_t>(records, _ref(body));
+            put<uint32_t>(records, env ? _env_refs[env.get()] : NO_REF);
+            put<uint8_t>(records, static_cast<uint8_t>(proc->frame_kind()));
+            break;
+        }
+        case MatterIF::matter_pair: {
+            const Pair * pair = static_cast<const Pair *>(matter.get());
+            if (pair->is_nil()) {
+                put<uint8_t>(records, record_nil);
+                break;
+            }
+            put<uint8_t>(records, record_pair);
+            put<uint32_t>(records, _ref(pair->car()));
+            put<uint32_t>(records, _ref(pair->cdr()));
+            break;
+        }
+        case MatterIF::matter_vector: {
+            const Vector * v = static_cast<const Vector *>(matter.get());
+            put<uint8_t>(records, record_vector);
+            put<uint8_t>(records, static_cast<uint8_t>(v->elem_type()));
+            put<uint64_t>(records, v->size());
+            // sizeof(int64_t) == sizeof(double)
+            records.append(reinterpret_cast<const char *>(v->i64_data()),
+                    v->size() * sizeof(int64_t));
+            break;
+        }
+        case MatterIF::matter_persistent_map: {
+            std::vector<MatterPtr> entries;
+            static_cast<const PersistentMap *>(matter.get())->for_each(
+                    _append_entry, &entries);
+            put<uint8_t>(records, record_persistent_map);
+            put<uint64_t>(records, entries.size() / 2);
+            for (size_t i = 0; i < entries.size(); ++i) {
+                put<uint32_t>(records, _ref(entries[i]));
+            }
+            break;
+        }
+        default:
+            PRETTY_MESSAGE(stderr, "cannot save a %s",
+                    matter->matter_type_name());
+            return false;
+    }
+
+    _new_ref(matter);
+    return num_objects < UINT32_MAX;
+}
+
+bool Writer::_add_atom(const Atom * atom)
+{
+    put<uint8_t>(records, record_atom);
+    put<uint8_t>(records, static_cast<uint8_t>(atom->atom_type()));
+    switch (atom->atom_type()) {
+        case Atom::atom_bool: {
+            bool v = false;
+            atom->to_bool(v);
+            put<uint8_t>(records, v);
+            break;
+        }
+        case Atom::atom_i32: {
+            int32_t v = 0;
+            atom->to_i32(v);
+            put(records, v);
+            break;
+        }
+        case Atom::atom_u32: {
+            uint32_t v = 0;
+            atom->to_u32(v);
+            put(records, v);
+            break;
+        }
+        case Atom::atom_i64: {
+            int64_t v = 0;
+            atom->to_i64(v);
+            put(records, v);
+            break;
+        }
+        case Atom::atom_u64: {
+            uint64_t v = 0;
+            atom->to_u64(v);
+            put(records, v);
+            break;
+        }
+        case Atom::atom_double: {
+            double v = 0;
+            atom->to_double(v);
+            put(records, v);
+            break;
+        }
+        case Atom::atom_long_double: {
+            long double v = 0;
+            LongDouble ld;
+            atom->to_long_double(v);
+            memset(ld, 0, sizeof(ld));
+            memcpy(ld, &v, sizeof(v));
+            records.append(reinterpret_cast<const char *>(ld), sizeof(ld));
+            break;
+        }
+        case Atom::atom_cstr:
+            if (atom->cstr_length() > UINT32_MAX) {
+                return false;
+            }
+            put<uint8_t>(records, atom->is_quoted_cstr());
+            put_text(records, atom->to_cstr(), atom->cstr_length());
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool Writer::add_fixups()
+{
+    struct Bindings
+    {
+        static bool append(const std::string &name, const MatterPtr &value,
+                void * arg)
+        {
+            Writer * w = static_cast<Writer *>(arg);
+            if (!w->_recorded(value) || name.size() > UINT32_MAX) {
+                // bound while the futures were realized
+                return false;
+            }
+            put_text(w->fixups, name.data(), name.size());
+            put<uint32_t>(w->fixups, w->_ref(value));
+            ++w->_count;
+            return true;
+        }
+
+        static bool append_entry(const MatterPtr &key, const MatterPtr &value,
+                void * arg)
+        {
+            Writer * w = static_cast<Writer *>(arg);
+            if (!w->_recorded(key) || !w->_recorded(value)) {
+                return false;
+            }
+            put<uint32_t>(w->fixups, w->_ref(key));
+            put<uint32_t>(w->fixups, w->_ref(value));
+            ++w->_count;
+            return true;
+        }
+    };
+
+    for (size_t i = 0; i < envs.size(); ++i) {
+        if (envs[i] == _base) {
+            put<uint64_t>(fixups, 0);
+            continue;
+        }
+        put<uint64_t>(fixups, envs[i]->size());
+        _count = 0;
+        envs[i]->for_each(Bindings::append, this);
+        if (_count != envs[i]->size()) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < hash_maps.size(); ++i) {
+        put<uint64_t>(fixups, hash_maps[i]->size());
+        _count = 0;
+        hash_maps[i]->for_each(Bindings::append_entry, this);
+        if (_count != hash_maps[i]->size()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Bounds checked reads of the records of a mapped snapshot.
+ */
+class Reader
+{
+public:
+    Reader(const char * begin, const char * end) :
+            _p(begin), _end(end)
+    {
+    }
+
+    template<typename T>
+    bool get(T &value)
+    {
+        if (static_cast<size_t>(_end - _p) < sizeof(T)) {
+            return false;
+        }
+        memcpy(&value, _p, sizeof(T));
+        _p += sizeof(T);
+        return true;
+    }
+
+    bool get_bytes(uint64_t length, const char * &bytes)
+    {
+        if (static_cast<uint64_t>(_end - _p) < length) {
+            return false;
+        }
+        bytes = _p;
+        _p += length;
+        return true;
+    }
+
+    bool get_text(const char * &text, uint32_t &length)
+    {
+        return get(length) && get_bytes(length, text);
+    }
+
+    bool at_end() const
+    {
+        return _p == _end;
+    }
+
+private:
+    const char * _p;
+    const char * _end;
+};
+
+/*
+ * The objects being restored, in the order of their references.
+ */
+struct Restored
+{
+    Restored() :
+            base(NO_REF), natives(NULL)
+    {
+    }
+
+    std::vector<ScopedEnvPtr> envs;
+    uint32_t base;
+    const std::vector<MatterPtr> * natives;
+    std::vector<MatterPtr> objects;
+    std::vector<HashMapPtr> hash_maps;
+
+    bool object(uint32_t ref, MatterPtr &result) const
+    {
+        if (ref > objects.size()) {
+            return false;
+        }
+        result = ref ? objects[ref - 1] : MatterPtr();
+        return true;
+    }
+
+    bool env(uint32_t ref, ScopedEnvPtr &result) const
+    {
+        if (ref > envs.size()) {
+            return false;
+        }
+        result = ref ? envs[ref - 1] : ScopedEnvPtr();
+        return true;
+    }
+};
+
+bool restore_atom(Reader &in, SymbolTable * symbols, MatterPtr &result)
+{
+    AtomPtr atom = Atom::create();
+    uint8_t type = 0;
+    if (!atom || !in.get(type)) {
+        return false;
+    }
+
+    switch (type) {
+        case Atom::atom_bool: {
+            uint8_t v = 0;
+            if (!in.get(v)) {
+                return false;
+            }
+            atom->set_bool(v != 0);
+            break;
+        }
+        case Atom::atom_i32: {
+            int32_t v = 0;
+            if (!in.get(v)) {
+                return false;
+            }
+            atom->set_i32(v);
+            break;
+        }
+        case Atom::atom_u32: {
+            uint32_t v = 0;
+            if (!in.get(v)) {
+                return false;
+            }
+            atom->set_u32(v);
+            break;
+        }
+        case Atom::atom_i64: {
+            int64_t v = 0;
+            if (!in.get(v)) {
+                return false;
+            }
+            atom->set_i64(v);
+            break;
+        }
+        case Atom::atom_u64: {
+            uint64_t v = 0;
+            if (!in.get(v)) {
+                return false;
+            }
+            atom->set_u64(v);
+            break;
+        }
+        case Atom::atom_double: {
+            double v = 0;
+            if (!in.get(v)) {
+                return false;
+            }
+            atom->set_double(v);
+            break;
+        }
+        case Atom::atom_long_double: {
+            const char * bytes = NULL;
+            long double v = 0;
+            if (!in.get_bytes(sizeof(LongDouble), bytes)) {
+                return false;
+            }
+            memcpy(&v, bytes, sizeof(v));
+            atom->set_long_double(v);
+            break;
+        }
+        case Atom::atom_cstr: {
+            uint8_t quoted = 0;
+            const char * text = NULL;
+            uint32_t length = 0;
+            if (!in.get(quoted) || !in.get_text(text, length)
+                    || !atom->set_cstr(text, length, quoted != 0,
+                            symbols)) {
+                return false;
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+
+    result = atom;
+    return true;
+}
+
+bool restore_record(Reader &in, uint8_t kind, MatterFactoryIF * factory,
+        const ScopedEnvPtr &prims, SymbolTable * symbols, Restored &r,
+        MatterPtr &result)
+{
+    switch (kind) {
+        case record_atom:
+            return restore_atom(in, symbols, result);
+        case record_list: {
+            uint32_t size = 0;
+            if (!in.get(size)) {
+                return false;
+            }
+            CompositeExprPtr list = factory->create_composite_expr(size);
+            if (!list) {
+                return false;
+            }
+            for (uint32_t i = 0; i < size; ++i) {
+                uint32_t ref = NO_REF;
+                MatterPtr child = NULL;
+                if (!in.get(ref) || !r.object(ref, child)
+                        || !list->append_expr(child)) {
+                    return false;
+                }
+            }
+            result = list;
+            return true;
+        }
+        case record_prim_proc: {
+            const char * text = NULL;
+            uint32_t length = 0;
+            if (!in.get_text(text, length)
+                    || !prims->lookup_local(std::string(text, length), result)
+                    || !result || !result->is_prim_proc()) {
+                PRETTY_MESSAGE(stderr, "unknown primitive procedure");
+                return false;
+            }
+            return true;
+        }
+        case record_native_proc: {
+            uint32_t index = 0;
+            if (!in.get(index) || !r.natives || index >= r.natives->size()) {
+                return false;
+            }
+            result = (*r.natives)[index];
+            return true;
+        }
+        case record_proc: {
+            uint32_t params_ref = NO_REF;
+            uint32_t body_ref = NO_REF;
+            uint32_t env_ref = NO_REF;
+            uint8_t frame_kind = 0;
+            MatterPtr params = NULL;
+            MatterPtr body = NULL;
+            ScopedEnvPtr env = NULL;
+            if (!in.get(params_ref) || !in.get(body_ref) || !in.get(env_ref)
+                    || !in.get(frame_kind) || frame_kind > Proc::frame_heap
+                    || !r.object(params_ref, params)
+                    || !r.object(body_ref, body) || !r.env(env_ref, env)) {
+                return false;
+            }
+            ProcPtr proc = factory->create_proc(params, body, env);
+            if (!proc) {
+                return false;
+            }
+            proc->set_frame_kind(static_cast<Proc::frame_kind_t>(frame_kind));
+            result = proc;
+            return true;
+        }
+        case record_nil:
+            result = Pair::nil();
+            return true;
+        case record_pair: {
+            uint32_t car_ref = NO_REF;
+            uint32_t cdr_ref = NO_REF;
+            MatterPtr car = NULL;
+            MatterPtr cdr = NULL;
+            if (!in.get(car_ref) || !in.get(cdr_ref) || !r.object(car_ref, car)
+                    || !r.object(cdr_ref, cdr) || (!car && !cdr)) {
+                return false;
+            }
+            result = factory->create_pair(car, cdr);
+            return result.get() != NULL;
+        }
+        case record_vector: {
+            uint8_t elem_type = 0;
+            uint64_t size = 0;
+            const char * bytes = NULL;
+            if (!in.get(elem_type) || elem_type > Vector::elem_double
+                    || !in.get(size) || size > UINT64_MAX / sizeof(int64_t)
+                    || !in.get_bytes(size * sizeof(int64_t), bytes)) {
+                return false;
+            }
+            VectorPtr v = factory->create_vector(
+                    static_cast<Vector::elem_type_t>(elem_type), size);
+            if (!v) {
+                return false;
+            }
+            memcpy(v->i64_data(), bytes, size * sizeof(int64_t));
+            result = v;
+            return true;
+        }
+        case record_hash_map: {
+            uint64_t size = 0;
+            HashMapPtr map = NULL;
+            if (!in.get(size) || size > UINT32_MAX
+                    || !(map = factory->create_hash_map(size))) {
+                return false;
+            }
+            r.hash_maps.push_back(map);
+            result = map;
+            return true;
+        }
+        case record_persistent_map: {
+            uint64_t size = 0;
+            if (!in.get(size) || size > UINT32_MAX) {
+                return false;
+            }
+            PersistentMapPtr empty = factory->create_persistent_map();
+            if (!empty) {
+                return false;
+            }
+            PersistentMap::Transient transient(empty);
+            for (uint64_t i = 0; i < size; ++i) {
+                uint32_t key_ref = NO_REF;
+                uint32_t value_ref = NO_REF;
+                MatterPtr key = NULL;
+                MatterPtr value = NULL;
+                if (!in.get(key_ref) || !in.get(value_ref)
+                        || !r.object(key_ref, key)
+                        || !r.object(value_ref, value)
+                        || !key || !AtomKey::is_valid(key)
+                        || !transient.assoc(key, value)) {
+                    return false;
+                }
+            }
+            result = transient.persistent();
+            return result.get() != NULL;
+        }
+        default:
+            return false;
+    }
+}
+
+/*
+ * The objects of a frozen env, the references to them are all aliases of
+ * the one shared pointer of the FrozenHeap, see HeapSnapshot::freeze().
+ */
+struct FrozenHeap
+{
+    std::vector<MatterPtr> objects;
+    std::vector<ScopedEnvPtr> envs;
+    // the env frozen, never freed either
+    ScopedEnvPtr original;
+};
+
+typedef boost::shared_ptr<FrozenHeap> FrozenHeapPtr;
+
+/*
+ * Description:
+ *   Restore the snapshot in `file', the objects are kept by `frozen' if not
+ *   NULL, the primitive procedures saved by index are the ones of `natives'.
+ */
+ScopedEnvPtr restore_mapped(const char * file, size_t file_size,
+        MatterFactoryIF * factory, const ScopedEnvPtr &prims,
+        SymbolTable * symbols, const FrozenHeapPtr &frozen = FrozenHeapPtr(),
+        const std::vector<MatterPtr> * natives = NULL)
+{
+    FileHeader h;
+    memcpy(&h, file, sizeof(h));
+    if (memcmp(h.magic, "SWLS", 4) != 0
+            || h.version != HeapSnapshot::VERSION
+            || h.byte_order != BYTE_ORDER_MARK
+            || h.long_double_size != sizeof(long double)
+            || h.reserved != 0
+            || h.num_envs > UINT32_MAX || h.num_objects > UINT32_MAX
+            || h.num_hash_maps > h.num_objects
+            || h.root_env == NO_REF || h.root_env > h.num_envs
+            || h.snapshot_hash != file_hash(file, file_size)) {
+        return NULL;
+    }
+
+    Restored r;
+    r.natives = natives;
+    Reader in(file + sizeof(h), file + file_size);
+    r.envs.reserve(h.num_envs);
+    r.objects.reserve(h.num_objects);
+    while (r.envs.size() < h.num_envs || r.objects.size() < h.num_objects) {
+        uint8_t kind = 0;
+        if (!in.get(kind)) {
+            return NULL;
+        }
+
+        if (kind == record_env) {
+            uint32_t ref = NO_REF;
+            ScopedEnvPtr external = NULL;
+            ScopedEnvPtr env = NULL;
+            if (r.envs.size() >= h.num_envs || !in.get(ref)
+                    || !r.env(ref, external)
+                    || !(env = factory->create_env(external))) {
+                return NULL;
+            }
+            if (frozen) {
+                frozen->envs.push_back(env);
+                env = ScopedEnvPtr(frozen, env.get());
+            }
+            r.envs.push_back(env);
+            continue;
+        }
+
+        if (kind == record_base_env) {
+            // shared, never frozen, nor added to
+            if (r.envs.size() >= h.num_envs || r.base) {
+                return NULL;
+            }
+            r.base = static_cast<uint32_t>(r.envs.size() + 1);
+            r.envs.push_back(prims);
+            continue;
+        }
+
+        MatterPtr result = NULL;
+        if (r.objects.size() >= h.num_objects
+                || !restore_record(in, kind, factory, prims, symbols, r,
+                        result)) {
+            return NULL;
+        }
+        if (frozen && result) {
+            frozen->objects.push_back(result);
+            result = MatterPtr(frozen, result.get());
+        }
+        r.objects.push_back(result);
+    }
+
+    if (r.hash_maps.size() != h.num_hash_maps) {
+        return NULL;
+    }
+
+    // the bindings, and the entries of the hash maps
+    for (size_t i = 0; i < r.envs.size(); ++i) {
+        uint64_t size = 0;
+        if (!in.get(size)) {
+            return NULL;
+        }
+        if (i + 1 == r.base && size) {
+            return NULL;
+        }
+        for (uint64_t k = 0; k < size; ++k) {
+            const char * name = NULL;
+            uint32_t length = 0;
+            uint32_t ref = NO_REF;
+            MatterPtr value = NULL;
+            if (!in.get_text(name, length) || !in.get(ref)
+                    || !r.object(ref, value)
+                    || !r.envs[i]->add(std::string(name, length), value)) {
+                return NULL;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < r.hash_maps.size(); ++i) {
+        uint64_t size = 0;
+        if (!in.get(size)) {
+            return NULL;
+        }
+        for (uint64_t k = 0; k < size; ++k) {
+            uint32_t key_ref = NO_REF;
+            uint32_t value_ref = NO_REF;
+            MatterPtr key = NULL;
+            MatterPtr value = NULL;
+            if (!in.get(key_ref) || !in.get(value_ref)
+                    || !r.object(key_ref, key) || !r.object(value_ref, value)
+                    || !key || !AtomKey::is_valid(key)
+                    || !r.hash_maps[i]->insert(key, value)) {
+                return NULL;
+            }
+        }
+    }
+
+    if (!in.at_end() || h.root_env == r.base) {
+        return NULL;
+    }
+
+    return r.envs[h.root_env - 1];
+}
+
+/*
+ * Description:
+ *   The whole of the snapshot of `env', in `file', see Writer for `natives'.
+ */
+bool build_file(const ScopedEnvPtr &env, const ScopedEnvPtr &base,
+        std::string &file, std::vector<MatterPtr> * natives = NULL)
+{
+    Writer w(base, natives);
+    uint32_t root = NO_REF;
+    if (!env || env == base || !w.add_root(env, root) || !w.add_fixups()) {
+        PRETTY_MESSAGE(stderr, "cannot take a snapshot of the env");
+        return false;
+    }
+
+    FileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, "SWLS", 4);
+    h.version = HeapSnapshot::VERSION;
+    h.byte_order = BYTE_ORDER_MARK;
+    h.long_double_size = sizeof(long double);
+    h.num_envs = w.envs.size();
+    h.num_objects = w.num_objects;
+    h.num_hash_maps = w.hash_maps.size();
+    h.root_env = root;
+
+    file.clear();
+    file.reserve(sizeof(h) + w.records.size() + w.fixups.size());
+    file.append(reinterpret_cast<const char *>(&h), sizeof(h));
+    file.append(w.records);
+    file.append(w.fixups);
+    h.snapshot_hash = file_hash(file.data(), file.size());
+    memcpy(&file[0], &h, sizeof(h));
+    return true;
+}
+
+} // anonymous namespace
+
+SymbolTable * HeapSnapshot::default_symbol_table()
+{
+    return &SymbolTable::global();
+}
+
+bool HeapSnapshot::save(const char * filename, const ScopedEnvPtr &env,
+        const ScopedEnvPtr &base)
+{
+    std::string file;
+    if (!build_file(env, base, file)) {
+        return false;
+    }
+
+    char tmp_name[4096];
+    snprintf(tmp_name, sizeof(tmp_name), "%s.tmp.%d", filename,
+            static_cast<int>(getpid()));
+    FILE * fp = fopen(tmp_name, "wb");
+    if (!fp) {
+        PRETTY_MESSAGE(stderr, "cannot create `%s': %s", tmp_name,
+                strerror(errno));
+        return false;
+    }
+
+    bool ok = fwrite(file.data(), 1, file.size(), fp) == file.size();
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || rename(tmp_name, filename) != 0) {
+        PRETTY_MESSAGE(stderr, "cannot write `%s': %s", filename,
+                strerror(errno));
+        unlink(tmp_name);
+        return false;
+    }
+
+    return true;
+}
+
+ScopedEnvPtr HeapSnapshot::restore(const char * filename,
+        MatterFactoryIF * factory, const ScopedEnvPtr &prims,
+        SymbolTable * symbols)
+{
+    if (!factory || !prims) {
+        return NULL;
+    }
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)
+            || st.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t file_size = static_cast<size_t>(st.st_size);
+    void * mapped = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        return NULL;
+    }
+
+    ScopedEnvPtr env = restore_mapped(static_cast<const char *>(mapped),
+            file_size, factory, prims, symbols);
+    munmap(mapped, file_size);
+    return env;
+}
+
+ScopedEnvPtr HeapSnapshot::freeze(const ScopedEnvPtr &env,
+        const ScopedEnvPtr &prims, SymbolTable * symbols)
+{
+    // the copy is made in this process, the primitive procedures which are
+    // not of `prims' are the same objects
+    std::string file;
+    std::vector<MatterPtr> natives;
+    if (!prims || !build_file(env, prims, file, &natives)) {
+        return NULL;
+    }
+
+    // not tracked by any collector, the reference counts are not their own
+    SimpleMatterFactory factory;
+    FrozenHeapPtr frozen(new (std::nothrow) FrozenHeap());
+    ScopedEnvPtr result = frozen ? restore_mapped(file.data(), file.size(),
+            &factory, prims, symbols, frozen, &natives) : ScopedEnvPtr();
+    if (!result) {
+        return NULL;
+    }
+    frozen->original = env;
+
+    // never released, like the processes forked to share it
+    static std::mutex lock;
+    static std::vector<FrozenHeapPtr> * heaps =
+            new std::vector<FrozenHeapPtr>();
+    std::lock_guard<std::mutex> guard(lock);
+    heaps->push_back(frozen);
+    return result;
+}
+
+} // namespace SolarWindLisp
@@ -8,8 +8,13 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
 #include "interpreter.h"
 #include "script_reader.h"
+#include "parallel_loader.h"
+#include "script_cache.h"
+#include "heap_snapshot.h"
 
 namespace SolarWindLisp
 {
@@ -21,14 +26,23 @@ InterpreterIF::InterpreterIF(ParserIF * parser, ScopedEnvPtr env,
     _env = env;
     _factory = factory;
     _initialized = _parser && _env && _factory;
+    if (_factory) {
+        _factory->set_collector(&_collector);
+    }
 }
 
 InterpreterIF::~InterpreterIF()
 {
     if (_env) {
-        // XXX remove circular reference
         _env->clear();
+        _env.reset();
+    }
+    for (size_t i = 0; i < _checkpoints.size(); ++i) {
+        _checkpoints[i]->clear();
     }
+    _checkpoints.clear();
+    // whatever left in cycles, e.g. closures escaped from `let'
+    _collector.collect();
 
     if (_parser) {
         delete _parser;
@@ -45,27 +59,160 @@ bool InterpreterIF::initialize()
         return true;
     }
 
-    if (!_parser) {
-        if (!(_parser = new (std::nothrow) SimpleParser())) {
+    if (!_create_parser_and_factory()) {
+        return false;
+    }
+
+    if (!_env) {
+        ScopedEnvPtr builtins = builtin_env();
+        if (!builtins || !(_env = _factory->create_env(builtins))) {
             return false;
         }
     }
+    else {
+        // the env given to the constructor has the prelude of its own
+        _expand();
+    }
 
-    if (!_factory) {
-        if (!(_factory = new (std::nothrow) SimpleMatterFactory())) {
-            return false;
+    _initialized = true;
+    return true;
+}
+
+bool InterpreterIF::initialize(const char * snapshot)
+{
+    if (_initialized || _env) {
+        // there is a global env already
+        return false;
+    }
+
+    if (!_create_parser_and_factory()) {
+        return false;
+    }
+
+    // the builtin env is not saved, but referred to
+    ScopedEnvPtr builtins = builtin_env();
+    if (!builtins
+            || !(_env = HeapSnapshot::restore(snapshot, _factory, builtins))) {
+        return false;
+    }
+
+    _initialized = true;
+    return true;
+}
+
+bool InterpreterIF::save_snapshot(const char * filename)
+{
+    return _initialized && HeapSnapshot::save(filename, _env, builtin_env());
+}
+
+bool InterpreterIF::freeze()
+{
+    if (!_initialized) {
+        return false;
+    }
+
+    _collector.collect();
+    ScopedEnvPtr builtins = builtin_env();
+    ScopedEnvPtr frozen = builtins ? HeapSnapshot::freeze(_env, builtins)
+            : NULL;
+    if (!frozen) {
+        return false;
+    }
+
+    // the objects of the old env are kept by the frozen one, a collection
+    // would lock every one of them
+    _env = frozen;
+    _collector.forget();
+    return true;
+}
+
+bool InterpreterIF::checkpoint()
+{
+    if (!_initialized) {
+        return false;
+    }
+
+    ScopedEnvPtr env = _factory->create_env(_env);
+    if (!env) {
+        return false;
+    }
+    _checkpoints.push_back(_env);
+    _env = env;
+    return true;
+}
+
+bool InterpreterIF::reset()
+{
+    if (_checkpoints.empty()) {
+        return false;
+    }
+
+    ScopedEnvPtr env = _factory->create_env(_checkpoints.back());
+    if (!env) {
+        return false;
+    }
+    // the procedures defined in it refer to it
+    _env->clear();
+    _env = env;
+    _parser->reset_stream();
+    return true;
+}
+
+ScopedEnvPtr InterpreterIF::builtin_env()
+{
+    // never released, the procedures of the prelude are in cycles with it
+    static const ScopedEnvPtr * env =
+            new (std::nothrow) ScopedEnvPtr(create_builtin_env());
+    return env ? *env : NULL;
+}
+
+ScopedEnvPtr InterpreterIF::create_builtin_env()
+{
+    InterpreterIF builder;
+    if (!builder._create_parser_and_factory()
+            || !(builder._env = builder.create_minimum_env())) {
+        return NULL;
+    }
+    builder._expand();
+
+    // the procedures may be called by several threads at once, where their
+    // frames go is decided now, not by their first call
+    builder._env->for_each(_decide_frame_kind, NULL);
+
+    ScopedEnvPtr env = NULL;
+    env.swap(builder._env);
+    return env;
+}
+
+bool InterpreterIF::_decide_frame_kind(const std::string &name UNUSED,
+        const MatterPtr &value, void * arg UNUSED)
+{
+    if (value && value->is_proc()) {
+        Proc * proc = static_cast<Proc *>(value.get());
+        MatterPtr body = NULL;
+        if (proc->frame_kind() == Proc::frame_unknown && proc->get_body(body)) {
+            proc->set_frame_kind(_captures_frame(body)
+                    ? Proc::frame_heap : Proc::frame_stack);
         }
     }
+    return true;
+}
 
-    if (!_env) {
-        if (!(_env = create_minimum_env())) {
+bool InterpreterIF::_create_parser_and_factory()
+{
+    if (!_parser) {
+        if (!(_parser = new (std::nothrow) SimpleParser())) {
             return false;
         }
     }
 
-    _expand();
+    if (!_factory) {
+        if (!(_factory = new (std::nothrow) SimpleMatterFactory())) {
+            return false;
+        }
+        _factory->set_collector(&_collector);
+    }
 
-    _initialized = true;
     return true;
 }
 
@@ -91,6 +238,37 @@ ScopedEnvPtr InterpreterIF::create_minimum_env()
         { "<=", PrimProcLe::create },
         { ">",  PrimProcGt::create },
         { ">=", PrimProcGe::create },
+
+        { "cons",    PrimProcCons::create },
+        { "car",     PrimProcCar::create },
+        { "cdr",     PrimProcCdr::create },
+        { "list",    PrimProcList::create },
+        { "length",  PrimProcLength::create },
+        { "nth",     PrimProcNth::create },
+        { "reverse", PrimProcReverse::create },
+
+        { "vector",       PrimProcVector::create },
+        { "make-vector",  PrimProcMakeVector::create },
+        { "list->vector", PrimProcListToVector::create },
+        { "vec-len",      PrimProcVecLen::create },
+        { "vec-ref",      PrimProcVecRef::create },
+        { "vec-sum",      PrimProcVecSum::create },
+        { "vec-dot",      PrimProcVecDot::create },
+        { "vec-min",      PrimProcVecMin::create },
+        { "vec-max",      PrimProcVecMax::create },
+        { "vec-map+",     PrimProcVecMapAdd::create },
+        { "vec-scale",    PrimProcVecScale::create },
+
+        { "hash-map",  PrimProcHashMap::create },
+        { "get",       PrimProcGet::create },
+        { "assoc!",    PrimProcAssocBang::create },
+        { "dissoc!",   PrimProcDissocBang::create },
+        { "contains?", PrimProcContains::create },
+        { "count",     PrimProcCount::create },
+
+        { "persistent-map", PrimProcPersistentMap::create },
+        { "assoc",          PrimProcAssoc::create },
+        { "dissoc",         PrimProcDissoc::create },
     };
 
     for (size_t i = 0; i < array_size(items); ++i) {
@@ -156,6 +334,7 @@ bool InterpreterIF::_eval(const MatterPtr &expr, ScopedEnvPtr &scope,
             { _is_do, _eval_do, "do" }, //
             { _is_when, _eval_when, "when" }, //
             { _is_let, _eval_let, "let" }, //
+            { _is_quote, _eval_quote, "quote" }, //
             { _is_time, _eval_time, "time" }, //
             { _is_name, _eval_name, "name" }, //
             { _is_lambda, _eval_lambda, "lambda" }, //
@@ -223,7 +402,12 @@ bool InterpreterIF::_is_special_form(const MatterPtr &expr, const char * keyword
         return false;
     }
 
-    const Atom * first = static_cast<const Atom *>(ce->get(0).get());
+    const MatterPtr &head = (*ce)[0];
+    if (!head->is_atom()) {
+        return false;
+    }
+
+    const Atom * first = static_cast<const Atom *>(head.get());
     if (!first->is_cstr()) {
         return false;
     }
@@ -231,10 +415,36 @@ bool InterpreterIF::_is_special_form(const MatterPtr &expr, const char * keyword
     return strcmp(keyword, first->to_cstr()) == 0;
 }
 
+bool InterpreterIF::_is_true(const MatterPtr &value)
+{
+    if (!value) {
+        return false;
+    }
+
+    switch (value->matter_type()) {
+        case MatterIF::matter_atom:
+            return static_cast<const Atom *>(value.get())->not_empty();
+        case MatterIF::matter_composite_expr:
+            return static_cast<const CompositeExpr *>(value.get())->size();
+        case MatterIF::matter_prim_proc:
+            return true;
+        case MatterIF::matter_pair:
+            return !static_cast<const Pair *>(value.get())->is_nil();
+        case MatterIF::matter_vector:
+            return static_cast<const Vector *>(value.get())->size();
+        case MatterIF::matter_hash_map:
+            return static_cast<const HashMap *>(value.get())->size();
+        case MatterIF::matter_persistent_map:
+            return static_cast<const PersistentMap *>(value.get())->size();
+        default:
+            return false;
+    }
+}
+
 bool InterpreterIF::_eval_if(const MatterPtr &expr, ScopedEnvPtr &scope,
         InterpreterIF * interpreter, MatterPtr &result)
 {
-    CompositeExpr * ce = static_cast<CompositeExpr *>(expr.get());
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
     MatterPtr pred = ce->get(1);
     MatterPtr cons = ce->get(2);
     MatterPtr alt = ce->get(3);
@@ -243,19 +453,7 @@ bool InterpreterIF::_eval_if(const MatterPtr &expr, ScopedEnvPtr &scope,
         return false;
     }
 
-    MatterPtr final_form = alt;
-    if (res) {
-        if (res->is_atom() && static_cast<Atom *>(res.get())->not_empty()) {
-            final_form = cons;
-        }
-        else if (res->is_composite_expr()
-                && static_cast<CompositeExpr *>(res.get())->size()) {
-            final_form = cons;
-        }
-        else if (res->is_prim_proc()) {
-            final_form = cons;
-        }
-    }
+    MatterPtr final_form = _is_true(res) ? cons : alt;
 
     // result will be set by the following _eval()
     result = NULL;
@@ -271,7 +469,7 @@ bool InterpreterIF::_eval_if(const MatterPtr &expr, ScopedEnvPtr &scope,
 bool InterpreterIF::_eval_define(const MatterPtr &expr, ScopedEnvPtr &scope,
         InterpreterIF * interpreter, MatterPtr &result)
 {
-    CompositeExpr * ce = static_cast<CompositeExpr *>(expr.get());
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
     if (ce->size() != 3) {
         return false;
     }
@@ -282,7 +480,7 @@ bool InterpreterIF::_eval_define(const MatterPtr &expr, ScopedEnvPtr &scope,
         return false;
     }
 
-    Atom * name = static_cast<Atom *>(pos1.get());
+    const Atom * name = static_cast<const Atom *>(pos1.get());
     if (!name->is_cstr() || name->is_quoted_cstr()) {
         return false;
     }
@@ -300,7 +498,7 @@ bool InterpreterIF::_eval_name(const MatterPtr &expr, ScopedEnvPtr &scope,
     PRETTY_MESSAGE(stderr, "execute: `%s' ...",
             expr->debug_string(false).c_str());
     if (expr->is_atom()) {
-        Atom * e = static_cast<Atom *>(expr.get());
+        const Atom * e = static_cast<const Atom *>(expr.get());
         if (e->is_cstr() && scope->lookup(e->to_cstr(), result)) {
             return true;
         }
@@ -308,6 +506,41 @@ bool InterpreterIF::_eval_name(const MatterPtr &expr, ScopedEnvPtr &scope,
     return false;
 }
 
+bool InterpreterIF::_eval_quote(const MatterPtr &expr, ScopedEnvPtr &scope,
+        InterpreterIF * interpreter, MatterPtr &result)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
+    if (ce->size() != 2) {
+        return false;
+    }
+
+    return _quote((*ce)[1], interpreter, result);
+}
+
+bool InterpreterIF::_quote(const MatterPtr &expr, InterpreterIF * interpreter,
+        MatterPtr &result)
+{
+    if (!expr->is_composite_expr()) {
+        // atoms, including names, stand for themselves
+        result = expr;
+        return true;
+    }
+
+    // (a b c) => (cons a (cons b (cons c nil)))
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
+    MatterPtr res = Pair::nil();
+    MatterPtr elem = NULL;
+    for (size_t i = ce->size(); i > 0; --i) {
+        if (!_quote((*ce)[i - 1], interpreter, elem)
+                || !(res = interpreter->factory()->create_pair(elem, res))) {
+            return false;
+        }
+    }
+
+    result = res;
+    return true;
+}
+
 bool InterpreterIF::_eval_time(const MatterPtr &expr, ScopedEnvPtr &scope,
         InterpreterIF * interpreter, MatterPtr &result)
 {
@@ -318,14 +551,21 @@ bool InterpreterIF::_eval_time(const MatterPtr &expr, ScopedEnvPtr &scope,
 bool InterpreterIF::_eval_lambda(const MatterPtr &expr, ScopedEnvPtr &scope,
         InterpreterIF * interpreter, MatterPtr &result)
 {
-    CompositeExpr * ce = static_cast<CompositeExpr *>(expr.get());
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
     MatterPtr p1 = ce->get(1);
     MatterPtr p2 = ce->get(2);
     if (!p1 || !p1->is_composite_expr() || !p2) {
         return false;
     }
 
-    ProcPtr p = interpreter->factory()->create_proc(p1, p2, scope);
+    ScopedEnvPtr env = scope;
+    if (scope != interpreter->_env
+            && !_flatten(static_cast<const CompositeExpr *>(p1.get()), p2,
+                    scope, interpreter, env)) {
+        env = scope;
+    }
+
+    ProcPtr p = interpreter->factory()->create_proc(p1, p2, env);
     if (!p) {
         return false;
     }
@@ -334,10 +574,204 @@ bool InterpreterIF::_eval_lambda(const MatterPtr &expr, ScopedEnvPtr &scope,
     return true;
 }
 
+bool InterpreterIF::_flatten(const CompositeExpr * params,
+        const MatterPtr &body, ScopedEnvPtr &scope,
+        InterpreterIF * interpreter, ScopedEnvPtr &result)
+{
+    std::vector<std::string> bound;
+    std::vector<std::string> names;
+    for (CompositeExpr::const_iterator it = params->begin();
+            it != params->end(); ++it) {
+        if (!_is_name(*it)) {
+            return false;
+        }
+        bound.push_back(static_cast<const Atom *>(it->get())->to_cstr());
+    }
+
+    if (!_free_names(body, bound, names)) {
+        return false;
+    }
+
+    const ScopedEnvPtr &global = interpreter->_env;
+    ScopedEnvPtr captures = NULL;
+    MatterPtr value = NULL;
+    for (size_t i = 0; i < names.size(); ++i) {
+        ScopedEnvPtr e = scope;
+        while (e && e != global && !e->lookup_local(names[i], value)) {
+            // a binding made later would hide the one found beyond
+            if (_may_bind(e, names[i])) {
+                return false;
+            }
+            e = e->external();
+        }
+
+        if (!e) {
+            // `scope' is not a descendant of the global env
+            return false;
+        }
+        else if (e == global) {
+            if (!global->lookup(names[i], value)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (!captures) {
+            if (!(captures = interpreter->factory()->create_env(global))) {
+                return false;
+            }
+            captures->seal();
+        }
+        if (!captures->add(names[i], value)) {
+            return false;
+        }
+    }
+
+    result = captures ? captures : global;
+    return true;
+}
+
+bool InterpreterIF::_may_bind(const ScopedEnvPtr &env, const std::string &name)
+{
+    switch (env->binds()) {
+        case ScopedEnv::binds_none:
+            return false;
+        case ScopedEnv::binds_code:
+            return _may_define(env->code(), name);
+        case ScopedEnv::binds_let: {
+            // (let (name value ...) body ...)
+            const CompositeExpr * ce =
+                    static_cast<const CompositeExpr *>(env->code().get());
+            const CompositeExpr * defs =
+                    static_cast<const CompositeExpr *>(ce->get(1).get());
+            for (size_t i = 0; i + 1 < defs->size(); i += 2) {
+                const MatterPtr &bound = (*defs)[i];
+                if (!_is_name(bound) || _may_define((*defs)[i + 1], name)
+                        || name == static_cast<const Atom *>(
+                                bound.get())->to_cstr()) {
+                    return true;
+                }
+            }
+            for (size_t i = 2; i < ce->size(); ++i) {
+                if (_may_define((*ce)[i], name)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        default:
+            return true;
+    }
+}
+
+bool InterpreterIF::_may_define(const MatterPtr &expr, const std::string &name)
+{
+    if (!expr->is_composite_expr() || _is_quote(expr) || _is_lambda(expr)
+            || _is_let(expr)) {
+        return false;
+    }
+
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
+    bool defn = _is_defn(expr);
+    if (defn || _is_define(expr)) {
+        MatterPtr defined = ce->get(1);
+        if (!defined || !_is_name(defined) || name
+                == static_cast<const Atom *>(defined.get())->to_cstr()) {
+            return true;
+        }
+        if (defn) {
+            return false;
+        }
+    }
+
+    for (CompositeExpr::const_iterator it = ce->begin(); it != ce->end();
+            ++it) {
+        if (_may_define(*it, name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InterpreterIF::_free_names(const MatterPtr &expr,
+        std::vector<std::string> &bound, std::vector<std::string> &names)
+{
+    if (_is_name(expr)) {
+        const char * name = static_cast<const Atom *>(expr.get())->to_cstr();
+        if (std::find(bound.begin(), bound.end(), name) == bound.end()
+                && std::find(names.begin(), names.end(), name) == names.end()) {
+            names.push_back(name);
+        }
+        return true;
+    }
+
+    if (!expr->is_composite_expr() || _is_quote(expr)) {
+        return true;
+    }
+
+    if (_is_define(expr) || _is_defn(expr)) {
+        return false;
+    }
+
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
+    size_t first = 0;
+    size_t depth = bound.size();
+    if (_is_lambda(expr)) {
+        MatterPtr params = ce->get(1);
+        if (ce->size() != 3 || !params->is_composite_expr()) {
+            return false;
+        }
+
+        const CompositeExpr * pe =
+                static_cast<const CompositeExpr *>(params.get());
+        for (CompositeExpr::const_iterator it = pe->begin(); it != pe->end();
+                ++it) {
+            if (!_is_name(*it)) {
+                return false;
+            }
+            bound.push_back(static_cast<const Atom *>(it->get())->to_cstr());
+        }
+        first = 2;
+    }
+    else if (_is_let(expr)) {
+        MatterPtr defs = ce->get(1);
+        if (!defs || !defs->is_composite_expr()) {
+            return false;
+        }
+
+        // all the names are visible to the lambdas in the values
+        const CompositeExpr * de = static_cast<const CompositeExpr *>(defs.get());
+        for (size_t i = 0; i < de->size(); i += 2) {
+            if (!_is_name((*de)[i])) {
+                return false;
+            }
+            bound.push_back(static_cast<const Atom *>((*de)[i].get())->to_cstr());
+        }
+        for (size_t i = 1; i < de->size(); i += 2) {
+            if (!_free_names((*de)[i], bound, names)) {
+                return false;
+            }
+        }
+        first = 2;
+    }
+    else if (_is_if(expr) || _is_cond(expr) || _is_do(expr) || _is_when(expr)
+            || _is_time(expr)) {
+        first = 1;
+    }
+
+    bool ok = true;
+    for (size_t i = first; ok && i < ce->size(); ++i) {
+        ok = _free_names((*ce)[i], bound, names);
+    }
+
+    bound.resize(depth);
+    return ok;
+}
+
 bool InterpreterIF::_eval_defn(const MatterPtr &expr, ScopedEnvPtr &scope,
         InterpreterIF * interpreter UNUSED, MatterPtr &result)
 {
-    CompositeExpr * ce = static_cast<CompositeExpr *>(expr.get());
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
     if (ce->size() != 4) {
         return false;
     }
@@ -345,7 +779,7 @@ bool InterpreterIF::_eval_defn(const MatterPtr &expr, ScopedEnvPtr &scope,
     if (!n->is_atom()) {
         return false;
     }
-    Atom * name = static_cast<Atom *>(n.get());
+    const Atom * name = static_cast<const Atom *>(n.get());
     if (!name->is_cstr() || name->is_quoted_cstr()) {
         return false;
     }
@@ -365,7 +799,7 @@ bool InterpreterIF::_eval_let(const MatterPtr &expr, ScopedEnvPtr &scope,
 {
     result = NULL;
 
-    CompositeExpr * ce = static_cast<CompositeExpr *>(expr.get());
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
     size_t sz = ce->size();
     // syntax error
     if (sz == 1) {
@@ -382,30 +816,31 @@ bool InterpreterIF::_eval_let(const MatterPtr &expr, ScopedEnvPtr &scope,
         // syntax error
         return false;
     }
-    CompositeExpr * defs = static_cast<CompositeExpr *>(mp.get());
+    const CompositeExpr * defs = static_cast<const CompositeExpr *>(mp.get());
     size_t sz2 = defs->size();
     if (sz2 % 2) {
         return false;
     }
 
-#define ENFORCE_ENV_CLEANUP() do { newenv->clear(); } while (0)
-    // NOTE: the newly created env should be clear() manually, in case
-    // functions are created in the `let' expr.
+    // closures created here may escape, cycles are left to the collector
     ScopedEnvPtr newenv = interpreter->factory()->create_env(scope);
-    Atom * name = NULL;
+    if (!newenv) {
+        return false;
+    }
+    newenv->set_code(expr, ScopedEnv::binds_let);
+
+    const Atom * name = NULL;
     MatterPtr value = NULL;
     for (size_t i = 0; i < sz2; i += 2) {
         if (!(mp = defs->get(i)) || !mp->is_atom()) {
-            ENFORCE_ENV_CLEANUP();
             return false;
         }
 
-        name = static_cast<Atom *>(mp.get());
+        name = static_cast<const Atom *>(mp.get());
         if (!name->is_cstr()
                 || name->is_quoted_cstr()
                 || !_eval(defs->get(i + 1), newenv, interpreter, value)
                 || !newenv->add(name->to_cstr(), value)) {
-            ENFORCE_ENV_CLEANUP();
             return false;
         }
     }
@@ -415,9 +850,7 @@ bool InterpreterIF::_eval_let(const MatterPtr &expr, ScopedEnvPtr &scope,
             return false;
         }
     }
-
-    ENFORCE_ENV_CLEANUP();
-#undef ENFORCE_ENV_CLEANUP
+    newenv->seal();
 
     result = value;
     return true;
@@ -426,7 +859,7 @@ bool InterpreterIF::_eval_let(const MatterPtr &expr, ScopedEnvPtr &scope,
 bool InterpreterIF::_eval_cond(const MatterPtr &expr, ScopedEnvPtr &scope,
         InterpreterIF * interpreter, MatterPtr &result)
 {
-    CompositeExpr * ce = static_cast<CompositeExpr *>(expr.get());
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
     size_t sz = ce->size();
     if (sz % 2 != 1) {
         return false;
@@ -440,11 +873,7 @@ bool InterpreterIF::_eval_cond(const MatterPtr &expr, ScopedEnvPtr &scope,
             return false;
         }
 
-        if (res && ((res->is_atom()
-                    && static_cast<Atom *>(res.get())->not_empty())
-                || (res->is_composite_expr()
-                    && static_cast<CompositeExpr *>(res.get())->size())
-            )) {
+        if (_is_true(res)) {
             return (elem = ce->get(i + 1))
                 ? _eval(elem, scope, interpreter, result) : false;
         }
@@ -459,7 +888,7 @@ bool InterpreterIF::_eval_do(const MatterPtr &expr, ScopedEnvPtr &scope,
 {
     MatterPtr res = NULL;
     MatterPtr m = NULL;
-    CompositeExpr * ce = static_cast<CompositeExpr *>(expr.get());
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
     size_t sz = ce->size();
     for (size_t i = 1; i < sz; ++i) {
         m = ce->get(i);
@@ -476,7 +905,7 @@ bool InterpreterIF::_eval_when(const MatterPtr &expr, ScopedEnvPtr &scope,
         InterpreterIF * interpreter, MatterPtr &result)
 {
     MatterPtr res = NULL;
-    CompositeExpr * ce = static_cast<CompositeExpr *>(expr.get());
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
     size_t sz = ce->size();
     result = NULL;
     if (sz > 1) {
@@ -485,11 +914,7 @@ bool InterpreterIF::_eval_when(const MatterPtr &expr, ScopedEnvPtr &scope,
             return false;
         }
 
-        if (sz > 2 && res && ((res->is_atom()
-                && static_cast<Atom *>(res.get())->not_empty())
-            || (res->is_composite_expr()
-                && static_cast<CompositeExpr *>(res.get())->size())
-            )) {
+        if (sz > 2 && _is_true(res)) {
             for (size_t i = 2; i < sz; ++i) {
                 if (!_eval(ce->get(i), scope, interpreter, result)) {
                     result = NULL;
@@ -514,21 +939,21 @@ bool InterpreterIF::_eval_app(const MatterPtr &expr, ScopedEnvPtr &scope,
 {
     PRETTY_MESSAGE(stderr, "executing `%s' ...",
             expr->debug_string(false).c_str());
-    CompositeExpr * ce = static_cast<CompositeExpr *>(expr.get());
-    if (!ce->rewind() || !ce->has_next()) {
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(expr.get());
+    if (!ce->size()) {
         return false;
     }
 
-    MatterPtr first = ce->get_next();
-    CompositeExprPtr args = interpreter->factory()->create_composite_expr();
+    const MatterPtr &first = (*ce)[0];
+    CompositeExprPtr args = interpreter->factory()->create_composite_expr(
+            ce->size() - 1);
     if (!args) {
         return false;
     }
 
-    MatterPtr ie = NULL;
-    while (ce->has_next()) {
-        ie = ce->get_next();
-        FuturePtr f = interpreter->factory()->create_future(ie, scope,
+    for (CompositeExpr::const_iterator it = ce->begin() + 1; it != ce->end();
+            ++it) {
+        FuturePtr f = interpreter->factory()->create_future(*it, scope,
                 interpreter);
         if (!f) {
             PRETTY_MESSAGE(stderr, "failed creating Future object");
@@ -563,16 +988,18 @@ bool InterpreterIF::_apply(const MatterPtr &proc_name, const MatterPtr &proc_ope
             proc_operands->debug_string(false).c_str());
     if (proc_name->is_prim_proc()) {
         PrimProcIF * p = static_cast<PrimProcIF *>(proc_name.get());
-        CompositeExprPtr ce = interpreter->factory()->create_composite_expr();
+        const CompositeExpr * operands =
+                static_cast<const CompositeExpr *>(proc_operands.get());
+        CompositeExprPtr ce = interpreter->factory()->create_composite_expr(
+                operands->size());
         if (!ce) {
             return false;
         }
 
-        CompositeExpr * operands = static_cast<CompositeExpr *>(proc_operands.get());
-        operands->rewind();
-        while (operands->has_next()) {
+        for (CompositeExpr::const_iterator it = operands->begin();
+                it != operands->end(); ++it) {
             MatterPtr res = NULL;
-            if (!_realize(operands->get_next(), res)) {
+            if (!_realize(*it, res)) {
                 return false;
             }
             ce->append_expr(res);
@@ -594,34 +1021,88 @@ bool InterpreterIF::_apply(const MatterPtr &proc_name, const MatterPtr &proc_ope
             return false;
         }
 
-        CompositeExpr * params = static_cast<CompositeExpr *>(temp.get());
-        CompositeExpr * operands =
-                static_cast<CompositeExpr *>(proc_operands.get());
+        const CompositeExpr * params = static_cast<const CompositeExpr *>(temp.get());
+        const CompositeExpr * operands =
+                static_cast<const CompositeExpr *>(proc_operands.get());
         if (params->size() != operands->size()) {
             return false;
         }
-        if (!params->rewind() || !operands->rewind()) {
-            return false;
-        }
 
-        ScopedEnvPtr newenv = interpreter->factory()->create_env(env);
-        if (!newenv) {
-            return false;
+        if (proc->frame_kind() == Proc::frame_unknown) {
+            proc->set_frame_kind(_captures_frame(body)
+                    ? Proc::frame_heap : Proc::frame_stack);
         }
 
-        Atom * param = NULL;
-        while (params->has_next() /* && operands->has_next() */) {
-            param = static_cast<Atom*>(params->get_next().get());
-            if (!param->is_cstr() || param->is_quoted_cstr()) {
+        if (proc->frame_kind() == Proc::frame_heap) {
+            ScopedEnvPtr newenv = interpreter->factory()->create_env(env);
+            if (!newenv || !_bind_params(params, operands, newenv)) {
                 return false;
             }
-
-            if (!newenv->add(param->to_cstr(), operands->get_next())) {
+            newenv->set_code(body, ScopedEnv::binds_code);
+            if (!_eval(body, newenv, interpreter, result)) {
                 return false;
             }
+            newenv->seal();
+            return true;
+        }
+
+        FrameStack &frames = interpreter->_frames;
+        FrameStack::Mark mark = frames.mark();
+        bool ok = false;
+        {
+            ScopedEnvPtr newenv = frames.create_env(env);
+            ok = newenv && _bind_params(params, operands, newenv)
+                    && _eval(body, newenv, interpreter, result);
+            if (newenv.use_count() > 1) {
+                // escaped, through a Future created in it
+                frames.retire();
+            }
+        }
+        frames.rewind(mark);
+        return ok;
+    }
+
+    return false;
+}
+
+bool InterpreterIF::_bind_params(const CompositeExpr * params,
+        const CompositeExpr * operands, ScopedEnvPtr &env)
+{
+    const Atom * param = NULL;
+    for (size_t i = 0; i < params->size(); ++i) {
+        param = static_cast<const Atom *>((*params)[i].get());
+        if (!param->is_cstr() || param->is_quoted_cstr()) {
+            return false;
+        }
+
+        if (!env->add(param->to_cstr(), (*operands)[i])) {
+            return false;
         }
+    }
+
+    return true;
+}
 
-        return _eval(body, newenv, interpreter, result);
+bool InterpreterIF::_captures_frame(const MatterPtr &body)
+{
+    if (!body->is_composite_expr()) {
+        return false;
+    }
+
+    if (_is_lambda(body) || _is_defn(body) || _is_define(body)) {
+        return true;
+    }
+
+    if (_is_quote(body)) {
+        return false;
+    }
+
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(body.get());
+    for (CompositeExpr::const_iterator it = ce->begin(); it != ce->end();
+            ++it) {
+        if (_captures_frame(*it)) {
+            return true;
+        }
     }
 
     return false;
@@ -629,9 +1110,17 @@ bool InterpreterIF::_apply(const MatterPtr &proc_name, const MatterPtr &proc_ope
 
 bool InterpreterIF::execute(MatterPtr &result, const char * str, ssize_t len)
 {
-    MatterPtr forms = _parser->parse(str, len);
+    size_t length = len < 0 ? strlen(str) : len;
+    MatterPtr forms = NULL;
+    if (_parse_cache.find(str, length, forms)) {
+        return execute_multi_expr(result, forms);
+    }
+
+    forms = _parser->parse(str, length);
     if (!forms) {
-        PRETTY_MESSAGE(stderr, "failed parsing input string!");
+        PRETTY_MESSAGE(stderr, "failed parsing input string, %s at byte %zu!",
+                _parser->error_message() ? _parser->error_message() : "no form",
+                _parser->error_offset());
         return false;
     }
 
@@ -641,6 +1130,7 @@ bool InterpreterIF::execute(MatterPtr &result, const char * str, ssize_t len)
         return false;
     }
 
+    _parse_cache.insert(str, length, forms);
     return execute_multi_expr(result, forms);
 }
 
@@ -651,14 +1141,10 @@ bool InterpreterIF::execute_multi_expr(MatterPtr &result, const MatterPtr &expr)
         return false;
     }
 
-    CompositeExpr * forms = static_cast<CompositeExpr *>(expr.get());
-    if (!forms->rewind()) {
-        PRETTY_MESSAGE(stderr, "rewind() failed!");
-        return false;
-    }
-
-    while (forms->has_next()) {
-        if (!execute_expr(result, forms->get_next())) {
+    const CompositeExpr * forms = static_cast<const CompositeExpr *>(expr.get());
+    for (CompositeExpr::const_iterator it = forms->begin(); it != forms->end();
+            ++it) {
+        if (!execute_expr(result, *it)) {
             PRETTY_MESSAGE(stderr, "failed executing form");
             return false;
         }
@@ -667,77 +1153,270 @@ bool InterpreterIF::execute_multi_expr(MatterPtr &result, const MatterPtr &expr)
     return true;
 }
 
+bool InterpreterIF::_is_param_name(const std::string &name) const
+{
+    // a name if the parser says so
+    MatterPtr parsed = _parser->parse(name.data(), name.size());
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(parsed.get());
+    return parsed && parsed->is_composite_expr() && ce->size() == 1
+            && _is_name((*ce)[0]);
+}
+
+bool InterpreterIF::_register_native(const char * name,
+        const PrimProcPtr &proc)
+{
+    if (!_initialized || !proc) {
+        return false;
+    }
+    if (!name || !_is_param_name(name)) {
+        PRETTY_MESSAGE(stderr, "invalid name `%s'", name ? name : "");
+        return false;
+    }
+    if (!_env->add(name, proc)) {
+        PRETTY_MESSAGE(stderr, "`%s' is defined already", name);
+        return false;
+    }
+    return true;
+}
+
+PreparedExpr InterpreterIF::prepare(const char * str,
+        const std::vector<std::string> &params, ssize_t len)
+{
+    PreparedExpr prepared;
+    if (!_initialized) {
+        return prepared;
+    }
+
+    for (size_t i = 0; i < params.size(); ++i) {
+        if (!_is_param_name(params[i])
+                || std::find(params.begin(), params.begin() + i, params[i])
+                        != params.begin() + i) {
+            PRETTY_MESSAGE(stderr, "invalid parameter `%s'", params[i].c_str());
+            return prepared;
+        }
+    }
+
+    MatterPtr forms = _parser->parse(str, len);
+    if (!forms || !forms->is_composite_expr()
+            || !static_cast<const CompositeExpr *>(forms.get())->size()) {
+        PRETTY_MESSAGE(stderr, "failed parsing input string, %s at byte %zu!",
+                _parser->error_message() ? _parser->error_message() : "no form",
+                _parser->error_offset());
+        return prepared;
+    }
+
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(forms.get());
+    for (CompositeExpr::const_iterator it = ce->begin(); it != ce->end();
+            ++it) {
+        prepared._heap_frame = prepared._heap_frame || _captures_frame(*it);
+    }
+    prepared._params = params;
+    prepared._forms = forms;
+    prepared._env = _env;
+    prepared._interpreter = this;
+    return prepared;
+}
+
+bool InterpreterIF::eval(const PreparedExpr &prepared, MatterPtr &result,
+        const std::vector<MatterPtr> &args)
+{
+    if (prepared._interpreter != this) {
+        PRETTY_MESSAGE(stderr, "not prepared by this interpreter!");
+        return false;
+    }
+    if (args.size() != prepared._params.size()) {
+        PRETTY_MESSAGE(stderr, "%zu arguments, %zu expected", args.size(),
+                prepared._params.size());
+        return false;
+    }
+
+    const CompositeExpr * forms =
+            static_cast<const CompositeExpr *>(prepared._forms.get());
+    FrameStack::Mark mark = _frames.mark();
+    bool ok = false;
+    {
+        ScopedEnvPtr frame = prepared._heap_frame
+                ? _factory->create_env(prepared._env)
+                : _frames.create_env(prepared._env);
+        ok = frame != NULL;
+        for (size_t i = 0; ok && i < args.size(); ++i) {
+            ok = args[i] && frame->add(prepared._params[i], args[i]);
+        }
+        if (ok) {
+            frame->set_code(prepared._forms, ScopedEnv::binds_code);
+        }
+        for (CompositeExpr::const_iterator it = forms->begin();
+                ok && it != forms->end(); ++it) {
+            ok = _force_eval(*it, frame, this, result);
+        }
+        if (ok) {
+            frame->seal();
+        }
+        if (!prepared._heap_frame && frame && frame.use_count() > 1) {
+            // escaped, through a Future created in it
+            _frames.retire();
+        }
+    }
+    _frames.rewind(mark);
+
+    // safe point, nothing is being evaluated
+    if (_collector.should_collect()) {
+        _collector.collect();
+    }
+
+    return ok;
+}
+
 bool InterpreterIF::execute_expr(MatterPtr &result, const MatterPtr &expr)
 {
     PRETTY_MESSAGE(stderr, "executing expr `%s' ...",
             expr->debug_string(false).c_str());
-    if (!_force_eval(expr, this->_env, this, result)) {
+    bool ok = _force_eval(expr, this->_env, this, result);
+    if (!ok) {
         PRETTY_MESSAGE(stderr, "failed");
-        return false;
     }
 
-    return true;
+    // safe point, nothing is being evaluated
+    if (_collector.should_collect()) {
+        _collector.collect();
+    }
+
+    return ok;
 }
 
-void InterpreterIF::_repl(InterpreterIF * interpreter, const char * filename)
+bool InterpreterIF::_run_script_file(ParserIF * parser, const char * filename,
+        const char * script, size_t length,
+        const std::function<bool(const MatterPtr &)> &execute)
 {
-    static const size_t default_buf_length = 4096;
-    char * buffer = (char *) malloc(default_buf_length);
-    if (!buffer) {
-        PRETTY_MESSAGE(stderr, "memory allocation failed!");
-        return;
+    bool cached = ScriptCache::enabled();
+    std::string cache_name = ScriptCache::cache_filename(filename);
+    std::vector<MatterPtr> forms;
+    if (cached && ScriptCache::load(cache_name.c_str(), script, length,
+            forms)) {
+        for (size_t i = 0; i < forms.size(); ++i) {
+            execute(forms[i]);
+        }
+        return true;
     }
 
-    MatterPtr ie = NULL;
-    CompositeExpr * ce = NULL;
+    // the forms are kept for the cache
+    auto keep = [&forms, &execute](const MatterPtr &form) {
+        forms.push_back(form);
+        return execute(form);
+    };
+
+    bool ok = true;
+    const char * message = NULL;
+    size_t offset = 0;
+    if (length >= PARALLEL_LOAD_SIZE) {
+        // a large script, parsed by several threads
+        ParallelLoader loader;
+        ok = loader.load(script, length, keep);
+        message = loader.error_message();
+        offset = loader.error_offset();
+    }
+    else {
+        std::vector<MatterPtr> parsed;
+        parser->reset_stream();
+        ok = parser->feed(script, length, parsed) && parser->finish(parsed);
+        message = parser->error_message();
+        offset = parser->error_offset();
+        for (size_t i = 0; i < parsed.size(); ++i) {
+            keep(parsed[i]);
+        }
+    }
+
+    if (!ok) {
+        fprintf(stderr, "parse error: %s at byte %zu of file `%s'.\n",
+                message, offset, filename);
+        return false;
+    }
+
+    if (cached) {
+        // a script which cannot be cached (e.g. read-only) is run anyway
+        ScriptCache::write(cache_name.c_str(), script, length, forms);
+    }
+    return true;
+}
+
+bool InterpreterIF::_run_file(InterpreterIF * interpreter,
+        const char * filename,
+        const std::function<bool(const MatterPtr &)> &execute)
+{
     ScriptFileReader reader;
     if (!reader.initialize(filename)) {
         PRETTY_MESSAGE(stderr, "cannot initialize reader!");
-        return;
+        return false;
     }
 
-    ssize_t buffer_size = default_buf_length;
-    ssize_t input_len = 0;
+    // forms are executed as soon as they are complete, whatever the chunks
+    ParserIF * parser = interpreter->parser();
+    parser->reset_stream();
+    std::vector<MatterPtr> forms;
     while (true) {
-        //printf("%s", prompt());
-        if ((input_len = reader.get_next_statement(&buffer, &buffer_size)) == -1) {
-            if (!reader.eof()) {
-                fprintf(stderr, "found error: file `%s', line number `%ld'.\n",
-                        reader.filename(), reader.line_number());
-            }
-            break;
+        const char * chunk = NULL;
+        ssize_t input_len = reader.next_chunk(&chunk, !parser->in_progress());
+
+        if (reader.is_mapped() && input_len > 0 && !parser->in_progress()) {
+            // the whole of a script file
+            return _run_script_file(parser, reader.filename(), chunk,
+                    input_len, execute);
         }
 
-        ie = interpreter->parser()->parse(buffer, input_len);
-        if (!ie) {
-            continue;
+        bool ok = input_len > 0 ? parser->feed(chunk, input_len, forms)
+                : parser->finish(forms);
+
+        for (size_t i = 0; i < forms.size(); ++i) {
+            execute(forms[i]);
         }
+        forms.clear();
 
-        if (!ie->is_composite_expr()) {
-            PRETTY_MESSAGE(stderr, "this shoud not happen");
-            break;
+        if (!ok) {
+            fprintf(stderr, "parse error: %s at byte %zu of file `%s'.\n",
+                    parser->error_message(), parser->error_offset(),
+                    reader.filename());
+            return false;
         }
 
-        ce = static_cast<CompositeExpr *>(ie.get());
-        ce->rewind();
-        while (ce->has_next()) {
-            MatterPtr next = ce->get_next();
-            PRETTY_MESSAGE(stderr, "executing expr `%s' ...",
-                    next->debug_string(false).c_str());
-            MatterPtr a_result = NULL;
-            if (!interpreter->execute_expr(a_result, next)) {
-                PRETTY_MESSAGE(stderr, "oops, failed!");
-            }
-            else if (a_result) {
-                PRETTY_MESSAGE(stderr, "result: `%s'",
-                        a_result->debug_string().c_str());
-                printf("%s\n", a_result->to_string().c_str());
-            }
-            // some expr (e.g. define, defn) returns nothing
+        if (input_len <= 0) {
+            return true;
         }
     }
+}
 
-    free(buffer);
+void InterpreterIF::_repl(InterpreterIF * interpreter, const char * filename)
+{
+    _run_file(interpreter, filename, [interpreter](const MatterPtr &next) {
+        PRETTY_MESSAGE(stderr, "executing expr `%s' ...",
+                next->debug_string(false).c_str());
+        MatterPtr a_result = NULL;
+        if (!interpreter->execute_expr(a_result, next)) {
+            PRETTY_MESSAGE(stderr, "oops, failed!");
+        }
+        else if (a_result) {
+            PRETTY_MESSAGE(stderr, "result: `%s'",
+                    a_result->debug_string().c_str());
+            printf("%s\n", a_result->to_string().c_str());
+        }
+        // some expr (e.g. define, defn) returns nothing
+        return true;
+    });
+}
+
+bool InterpreterIF::load_script(const char * filename)
+{
+    if (!filename) {
+        return false;
+    }
+
+    // every form is executed, as in the REPL
+    bool ok = true;
+    bool read = _run_file(this, filename, [this, &ok](const MatterPtr &next) {
+        MatterPtr result = NULL;
+        ok = execute_expr(result, next) && ok;
+        return true;
+    });
+    return read && ok;
 }
 
 void InterpreterIF::interactive(const char * filename)
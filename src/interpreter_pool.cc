@@ -0,0 +1,260 @@
+/*
+ * file name:           src/interpreter_pool.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 05:12:48 2026 CST
+ */
+
+#include <new>
+#include "interpreter_pool.h"
+#include "interpreter.h"
+#include "matter.h"
+#include "pretty_message.h"
+#include "utils.h"
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+const uint64_t INDEX_MASK = 0xffffffffULL;
+
+uint64_t head_of(uint64_t tag, uint32_t top)
+{
+    return (tag << 32) | top;
+}
+
+template<typename T>
+void update_max(std::atomic<T> &max, T value)
+{
+    T current = max.load(std::memory_order_relaxed);
+    while (current < value
+            && !max.compare_exchange_weak(current, value,
+                    std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+InterpreterIF * InterpreterPool::Lease::get() const
+{
+    return _pool ? _pool->_slots[_index].interpreter : NULL;
+}
+
+void InterpreterPool::Lease::release()
+{
+    if (_pool) {
+        _pool->_release(_index);
+        _pool = NULL;
+    }
+}
+
+InterpreterPool::InterpreterPool(size_t size, const char * setup) :
+        _size(size), _setup(setup), _slots(NULL), _initialized_usec(0),
+        _head(0), _waiters(0), _acquisitions(0), _waits(0),
+        _total_wait_usec(0), _max_wait_usec(0), _in_use(0), _max_in_use(0),
+        _leased_usec(0)
+{
+}
+
+InterpreterPool::~InterpreterPool()
+{
+    if (_slots) {
+        for (size_t i = 0; i < _size; ++i) {
+            delete _slots[i].interpreter;
+        }
+        delete[] _slots;
+        _slots = NULL;
+    }
+}
+
+bool InterpreterPool::initialize()
+{
+    if (_slots) {
+        PRETTY_MESSAGE(stderr, "already initialized");
+        return false;
+    }
+    if (!_size || _size >= INDEX_MASK) {
+        PRETTY_MESSAGE(stderr, "invalid pool size %zu", _size);
+        return false;
+    }
+
+    Slot * slots = new (std::nothrow) Slot[_size];
+    if (!slots) {
+        return false;
+    }
+    for (size_t i = 0; i < _size; ++i) {
+        slots[i].interpreter = NULL;
+        slots[i].next.store(i + 1 < _size ? i + 2 : 0);
+        slots[i].leased_usec.store(0);
+    }
+
+    for (size_t i = 0; i < _size; ++i) {
+        InterpreterIF * interpreter = new (std::nothrow) SimpleInterpreter();
+        slots[i].interpreter = interpreter;
+        if (!interpreter || !interpreter->initialize()) {
+            PRETTY_MESSAGE(stderr, "failed initializing interpreter %zu", i);
+            break;
+        }
+        MatterPtr result;
+        if (_setup && !interpreter->execute(result, _setup)) {
+            PRETTY_MESSAGE(stderr, "interpreter %zu failed the setup", i);
+            break;
+        }
+        if (!interpreter->checkpoint()) {
+            break;
+        }
+        if (i + 1 == _size) {
+            _slots = slots;
+        }
+    }
+    if (!_slots) {
+        for (size_t i = 0; i < _size; ++i) {
+            delete slots[i].interpreter;
+        }
+        delete[] slots;
+        return false;
+    }
+
+    _initialized_usec = Utils::Time::timestamp_usec();
+    _head.store(head_of(0, 1));
+    return true;
+}
+
+bool InterpreterPool::_pop(uint32_t &index)
+{
+    uint64_t head = _head.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t top = static_cast<uint32_t>(head & INDEX_MASK);
+        if (!top) {
+            return false;
+        }
+        // the slot may be popped by another thread meanwhile, then the tag
+        // has changed, and the exchange fails
+        uint32_t next = _slots[top - 1].next.load(std::memory_order_relaxed);
+        if (_head.compare_exchange_weak(head, head_of((head >> 32) + 1, next),
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+            index = top - 1;
+            return true;
+        }
+    }
+}
+
+void InterpreterPool::_push(uint32_t index)
+{
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    for (;;) {
+        _slots[index].next.store(static_cast<uint32_t>(head & INDEX_MASK),
+                std::memory_order_relaxed);
+        if (_head.compare_exchange_weak(head,
+                head_of((head >> 32) + 1, index + 1),
+                std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+InterpreterPool::Lease InterpreterPool::_lease(uint32_t index,
+        uint64_t wait_usec)
+{
+    _slots[index].leased_usec.store(Utils::Time::timestamp_usec(),
+            std::memory_order_relaxed);
+    _acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (wait_usec) {
+        _waits.fetch_add(1, std::memory_order_relaxed);
+        _total_wait_usec.fetch_add(wait_usec, std::memory_order_relaxed);
+        update_max(_max_wait_usec, wait_usec);
+    }
+    update_max(_max_in_use,
+            _in_use.fetch_add(1, std::memory_order_relaxed) + 1);
+    return Lease(this, index);
+}
+
+InterpreterPool::Lease InterpreterPool::try_acquire()
+{
+    uint32_t index;
+    if (!_slots || !_pop(index)) {
+        return Lease();
+    }
+    return _lease(index, 0);
+}
+
+InterpreterPool::Lease InterpreterPool::acquire()
+{
+    uint32_t index;
+    if (!_slots) {
+        return Lease();
+    }
+    if (_pop(index)) {
+        return _lease(index, 0);
+    }
+
+    int64_t start = Utils::Time::timestamp_usec();
+    // counted before popping again, so a release in between notifies
+    _waiters.fetch_add(1);
+    {
+        std::unique_lock<std::mutex> guard(_lock);
+        while (!_pop(index)) {
+            _released.wait(guard);
+        }
+    }
+    _waiters.fetch_sub(1);
+    int64_t waited = Utils::Time::timestamp_usec() - start;
+    return _lease(index, waited > 0 ? waited : 1);
+}
+
+void InterpreterPool::_release(uint32_t index)
+{
+    Slot &slot = _slots[index];
+    slot.interpreter->reset();
+
+    int64_t leased = slot.leased_usec.exchange(0, std::memory_order_relaxed);
+    int64_t held = Utils::Time::timestamp_usec() - leased;
+    _leased_usec.fetch_add(held > 0 ? held : 0, std::memory_order_relaxed);
+    _in_use.fetch_sub(1, std::memory_order_relaxed);
+
+    _push(index);
+    if (_waiters.load()) {
+        // the waiter is either before its pop, or waiting already
+        std::lock_guard<std::mutex> guard(_lock);
+        _released.notify_one();
+    }
+}
+
+InterpreterPool::Stats InterpreterPool::stats() const
+{
+    Stats stats;
+    stats.acquisitions = _acquisitions.load(std::memory_order_relaxed);
+    stats.waits = _waits.load(std::memory_order_relaxed);
+    stats.total_wait_usec = _total_wait_usec.load(std::memory_order_relaxed);
+    stats.max_wait_usec = _max_wait_usec.load(std::memory_order_relaxed);
+    stats.in_use = _in_use.load(std::memory_order_relaxed);
+    stats.max_in_use = _max_in_use.load(std::memory_order_relaxed);
+    stats.utilization = 0;
+    if (!_slots) {
+        return stats;
+    }
+
+    int64_t now = Utils::Time::timestamp_usec();
+    uint64_t leased = _leased_usec.load(std::memory_order_relaxed);
+    // the leases not returned yet count too
+    for (size_t i = 0; i < _size; ++i) {
+        int64_t since = _slots[i].leased_usec.load(std::memory_order_relaxed);
+        if (since && now > since) {
+            leased += now - since;
+        }
+    }
+    int64_t elapsed = now - _initialized_usec;
+    if (elapsed > 0) {
+        stats.utilization = static_cast<double>(leased)
+                / (static_cast<double>(elapsed) * _size);
+        if (stats.utilization > 1) {
+            stats.utilization = 1;
+        }
+    }
+    return stats;
+}
+
+} // namespace SolarWindLisp
@@ -0,0 +1,92 @@
+/*
+ * file name:           src/pair.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 14:02:47 2026 CST
+ */
+
+#include <sstream>
+#include "pair.h"
+#include "utils.h"
+
+namespace SolarWindLisp
+{
+
+const PairPtr & Pair::nil()
+{
+    static const PairPtr the_nil(new Pair(MatterPtr(), MatterPtr()));
+    return the_nil;
+}
+
+Pair::~Pair()
+{
+    // release the rest of a long list iteratively, not recursively
+    MatterPtr next;
+    next.swap(_cdr);
+    while (next && next->is_pair() && next.unique()) {
+        MatterPtr rest;
+        rest.swap(static_cast<Pair *>(next.get())->_cdr);
+        next.swap(rest);
+    }
+}
+
+ssize_t Pair::length() const
+{
+    ssize_t n = 0;
+    const Pair * p = this;
+    while (!p->is_nil()) {
+        ++n;
+        if (!p->_cdr || !p->_cdr->is_pair()) {
+            return -1;
+        }
+        p = static_cast<const Pair *>(p->_cdr.get());
+    }
+    return n;
+}
+
+std::string Pair::debug_string(bool compact, int level,
+        const char * indent_seq) const
+{
+    std::string indent = compact ? "" : Utils::Misc::repeat(indent_seq, level);
+    std::string first_sep =
+            compact ? "" : (std::string("\n") + indent + indent_seq);
+    std::string sep =
+            compact ? "," : (std::string(",\n") + indent + indent_seq);
+
+    std::stringstream ss;
+    ss << indent << "Pair{";
+    if (is_nil()) {
+        ss << "nil}";
+        return ss.str();
+    }
+
+    ss << first_sep << "car:" << (compact ? "" : "\n")
+        << (_car ? _car->debug_string(compact, level + 2, indent_seq) : "NULL")
+        << sep << "cdr:" << (compact ? "" : "\n")
+        << (_cdr ? _cdr->debug_string(compact, level + 2, indent_seq) : "NULL")
+        << "}";
+    return ss.str();
+}
+
+std::string Pair::to_string() const
+{
+    std::stringstream ss;
+    ss << "(";
+    const Pair * p = this;
+    while (!p->is_nil()) {
+        if (p != this) {
+            ss << " ";
+        }
+        ss << (p->_car ? p->_car->to_string() : "NULL");
+        if (!p->_cdr || !p->_cdr->is_pair()) {
+            ss << " . " << (p->_cdr ? p->_cdr->to_string() : "NULL");
+            break;
+        }
+        p = static_cast<const Pair *>(p->_cdr.get());
+    }
+    ss << ")";
+    return ss.str();
+}
+
+} // namespace SolarWindLisp
@@ -0,0 +1,149 @@
+/*
+ * file name:           src/parallel_loader.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 00:21:07 2026 CST
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "parallel_loader.h"
+#include "parser.h"
+#include "symbol_table.h"
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+struct Batch
+{
+    size_t begin;
+    size_t end;
+    std::vector<MatterPtr> forms;
+    bool done;
+    bool ok;
+    size_t error_offset;
+    const char * error_message;
+};
+
+void parse_batch(const char * input, Batch &batch, SymbolTable * symbols)
+{
+    SimpleParser parser;
+    parser.set_symbol_table(symbols);
+    batch.ok = parser.feed(input + batch.begin, batch.end - batch.begin,
+            batch.forms) && parser.finish(batch.forms);
+    if (!batch.ok) {
+        batch.error_offset = batch.begin + parser.error_offset();
+        batch.error_message = parser.error_message();
+    }
+}
+
+} // anonymous namespace
+
+SymbolTable * ParallelLoader::default_symbol_table()
+{
+    return &SymbolTable::global();
+}
+
+ParallelLoader::ParallelLoader(size_t threads, SymbolTable * symbols) :
+        _threads(threads), _symbols(symbols), _batches(0), _error_offset(0),
+        _error_message(NULL)
+{
+    if (!_threads) {
+        _threads = std::thread::hardware_concurrency();
+        _threads = _threads ? _threads : 1;
+    }
+}
+
+bool ParallelLoader::load(const char * input, size_t length,
+        const form_handler &handler)
+{
+    _error_offset = 0;
+    _error_message = NULL;
+
+    size_t batch_size = length / (_threads * BATCHES_PER_THREAD);
+    batch_size = batch_size < MIN_BATCH_SIZE ? MIN_BATCH_SIZE : batch_size;
+    std::vector<size_t> starts;
+    ParserIF::split(input, length, batch_size, starts);
+
+    std::vector<Batch> batches(starts.size());
+    for (size_t i = 0; i < batches.size(); ++i) {
+        batches[i].begin = starts[i];
+        batches[i].end = i + 1 < starts.size() ? starts[i + 1] : length;
+        batches[i].done = false;
+        batches[i].ok = false;
+        batches[i].error_offset = 0;
+        batches[i].error_message = NULL;
+    }
+    _batches = batches.size();
+
+    // the workers take the batches in order, done ones are announced
+    std::atomic<size_t> next(0);
+    std::atomic<bool> stop(false);
+    std::mutex lock;
+    std::condition_variable announce;
+    auto work = [&]() {
+        size_t i;
+        while (!stop && (i = next++) < batches.size()) {
+            parse_batch(input, batches[i], _symbols);
+            std::lock_guard<std::mutex> guard(lock);
+            batches[i].done = true;
+            announce.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    size_t n_workers = _threads < batches.size() ? _threads : batches.size();
+    for (size_t i = 0; n_workers > 1 && i < n_workers; ++i) {
+        workers.push_back(std::thread(work));
+    }
+
+    bool ok = true;
+    for (size_t i = 0; ok && i < batches.size(); ++i) {
+        Batch &batch = batches[i];
+        if (workers.empty()) {
+            parse_batch(input, batch, _symbols);
+        }
+        else {
+            std::unique_lock<std::mutex> guard(lock);
+            while (!batch.done) {
+                announce.wait(guard);
+            }
+        }
+
+        // the forms before a parse error are handled, like in the REPL
+        for (size_t k = 0; ok && k < batch.forms.size(); ++k) {
+            ok = handler(batch.forms[k]);
+        }
+        batch.forms.clear();
+
+        if (ok && !batch.ok) {
+            _error_offset = batch.error_offset;
+            _error_message = batch.error_message;
+            ok = false;
+        }
+    }
+
+    stop = true;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    return ok;
+}
+
+bool ParallelLoader::load(const char * input, size_t length,
+        std::vector<MatterPtr> &forms)
+{
+    return load(input, length, [&forms](const MatterPtr &form) {
+        forms.push_back(form);
+        return true;
+    });
+}
+
+} // namespace SolarWindLisp
@@ -0,0 +1,115 @@
+/*
+ * file name:           src/parse_cache.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 06:41:15 2026 CST
+ */
+
+#include <string.h>
+#include "parse_cache.h"
+#include "script_cache.h"
+
+namespace SolarWindLisp
+{
+
+ParseCache::ParseCache(size_t capacity, size_t max_input) :
+        _capacity(capacity), _max_input(max_input), _bytes(0), _hits(0),
+        _misses(0), _evictions(0)
+{
+}
+
+bool ParseCache::find(const char * str, size_t len, MatterPtr &forms)
+{
+    if (!accepts(len)) {
+        return false;
+    }
+
+    std::unordered_map<uint64_t, entry_list::iterator>::iterator found =
+            _index.find(ScriptCache::content_hash(str, len));
+    if (found == _index.end()) {
+        ++_misses;
+        return false;
+    }
+
+    entry_list::iterator entry = found->second;
+    if (entry->input.size() != len
+            || memcmp(entry->input.data(), str, len) != 0) {
+        ++_misses;
+        return false;
+    }
+
+    _entries.splice(_entries.begin(), _entries, entry);
+    forms = entry->forms;
+    ++_hits;
+    return true;
+}
+
+void ParseCache::insert(const char * str, size_t len, const MatterPtr &forms)
+{
+    if (!accepts(len) || !forms) {
+        return;
+    }
+
+    uint64_t hash = ScriptCache::content_hash(str, len);
+    std::unordered_map<uint64_t, entry_list::iterator>::iterator found =
+            _index.find(hash);
+    if (found != _index.end()) {
+        // the same input, or another one with its hash
+        entry_list::iterator entry = found->second;
+        _bytes -= entry->input.size();
+        entry->input.assign(str, len);
+        entry->forms = forms;
+        _bytes += len;
+        _entries.splice(_entries.begin(), _entries, entry);
+        return;
+    }
+
+    while (_entries.size() >= _capacity) {
+        _evict();
+    }
+    Entry entry;
+    entry.hash = hash;
+    entry.input.assign(str, len);
+    entry.forms = forms;
+    _entries.push_front(entry);
+    _index[hash] = _entries.begin();
+    _bytes += len;
+}
+
+void ParseCache::set_capacity(size_t capacity)
+{
+    _capacity = capacity;
+    while (_entries.size() > _capacity) {
+        _evict();
+    }
+}
+
+void ParseCache::clear()
+{
+    _entries.clear();
+    _index.clear();
+    _bytes = 0;
+}
+
+ParseCache::Stats ParseCache::stats() const
+{
+    Stats stats;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    stats.evictions = _evictions;
+    stats.entries = _entries.size();
+    stats.bytes = _bytes;
+    return stats;
+}
+
+void ParseCache::_evict()
+{
+    const Entry &last = _entries.back();
+    _index.erase(last.hash);
+    _bytes -= last.input.size();
+    _entries.pop_back();
+    ++_evictions;
+}
+
+} // namespace SolarWindLisp
@@ -6,7 +6,10 @@
  * date created:        Sat Nov 22 01:49:21 2014 CST
  */
 
+#include <ctype.h>
+#include <string.h>
 #include "parser.h"
+#include "structural_index.h"
 
 namespace SolarWindLisp
 {
@@ -24,137 +27,530 @@ const char ParserIF::C_DQ;
 const char ParserIF::C_LP;
 const char ParserIF::C_RP;
 
-bool ParserIF::tokenize(lexical_tokens * p_result, const char * input,
-        ssize_t input_length)
+namespace
 {
-    p_result->clear();
 
-    std::string current;
+/*
+ * Return value:
+ *   true if there are only spaces before `idx' on its line, `blank' tells
+ *   if it is so at the start of `input'.
+ */
+bool at_line_start(const char * input, ssize_t idx, bool blank)
+{
+    while (--idx >= 0 && input[idx] != '\n') {
+        if (!isspace(input[idx])) {
+            return false;
+        }
+    }
+    return idx >= 0 || blank;
+}
 
-    char quote_char = C_TERM;
-    bool escape_mode = false;
+} // anonymous namespace
 
-    for (ssize_t idx = 0;
-            (input_length >= 0 && idx < input_length)
-                    || (input_length < 0 && input[idx] != '\0'); ++idx) {
-        char c = input[idx];
-        if (escape_mode) {
-            current += c;
+template<typename Sink>
+bool ParserIF::_scan(ScanState &st, const char * input, ssize_t input_length,
+        Sink &sink, bool last)
+{
+    // the token being scanned, if `start' >= 0, with its bytes of the
+    // earlier chunks in `st.carried' if `carried'
+    ssize_t start = st.carrying ? 0 : -1;
+    bool carried = st.carrying;
+    char start_quote = st.start_quote;
+    bool escaped = st.escaped;
+
+    char quote_char = st.quote_char;
+    bool escape_mode = st.escape_mode;
+
+    if (input_length < 0) {
+        input_length = strlen(input);
+    }
+
+    // runs of ordinary chars and of spaces are skipped with the index
+    StructuralIndex index(input, input_length);
+
+    ssize_t idx = 0;
+    if (st.in_comment) {
+        idx = index.find(0, StructuralIndex::NEWLINE);
+        st.in_comment = idx >= input_length;
+    }
+
+    for (;; ++idx) {
+        bool more = idx < input_length;
+        if (!more && !last) {
+            break;
+        }
+
+        char c = more ? input[idx] : C_TERM;
+        if (more && escape_mode) {
             escape_mode = false;
+            continue;
         }
-        else if (c == C_BS) {
+
+        if (more && c == ';' && st.comments && start < 0 && !quote_char
+                && at_line_start(input, idx, st.line_blank)) {
+            // the rest of the line, the newline is a space
+            idx = index.find(idx, StructuralIndex::NEWLINE);
+            st.in_comment = idx >= input_length;
+            --idx;
+            continue;
+        }
+
+        if (more && c == C_BS) {
+            if (start < 0) {
+                start = idx;
+                start_quote = quote_char;
+            }
             if (quote_char) {
                 escape_mode = true;
+                escaped = true;
             }
-            else {
-                current += c;
-            }
+            continue;
         }
-        else if (c == C_SQ || c == C_DQ) {
+
+        if (more && (c == C_SQ || c == C_DQ)) {
             if (!quote_char) {
+                // the text before the opening quote is dropped
                 quote_char = c;
-                current = quote_char;
-            }
-            else if (quote_char == c) {
-                current += c;
-                quote_char = C_TERM;
+                start = idx;
+                start_quote = C_TERM;
+                escaped = false;
+                carried = false;
             }
             else {
-                current += c;
+                if (start < 0) {
+                    start = idx;
+                    start_quote = quote_char;
+                }
+                if (quote_char == c) {
+                    quote_char = C_TERM;
+                }
             }
+            continue;
         }
-        else if (isspace(c)) {
-            if (quote_char) {
-                current += c;
+
+        bool is_paren = c == C_LP || c == C_RP;
+        if (more && !is_paren && (quote_char || !isspace(c))) {
+            if (start < 0) {
+                start = idx;
+                start_quote = quote_char;
+            }
+            idx = index.find(idx + 1, quote_char
+                    ? StructuralIndex::PAREN | StructuralIndex::QUOTE
+                    : StructuralIndex::PAREN | StructuralIndex::QUOTE
+                            | StructuralIndex::SPACE) - 1;
+            continue;
+        }
+
+        // end of the current token
+        if (start >= 0) {
+            Token t;
+            const char * raw = input + start;
+            uint64_t length = idx - start;
+            t.offset = st.offset + start;
+            if (carried) {
+                st.carried.append(input, idx);
+                raw = st.carried.data();
+                length = st.carried.size();
+                t.offset = st.carried_offset;
             }
-            else if (current.length() > 0) {
-                p_result->push_back(current);
-                current = "";
+
+            if (length > UINT32_MAX) {
+                sink.error(t.offset, "token too long");
+                return false;
             }
+
+            t.length = static_cast<uint32_t>(length);
+            t.kind = escaped ? token_escaped_atom : token_atom;
+            t.quote = start_quote;
+            if (!sink.token(t, raw)) {
+                return false;
+            }
+            start = -1;
+            escaped = false;
+            carried = false;
+            st.carried.clear();
+        }
+
+        if (!more) {
+            break;
         }
-        else if (c == C_LP || c == C_RP) {
-            if (current.length() > 0) {
-                p_result->push_back(current);
-                current = "";
+
+        if (is_paren) {
+            Token t;
+            t.offset = st.offset + idx;
+            t.length = 1;
+            t.kind = c == C_LP ? token_lparen : token_rparen;
+            t.quote = C_TERM;
+            if (!sink.token(t, input + idx)) {
+                return false;
             }
-            p_result->push_back(c == C_LP ? S_LP : S_RP);
         }
         else {
-            current += c;
+            idx = index.find_not(idx + 1, StructuralIndex::SPACE) - 1;
         }
     }
 
-    if (current.length() > 0) {
-        p_result->push_back(current);
+    // the state for the next chunk
+    if (start >= 0) {
+        if (!carried) {
+            st.carried.assign(input + start, input_length - start);
+            st.carried_offset = st.offset + start;
+        }
+        else {
+            st.carried.append(input, input_length);
+        }
     }
+    st.carrying = start >= 0;
+    st.start_quote = start_quote;
+    st.escaped = escaped;
+    st.quote_char = quote_char;
+    st.escape_mode = escape_mode;
+    if (st.comments) {
+        ssize_t i = input_length;
+        while (--i >= 0 && input[i] != '\n' && isspace(input[i])) {
+        }
+        st.line_blank = i < 0 ? st.line_blank : input[i] == '\n';
+    }
+    st.offset += input_length;
 
-    return p_result->size() != 0;
+    return true;
 }
 
-MatterPtr ParserIF::parse(const char * input, ssize_t input_length)
+namespace
+{
+
+struct TokenCollector
 {
-    // setup
-    _form_str = input;
-    _form_len = input_length;
+    ParserIF::token_views * tokens;
 
-    if (!ParserIF::tokenize(&_tokens, _form_str, _form_len)) {
-        return NULL;
+    bool token(const ParserIF::Token &t, const char * raw)
+    {
+        tokens->push_back(t);
+        return true;
     }
 
-    MatterPtr result = _parse_tokens(false);
+    void error(size_t offset, const char * message)
+    {
+    }
+};
 
-    // tear down
-    _form_str = NULL;
-    _form_len = 0;
+} // anonymous namespace
 
-    return result;
+bool ParserIF::tokenize(token_views * p_result, const char * input,
+        ssize_t input_length)
+{
+    p_result->clear();
+
+    TokenCollector collector = { p_result };
+    ScanState st;
+    if (!_scan(st, input, input_length, collector, true)) {
+        p_result->clear();
+        return false;
+    }
+
+    return p_result->size() != 0;
 }
 
-MatterPtr ParserIF::_parse_tokens(bool inner)
+void ParserIF::split(const char * input, size_t length, size_t piece_size,
+        std::vector<size_t> &starts)
 {
-    std::string current;
-
-    CompositeExprPtr result = CompositeExpr::create();
-    while (_tokens.size() > 0) {
-        current = _tokens.front();
-        _tokens.pop_front();
+    starts.push_back(0);
 
-        if (current == S_LP) {
-            MatterPtr expr = _parse_tokens(true);
-            if (!expr.get()) {
-                return MatterPtr(NULL);
+    const unsigned interesting = StructuralIndex::PAREN
+            | StructuralIndex::QUOTE | StructuralIndex::NEWLINE
+            | StructuralIndex::COMMENT;
+    StructuralIndex index(input, length);
+    size_t depth = 0;
+    char quote_char = C_TERM;
+    size_t last = 0;
+    // the index after the last paren in quotes
+    size_t after_paren = 0;
+    for (size_t idx = index.find(0, interesting); idx < length;
+            idx = index.find(idx + 1, interesting)) {
+        char c = input[idx];
+        if (quote_char) {
+            if (c == C_BS) {
+                // the escaped char is skipped, but a paren alone, between
+                // two others, or at the end, see token()
+                bool alone = idx == after_paren && idx + 1 < length
+                        && (input[idx + 1] == C_LP || input[idx + 1] == C_RP)
+                        && (idx + 2 == length || input[idx + 2] == C_LP
+                                || input[idx + 2] == C_RP);
+                if (!alone) {
+                    ++idx;
+                    continue;
+                }
+                c = input[++idx];
             }
-            else {
-                result->append_expr(expr);
+
+            if (c == quote_char) {
+                quote_char = C_TERM;
             }
-        }
-        else if (current == S_RP) {
-            if (inner) {
-                return result;
+            else if (c == C_LP) {
+                // still a token inside quotes
+                ++depth;
+                after_paren = idx + 1;
             }
-            else {
-                // unmatched close parenthesis in input
-                return MatterPtr(NULL);
+            else if (c == C_RP) {
+                if (!depth) {
+                    return;
+                }
+                --depth;
+                after_paren = idx + 1;
             }
+            continue;
+        }
+
+        switch (c) {
+            case C_LP:
+                ++depth;
+                break;
+            case C_RP:
+                if (!depth) {
+                    return;
+                }
+                --depth;
+                break;
+            case C_SQ:
+            case C_DQ:
+                quote_char = c;
+                break;
+            case ';':
+                if (at_line_start(input, idx, true)) {
+                    idx = index.find(idx, StructuralIndex::NEWLINE) - 1;
+                }
+                break;
+            case '\n':
+                if (!depth && idx + 1 - last >= piece_size
+                        && idx + 1 < length) {
+                    last = idx + 1;
+                    starts.push_back(last);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void ParserIF::token_text(const char * input, const Token &token,
+        std::string &result)
+{
+    _token_text(input + token.offset, token, result);
+}
+
+void ParserIF::_token_text(const char * p, const Token &token,
+        std::string &result)
+{
+    if (token.kind != token_escaped_atom) {
+        result.assign(p, token.length);
+        return;
+    }
+
+    // replay the quoting of the tokenizer
+    result.clear();
+    char quote_char = token.quote;
+    bool escape_mode = false;
+    for (uint32_t i = 0; i < token.length; ++i) {
+        char c = p[i];
+        if (escape_mode) {
+            result += c;
+            escape_mode = false;
+        }
+        else if (c == C_BS && quote_char) {
+            escape_mode = true;
+        }
+        else if ((c == C_SQ || c == C_DQ) && !quote_char) {
+            quote_char = c;
+            result = quote_char;
         }
         else {
-            AtomPtr expr = Atom::create(current.c_str(), current.length());
-            if (!expr.get()) {
-                return MatterPtr(NULL);
-            }
-            else {
-                result->append_expr(expr);
+            if (c == quote_char) {
+                quote_char = C_TERM;
             }
+            result += c;
         }
-    } // end while
+    }
+}
 
-    if (inner) {
-        // parser is in an inner context when the input is finished.
-        return MatterPtr(NULL);
+bool ParserIF::tokenize(lexical_tokens * p_result, const char * input,
+        ssize_t input_length)
+{
+    p_result->clear();
+
+    token_views views;
+    if (!tokenize(&views, input, input_length)) {
+        return false;
+    }
+
+    std::string text;
+    for (size_t i = 0; i < views.size(); ++i) {
+        token_text(input, views[i], text);
+        if (text.length() > 0) {
+            p_result->push_back(text);
+        }
+    }
+
+    return p_result->size() != 0;
+}
+
+MatterPtr ParserIF::parse(const char * input, ssize_t input_length)
+{
+    // setup, a stream being fed is abandoned
+    reset_stream();
+    if (input_length < 0) {
+        input_length = strlen(input);
+    }
+
+    MatterPtr result = NULL;
+    ScanState st;
+    bool ok = _scan(st, input, input_length, *this, true);
+    if (ok && !_open.empty()) {
+        // report the inner most one
+        error(_open.back().offset, "unclosed parenthesis");
+    }
+    else if (ok && !_scratch.empty()) {
+        result = _collect_children(0);
+        if (!result) {
+            error(input_length, "out of memory");
+        }
+    }
+
+    // tear down, the capacity of the buffers is kept for the next input
+    _open.clear();
+    _scratch.clear();
+
+    return result;
+}
+
+bool ParserIF::feed(const char * input, size_t length,
+        std::vector<MatterPtr> &forms)
+{
+    _error_offset = 0;
+    _error_message = NULL;
+
+    bool ok = _scan(_stream, input, length, *this, false);
+    _take_forms(forms);
+    if (!ok) {
+        _reset_stream_state();
+    }
+    return ok;
+}
+
+bool ParserIF::finish(std::vector<MatterPtr> &forms)
+{
+    bool ok = _scan(_stream, "", 0, *this, true);
+    if (ok && !_open.empty()) {
+        error(_open.back().offset, "unclosed parenthesis");
+        ok = false;
+    }
+
+    _take_forms(forms);
+    _reset_stream_state();
+    return ok;
+}
+
+void ParserIF::reset_stream()
+{
+    _reset_stream_state();
+    _error_offset = 0;
+    _error_message = NULL;
+}
+
+void ParserIF::_reset_stream_state()
+{
+    _stream = ScanState();
+    _stream.comments = true;
+    _open.clear();
+    _scratch.clear();
+}
+
+void ParserIF::_take_forms(std::vector<MatterPtr> &forms)
+{
+    // the top level forms before the first open list are complete
+    size_t n = _open.empty() ? _scratch.size() : _open.front().base;
+    if (!n) {
+        return;
+    }
+
+    forms.insert(forms.end(), _scratch.begin(), _scratch.begin() + n);
+    _scratch.erase(_scratch.begin(), _scratch.begin() + n);
+    for (size_t i = 0; i < _open.size(); ++i) {
+        _open[i].base -= n;
+    }
+}
+
+bool ParserIF::token(const Token &t, const char * raw)
+{
+    uint8_t kind = t.kind;
+    if (kind == token_escaped_atom) {
+        _token_text(raw, t, _text);
+        if (!_text.length()) {
+            // a dangling escape char
+            return true;
+        }
+        if (_text.length() == 1 && (_text[0] == C_LP || _text[0] == C_RP)) {
+            // an escaped paren alone
+            kind = _text[0] == C_LP ? token_lparen : token_rparen;
+        }
+    }
+
+    if (kind == token_lparen) {
+        OpenList open = { _scratch.size(), t.offset };
+        _open.push_back(open);
+        return true;
+    }
+
+    MatterPtr expr = NULL;
+    if (kind == token_rparen) {
+        if (_open.empty()) {
+            error(t.offset, "unmatched close parenthesis");
+            return false;
+        }
+
+        expr = _collect_children(_open.back().base);
+        _open.pop_back();
+        if (!expr) {
+            error(t.offset, "out of memory");
+            return false;
+        }
+    }
+    else if (kind == token_atom) {
+        // straight from the input, Atom::parse() copies what it keeps
+        if (!(expr = Atom::create(raw, t.length, _symbols))) {
+            error(t.offset, "invalid atom");
+            return false;
+        }
     }
     else {
-        return result;
+        expr = Atom::create(_text.c_str(), _text.length(), _symbols);
+        if (!expr) {
+            error(t.offset, "invalid atom");
+            return false;
+        }
+    }
+
+    _scratch.push_back(expr);
+    return true;
+}
+
+void ParserIF::error(size_t offset, const char * message)
+{
+    _error_offset = offset;
+    _error_message = message;
+}
+
+CompositeExprPtr ParserIF::_collect_children(size_t base)
+{
+    CompositeExprPtr result = CompositeExpr::create(_scratch.size() - base);
+    if (result) {
+        for (size_t i = base; i < _scratch.size(); ++i) {
+            result->append_expr(_scratch[i]);
+        }
     }
+
+    _scratch.resize(base);
+    return result;
 }
 
 } // namespace SolarWindLisp
@@ -0,0 +1,519 @@
+/*
+ * file name:           src/persistent_map.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 20:05:33 2026 CST
+ */
+
+#include <new>
+#include <atomic>
+#include <sstream>
+#include "persistent_map.h"
+#include "utils.h"
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+typedef PersistentMap::Node Node;
+typedef PersistentMap::NodePtr NodePtr;
+typedef PersistentMap::Slot Slot;
+
+const unsigned BITS_PER_LEVEL = 5;
+const unsigned HASH_BITS = 64;
+
+inline uint32_t bit_of(uint64_t hash, unsigned shift)
+{
+    return 1U << ((hash >> shift) & ((1U << BITS_PER_LEVEL) - 1));
+}
+
+inline size_t index_of(uint32_t bitmap, uint32_t bit)
+{
+    return static_cast<size_t>(__builtin_popcount(bitmap & (bit - 1)));
+}
+
+inline bool slot_matches(const Slot &s, uint64_t hash, const MatterPtr &key)
+{
+    return !s.child && s.hash == hash && AtomKey::equal(s.key, key);
+}
+
+/*
+ * Return value:
+ *   `node' itself if it is owned by the transient `edit', a copy owned by
+ *   `edit' otherwise, or NULL if out of memory.
+ */
+NodePtr editable(const NodePtr &node, uint64_t edit)
+{
+    if (edit && node->edit == edit) {
+        return node;
+    }
+
+    NodePtr n(new (std::nothrow) Node(edit));
+    if (n) {
+        n->bitmap = node->bitmap;
+        n->collision = node->collision;
+        n->slots = node->slots;
+    }
+    return n;
+}
+
+/*
+ * Description:
+ *   Create the subtree holding two entries of different keys, at `shift'.
+ */
+NodePtr merge(const Slot &a, const Slot &b, unsigned shift, uint64_t edit)
+{
+    NodePtr n(new (std::nothrow) Node(edit));
+    if (!n) {
+        return NULL;
+    }
+
+    if (shift >= HASH_BITS) {
+        n->collision = true;
+        n->slots.push_back(a);
+        n->slots.push_back(b);
+        return n;
+    }
+
+    uint32_t bit_a = bit_of(a.hash, shift);
+    uint32_t bit_b = bit_of(b.hash, shift);
+    if (bit_a == bit_b) {
+        Slot s;
+        s.hash = 0;
+        if (!(s.child = merge(a, b, shift + BITS_PER_LEVEL, edit))) {
+            return NULL;
+        }
+        n->bitmap = bit_a;
+        n->slots.push_back(s);
+    }
+    else {
+        n->bitmap = bit_a | bit_b;
+        n->slots.push_back(bit_a < bit_b ? a : b);
+        n->slots.push_back(bit_a < bit_b ? b : a);
+    }
+    return n;
+}
+
+bool node_assoc(const NodePtr &node, unsigned shift, uint64_t hash,
+        const MatterPtr &key, const MatterPtr &value, uint64_t edit,
+        bool &added, NodePtr &result)
+{
+    Slot entry;
+    entry.hash = hash;
+    entry.key = key;
+    entry.value = value;
+
+    if (!node) {
+        NodePtr n(new (std::nothrow) Node(edit));
+        if (!n) {
+            return false;
+        }
+        n->bitmap = bit_of(hash, shift);
+        n->slots.push_back(entry);
+        added = true;
+        result = n;
+        return true;
+    }
+
+    if (node->collision) {
+        size_t idx = 0;
+        while (idx < node->slots.size()
+                && !slot_matches(node->slots[idx], hash, key)) {
+            ++idx;
+        }
+
+        NodePtr n = editable(node, edit);
+        if (!n) {
+            return false;
+        }
+        if (idx < n->slots.size()) {
+            n->slots[idx].value = value;
+        }
+        else {
+            n->slots.push_back(entry);
+            added = true;
+        }
+        result = n;
+        return true;
+    }
+
+    uint32_t bit = bit_of(hash, shift);
+    size_t idx = index_of(node->bitmap, bit);
+    if (!(node->bitmap & bit)) {
+        NodePtr n = editable(node, edit);
+        if (!n) {
+            return false;
+        }
+        n->slots.insert(n->slots.begin() + idx, entry);
+        n->bitmap |= bit;
+        added = true;
+        result = n;
+        return true;
+    }
+
+    const Slot &s = node->slots[idx];
+    if (s.child) {
+        NodePtr child;
+        if (!node_assoc(s.child, shift + BITS_PER_LEVEL, hash, key, value,
+                edit, added, child)) {
+            return false;
+        }
+        if (child == s.child) {
+            result = node;
+            return true;
+        }
+
+        NodePtr n = editable(node, edit);
+        if (!n) {
+            return false;
+        }
+        n->slots[idx].child = child;
+        result = n;
+        return true;
+    }
+
+    if (slot_matches(s, hash, key)) {
+        if (s.value == value) {
+            result = node;
+            return true;
+        }
+
+        NodePtr n = editable(node, edit);
+        if (!n) {
+            return false;
+        }
+        n->slots[idx].value = value;
+        result = n;
+        return true;
+    }
+
+    // a different key at the same position, push both of them down
+    Slot sub;
+    sub.hash = 0;
+    if (!(sub.child = merge(s, entry, shift + BITS_PER_LEVEL, edit))) {
+        return false;
+    }
+
+    NodePtr n = editable(node, edit);
+    if (!n) {
+        return false;
+    }
+    n->slots[idx] = sub;
+    added = true;
+    result = n;
+    return true;
+}
+
+/*
+ * Description:
+ *   `result' is NULL if the last entry of `node' was removed, which happens
+ *   to the root only, since every subtree holds at least two entries.
+ */
+bool node_dissoc(const NodePtr &node, unsigned shift, uint64_t hash,
+        const MatterPtr &key, uint64_t edit, bool &removed, NodePtr &result)
+{
+    result = node;
+    if (!node) {
+        return true;
+    }
+
+    size_t idx = 0;
+    uint32_t bit = 0;
+    if (node->collision) {
+        while (idx < node->slots.size()
+                && !slot_matches(node->slots[idx], hash, key)) {
+            ++idx;
+        }
+        if (idx == node->slots.size()) {
+            return true;
+        }
+    }
+    else {
+        bit = bit_of(hash, shift);
+        if (!(node->bitmap & bit)) {
+            return true;
+        }
+
+        idx = index_of(node->bitmap, bit);
+        const Slot &s = node->slots[idx];
+        if (s.child) {
+            bool gone = false;
+            NodePtr child;
+            if (!node_dissoc(s.child, shift + BITS_PER_LEVEL, hash, key, edit,
+                    gone, child)) {
+                return false;
+            }
+            if (!gone) {
+                return true;
+            }
+
+            // the child may have been edited in place by the transient, so
+            // it is `s.child' still, but the subtree has changed anyway
+            removed = true;
+            if (!child || child->slots.empty()) {
+                if (node->slots.size() == 1) {
+                    result = NULL;
+                    return true;
+                }
+
+                NodePtr n = editable(node, edit);
+                if (!n) {
+                    return false;
+                }
+                n->slots.erase(n->slots.begin() + idx);
+                n->bitmap &= ~bit;
+                result = n;
+                return true;
+            }
+
+            NodePtr n = editable(node, edit);
+            if (!n) {
+                return false;
+            }
+            if (child->slots.size() == 1 && !child->slots[0].child) {
+                // only one entry left in the subtree, pull it up
+                n->slots[idx] = child->slots[0];
+            }
+            else {
+                n->slots[idx].child = child;
+            }
+            result = n;
+            return true;
+        }
+        else if (!slot_matches(s, hash, key)) {
+            return true;
+        }
+    }
+
+    removed = true;
+    if (node->slots.size() == 1) {
+        result = NULL;
+        return true;
+    }
+
+    NodePtr n = editable(node, edit);
+    if (!n) {
+        return false;
+    }
+    n->slots.erase(n->slots.begin() + idx);
+    n->bitmap &= ~bit;
+    result = n;
+    return true;
+}
+
+bool node_for_each(const Node * node, bool (*func)(const MatterPtr &key,
+        const MatterPtr &value, void * arg), void * arg)
+{
+    for (size_t i = 0; i < node->slots.size(); ++i) {
+        const Slot &s = node->slots[i];
+        if (s.child) {
+            if (!node_for_each(s.child.get(), func, arg)) {
+                return false;
+            }
+        }
+        else if (!func(s.key, s.value, arg)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void node_stats(const Node * node, size_t level, size_t &count, size_t &depth)
+{
+    ++count;
+    if (level > depth) {
+        depth = level;
+    }
+    for (size_t i = 0; i < node->slots.size(); ++i) {
+        if (node->slots[i].child) {
+            node_stats(node->slots[i].child.get(), level + 1, count, depth);
+        }
+    }
+}
+
+bool append_entry(const MatterPtr &key, const MatterPtr &value, void * arg)
+{
+    std::stringstream &ss = *static_cast<std::stringstream *>(arg);
+    if (ss.tellp() > 1) {
+        ss << ", ";
+    }
+    ss << key->to_string() << " " << (value ? value->to_string() : "NULL");
+    return true;
+}
+
+// ids of transients, never reused
+std::atomic<uint64_t> g_last_edit(0);
+
+} // anonymous namespace
+
+PersistentMapPtr PersistentMap::create()
+{
+    return PersistentMapPtr(new (std::nothrow) PersistentMap(NULL, 0));
+}
+
+const MatterPtr * PersistentMap::find(const MatterPtr &key) const
+{
+    if (!_root || !AtomKey::is_valid(key)) {
+        return NULL;
+    }
+
+    uint64_t hash = AtomKey::hash(key);
+    const Node * node = _root.get();
+    for (unsigned shift = 0; node; shift += BITS_PER_LEVEL) {
+        if (node->collision) {
+            for (size_t i = 0; i < node->slots.size(); ++i) {
+                if (slot_matches(node->slots[i], hash, key)) {
+                    return &node->slots[i].value;
+                }
+            }
+            return NULL;
+        }
+
+        uint32_t bit = bit_of(hash, shift);
+        if (!(node->bitmap & bit)) {
+            return NULL;
+        }
+
+        const Slot &s = node->slots[index_of(node->bitmap, bit)];
+        if (!s.child) {
+            return slot_matches(s, hash, key) ? &s.value : NULL;
+        }
+        node = s.child.get();
+    }
+
+    return NULL;
+}
+
+PersistentMapPtr PersistentMap::assoc(const MatterPtr &key,
+        const MatterPtr &value) const
+{
+    bool added = false;
+    NodePtr root;
+    if (!node_assoc(_root, 0, AtomKey::hash(key), key, value, 0, added,
+            root)) {
+        return NULL;
+    }
+
+    return PersistentMapPtr(
+            new (std::nothrow) PersistentMap(root, _size + (added ? 1 : 0)));
+}
+
+PersistentMapPtr PersistentMap::dissoc(const MatterPtr &key) const
+{
+    bool removed = false;
+    NodePtr root;
+    if (!AtomKey::is_valid(key)) {
+        root = _root;
+    }
+    else if (!node_dissoc(_root, 0, AtomKey::hash(key), key, 0, removed,
+            root)) {
+        return NULL;
+    }
+
+    return PersistentMapPtr(
+            new (std::nothrow) PersistentMap(root, _size - (removed ? 1 : 0)));
+}
+
+void PersistentMap::for_each(bool (*func)(const MatterPtr &key,
+        const MatterPtr &value, void * arg), void * arg) const
+{
+    if (_root) {
+        node_for_each(_root.get(), func, arg);
+    }
+}
+
+size_t PersistentMap::node_count() const
+{
+    size_t count = 0;
+    size_t depth = 0;
+    if (_root) {
+        node_stats(_root.get(), 1, count, depth);
+    }
+    return count;
+}
+
+size_t PersistentMap::depth() const
+{
+    size_t count = 0;
+    size_t depth = 0;
+    if (_root) {
+        node_stats(_root.get(), 1, count, depth);
+    }
+    return depth;
+}
+
+std::string PersistentMap::debug_string(bool compact, int level,
+        const char * indent_seq) const
+{
+    std::string indent = compact ? "" : Utils::Misc::repeat(indent_seq, level);
+
+    std::stringstream ss;
+    ss << indent << "PersistentMap{" << _size << "," << to_string() << "}";
+    return ss.str();
+}
+
+std::string PersistentMap::to_string() const
+{
+    std::stringstream ss;
+    ss << "{";
+    for_each(append_entry, &ss);
+    ss << "}";
+    return ss.str();
+}
+
+PersistentMap::Transient::Transient(const PersistentMapPtr &from) :
+        _root(from->_root), _size(from->_size), _edit(++g_last_edit)
+{
+}
+
+bool PersistentMap::Transient::assoc(const MatterPtr &key,
+        const MatterPtr &value)
+{
+    bool added = false;
+    NodePtr root;
+    if (!_edit || !node_assoc(_root, 0, AtomKey::hash(key), key, value, _edit,
+            added, root)) {
+        return false;
+    }
+
+    _root = root;
+    _size += added ? 1 : 0;
+    return true;
+}
+
+bool PersistentMap::Transient::dissoc(const MatterPtr &key)
+{
+    bool removed = false;
+    if (!_edit) {
+        return false;
+    }
+
+    NodePtr root = _root;
+    if (AtomKey::is_valid(key) && !node_dissoc(_root, 0, AtomKey::hash(key),
+            key, _edit, removed, root)) {
+        return false;
+    }
+
+    _root = root;
+    _size -= removed ? 1 : 0;
+    return true;
+}
+
+PersistentMapPtr PersistentMap::Transient::persistent()
+{
+    if (!_edit) {
+        return NULL;
+    }
+
+    // nodes owned by this transient are frozen from now on
+    _edit = 0;
+    PersistentMapPtr result(new (std::nothrow) PersistentMap(_root, _size));
+    _root = NULL;
+    _size = 0;
+    return result;
+}
+
+} // namespace SolarWindLisp
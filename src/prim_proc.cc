@@ -8,6 +8,11 @@
 
 #include "expr.h"
 #include "prim_proc.h"
+#include "pair.h"
+#include "vector.h"
+#include "vector_kernels.h"
+#include "hash_map.h"
+#include "persistent_map.h"
 #include "matter_factory.h"
 
 namespace SolarWindLisp
@@ -17,9 +22,6 @@ bool PrimProcAdd::run(const MatterPtr &ops, MatterPtr &result,
         MatterFactoryIF * factory)
 {
     const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
-    if (!ce->rewind()) {
-        return false;
-    }
 
     AtomPtr res = factory->create_atom();
     if (!res.get()) {
@@ -31,8 +33,9 @@ bool PrimProcAdd::run(const MatterPtr &ops, MatterPtr &result,
     int64_t temp_i64 = 0;
     long double temp_ld = 0;
     bool integer = true;
-    while (ce->has_next()) {
-        const Atom * e = static_cast<const Atom *>(ce->get_next().get());
+    for (CompositeExpr::const_iterator it = ce->begin(); it != ce->end();
+            ++it) {
+        const Atom * e = static_cast<const Atom *>(it->get());
         if (e->is_integer()) {
             e->to_i64(temp_i64);
             if (integer) {
@@ -72,9 +75,6 @@ bool PrimProcSub::run(const MatterPtr &ops, MatterPtr &result,
         MatterFactoryIF * factory)
 {
     const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
-    if (!ce->rewind()) {
-        return false;
-    }
 
     AtomPtr res = factory->create_atom();
     if (!res.get()) {
@@ -86,7 +86,8 @@ bool PrimProcSub::run(const MatterPtr &ops, MatterPtr &result,
     int64_t temp_i64 = 0;
     long double temp_ld = 0;
     bool integer = true;
-    const Atom * first = static_cast<const Atom *>(ce->get_next().get());
+    CompositeExpr::const_iterator it = ce->begin();
+    const Atom * first = static_cast<const Atom *>((it++)->get());
     if (first->is_integer()) {
         first->to_i64(result_i64);
     }
@@ -107,8 +108,8 @@ bool PrimProcSub::run(const MatterPtr &ops, MatterPtr &result,
         }
     }
     else {
-        while (ce->has_next()) {
-            const Atom * e = static_cast<const Atom *>(ce->get_next().get());
+        for (; it != ce->end(); ++it) {
+            const Atom * e = static_cast<const Atom *>(it->get());
             if (e->is_integer()) {
                 e->to_i64(temp_i64);
                 if (integer) {
@@ -147,9 +148,6 @@ bool PrimProcMul::run(const MatterPtr &ops, MatterPtr &result,
         MatterFactoryIF * factory)
 {
     const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
-    if (!ce->rewind()) {
-        return false;
-    }
 
     AtomPtr res = factory->create_atom();
     if (!res.get()) {
@@ -161,8 +159,9 @@ bool PrimProcMul::run(const MatterPtr &ops, MatterPtr &result,
     int64_t temp_i64 = 0;
     long double temp_ld = 0;
     bool integer = true;
-    while (ce->has_next()) {
-        const Atom * e = static_cast<const Atom *>(ce->get_next().get());
+    for (CompositeExpr::const_iterator it = ce->begin(); it != ce->end();
+            ++it) {
+        const Atom * e = static_cast<const Atom *>(it->get());
         if (e->is_integer()) {
             e->to_i64(temp_i64);
             if (integer) {
@@ -202,9 +201,6 @@ bool PrimProcDiv::run(const MatterPtr &ops, MatterPtr &result,
         MatterFactoryIF * factory)
 {
     const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
-    if (!ce->rewind()) {
-        return false;
-    }
 
     AtomPtr res = factory->create_atom();
     if (!res.get()) {
@@ -214,7 +210,8 @@ bool PrimProcDiv::run(const MatterPtr &ops, MatterPtr &result,
     long double result_ld = 0;
     long double temp_ld = 0;
 
-    const Atom * first = static_cast<const Atom *>(ce->get_next().get());
+    CompositeExpr::const_iterator it = ce->begin();
+    const Atom * first = static_cast<const Atom *>((it++)->get());
     first->to_long_double(result_ld);
     if (ce->size() == 1) {
         if (result_ld == 0) {
@@ -223,8 +220,8 @@ bool PrimProcDiv::run(const MatterPtr &ops, MatterPtr &result,
         result_ld = 1.0 / result_ld;
     }
     else {
-        while (ce->has_next()) {
-            const Atom * e = static_cast<const Atom *>(ce->get_next().get());
+        for (; it != ce->end(); ++it) {
+            const Atom * e = static_cast<const Atom *>(it->get());
             if (!e->to_long_double(temp_ld) || temp_ld == 0) {
                 return false;
             }
@@ -244,9 +241,6 @@ bool PrimProc##name::run(const MatterPtr &ops, MatterPtr &result,       \
 {                                                                       \
     const CompositeExpr * ce =                                          \
             static_cast<const CompositeExpr*>(ops.get());               \
-    if (!ce->rewind()) {                                                \
-        return false;                                                   \
-    }                                                                   \
     AtomPtr res = factory->create_atom();                               \
     if (!res.get()) {                                                   \
         return false;                                                   \
@@ -254,9 +248,9 @@ bool PrimProc##name::run(const MatterPtr &ops, MatterPtr &result,       \
     long double first = 0;                                              \
     long double second = 0;                                             \
     const Atom * e = NULL;                                              \
-    e = static_cast<const Atom *>(ce->get(0).get());                    \
+    e = static_cast<const Atom *>((*ce)[0].get());                      \
     e->to_long_double(first);                                           \
-    e = static_cast<const Atom *>(ce->get(1).get());                    \
+    e = static_cast<const Atom *>((*ce)[1].get());                      \
     e->to_long_double(second);                                          \
     res->set_bool(first 
 
@@ -274,4 +268,830 @@ PRIM_PROC_RUN_IMPL_MACRO_BEGIN(Ge) >= PRIM_PROC_RUN_IMPL_MACRO_END()
 #undef PRIM_PROC_RUN_IMPL_MACRO_BEGIN
 #undef PRIM_PROC_RUN_IMPL_MACRO_END
 
+/*
+ * Return value:
+ *   `m' as a Pair if it is a list (including nil), NULL otherwise.
+ */
+static const Pair * _to_list(const MatterPtr &m)
+{
+    return (m && m->is_pair()) ? static_cast<const Pair *>(m.get()) : NULL;
+}
+
+bool PrimProcCons::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    if (!(*ce)[0] || !(*ce)[1]) {
+        return false;
+    }
+
+    PairPtr res = factory->create_pair((*ce)[0], (*ce)[1]);
+    if (!res) {
+        return false;
+    }
+
+    result = res;
+    return true;
+}
+
+bool PrimProcCar::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Pair * p = _to_list((*ce)[0]);
+    if (!p || p->is_nil()) {
+        PRETTY_MESSAGE(stderr, "operand is not a non-empty list");
+        return false;
+    }
+
+    result = p->car();
+    return true;
+}
+
+bool PrimProcCdr::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Pair * p = _to_list((*ce)[0]);
+    if (!p || p->is_nil()) {
+        PRETTY_MESSAGE(stderr, "operand is not a non-empty list");
+        return false;
+    }
+
+    result = p->cdr();
+    return true;
+}
+
+bool PrimProcList::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    MatterPtr res = Pair::nil();
+    for (size_t i = ce->size(); i > 0; --i) {
+        if (!(*ce)[i - 1] || !(res = factory->create_pair((*ce)[i - 1], res))) {
+            return false;
+        }
+    }
+
+    result = res;
+    return true;
+}
+
+bool PrimProcLength::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Pair * p = _to_list((*ce)[0]);
+    ssize_t length = p ? p->length() : -1;
+    if (length < 0) {
+        PRETTY_MESSAGE(stderr, "operand is not a proper list");
+        return false;
+    }
+
+    AtomPtr res = factory->create_atom();
+    if (!res) {
+        return false;
+    }
+
+    res->set_i64(static_cast<int64_t>(length));
+    result = res;
+    return true;
+}
+
+bool PrimProcNth::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Pair * p = _to_list((*ce)[0]);
+    const MatterPtr &idx = (*ce)[1];
+    int64_t n = 0;
+    if (!p || !idx || !idx->is_atom()
+            || !static_cast<const Atom *>(idx.get())->is_integer()
+            || !static_cast<const Atom *>(idx.get())->to_i64(n) || n < 0) {
+        return false;
+    }
+
+    for (; !p->is_nil(); --n) {
+        if (!n) {
+            result = p->car();
+            return true;
+        }
+
+        if (!(p = _to_list(p->cdr()))) {
+            break;
+        }
+    }
+
+    PRETTY_MESSAGE(stderr, "index out of range");
+    return false;
+}
+
+bool PrimProcReverse::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Pair * p = _to_list((*ce)[0]);
+    if (!p || p->length() < 0) {
+        PRETTY_MESSAGE(stderr, "operand is not a proper list");
+        return false;
+    }
+
+    MatterPtr res = Pair::nil();
+    for (; !p->is_nil(); p = static_cast<const Pair *>(p->cdr().get())) {
+        if (!(res = factory->create_pair(p->car(), res))) {
+            return false;
+        }
+    }
+
+    result = res;
+    return true;
+}
+
+static const Vector * _to_vector(const MatterPtr &m)
+{
+    return (m && m->is_vector()) ? static_cast<const Vector *>(m.get()) : NULL;
+}
+
+/*
+ * Description:
+ *   Convert a numeric atom, `is_real' tells which one of `i64' and `d' is
+ *   set, `d' is always set.
+ */
+static bool _to_number(const MatterPtr &m, bool &is_real, int64_t &i64,
+        double &d)
+{
+    if (!m || !m->is_atom()) {
+        return false;
+    }
+
+    const Atom * a = static_cast<const Atom *>(m.get());
+    if (a->is_integer()) {
+        is_real = false;
+        if (!a->to_i64(i64)) {
+            return false;
+        }
+        d = static_cast<double>(i64);
+        return true;
+    }
+    else if (a->is_real()) {
+        is_real = true;
+        return a->to_double(d);
+    }
+
+    return false;
+}
+
+static bool _set_number(bool is_real, int64_t i64, double d, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    AtomPtr res = factory->create_atom();
+    if (!res) {
+        return false;
+    }
+
+    if (is_real) {
+        res->set_double(d);
+    }
+    else {
+        res->set_i64(i64);
+    }
+    result = res;
+    return true;
+}
+
+/*
+ * Description:
+ *   Elements of `v' as doubles, `v' itself if it already is a double vector,
+ *   a converted copy (kept alive by `holder') otherwise.
+ */
+static const double * _double_elements(const Vector * v, VectorPtr &holder,
+        MatterFactoryIF * factory)
+{
+    if (v->is_double()) {
+        return v->double_data();
+    }
+
+    if (!(holder = factory->create_vector(Vector::elem_double, v->size()))) {
+        return NULL;
+    }
+
+    double * out = holder->double_data();
+    const int64_t * in = v->i64_data();
+    for (size_t i = 0; i < v->size(); ++i) {
+        out[i] = static_cast<double>(in[i]);
+    }
+    return out;
+}
+
+/*
+ * Description:
+ *   Create a vector from the numeric atoms in [begin, end).
+ */
+template<typename Iterator>
+static bool _build_vector(Iterator begin, Iterator end, size_t size,
+        MatterPtr &result, MatterFactoryIF * factory)
+{
+    bool any_real = false;
+    bool is_real = false;
+    int64_t i64 = 0;
+    double d = 0;
+    for (Iterator it = begin; it != end; ++it) {
+        if (!_to_number(*it, is_real, i64, d)) {
+            PRETTY_MESSAGE(stderr, "element is not a number");
+            return false;
+        }
+        any_real = any_real || is_real;
+    }
+
+    VectorPtr res = factory->create_vector(
+            any_real ? Vector::elem_double : Vector::elem_i64, size);
+    if (!res) {
+        return false;
+    }
+
+    size_t idx = 0;
+    for (Iterator it = begin; it != end; ++it, ++idx) {
+        _to_number(*it, is_real, i64, d);
+        if (any_real) {
+            res->double_data()[idx] = d;
+        }
+        else {
+            res->i64_data()[idx] = i64;
+        }
+    }
+
+    result = res;
+    return true;
+}
+
+bool PrimProcVector::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    return _build_vector(ce->begin(), ce->end(), ce->size(), result, factory);
+}
+
+bool PrimProcMakeVector::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    bool is_real = false;
+    int64_t size = 0;
+    double d = 0;
+    if (!_to_number((*ce)[0], is_real, size, d) || is_real || size < 0) {
+        PRETTY_MESSAGE(stderr, "size is not a non-negative integer");
+        return false;
+    }
+
+    int64_t fill_i64 = 0;
+    double fill_d = 0;
+    if (ce->size() > 1 && !_to_number((*ce)[1], is_real, fill_i64, fill_d)) {
+        PRETTY_MESSAGE(stderr, "initial value is not a number");
+        return false;
+    }
+
+    VectorPtr res = factory->create_vector(
+            is_real ? Vector::elem_double : Vector::elem_i64,
+            static_cast<size_t>(size));
+    if (!res) {
+        return false;
+    }
+
+    for (size_t i = 0; i < res->size(); ++i) {
+        if (is_real) {
+            res->double_data()[i] = fill_d;
+        }
+        else {
+            res->i64_data()[i] = fill_i64;
+        }
+    }
+
+    result = res;
+    return true;
+}
+
+namespace
+{
+
+/*
+ * Iterates over the elements of a proper list.
+ */
+class ListIterator
+{
+public:
+    ListIterator(const Pair * p) :
+            _p(p)
+    {
+    }
+
+    const MatterPtr & operator*() const
+    {
+        return _p->car();
+    }
+
+    ListIterator & operator++()
+    {
+        _p = static_cast<const Pair *>(_p->cdr().get());
+        return *this;
+    }
+
+    bool operator!=(const ListIterator &other) const
+    {
+        return _p != other._p;
+    }
+
+private:
+    const Pair * _p;
+};
+
+} // anonymous namespace
+
+bool PrimProcListToVector::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Pair * p = _to_list((*ce)[0]);
+    ssize_t length = p ? p->length() : -1;
+    if (length < 0) {
+        PRETTY_MESSAGE(stderr, "operand is not a proper list");
+        return false;
+    }
+
+    return _build_vector(ListIterator(p), ListIterator(Pair::nil().get()),
+            static_cast<size_t>(length), result, factory);
+}
+
+bool PrimProcVecLen::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Vector * v = _to_vector((*ce)[0]);
+    if (!v) {
+        PRETTY_MESSAGE(stderr, "operand is not a vector");
+        return false;
+    }
+
+    return _set_number(false, static_cast<int64_t>(v->size()), 0, result,
+            factory);
+}
+
+bool PrimProcVecRef::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Vector * v = _to_vector((*ce)[0]);
+    bool is_real = false;
+    int64_t idx = 0;
+    double d = 0;
+    if (!v || !_to_number((*ce)[1], is_real, idx, d) || is_real) {
+        return false;
+    }
+
+    if (idx < 0 || static_cast<uint64_t>(idx) >= v->size()) {
+        PRETTY_MESSAGE(stderr, "index out of range");
+        return false;
+    }
+
+    return v->is_double()
+            ? _set_number(true, 0, v->double_data()[idx], result, factory)
+            : _set_number(false, v->i64_data()[idx], 0, result, factory);
+}
+
+bool PrimProcVecSum::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Vector * v = _to_vector((*ce)[0]);
+    if (!v) {
+        PRETTY_MESSAGE(stderr, "operand is not a vector");
+        return false;
+    }
+
+    const VectorKernels &k = VectorKernels::get();
+    return v->is_double()
+            ? _set_number(true, 0, k.sum_f64(v->double_data(), v->size()),
+                    result, factory)
+            : _set_number(false, k.sum_i64(v->i64_data(), v->size()), 0,
+                    result, factory);
+}
+
+bool PrimProcVecDot::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Vector * a = _to_vector((*ce)[0]);
+    const Vector * b = _to_vector((*ce)[1]);
+    if (!a || !b || a->size() != b->size()) {
+        PRETTY_MESSAGE(stderr, "operands are not vectors of the same size");
+        return false;
+    }
+
+    const VectorKernels &k = VectorKernels::get();
+    if (a->is_i64() && b->is_i64()) {
+        return _set_number(false,
+                k.dot_i64(a->i64_data(), b->i64_data(), a->size()), 0,
+                result, factory);
+    }
+
+    VectorPtr holder_a;
+    VectorPtr holder_b;
+    const double * da = _double_elements(a, holder_a, factory);
+    const double * db = _double_elements(b, holder_b, factory);
+    if (!da || !db) {
+        return false;
+    }
+
+    return _set_number(true, 0, k.dot_f64(da, db, a->size()), result,
+            factory);
+}
+
+bool PrimProcVecMin::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Vector * v = _to_vector((*ce)[0]);
+    if (!v || !v->size()) {
+        PRETTY_MESSAGE(stderr, "operand is not a non-empty vector");
+        return false;
+    }
+
+    const VectorKernels &k = VectorKernels::get();
+    return v->is_double()
+            ? _set_number(true, 0, k.min_f64(v->double_data(), v->size()),
+                    result, factory)
+            : _set_number(false, k.min_i64(v->i64_data(), v->size()), 0,
+                    result, factory);
+}
+
+bool PrimProcVecMax::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Vector * v = _to_vector((*ce)[0]);
+    if (!v || !v->size()) {
+        PRETTY_MESSAGE(stderr, "operand is not a non-empty vector");
+        return false;
+    }
+
+    const VectorKernels &k = VectorKernels::get();
+    return v->is_double()
+            ? _set_number(true, 0, k.max_f64(v->double_data(), v->size()),
+                    result, factory)
+            : _set_number(false, k.max_i64(v->i64_data(), v->size()), 0,
+                    result, factory);
+}
+
+bool PrimProcVecMapAdd::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Vector * a = _to_vector((*ce)[0]);
+    const Vector * b = _to_vector((*ce)[1]);
+    if (!a || !b || a->size() != b->size()) {
+        PRETTY_MESSAGE(stderr, "operands are not vectors of the same size");
+        return false;
+    }
+
+    const VectorKernels &k = VectorKernels::get();
+    VectorPtr res;
+    if (a->is_i64() && b->is_i64()) {
+        if (!(res = factory->create_vector(Vector::elem_i64, a->size()))) {
+            return false;
+        }
+        k.add_i64(a->i64_data(), b->i64_data(), res->i64_data(), a->size());
+    }
+    else {
+        VectorPtr holder_a;
+        VectorPtr holder_b;
+        const double * da = _double_elements(a, holder_a, factory);
+        const double * db = _double_elements(b, holder_b, factory);
+        if (!da || !db || !(res = factory->create_vector(Vector::elem_double,
+                a->size()))) {
+            return false;
+        }
+        k.add_f64(da, db, res->double_data(), a->size());
+    }
+
+    result = res;
+    return true;
+}
+
+bool PrimProcVecScale::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const Vector * v = _to_vector((*ce)[0]);
+    bool is_real = false;
+    int64_t k_i64 = 0;
+    double k_d = 0;
+    if (!v || !_to_number((*ce)[1], is_real, k_i64, k_d)) {
+        PRETTY_MESSAGE(stderr, "operands are not a vector and a number");
+        return false;
+    }
+
+    const VectorKernels &k = VectorKernels::get();
+    VectorPtr res;
+    if (v->is_i64() && !is_real) {
+        if (!(res = factory->create_vector(Vector::elem_i64, v->size()))) {
+            return false;
+        }
+        k.scale_i64(v->i64_data(), k_i64, res->i64_data(), v->size());
+    }
+    else {
+        VectorPtr holder;
+        const double * dv = _double_elements(v, holder, factory);
+        if (!dv || !(res = factory->create_vector(Vector::elem_double,
+                v->size()))) {
+            return false;
+        }
+        k.scale_f64(dv, k_d, res->double_data(), v->size());
+    }
+
+    result = res;
+    return true;
+}
+
+static HashMap * _to_hash_map(const MatterPtr &m)
+{
+    return (m && m->is_hash_map()) ? static_cast<HashMap *>(m.get()) : NULL;
+}
+
+/*
+ * Description:
+ *   Insert the key value pairs in [begin, end) into `m'.
+ */
+static bool _insert_pairs(HashMap * m, CompositeExpr::const_iterator begin,
+        CompositeExpr::const_iterator end)
+{
+    if ((end - begin) % 2) {
+        PRETTY_MESSAGE(stderr, "missing value of the last key");
+        return false;
+    }
+
+    for (CompositeExpr::const_iterator it = begin; it != end; it += 2) {
+        if (!AtomKey::is_valid(*it)) {
+            PRETTY_MESSAGE(stderr, "key is not a number, string or symbol");
+            return false;
+        }
+        if (!*(it + 1) || !m->insert(*it, *(it + 1))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool PrimProcHashMap::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    HashMapPtr res = factory->create_hash_map(ce->size() / 2);
+    if (!res || !_insert_pairs(res.get(), ce->begin(), ce->end())) {
+        return false;
+    }
+
+    result = res;
+    return true;
+}
+
+/*
+ * Description:
+ *   Look up `key' in a hash map or a persistent map.
+ *
+ * Return value:
+ *   false if `m' is not a map, `value' is set to NULL if `key' not found.
+ */
+static bool _map_find(const MatterPtr &m, const MatterPtr &key,
+        const MatterPtr * &value)
+{
+    if (m && m->is_hash_map()) {
+        value = static_cast<const HashMap *>(m.get())->find(key);
+        return true;
+    }
+    else if (m && m->is_persistent_map()) {
+        value = static_cast<const PersistentMap *>(m.get())->find(key);
+        return true;
+    }
+
+    PRETTY_MESSAGE(stderr, "operand is not a map");
+    return false;
+}
+
+bool PrimProcGet::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const MatterPtr * value = NULL;
+    if (!_map_find((*ce)[0], (*ce)[1], value)) {
+        return false;
+    }
+
+    if (value) {
+        result = *value;
+    }
+    else {
+        result = ce->size() > 2 ? (*ce)[2] : Pair::nil();
+    }
+    return true;
+}
+
+bool PrimProcAssocBang::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    HashMap * m = _to_hash_map((*ce)[0]);
+    if (!m) {
+        PRETTY_MESSAGE(stderr, "operand is not a map");
+        return false;
+    }
+
+    if (!_insert_pairs(m, ce->begin() + 1, ce->end())) {
+        return false;
+    }
+
+    result = (*ce)[0];
+    return true;
+}
+
+bool PrimProcDissocBang::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    HashMap * m = _to_hash_map((*ce)[0]);
+    if (!m) {
+        PRETTY_MESSAGE(stderr, "operand is not a map");
+        return false;
+    }
+
+    for (CompositeExpr::const_iterator it = ce->begin() + 1; it != ce->end();
+            ++it) {
+        m->erase(*it);
+    }
+
+    result = (*ce)[0];
+    return true;
+}
+
+bool PrimProcContains::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const MatterPtr * value = NULL;
+    if (!_map_find((*ce)[0], (*ce)[1], value)) {
+        return false;
+    }
+
+    AtomPtr res = factory->create_atom();
+    if (!res) {
+        return false;
+    }
+
+    res->set_bool(value != NULL);
+    result = res;
+    return true;
+}
+
+bool PrimProcCount::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    const MatterPtr &m = (*ce)[0];
+    ssize_t n = -1;
+    if (!m) {
+        return false;
+    }
+    else if (m->is_hash_map()) {
+        n = static_cast<ssize_t>(static_cast<const HashMap *>(m.get())->size());
+    }
+    else if (m->is_persistent_map()) {
+        n = static_cast<ssize_t>(
+                static_cast<const PersistentMap *>(m.get())->size());
+    }
+    else if (m->is_vector()) {
+        n = static_cast<ssize_t>(static_cast<const Vector *>(m.get())->size());
+    }
+    else if (m->is_pair()) {
+        n = static_cast<const Pair *>(m.get())->length();
+    }
+
+    if (n < 0) {
+        PRETTY_MESSAGE(stderr, "operand is not a map, vector or proper list");
+        return false;
+    }
+
+    return _set_number(false, static_cast<int64_t>(n), 0, result, factory);
+}
+
+static const PersistentMap * _to_persistent_map(const MatterPtr &m)
+{
+    return (m && m->is_persistent_map())
+            ? static_cast<const PersistentMap *>(m.get()) : NULL;
+}
+
+/*
+ * Description:
+ *   Apply the key value pairs in [begin, end) to `from' in one batch.
+ */
+static bool _assoc_pairs(const PersistentMapPtr &from,
+        CompositeExpr::const_iterator begin, CompositeExpr::const_iterator end,
+        MatterPtr &result)
+{
+    if ((end - begin) % 2) {
+        PRETTY_MESSAGE(stderr, "missing value of the last key");
+        return false;
+    }
+
+    PersistentMap::Transient transient(from);
+    for (CompositeExpr::const_iterator it = begin; it != end; it += 2) {
+        if (!AtomKey::is_valid(*it)) {
+            PRETTY_MESSAGE(stderr, "key is not a number, string or symbol");
+            return false;
+        }
+        if (!*(it + 1) || !transient.assoc(*it, *(it + 1))) {
+            return false;
+        }
+    }
+
+    PersistentMapPtr res = transient.persistent();
+    if (!res) {
+        return false;
+    }
+
+    result = res;
+    return true;
+}
+
+bool PrimProcPersistentMap::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    PersistentMapPtr empty = factory->create_persistent_map();
+    return empty && _assoc_pairs(empty, ce->begin(), ce->end(), result);
+}
+
+bool PrimProcAssoc::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    if (!_to_persistent_map((*ce)[0])) {
+        PRETTY_MESSAGE(stderr, "operand is not a persistent map");
+        return false;
+    }
+
+    const PersistentMapPtr from =
+            boost::static_pointer_cast<PersistentMap>((*ce)[0]);
+    if (ce->size() == 3) {
+        if (!AtomKey::is_valid((*ce)[1])) {
+            PRETTY_MESSAGE(stderr, "key is not a number, string or symbol");
+            return false;
+        }
+
+        PersistentMapPtr res = from->assoc((*ce)[1], (*ce)[2]);
+        if (!res) {
+            return false;
+        }
+        result = res;
+        return true;
+    }
+
+    return _assoc_pairs(from, ce->begin() + 1, ce->end(), result);
+}
+
+bool PrimProcDissoc::run(const MatterPtr &ops, MatterPtr &result,
+        MatterFactoryIF * factory)
+{
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(ops.get());
+    if (!_to_persistent_map((*ce)[0])) {
+        PRETTY_MESSAGE(stderr, "operand is not a persistent map");
+        return false;
+    }
+
+    const PersistentMapPtr from =
+            boost::static_pointer_cast<PersistentMap>((*ce)[0]);
+    if (ce->size() == 2) {
+        PersistentMapPtr res = from->dissoc((*ce)[1]);
+        if (!res) {
+            return false;
+        }
+        result = res;
+        return true;
+    }
+
+    PersistentMap::Transient transient(from);
+    for (CompositeExpr::const_iterator it = ce->begin() + 1; it != ce->end();
+            ++it) {
+        if (!transient.dissoc(*it)) {
+            return false;
+        }
+    }
+
+    PersistentMapPtr res = transient.persistent();
+    if (!res) {
+        return false;
+    }
+
+    result = res;
+    return true;
+}
+
 } // namespace SolarWindLisp
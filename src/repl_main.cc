@@ -7,10 +7,17 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "solarwindlisp.h"
 
 int main(int argc, char ** argv)
 {
+    // the script is cached next to it (see ScriptCache) only if asked for
+    const char * cache = getenv("SWL_SCRIPT_CACHE");
+    if (cache && *cache && strcmp(cache, "0") != 0) {
+        SolarWindLisp::ScriptCache::set_enabled(true);
+    }
+
     SolarWindLisp::InterpreterIF::repl(argc > 1 ? argv[1] : NULL);
     exit(EXIT_SUCCESS);
 }
@@ -0,0 +1,638 @@
+/*
+ * file name:           src/script_cache.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 01:04:52 2026 CST
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <unordered_map>
+#include "script_cache.h"
+#include "expr.h"
+#include "symbol_table.h"
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+std::atomic<bool> g_enabled(false);
+
+struct FileHeader
+{
+    char magic[4];              // SWLC
+    uint32_t version;
+    uint32_t byte_order;        // BYTE_ORDER_MARK, as written
+    uint16_t long_double_size;
+    uint16_t reserved;
+    uint64_t source_length;
+    uint64_t source_hash;
+    uint64_t cache_hash;        // of the whole file, see file_hash()
+    uint64_t pool_offset;       // texts
+    uint64_t pool_size;
+    uint64_t symbols_offset;    // TextRef[]
+    uint64_t num_symbols;
+    uint64_t constants_offset;  // uint64_t[], the values
+    uint64_t types_offset;      // uint8_t[], Atom::atom_type_t of each
+    uint64_t num_constants;
+    uint64_t long_doubles_offset;
+    uint64_t num_long_doubles;
+    uint64_t nodes_offset;      // uint32_t[], in postorder
+    uint64_t num_nodes;
+    uint64_t num_forms;         // left on the stack by the nodes
+};
+
+struct TextRef
+{
+    uint32_t offset;            // in the pool
+    uint32_t length;
+};
+
+/*
+ * The value of a constant is a number of 64 bits at most, a string is the
+ * offset of its text in the high half and the length in the low half, a
+ * long double is an index into a section of its own, as they are rare.
+ */
+typedef uint64_t ConstantValue;
+
+typedef unsigned char LongDouble[16];
+
+static_assert(sizeof(long double) <= sizeof(LongDouble),
+        "long double does not fit");
+
+// a node is a kind in the 2 high bits, and an index or a count
+enum node_kind_t
+{
+    node_symbol = 0,
+    node_constant,
+    node_list,                  // of the children just before it
+};
+
+const uint32_t NODE_VALUE_MASK = (1U << 30) - 1;
+
+inline uint32_t make_node(node_kind_t kind, uint32_t value)
+{
+    return (static_cast<uint32_t>(kind) << 30) | value;
+}
+
+inline uint64_t rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t fmix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/*
+ * Return value:
+ *   hash of the cache `file', its header included, with `cache_hash' as 0.
+ */
+uint64_t file_hash(const char * file, size_t file_size)
+{
+    FileHeader h;
+    memcpy(&h, file, sizeof(h));
+    h.cache_hash = 0;
+    return ScriptCache::content_hash(reinterpret_cast<const char *>(&h),
+            sizeof(h)) ^ rotl64(ScriptCache::content_hash(file + sizeof(h),
+                    file_size - sizeof(h)), 1);
+}
+
+void append_padded(std::string &file, const void * data, size_t length)
+{
+    file.append(static_cast<const char *>(data), length);
+    file.append((8 - file.size() % 8) % 8, '\0');
+}
+
+/*
+ * The sections of a cache file being built, the distinct symbols and
+ * constants are numbered in the order they are first seen.
+ */
+class Builder
+{
+public:
+    bool add_form(const MatterPtr &form);
+
+    std::string pool;
+    std::vector<TextRef> symbols;
+    std::vector<ConstantValue> values;
+    std::vector<uint8_t> types;
+    std::vector<long double> long_doubles;
+    std::vector<uint32_t> nodes;
+
+private:
+    bool _add_atom(const Atom * atom);
+    bool _add_text(const char * text, size_t length, TextRef &ref);
+
+    std::unordered_map<std::string, uint32_t> _symbol_index;
+    std::unordered_map<std::string, uint32_t> _constant_index;   // by type and value
+};
+
+bool Builder::_add_text(const char * text, size_t length, TextRef &ref)
+{
+    if (pool.size() + length + 1 > UINT32_MAX) {
+        return false;
+    }
+
+    ref.offset = static_cast<uint32_t>(pool.size());
+    ref.length = static_cast<uint32_t>(length);
+    pool.append(text, length);
+    pool += '\0';
+    return true;
+}
+
+bool Builder::_add_atom(const Atom * atom)
+{
+    if (atom->is_cstr() && !atom->is_quoted_cstr()) {
+        std::string name(atom->to_cstr(), atom->cstr_length());
+        std::unordered_map<std::string, uint32_t>::iterator it =
+                _symbol_index.find(name);
+        if (it == _symbol_index.end()) {
+            TextRef ref;
+            if (symbols.size() > NODE_VALUE_MASK
+                    || !_add_text(name.data(), name.size(), ref)) {
+                return false;
+            }
+            it = _symbol_index.insert(std::make_pair(name,
+                    static_cast<uint32_t>(symbols.size()))).first;
+            symbols.push_back(ref);
+        }
+        nodes.push_back(make_node(node_symbol, it->second));
+        return true;
+    }
+
+    // the key is the type and the bytes of the value, or the text
+    uint8_t type = static_cast<uint8_t>(atom->atom_type());
+    ConstantValue value = 0;
+    long double ld = 0;
+    std::string key(1, static_cast<char>(type));
+    switch (atom->atom_type()) {
+        case Atom::atom_bool: {
+            bool v = false;
+            atom->to_bool(v);
+            value = v;
+            break;
+        }
+        case Atom::atom_i32: {
+            int32_t v = 0;
+            atom->to_i32(v);
+            value = static_cast<uint32_t>(v);
+            break;
+        }
+        case Atom::atom_u32: {
+            uint32_t v = 0;
+            atom->to_u32(v);
+            value = v;
+            break;
+        }
+        case Atom::atom_i64: {
+            int64_t v = 0;
+            atom->to_i64(v);
+            value = static_cast<uint64_t>(v);
+            break;
+        }
+        case Atom::atom_u64:
+            atom->to_u64(value);
+            break;
+        case Atom::atom_double: {
+            double v = 0;
+            atom->to_double(v);
+            memcpy(&value, &v, sizeof(v));
+            break;
+        }
+        case Atom::atom_long_double:
+            // the padding bytes may differ, equal ones are not merged then
+            atom->to_long_double(ld);
+            key.append(reinterpret_cast<const char *>(&ld), sizeof(ld));
+            break;
+        case Atom::atom_cstr:
+            key.append(atom->to_cstr(), atom->cstr_length());
+            break;
+        default:
+            return false;
+    }
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+
+    std::unordered_map<std::string, uint32_t>::iterator it = _constant_index.find(key);
+    if (it == _constant_index.end()) {
+        if (values.size() > NODE_VALUE_MASK) {
+            return false;
+        }
+        if (atom->is_cstr()) {
+            TextRef ref;
+            if (!_add_text(atom->to_cstr(), atom->cstr_length(), ref)) {
+                return false;
+            }
+            value = (static_cast<uint64_t>(ref.offset) << 32) | ref.length;
+        }
+        else if (atom->is_long_double()) {
+            value = long_doubles.size();
+            long_doubles.push_back(ld);
+        }
+        it = _constant_index.insert(std::make_pair(key,
+                static_cast<uint32_t>(values.size()))).first;
+        values.push_back(value);
+        types.push_back(type);
+    }
+    nodes.push_back(make_node(node_constant, it->second));
+    return true;
+}
+
+bool Builder::add_form(const MatterPtr &form)
+{
+    // postorder, without recursion, nesting is limited by memory only
+    struct Pending
+    {
+        const CompositeExpr * list;
+        size_t next;
+    };
+    std::vector<Pending> pending;
+
+    if (!form) {
+        return false;
+    }
+
+    MatterPtr next = form;
+    while (true) {
+        if (next) {
+            if (next->is_atom()) {
+                if (!_add_atom(static_cast<const Atom *>(next.get()))) {
+                    return false;
+                }
+            }
+            else if (next->is_composite_expr()) {
+                const CompositeExpr * list =
+                        static_cast<const CompositeExpr *>(next.get());
+                if (list->size() > NODE_VALUE_MASK) {
+                    return false;
+                }
+                Pending p = { list, 0 };
+                pending.push_back(p);
+            }
+            else {
+                // not a parsed form
+                return false;
+            }
+        }
+
+        if (pending.empty()) {
+            return true;
+        }
+
+        Pending &top = pending.back();
+        if (top.next < top.list->size()) {
+            next = (*top.list)[top.next++];
+        }
+        else {
+            nodes.push_back(make_node(node_list,
+                    static_cast<uint32_t>(top.list->size())));
+            pending.pop_back();
+            next.reset();
+        }
+    }
+}
+
+/*
+ * Return value:
+ *   true if `count' records of `size' bytes at `offset', aligned to
+ *   `align', are inside the file of `file_size' bytes.
+ */
+bool section_ok(uint64_t offset, uint64_t count, size_t size, size_t align,
+        size_t file_size)
+{
+    return offset % align == 0 && offset <= file_size
+            && count <= (file_size - offset) / size;
+}
+
+bool text_ok(const TextRef &ref, uint64_t pool_size)
+{
+    return ref.offset <= pool_size && ref.length < pool_size - ref.offset;
+}
+
+bool load_mapped(const char * file, size_t file_size, const char * source,
+        size_t source_length, std::vector<MatterPtr> &forms,
+        SymbolTable * symbols)
+{
+    FileHeader h;
+    if (file_size < sizeof(h)) {
+        return false;
+    }
+    memcpy(&h, file, sizeof(h));
+
+    if (memcmp(h.magic, "SWLC", 4) || h.version != ScriptCache::VERSION
+            || h.byte_order != BYTE_ORDER_MARK
+            || h.long_double_size != sizeof(long double) || h.reserved
+            || h.source_length != source_length
+            || h.source_hash != ScriptCache::content_hash(source,
+                    source_length)
+            || h.cache_hash != file_hash(file, file_size)) {
+        return false;
+    }
+
+    if (!section_ok(h.pool_offset, h.pool_size, 1, 8, file_size)
+            || !section_ok(h.symbols_offset, h.num_symbols, sizeof(TextRef),
+                    8, file_size)
+            || !section_ok(h.constants_offset, h.num_constants,
+                    sizeof(ConstantValue), 8, file_size)
+            || !section_ok(h.types_offset, h.num_constants, 1, 1, file_size)
+            || !section_ok(h.long_doubles_offset, h.num_long_doubles,
+                    sizeof(LongDouble), 8, file_size)
+            || !section_ok(h.nodes_offset, h.num_nodes, sizeof(uint32_t), 4,
+                    file_size)) {
+        return false;
+    }
+
+    const char * pool = file + h.pool_offset;
+    const TextRef * symbol_refs =
+            reinterpret_cast<const TextRef *>(file + h.symbols_offset);
+    const ConstantValue * values = reinterpret_cast<const ConstantValue *>(
+            file + h.constants_offset);
+    const uint8_t * types =
+            reinterpret_cast<const uint8_t *>(file + h.types_offset);
+    const LongDouble * long_doubles =
+            reinterpret_cast<const LongDouble *>(file + h.long_doubles_offset);
+    const uint32_t * nodes =
+            reinterpret_cast<const uint32_t *>(file + h.nodes_offset);
+
+    // one atom per symbol and per constant, shared by their occurrences
+    std::vector<MatterPtr> atoms(h.num_symbols + h.num_constants);
+    for (size_t i = 0; i < h.num_symbols; ++i) {
+        AtomPtr atom = Atom::create();
+        if (!atom || !text_ok(symbol_refs[i], h.pool_size)
+                || !atom->set_cstr(pool + symbol_refs[i].offset,
+                        symbol_refs[i].length, false, symbols)) {
+            return false;
+        }
+        atoms[i] = atom;
+    }
+
+    for (size_t i = 0; i < h.num_constants; ++i) {
+        AtomPtr atom = Atom::create();
+        if (!atom) {
+            return false;
+        }
+
+        ConstantValue v = values[i];
+        switch (types[i]) {
+            case Atom::atom_bool:
+                atom->set_bool(v != 0);
+                break;
+            case Atom::atom_i32:
+                atom->set_i32(static_cast<int32_t>(static_cast<uint32_t>(v)));
+                break;
+            case Atom::atom_u32:
+                atom->set_u32(static_cast<uint32_t>(v));
+                break;
+            case Atom::atom_i64:
+                atom->set_i64(static_cast<int64_t>(v));
+                break;
+            case Atom::atom_u64:
+                atom->set_u64(v);
+                break;
+            case Atom::atom_double: {
+                double d;
+                memcpy(&d, &v, sizeof(d));
+                atom->set_double(d);
+                break;
+            }
+            case Atom::atom_long_double: {
+                if (v >= h.num_long_doubles) {
+                    return false;
+                }
+                long double ld;
+                memcpy(&ld, long_doubles[v], sizeof(ld));
+                atom->set_long_double(ld);
+                break;
+            }
+            case Atom::atom_cstr: {
+                TextRef ref = { static_cast<uint32_t>(v >> 32),
+                        static_cast<uint32_t>(v) };
+                if (!text_ok(ref, h.pool_size)
+                        || !atom->set_cstr(pool + ref.offset, ref.length,
+                                true)) {
+                    return false;
+                }
+                break;
+            }
+            default:
+                return false;
+        }
+        atoms[h.num_symbols + i] = atom;
+    }
+
+    // the lists are built from the children on top of the stack
+    std::vector<MatterPtr> stack;
+    for (size_t i = 0; i < h.num_nodes; ++i) {
+        uint32_t value = nodes[i] & NODE_VALUE_MASK;
+        switch (nodes[i] >> 30) {
+            case node_symbol:
+                if (value >= h.num_symbols) {
+                    return false;
+                }
+                stack.push_back(atoms[value]);
+                break;
+            case node_constant:
+                if (value >= h.num_constants) {
+                    return false;
+                }
+                stack.push_back(atoms[h.num_symbols + value]);
+                break;
+            case node_list: {
+                if (value > stack.size()) {
+                    return false;
+                }
+                CompositeExprPtr list = CompositeExpr::create(value);
+                if (!list) {
+                    return false;
+                }
+                size_t first = stack.size() - value;
+                for (size_t k = first; k < stack.size(); ++k) {
+                    list->append_expr(stack[k]);
+                }
+                stack.resize(first);
+                stack.push_back(list);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    if (stack.size() != h.num_forms) {
+        return false;
+    }
+
+    forms.insert(forms.end(), stack.begin(), stack.end());
+    return true;
+}
+
+} // anonymous namespace
+
+void ScriptCache::set_enabled(bool enabled)
+{
+    g_enabled.store(enabled);
+}
+
+bool ScriptCache::enabled()
+{
+    return g_enabled.load();
+}
+
+std::string ScriptCache::cache_filename(const char * filename)
+{
+    std::string result(filename);
+    size_t length = result.length();
+    if (length > 4 && result.compare(length - 4, 4, ".swl") == 0) {
+        return result + "c";
+    }
+    return result + ".swlc";
+}
+
+uint64_t ScriptCache::content_hash(const char * data, size_t length)
+{
+    // MurmurHash3 style, a word at a time
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ length;
+
+    size_t i = 0;
+    while (i < length) {
+        uint64_t w = 0;
+        size_t n = length - i < 8 ? length - i : 8;
+        memcpy(&w, data + i, n);
+        i += n;
+
+        w *= c1;
+        w = rotl64(w, 31);
+        w *= c2;
+        h ^= w;
+        h = rotl64(h, 27) * 5 + 0x52dce729;
+    }
+
+    return fmix64(h);
+}
+
+SymbolTable * ScriptCache::default_symbol_table()
+{
+    return &SymbolTable::global();
+}
+
+bool ScriptCache::write(const char * filename, const char * source,
+        size_t source_length, const std::vector<MatterPtr> &forms)
+{
+    Builder b;
+    for (size_t i = 0; i < forms.size(); ++i) {
+        if (!b.add_form(forms[i])) {
+            return false;
+        }
+    }
+
+    FileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, "SWLC", 4);
+    h.version = VERSION;
+    h.byte_order = BYTE_ORDER_MARK;
+    h.long_double_size = sizeof(long double);
+    h.source_length = source_length;
+    h.source_hash = content_hash(source, source_length);
+    h.num_symbols = b.symbols.size();
+    h.num_constants = b.values.size();
+    h.num_long_doubles = b.long_doubles.size();
+    h.num_nodes = b.nodes.size();
+    h.num_forms = forms.size();
+
+    std::string file;
+    append_padded(file, &h, sizeof(h));
+    h.pool_offset = file.size();
+    h.pool_size = b.pool.size();
+    append_padded(file, b.pool.data(), b.pool.size());
+    h.symbols_offset = file.size();
+    append_padded(file, b.symbols.data(), b.symbols.size() * sizeof(TextRef));
+    h.constants_offset = file.size();
+    append_padded(file, b.values.data(),
+            b.values.size() * sizeof(ConstantValue));
+    h.types_offset = file.size();
+    append_padded(file, b.types.data(), b.types.size());
+    h.long_doubles_offset = file.size();
+    for (size_t i = 0; i < b.long_doubles.size(); ++i) {
+        LongDouble ld;
+        memset(ld, 0, sizeof(ld));
+        memcpy(ld, &b.long_doubles[i], sizeof(long double));
+        append_padded(file, ld, sizeof(ld));
+    }
+    h.nodes_offset = file.size();
+    append_padded(file, b.nodes.data(), b.nodes.size() * sizeof(uint32_t));
+    memcpy(&file[0], &h, sizeof(h));
+    h.cache_hash = file_hash(file.data(), file.size());
+    memcpy(&file[0], &h, sizeof(h));
+
+    char tmp_name[4096];
+    snprintf(tmp_name, sizeof(tmp_name), "%s.tmp.%d", filename,
+            static_cast<int>(getpid()));
+    FILE * fp = fopen(tmp_name, "wb");
+    if (!fp) {
+        return false;
+    }
+
+    bool ok = fwrite(file.data(), 1, file.size(), fp) == file.size();
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || rename(tmp_name, filename) != 0) {
+        unlink(tmp_name);
+        return false;
+    }
+
+    return true;
+}
+
+bool ScriptCache::load(const char * filename, const char * source,
+        size_t source_length, std::vector<MatterPtr> &forms,
+        SymbolTable * symbols)
+{
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)
+            || st.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(fd);
+        return false;
+    }
+
+    size_t file_size = static_cast<size_t>(st.st_size);
+    void * mapped = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    // nothing is appended unless all the forms are rebuilt
+    std::vector<MatterPtr> loaded;
+    bool ok = load_mapped(static_cast<const char *>(mapped), file_size,
+            source, source_length, loaded, symbols);
+    munmap(mapped, file_size);
+    if (ok) {
+        forms.insert(forms.end(), loaded.begin(), loaded.end());
+    }
+
+    return ok;
+}
+
+} // namespace SolarWindLisp
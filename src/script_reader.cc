@@ -6,23 +6,19 @@
  * date created:        Wed Dec 03 22:12:29 2014 CST
  */
 
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "interpreter.h"
 #include "script_reader.h"
 namespace SolarWindLisp {
 
 bool ScriptFileReader::initialize(const char * filename)
 {
-    static const size_t DEFAULT_LINE_BUF_SIZE = 4096;
-
-    if (!(_line_buf = (char *) malloc(DEFAULT_LINE_BUF_SIZE))) {
-        PRETTY_MESSAGE(stderr, "cannot allocate line buffer");
-        return false;
-    }
-
-    _line_buf_size = DEFAULT_LINE_BUF_SIZE;
-    _line_buf[0] = '\0';
-
     if (!filename || !strcmp(filename, "-")) {
         _filename = strdup("stdin");
     }
@@ -36,19 +32,290 @@ bool ScriptFileReader::initialize(const char * filename)
     }
 
     if (!strcmp(_filename, "stdin")) {
-        _filehandle = stdin;
-        return true;
+        _fd = STDIN_FILENO;
     }
-    else {
-        if (!(_filehandle = fopen(_filename, "r"))) {
-            PRETTY_MESSAGE(stderr, "cannot open file `%s'", _filename);
+    else if ((_fd = open(_filename, O_RDONLY)) < 0) {
+        PRETTY_MESSAGE(stderr, "cannot open file `%s'", _filename);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(_fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void * p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if (p != MAP_FAILED) {
+            (void) madvise(p, st.st_size, MADV_SEQUENTIAL);
+            _mapped = true;
+            _data = static_cast<const char *>(p);
+            _size = st.st_size;
+            _end_of_input = true;
+            _index.reset(_data, _size);
+            return true;
+        }
+        // e.g. on a file system without mmap(), read it instead
+    }
+
+    if (!(_buf = (char *) malloc(READ_CHUNK_SIZE))) {
+        PRETTY_MESSAGE(stderr, "cannot allocate read buffer");
+        return false;
+    }
+
+    _buf_size = READ_CHUNK_SIZE;
+    _data = _buf;
+    return true;
+}
+
+ScriptFileReader::~ScriptFileReader()
+{
+    if (_filename) {
+        free(_filename);
+    }
+
+    if (_mapped) {
+        munmap(const_cast<char *>(_data), _size);
+    }
+
+    if (_fd >= 0 && _fd != STDIN_FILENO) {
+        close(_fd);
+    }
+
+    if (_buf) {
+        free(_buf);
+    }
+}
+
+bool ScriptFileReader::_fill(bool primary_prompt)
+{
+    if (_end_of_input) {
+        return false;
+    }
+
+    // keep the unconsumed data only, at the front
+    if (_pos) {
+        memmove(_buf, _buf + _pos, _size - _pos);
+        _size -= _pos;
+        _pos = 0;
+    }
+
+    // a statement larger than the buffer
+    if (_buf_size - _size < READ_CHUNK_SIZE / 2) {
+        char * ptr = (char *) realloc(_buf, _buf_size * 2);
+        if (!ptr) {
+            PRETTY_MESSAGE(stderr, "cannot grow read buffer");
+            _end_of_input = true;
             return false;
         }
+        _buf = ptr;
+        _buf_size *= 2;
+    }
+    _data = _buf;
+
+    if (_fd == STDIN_FILENO) {
+        fprintf(stderr, "%s", InterpreterIF::prompt(primary_prompt));
+    }
+
+    ssize_t n = 0;
+    do {
+        n = read(_fd, _buf + _size, _buf_size - _size);
+    } while (n < 0 && errno == EINTR);
+
+    if (n <= 0) {
+        if (n < 0) {
+            PRETTY_MESSAGE(stderr, "cannot read `%s'", _filename);
+        }
+        _end_of_input = true;
+        _index.reset(_data, _size);
+        return false;
+    }
+
+    _size += n;
+    _index.reset(_data, _size);
+    return true;
+}
+
+namespace
+{
+
+size_t count_lines(const char * p, const char * end)
+{
+    size_t n = 0;
+    while ((p = static_cast<const char *>(memchr(p, '\n', end - p)))) {
+        ++n;
+        ++p;
+    }
+    return n;
+}
+
+} // anonymous namespace
+
+void ScriptFileReader::_consume(size_t end, size_t next)
+{
+    _newlines += count_lines(_data + _pos, _data + end);
+    _line_number = _newlines + 1;
+    _newlines += count_lines(_data + end, _data + next);
+    _pos = next;
+}
+
+ScriptFileReader::scan_result_t ScriptFileReader::_scan_statement(
+        size_t * start, size_t * end, size_t * next, bool * open)
+{
+    static const unsigned LIST_CHARS = StructuralIndex::PAREN
+            | StructuralIndex::QUOTE | StructuralIndex::NEWLINE;
+
+    _comments.clear();
+    *open = false;
+
+    // spaces and comments before the statement
+    size_t p = _pos;
+    while (true) {
+        p = _index.find_not(p, StructuralIndex::SPACE);
+        if (p >= _size) {
+            *start = *end = *next = p;
+            return scan_more;
+        }
+        if (_data[p] != ';') {
+            break;
+        }
+        if ((p = _index.find(p, StructuralIndex::NEWLINE)) >= _size) {
+            *start = *end = *next = p;
+            return scan_more;
+        }
+    }
+
+    *start = p;
+    int depth = 0;
+    char quote_char = '\0';
+    while (true) {
+        p = _index.find(p, LIST_CHARS);
+        if (p >= _size) {
+            *open = depth > 0;
+            *end = *next = _size;
+            return scan_more;
+        }
 
-        return true;
+        char c = _data[p];
+        if (c == '\\') {
+            // escapes the next char in quotes only
+            p += quote_char ? 2 : 1;
+            if (p > _size) {
+                *open = depth > 0;
+                *end = *next = _size;
+                return scan_more;
+            }
+        }
+        else if (c == '\'' || c == '"') {
+            if (!quote_char) {
+                quote_char = c;
+            }
+            else if (quote_char == c) {
+                quote_char = '\0';
+            }
+            ++p;
+        }
+        else if (c == '(') {
+            ++depth;
+            ++p;
+        }
+        else if (c == ')') {
+            if (!depth) {
+                *end = *next = p;
+                return scan_error;
+            }
+            if (!--depth) {
+                *end = *next = p + 1;
+                return scan_done;
+            }
+            ++p;
+        }
+        else if (!depth) {
+            // a newline ends atoms outside of lists
+            *end = p;
+            *next = p + 1;
+            return scan_done;
+        }
+        else {
+            // a comment line inside the list, quoted text is left alone
+            size_t q = _index.find_not(p + 1, StructuralIndex::SPACE);
+            if (q < _size && _data[q] == ';' && !quote_char) {
+                size_t eol = _index.find(q, StructuralIndex::NEWLINE);
+                if (eol >= _size) {
+                    *open = true;
+                    *end = *next = _size;
+                    return scan_more;
+                }
+                _comments.push_back(std::make_pair(q, eol));
+                p = eol;
+            }
+            else {
+                ++p;
+            }
+        }
     }
 }
 
+ssize_t ScriptFileReader::next_statement(const char ** stmt)
+{
+    size_t start = 0;
+    size_t end = 0;
+    size_t next = 0;
+    bool open = false;
+
+    scan_result_t r = scan_done;
+    while ((r = _scan_statement(&start, &end, &next, &open)) == scan_more
+            && !_end_of_input) {
+        // scanned again from `_pos', the data may have been moved
+        _fill(start >= _size);
+    }
+
+    if (r == scan_error) {
+        _consume(end, end);
+        return -1;
+    }
+
+    if (r == scan_more && (start >= _size || open)) {
+        // nothing but spaces and comments left, or an unclosed list
+        if (!open) {
+            _consume(_size, _size);
+        }
+        return -1;
+    }
+
+    _consume(end, next);
+    if (_comments.empty()) {
+        *stmt = _data + start;
+        return end - start;
+    }
+
+    _copy.clear();
+    size_t from = start;
+    for (size_t i = 0; i < _comments.size(); ++i) {
+        _copy.append(_data + from, _comments[i].first - from);
+        from = _comments[i].second;
+    }
+    _copy.append(_data + from, end - from);
+    *stmt = _copy.data();
+    return _copy.size();
+}
+
+ssize_t ScriptFileReader::next_chunk(const char ** chunk, bool primary_prompt)
+{
+    if (_pos >= _size) {
+        if (_end_of_input) {
+            return 0;
+        }
+
+        // everything consumed, the buffer is read into from its start
+        _pos = _size = 0;
+        if (!_fill(primary_prompt)) {
+            return 0;
+        }
+    }
+
+    *chunk = _data + _pos;
+    size_t length = _size - _pos;
+    _consume(_size, _size);
+    return length;
+}
+
 ssize_t ScriptFileReader::get_next_statement(char ** stmt_buf, ssize_t * stmt_buf_size)
 {
     int left_paren = 0;
@@ -119,6 +386,16 @@ ssize_t ScriptFileReader::get_next_statement(char ** stmt_buf, ssize_t * stmt_bu
                 bare_expr = true;
             }
             save_char(c, stmt_buf, stmt_buf_size, &stmt_offset);
+
+            // the following chars up to the next one handled above
+            size_t end = _line_index.find(_line_buf_offset,
+                    StructuralIndex::PAREN | StructuralIndex::QUOTE
+                            | StructuralIndex::NEWLINE);
+            if (end > _line_buf_offset) {
+                save_chars(_line + _line_buf_offset, end - _line_buf_offset,
+                        stmt_buf, stmt_buf_size, &stmt_offset);
+                _line_buf_offset = end;
+            }
         }
     }
 
@@ -127,49 +404,72 @@ ssize_t ScriptFileReader::get_next_statement(char ** stmt_buf, ssize_t * stmt_bu
 
 int ScriptFileReader::save_char(int c, char ** stmt_buf,
         ssize_t * stmt_buf_size, ssize_t * offset)
+{
+    char ch = c;
+    return save_chars(&ch, 1, stmt_buf, stmt_buf_size, offset);
+}
+
+int ScriptFileReader::save_chars(const char * chars, size_t n,
+        char ** stmt_buf, ssize_t * stmt_buf_size, ssize_t * offset)
 {
     static const size_t DELTA = 1024;
 
-    if (*offset < *stmt_buf_size - 1) {
-        (*stmt_buf)[*offset] = c;
-        (*stmt_buf)[*offset + 1] = '\0';
-        *offset += 1;
-        return 0;
-    }
+    if (*offset + static_cast<ssize_t>(n) >= *stmt_buf_size) {
+        // doubled, so long statements are not copied over and over
+        ssize_t size = *stmt_buf_size * 2;
+        if (size < static_cast<ssize_t>(*offset + n + DELTA)) {
+            size = *offset + n + DELTA;
+        }
+        char * ptr = (char *) realloc(*stmt_buf, size);
+        if (!ptr) {
+            return -1;
+        }
 
-    char * ptr = (char *) realloc(*stmt_buf, *stmt_buf_size + DELTA);
-    if (!ptr) {
-        return -1;
+        *stmt_buf = ptr;
+        *stmt_buf_size = size;
     }
 
-    *stmt_buf = ptr;
-    *stmt_buf_size = *stmt_buf_size + DELTA;
-    (*stmt_buf)[*offset] = c;
-    (*stmt_buf)[*offset + 1] = '\0';
-    *offset += 1;
+    memcpy(*stmt_buf + *offset, chars, n);
+    *offset += n;
+    (*stmt_buf)[*offset] = '\0';
     return 0;
 }
 
 int ScriptFileReader::get_next_char(bool skip_comment, int num_left_paren)
 {
-    int c = _line_buf[_line_buf_offset++];
+    int c = _line_buf_offset < _line_length ? _line[_line_buf_offset++] : 0;
     if (c) {
         return c;
     }
 
     _line_buf_offset = 0;
+    _line_length = 0;
     ssize_t input_len = 0;
     while (true) {
-        if (_filehandle == stdin) {
-            fprintf(stderr, "%s", InterpreterIF::prompt(num_left_paren == 0));
+        // the next line, read more input until it is complete
+        const void * newline = NULL;
+        size_t searched = 0;
+        while (!(newline = memchr(_data + _pos + searched, '\n',
+                _size - _pos - searched))) {
+            searched = _size - _pos;
+            if (!_fill(num_left_paren == 0)) {
+                break;
+            }
         }
 
-        input_len = getline(&_line_buf, &_line_buf_size, _filehandle);
-        ++_line_number;
-        if (input_len == -1) {
+        input_len = newline
+                ? static_cast<const char *>(newline) - (_data + _pos) + 1
+                : _size - _pos;
+        if (!input_len) {
+            input_len = -1;
             break;
         }
-        if (_line_buf[0] == '\n') {
+
+        _line = _data + _pos;
+        _line_length = input_len;
+        _pos += input_len;
+        ++_line_number;
+        if (_line[0] == '\n') {
             continue;
         }
 
@@ -180,12 +480,12 @@ int ScriptFileReader::get_next_char(bool skip_comment, int num_left_paren)
         // find first non-whitespace char
         ssize_t i = 0;
         for (; i < input_len; ++i) {
-            if (!isspace(_line_buf[i])) {
+            if (!isspace(_line[i])) {
                 break;
             }
         }
 
-        if (i == input_len - 1 || _line_buf[i] == ';' || _line_buf[i] == '\n') {
+        if (i >= input_len - 1 || _line[i] == ';' || _line[i] == '\n') {
             continue;
         }
         else {
@@ -195,10 +495,13 @@ int ScriptFileReader::get_next_char(bool skip_comment, int num_left_paren)
     }
 
     if (input_len == -1) {
+        _line_length = 0;
+        _line_index.reset(NULL, 0);
         return -1;
     }
 
-    return _line_buf[_line_buf_offset++];
+    _line_index.reset(_line, _line_length);
+    return _line[_line_buf_offset++];
 }
 
 } // namespace SolarWindLisp
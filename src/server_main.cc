@@ -0,0 +1,94 @@
+/*
+ * file name:           src/server_main.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 03:41:26 2026 CST
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "solarwindlisp.h"
+
+static volatile sig_atomic_t g_stopped = 0;
+
+static void on_signal(int signo)
+{
+    (void) signo;
+    g_stopped = 1;
+}
+
+static void usage(const char * prog)
+{
+    fprintf(stderr, "usage: %s [-w workers] [-f] [-s snapshot] socket-path "
+            "[script ...]\n"
+            "  -w  number of worker processes, the number of CPUs by default\n"
+            "  -f  freeze the global env before forking the workers\n"
+            "  -s  restore the global env from a heap snapshot\n", prog);
+}
+
+int main(int argc, char ** argv)
+{
+    size_t workers = 0;
+    bool freeze = false;
+    const char * snapshot = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "w:fs:h")) != -1) {
+        switch (opt) {
+        case 'w':
+            workers = strtoul(optarg, NULL, 10);
+            break;
+        case 'f':
+            freeze = true;
+            break;
+        case 's':
+            snapshot = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            exit(opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    const char * path = argv[optind++];
+
+    SolarWindLisp::SimpleInterpreter interpreter;
+    if (snapshot ? !interpreter.initialize(snapshot)
+            : !interpreter.initialize()) {
+        fprintf(stderr, "cannot initialize the interpreter\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = optind; i < argc; ++i) {
+        if (!interpreter.load_script(argv[i])) {
+            fprintf(stderr, "failed loading script `%s'\n", argv[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (freeze && !interpreter.freeze()) {
+        fprintf(stderr, "cannot freeze the global env\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    SolarWindLisp::WorkerPool pool(&interpreter, workers);
+    if (!pool.start()) {
+        fprintf(stderr, "cannot start the workers\n");
+        exit(EXIT_FAILURE);
+    }
+    fprintf(stderr, "%zu workers, listening on `%s'\n", pool.workers(), path);
+    bool ok = pool.serve(path, &g_stopped);
+    pool.stop();
+    exit(ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -14,6 +14,10 @@
 #include "future.h"
 #include "scoped_env.h"
 #include "proc.h"
+#include "pair.h"
+#include "vector.h"
+#include "hash_map.h"
+#include "persistent_map.h"
 #include "prim_proc.h"
 #include "interpreter.h"
 #include "random.h"
@@ -53,6 +57,12 @@ int main(int argc, char ** argv)
     print_sizeof(SolarWindLisp::PrimProcIF);
     print_sizeof(SolarWindLisp::Proc);
     print_sizeof(SolarWindLisp::Future);
+    print_sizeof(SolarWindLisp::Pair);
+    print_sizeof(SolarWindLisp::Vector);
+    print_sizeof(SolarWindLisp::HashMap);
+    print_sizeof(SolarWindLisp::PersistentMap);
+    print_sizeof(SolarWindLisp::PersistentMap::Node);
+    print_sizeof(SolarWindLisp::PersistentMap::Slot);
     print_sizeof(SolarWindLisp::ScopedEnv);
     print_sizeof(SolarWindLisp::MatterFactoryIF);
     print_sizeof(SolarWindLisp::SimpleMatterFactory);
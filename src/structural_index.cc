@@ -0,0 +1,204 @@
+/*
+ * file name:           src/structural_index.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 23:52:16 2026 CST
+ */
+
+#include <string.h>
+#include "structural_index.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SWL_X86_KERNELS 1
+#include <immintrin.h>
+// only the AVX2 classifier is compiled for AVX2, the rest of the program is not
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// scalar, works everywhere
+
+struct ClassTable
+{
+    unsigned char table[256];
+
+    ClassTable()
+    {
+        memset(table, 0, sizeof(table));
+        table[static_cast<unsigned char>('(')] = StructuralIndex::PAREN;
+        table[static_cast<unsigned char>(')')] = StructuralIndex::PAREN;
+        table[static_cast<unsigned char>('\'')] = StructuralIndex::QUOTE;
+        table[static_cast<unsigned char>('"')] = StructuralIndex::QUOTE;
+        table[static_cast<unsigned char>('\\')] = StructuralIndex::QUOTE;
+        table[static_cast<unsigned char>(';')] = StructuralIndex::COMMENT;
+        const char * spaces = " \t\v\f";
+        for (const char * p = spaces; *p; ++p) {
+            table[static_cast<unsigned char>(*p)] = StructuralIndex::SPACE;
+        }
+        table[static_cast<unsigned char>('\r')] =
+                StructuralIndex::SPACE | StructuralIndex::NEWLINE;
+        table[static_cast<unsigned char>('\n')] =
+                StructuralIndex::SPACE | StructuralIndex::NEWLINE;
+    }
+};
+
+const ClassTable g_class_table;
+
+void scalar_classify(const char * block,
+        uint64_t masks[StructuralIndex::NUM_OF_CLASSES])
+{
+    for (int k = 0; k < StructuralIndex::NUM_OF_CLASSES; ++k) {
+        masks[k] = 0;
+    }
+
+    for (size_t i = 0; i < StructuralIndex::BLOCK_SIZE; ++i) {
+        unsigned t = g_class_table.table[static_cast<unsigned char>(block[i])];
+        for (int k = 0; t; ++k, t >>= 1) {
+            masks[k] |= static_cast<uint64_t>(t & 1) << i;
+        }
+    }
+}
+
+#ifdef SWL_X86_KERNELS
+
+//----------------------------------------------------------------------------
+// SSE2, 16 bytes per compare
+
+inline void sse2_classify16(__m128i c, int shift,
+        uint64_t masks[StructuralIndex::NUM_OF_CLASSES])
+{
+    __m128i paren = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('(')),
+            _mm_cmpeq_epi8(c, _mm_set1_epi8(')')));
+    __m128i quote = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\'')),
+            _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('"')),
+                    _mm_cmpeq_epi8(c, _mm_set1_epi8('\\'))));
+    __m128i newline = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n')),
+            _mm_cmpeq_epi8(c, _mm_set1_epi8('\r')));
+    // \t \n \v \f \r are 9 to 13, i.e. c - 9 <= 4 unsigned
+    __m128i t = _mm_sub_epi8(c, _mm_set1_epi8(9));
+    __m128i space = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')),
+            _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(4)), t));
+    __m128i comment = _mm_cmpeq_epi8(c, _mm_set1_epi8(';'));
+
+    typedef uint64_t u64;
+    masks[StructuralIndex::class_paren] |=
+            static_cast<u64>(_mm_movemask_epi8(paren) & 0xffff) << shift;
+    masks[StructuralIndex::class_quote] |=
+            static_cast<u64>(_mm_movemask_epi8(quote) & 0xffff) << shift;
+    masks[StructuralIndex::class_space] |=
+            static_cast<u64>(_mm_movemask_epi8(space) & 0xffff) << shift;
+    masks[StructuralIndex::class_newline] |=
+            static_cast<u64>(_mm_movemask_epi8(newline) & 0xffff) << shift;
+    masks[StructuralIndex::class_comment] |=
+            static_cast<u64>(_mm_movemask_epi8(comment) & 0xffff) << shift;
+}
+
+void sse2_classify(const char * block,
+        uint64_t masks[StructuralIndex::NUM_OF_CLASSES])
+{
+    for (int k = 0; k < StructuralIndex::NUM_OF_CLASSES; ++k) {
+        masks[k] = 0;
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        sse2_classify16(
+                _mm_loadu_si128((const __m128i *) (block + 16 * i)), 16 * i,
+                masks);
+    }
+}
+
+//----------------------------------------------------------------------------
+// AVX2, 32 bytes per compare
+
+TARGET_AVX2 inline void avx2_classify32(__m256i c, int shift,
+        uint64_t masks[StructuralIndex::NUM_OF_CLASSES])
+{
+    __m256i paren = _mm256_or_si256(
+            _mm256_cmpeq_epi8(c, _mm256_set1_epi8('(')),
+            _mm256_cmpeq_epi8(c, _mm256_set1_epi8(')')));
+    __m256i quote = _mm256_or_si256(
+            _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\'')),
+            _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('"')),
+                    _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\\'))));
+    __m256i newline = _mm256_or_si256(
+            _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n')),
+            _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\r')));
+    __m256i t = _mm256_sub_epi8(c, _mm256_set1_epi8(9));
+    __m256i space = _mm256_or_si256(
+            _mm256_cmpeq_epi8(c, _mm256_set1_epi8(' ')),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(4)), t));
+    __m256i comment = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(';'));
+
+    typedef uint64_t u64;
+    typedef uint32_t u32;
+    masks[StructuralIndex::class_paren] |=
+            static_cast<u64>(static_cast<u32>(_mm256_movemask_epi8(paren)))
+                    << shift;
+    masks[StructuralIndex::class_quote] |=
+            static_cast<u64>(static_cast<u32>(_mm256_movemask_epi8(quote)))
+                    << shift;
+    masks[StructuralIndex::class_space] |=
+            static_cast<u64>(static_cast<u32>(_mm256_movemask_epi8(space)))
+                    << shift;
+    masks[StructuralIndex::class_newline] |=
+            static_cast<u64>(static_cast<u32>(_mm256_movemask_epi8(newline)))
+                    << shift;
+    masks[StructuralIndex::class_comment] |=
+            static_cast<u64>(static_cast<u32>(_mm256_movemask_epi8(comment)))
+                    << shift;
+}
+
+TARGET_AVX2 void avx2_classify(const char * block,
+        uint64_t masks[StructuralIndex::NUM_OF_CLASSES])
+{
+    for (int k = 0; k < StructuralIndex::NUM_OF_CLASSES; ++k) {
+        masks[k] = 0;
+    }
+
+    avx2_classify32(_mm256_loadu_si256((const __m256i *) block), 0, masks);
+    avx2_classify32(_mm256_loadu_si256((const __m256i *) (block + 32)), 32,
+            masks);
+}
+
+#endif // SWL_X86_KERNELS
+
+const StructuralIndex::classify_func classifiers[VectorKernels::NUM_OF_ISAS] = {
+    scalar_classify,
+#ifdef SWL_X86_KERNELS
+    sse2_classify,
+    avx2_classify,
+#endif
+};
+
+} // anonymous namespace
+
+StructuralIndex::classify_func StructuralIndex::classifier(
+        VectorKernels::isa_t isa)
+{
+    VectorKernels::isa_t best = VectorKernels::best_isa();
+    return classifiers[isa < best ? isa : best];
+}
+
+void StructuralIndex::_load(size_t base)
+{
+    _base = base;
+    if (base + BLOCK_SIZE <= _length) {
+        _classify(_input + base, _masks);
+        return;
+    }
+
+    // the last block, padded with NUL which is of no class
+    char block[BLOCK_SIZE];
+    memset(block, 0, sizeof(block));
+    memcpy(block, _input + base, _length - base);
+    _classify(block, _masks);
+}
+
+} // namespace SolarWindLisp
@@ -0,0 +1,193 @@
+/*
+ * file name:           src/symbol_table.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 23:58:41 2026 CST
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include "symbol_table.h"
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+// FNV-1a, finished like the hashes of HashMap, never 0
+uint64_t hash_text(const char * text, size_t length)
+{
+    const unsigned char * p = reinterpret_cast<const unsigned char *>(text);
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; ++i) {
+        h = (h ^ p[i]) * 0x100000001b3ULL;
+    }
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h ? h : 1;
+}
+
+} // anonymous namespace
+
+SymbolTable & SymbolTable::global()
+{
+    // thread-safe initialization of local statics is guaranteed by C++11
+    static SymbolTable * table = new SymbolTable();
+    return *table;
+}
+
+SymbolTable::SymbolTable()
+{
+}
+
+SymbolTable::~SymbolTable()
+{
+    for (size_t i = 0; i < NUM_OF_SHARDS; ++i) {
+        Shard &shard = _shards[i];
+        delete[] shard.hashes;
+        delete[] shard.texts;
+        delete[] shard.lengths;
+        for (size_t k = 0; k < shard.blocks.size(); ++k) {
+            free(shard.blocks[k]);
+        }
+    }
+}
+
+const char * SymbolTable::intern(const char * text, size_t length)
+{
+    if (length > UINT32_MAX) {
+        return NULL;
+    }
+
+    uint64_t hash = hash_text(text, length);
+    // the high bits choose the shard, the low bits the slot
+    Shard &shard = _shards[hash >> 58];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.find_or_add(hash, text, static_cast<uint32_t>(length));
+}
+
+size_t SymbolTable::size() const
+{
+    size_t result = 0;
+    for (size_t i = 0; i < NUM_OF_SHARDS; ++i) {
+        std::lock_guard<std::mutex> guard(_shards[i].lock);
+        result += _shards[i].size;
+    }
+    return result;
+}
+
+size_t SymbolTable::bytes() const
+{
+    size_t result = 0;
+    for (size_t i = 0; i < NUM_OF_SHARDS; ++i) {
+        const Shard &shard = _shards[i];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        result += shard.bytes + shard.capacity
+                * (sizeof(uint64_t) + sizeof(const char *) + sizeof(uint32_t));
+    }
+    return result;
+}
+
+const char * SymbolTable::Shard::find_or_add(uint64_t hash, const char * text,
+        uint32_t length)
+{
+    if ((size + 1) > capacity / 4 * 3
+            && !rehash(capacity ? capacity * 2 : _MIN_CAPACITY)) {
+        return NULL;
+    }
+
+    size_t mask = capacity - 1;
+    size_t idx = static_cast<size_t>(hash) & mask;
+    while (hashes[idx]) {
+        if (hashes[idx] == hash && lengths[idx] == length
+                && !memcmp(texts[idx], text, length)) {
+            return texts[idx];
+        }
+        idx = (idx + 1) & mask;
+    }
+
+    char * copy = allocate(length + 1);
+    if (!copy) {
+        return NULL;
+    }
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+
+    hashes[idx] = hash;
+    texts[idx] = copy;
+    lengths[idx] = length;
+    ++size;
+    return copy;
+}
+
+bool SymbolTable::Shard::rehash(size_t new_capacity)
+{
+    uint64_t * new_hashes = new (std::nothrow) uint64_t[new_capacity];
+    const char ** new_texts = new (std::nothrow) const char *[new_capacity];
+    uint32_t * new_lengths = new (std::nothrow) uint32_t[new_capacity];
+    if (!new_hashes || !new_texts || !new_lengths) {
+        delete[] new_hashes;
+        delete[] new_texts;
+        delete[] new_lengths;
+        return false;
+    }
+    memset(new_hashes, 0, new_capacity * sizeof(uint64_t));
+
+    size_t mask = new_capacity - 1;
+    for (size_t i = 0; i < capacity; ++i) {
+        if (hashes[i]) {
+            size_t idx = static_cast<size_t>(hashes[i]) & mask;
+            while (new_hashes[idx]) {
+                idx = (idx + 1) & mask;
+            }
+            new_hashes[idx] = hashes[i];
+            new_texts[idx] = texts[i];
+            new_lengths[idx] = lengths[i];
+        }
+    }
+
+    delete[] hashes;
+    delete[] texts;
+    delete[] lengths;
+    hashes = new_hashes;
+    texts = new_texts;
+    lengths = new_lengths;
+    capacity = new_capacity;
+    return true;
+}
+
+char * SymbolTable::Shard::allocate(size_t n)
+{
+    if (n > _BLOCK_SIZE / 4) {
+        // a block of its own, before the one being filled
+        char * p = (char *) malloc(n);
+        if (p) {
+            blocks.insert(blocks.end() - (blocks.empty() ? 0 : 1), p);
+            bytes += n;
+        }
+        return p;
+    }
+
+    if (block_used + n > _BLOCK_SIZE) {
+        char * p = (char *) malloc(_BLOCK_SIZE);
+        if (!p) {
+            return NULL;
+        }
+        blocks.push_back(p);
+        block_used = 0;
+        bytes += _BLOCK_SIZE;
+    }
+
+    char * p = blocks.back() + block_used;
+    block_used += n;
+    return p;
+}
+
+} // namespace SolarWindLisp
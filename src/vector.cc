@@ -0,0 +1,87 @@
+/*
+ * file name:           src/vector.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 16:25:09 2026 CST
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <sstream>
+#include "vector.h"
+#include "utils.h"
+
+namespace SolarWindLisp
+{
+
+VectorPtr Vector::create(elem_type_t elem_type, size_t size)
+{
+    Vector * result = new (std::nothrow) Vector(elem_type);
+    if (!result) {
+        return NULL;
+    }
+
+    // sizeof(int64_t) == sizeof(double), the bytes rounded up must not
+    // overflow either
+    if (size > (static_cast<size_t>(-1) - (VECTOR_ALIGNMENT - 1))
+            / sizeof(int64_t)) {
+        delete result;
+        return NULL;
+    }
+
+    // round up, so kernels may read whole registers near the end safely
+    size_t bytes = (size * sizeof(int64_t) + VECTOR_ALIGNMENT - 1)
+            & ~(VECTOR_ALIGNMENT - 1);
+    if (bytes) {
+        if (posix_memalign(&result->_data, VECTOR_ALIGNMENT, bytes)) {
+            result->_data = NULL;
+            delete result;
+            return NULL;
+        }
+        memset(result->_data, 0, bytes);
+    }
+
+    result->_size = size;
+    return VectorPtr(result);
+}
+
+Vector::~Vector()
+{
+    if (_data) {
+        free(_data);
+    }
+}
+
+std::string Vector::debug_string(bool compact, int level,
+        const char * indent_seq) const
+{
+    std::string indent = compact ? "" : Utils::Misc::repeat(indent_seq, level);
+
+    std::stringstream ss;
+    ss << indent << "Vector{" << (is_i64() ? "i64" : "double") << ","
+            << _size << "," << to_string() << "}";
+    return ss.str();
+}
+
+std::string Vector::to_string() const
+{
+    std::stringstream ss;
+    ss << "[";
+    for (size_t i = 0; i < _size; ++i) {
+        if (i) {
+            ss << " ";
+        }
+        if (is_i64()) {
+            ss << i64_data()[i];
+        }
+        else {
+            ss << double_data()[i];
+        }
+    }
+    ss << "]";
+    return ss.str();
+}
+
+} // namespace SolarWindLisp
@@ -0,0 +1,842 @@
+/*
+ * file name:           src/vector_kernels.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Mon Oct 19 16:25:09 2026 CST
+ */
+
+#include "vector_kernels.h"
+#include "gnu_attributes.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SWL_X86_KERNELS 1
+#include <immintrin.h>
+// only the AVX2 kernels are compiled for AVX2, the rest of the program is not
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// scalar, works everywhere
+
+// the type to compute in: 64-bit integers wrap around on overflow, as the
+// SIMD lanes do, so they are computed as unsigned, signed overflow would be
+// undefined behavior
+template<typename T>
+struct Wrapping
+{
+    typedef T type;
+};
+
+template<>
+struct Wrapping<int64_t>
+{
+    typedef uint64_t type;
+};
+
+template<typename T>
+T scalar_sum(const T * a, size_t n)
+{
+    typedef typename Wrapping<T>::type W;
+    W s = 0;
+    for (size_t i = 0; i < n; ++i) {
+        s += static_cast<W>(a[i]);
+    }
+    return static_cast<T>(s);
+}
+
+template<typename T>
+T scalar_dot(const T * a, const T * b, size_t n)
+{
+    typedef typename Wrapping<T>::type W;
+    W s = 0;
+    for (size_t i = 0; i < n; ++i) {
+        s += static_cast<W>(a[i]) * static_cast<W>(b[i]);
+    }
+    return static_cast<T>(s);
+}
+
+inline bool is_nan(int64_t v UNUSED)
+{
+    return false;
+}
+
+inline bool is_nan(double v)
+{
+    return v != v;
+}
+
+// the first NaN if there is any, in every version
+template<typename T>
+T scalar_min(const T * a, size_t n)
+{
+    T m = a[0];
+    for (size_t i = 0; i < n; ++i) {
+        if (is_nan(a[i])) {
+            return a[i];
+        }
+        if (a[i] < m) {
+            m = a[i];
+        }
+    }
+    return m;
+}
+
+template<typename T>
+T scalar_max(const T * a, size_t n)
+{
+    T m = a[0];
+    for (size_t i = 0; i < n; ++i) {
+        if (is_nan(a[i])) {
+            return a[i];
+        }
+        if (a[i] > m) {
+            m = a[i];
+        }
+    }
+    return m;
+}
+
+template<typename T>
+void scalar_add(const T * a, const T * b, T * out, size_t n)
+{
+    typedef typename Wrapping<T>::type W;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<T>(static_cast<W>(a[i]) + static_cast<W>(b[i]));
+    }
+}
+
+template<typename T>
+void scalar_scale(const T * a, T k, T * out, size_t n)
+{
+    typedef typename Wrapping<T>::type W;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<T>(static_cast<W>(a[i]) * static_cast<W>(k));
+    }
+}
+
+template<typename T>
+void scalar_sub(const T * a, const T * b, T * out, size_t n)
+{
+    typedef typename Wrapping<T>::type W;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<T>(static_cast<W>(a[i]) - static_cast<W>(b[i]));
+    }
+}
+
+template<typename T>
+void scalar_mul(const T * a, const T * b, T * out, size_t n)
+{
+    typedef typename Wrapping<T>::type W;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<T>(static_cast<W>(a[i]) * static_cast<W>(b[i]));
+    }
+}
+
+template<typename T>
+void scalar_div(const T * a, const T * b, T * out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i] / b[i];
+    }
+}
+
+template<typename T>
+void scalar_cmp(const T * a, const T * b, VectorKernels::cmp_op_t op,
+        uint8_t * out, size_t n)
+{
+    // the switch out of the loops, so each one is vectorized by itself
+    switch (op) {
+        case VectorKernels::cmp_eq:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = a[i] == b[i];
+            }
+            break;
+        case VectorKernels::cmp_ne:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = a[i] != b[i];
+            }
+            break;
+        case VectorKernels::cmp_lt:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = a[i] < b[i];
+            }
+            break;
+        case VectorKernels::cmp_le:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = a[i] <= b[i];
+            }
+            break;
+        case VectorKernels::cmp_gt:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = a[i] > b[i];
+            }
+            break;
+        default:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = a[i] >= b[i];
+            }
+            break;
+    }
+}
+
+// the lowest `lanes' bits of `mask' to bytes, 1 or 0
+inline void mask_to_bytes(int mask, uint8_t * out, size_t lanes)
+{
+    for (size_t l = 0; l < lanes; ++l) {
+        out[l] = (mask >> l) & 1;
+    }
+}
+
+#ifdef SWL_X86_KERNELS
+
+//----------------------------------------------------------------------------
+// SSE2, always available on x86_64; there is no 64-bit integer multiply nor
+// compare, so i64 dot, scale, min and max use the scalar versions.
+
+int64_t sse2_sum_i64(const int64_t * a, size_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        acc = _mm_add_epi64(acc, _mm_loadu_si128((const __m128i *) (a + i)));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i *) lanes, acc);
+    uint64_t s = lanes[0] + lanes[1];
+    for (; i < n; ++i) {
+        s += static_cast<uint64_t>(a[i]);
+    }
+    return static_cast<int64_t>(s);
+}
+
+double sse2_sum_f64(const double * a, size_t n)
+{
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(a + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(a + i + 2));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    double s = lanes[0] + lanes[1];
+    for (; i < n; ++i) {
+        s += a[i];
+    }
+    return s;
+}
+
+double sse2_dot_f64(const double * a, const double * b, size_t n)
+{
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0,
+                _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        acc1 = _mm_add_pd(acc1,
+                _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    double s = lanes[0] + lanes[1];
+    for (; i < n; ++i) {
+        s += a[i] * b[i];
+    }
+    return s;
+}
+
+double sse2_min_f64(const double * a, size_t n)
+{
+    size_t i = 0;
+    double m = a[0];
+    if (n >= 2) {
+        // _mm_min_pd() returns the second operand if either is a NaN
+        __m128d acc = _mm_loadu_pd(a);
+        __m128d nan = _mm_cmpunord_pd(acc, acc);
+        for (i = 2; i + 2 <= n; i += 2) {
+            __m128d v = _mm_loadu_pd(a + i);
+            acc = _mm_min_pd(acc, v);
+            nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+        }
+        if (_mm_movemask_pd(nan)) {
+            return scalar_min(a, n);
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, acc);
+        m = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+    }
+    for (; i < n; ++i) {
+        if (is_nan(a[i])) {
+            return a[i];
+        }
+        if (a[i] < m) {
+            m = a[i];
+        }
+    }
+    return m;
+}
+
+double sse2_max_f64(const double * a, size_t n)
+{
+    size_t i = 0;
+    double m = a[0];
+    if (n >= 2) {
+        // _mm_max_pd() returns the second operand if either is a NaN
+        __m128d acc = _mm_loadu_pd(a);
+        __m128d nan = _mm_cmpunord_pd(acc, acc);
+        for (i = 2; i + 2 <= n; i += 2) {
+            __m128d v = _mm_loadu_pd(a + i);
+            acc = _mm_max_pd(acc, v);
+            nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+        }
+        if (_mm_movemask_pd(nan)) {
+            return scalar_max(a, n);
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, acc);
+        m = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+    }
+    for (; i < n; ++i) {
+        if (is_nan(a[i])) {
+            return a[i];
+        }
+        if (a[i] > m) {
+            m = a[i];
+        }
+    }
+    return m;
+}
+
+void sse2_add_i64(const int64_t * a, const int64_t * b, int64_t * out,
+        size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_si128((__m128i *) (out + i),
+                _mm_add_epi64(_mm_loadu_si128((const __m128i *) (a + i)),
+                        _mm_loadu_si128((const __m128i *) (b + i))));
+    }
+    scalar_add(a + i, b + i, out + i, n - i);
+}
+
+void sse2_add_f64(const double * a, const double * b, double * out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(out + i,
+                _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    for (; i < n; ++i) {
+        out[i] = a[i] + b[i];
+    }
+}
+
+void sse2_scale_f64(const double * a, double k, double * out, size_t n)
+{
+    __m128d kk = _mm_set1_pd(k);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), kk));
+    }
+    for (; i < n; ++i) {
+        out[i] = a[i] * k;
+    }
+}
+
+void sse2_sub_i64(const int64_t * a, const int64_t * b, int64_t * out,
+        size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_si128((__m128i *) (out + i),
+                _mm_sub_epi64(_mm_loadu_si128((const __m128i *) (a + i)),
+                        _mm_loadu_si128((const __m128i *) (b + i))));
+    }
+    scalar_sub(a + i, b + i, out + i, n - i);
+}
+
+#define SSE2_BINARY_F64(name, intrinsic, op)                            \
+void sse2_##name##_f64(const double * a, const double * b, double * out, \
+        size_t n)                                                       \
+{                                                                       \
+    size_t i = 0;                                                       \
+    for (; i + 2 <= n; i += 2) {                                        \
+        _mm_storeu_pd(out + i,                                          \
+                intrinsic(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));   \
+    }                                                                   \
+    for (; i < n; ++i) {                                                \
+        out[i] = a[i] op b[i];                                          \
+    }                                                                   \
+}
+SSE2_BINARY_F64(sub, _mm_sub_pd, -)
+SSE2_BINARY_F64(mul, _mm_mul_pd, *)
+SSE2_BINARY_F64(div, _mm_div_pd, /)
+#undef SSE2_BINARY_F64
+
+template<int op>
+inline __m128d sse2_compare(__m128d x, __m128d y)
+{
+    switch (op) {
+        case VectorKernels::cmp_eq:
+            return _mm_cmpeq_pd(x, y);
+        case VectorKernels::cmp_ne:
+            return _mm_cmpneq_pd(x, y);
+        case VectorKernels::cmp_lt:
+            return _mm_cmplt_pd(x, y);
+        case VectorKernels::cmp_le:
+            return _mm_cmple_pd(x, y);
+        case VectorKernels::cmp_gt:
+            return _mm_cmpgt_pd(x, y);
+        default:
+            return _mm_cmpge_pd(x, y);
+    }
+}
+
+template<int op>
+void sse2_cmp_f64_loop(const double * a, const double * b, uint8_t * out,
+        size_t n)
+{
+    for (size_t i = 0; i + 2 <= n; i += 2) {
+        mask_to_bytes(_mm_movemask_pd(sse2_compare<op>(_mm_loadu_pd(a + i),
+                _mm_loadu_pd(b + i))), out + i, 2);
+    }
+}
+
+void sse2_cmp_f64(const double * a, const double * b,
+        VectorKernels::cmp_op_t op, uint8_t * out, size_t n)
+{
+    switch (op) {
+        case VectorKernels::cmp_eq:
+            sse2_cmp_f64_loop<VectorKernels::cmp_eq>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_ne:
+            sse2_cmp_f64_loop<VectorKernels::cmp_ne>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_lt:
+            sse2_cmp_f64_loop<VectorKernels::cmp_lt>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_le:
+            sse2_cmp_f64_loop<VectorKernels::cmp_le>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_gt:
+            sse2_cmp_f64_loop<VectorKernels::cmp_gt>(a, b, out, n);
+            break;
+        default:
+            sse2_cmp_f64_loop<VectorKernels::cmp_ge>(a, b, out, n);
+            break;
+    }
+    size_t done = n & ~static_cast<size_t>(1);
+    scalar_cmp(a + done, b + done, op, out + done, n - done);
+}
+
+//----------------------------------------------------------------------------
+// AVX2, four lanes of 64 bits; i64 dot and scale still use the scalar
+// versions, since there is no 64-bit integer multiply before AVX-512.
+
+TARGET_AVX2 int64_t avx2_sum_i64(const int64_t * a, size_t n)
+{
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_epi64(acc0,
+                _mm256_loadu_si256((const __m256i *) (a + i)));
+        acc1 = _mm256_add_epi64(acc1,
+                _mm256_loadu_si256((const __m256i *) (a + i + 4)));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *) lanes, _mm256_add_epi64(acc0, acc1));
+    uint64_t s = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i) {
+        s += static_cast<uint64_t>(a[i]);
+    }
+    return static_cast<int64_t>(s);
+}
+
+TARGET_AVX2 double avx2_sum_f64(const double * a, size_t n)
+{
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(a + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(a + i + 4));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    double s = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; ++i) {
+        s += a[i];
+    }
+    return s;
+}
+
+TARGET_AVX2 double avx2_dot_f64(const double * a, const double * b, size_t n)
+{
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0,
+                _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        acc1 = _mm256_add_pd(acc1,
+                _mm256_mul_pd(_mm256_loadu_pd(a + i + 4),
+                        _mm256_loadu_pd(b + i + 4)));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    double s = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; ++i) {
+        s += a[i] * b[i];
+    }
+    return s;
+}
+
+TARGET_AVX2 int64_t avx2_min_i64(const int64_t * a, size_t n)
+{
+    size_t i = 0;
+    int64_t m = a[0];
+    if (n >= 4) {
+        __m256i acc = _mm256_loadu_si256((const __m256i *) a);
+        for (i = 4; i + 4 <= n; i += 4) {
+            __m256i v = _mm256_loadu_si256((const __m256i *) (a + i));
+            acc = _mm256_blendv_epi8(acc, v, _mm256_cmpgt_epi64(acc, v));
+        }
+        int64_t lanes[4];
+        _mm256_storeu_si256((__m256i *) lanes, acc);
+        m = scalar_min(lanes, 4);
+    }
+    for (; i < n; ++i) {
+        if (a[i] < m) {
+            m = a[i];
+        }
+    }
+    return m;
+}
+
+TARGET_AVX2 int64_t avx2_max_i64(const int64_t * a, size_t n)
+{
+    size_t i = 0;
+    int64_t m = a[0];
+    if (n >= 4) {
+        __m256i acc = _mm256_loadu_si256((const __m256i *) a);
+        for (i = 4; i + 4 <= n; i += 4) {
+            __m256i v = _mm256_loadu_si256((const __m256i *) (a + i));
+            acc = _mm256_blendv_epi8(acc, v, _mm256_cmpgt_epi64(v, acc));
+        }
+        int64_t lanes[4];
+        _mm256_storeu_si256((__m256i *) lanes, acc);
+        m = scalar_max(lanes, 4);
+    }
+    for (; i < n; ++i) {
+        if (a[i] > m) {
+            m = a[i];
+        }
+    }
+    return m;
+}
+
+TARGET_AVX2 double avx2_min_f64(const double * a, size_t n)
+{
+    size_t i = 0;
+    double m = a[0];
+    if (n >= 4) {
+        __m256d acc = _mm256_loadu_pd(a);
+        __m256d nan = _mm256_cmp_pd(acc, acc, _CMP_UNORD_Q);
+        for (i = 4; i + 4 <= n; i += 4) {
+            __m256d v = _mm256_loadu_pd(a + i);
+            acc = _mm256_min_pd(acc, v);
+            nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+        }
+        if (_mm256_movemask_pd(nan)) {
+            return scalar_min(a, n);
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, acc);
+        m = scalar_min(lanes, 4);
+    }
+    for (; i < n; ++i) {
+        if (is_nan(a[i])) {
+            return a[i];
+        }
+        if (a[i] < m) {
+            m = a[i];
+        }
+    }
+    return m;
+}
+
+TARGET_AVX2 double avx2_max_f64(const double * a, size_t n)
+{
+    size_t i = 0;
+    double m = a[0];
+    if (n >= 4) {
+        __m256d acc = _mm256_loadu_pd(a);
+        __m256d nan = _mm256_cmp_pd(acc, acc, _CMP_UNORD_Q);
+        for (i = 4; i + 4 <= n; i += 4) {
+            __m256d v = _mm256_loadu_pd(a + i);
+            acc = _mm256_max_pd(acc, v);
+            nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+        }
+        if (_mm256_movemask_pd(nan)) {
+            return scalar_max(a, n);
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, acc);
+        m = scalar_max(lanes, 4);
+    }
+    for (; i < n; ++i) {
+        if (is_nan(a[i])) {
+            return a[i];
+        }
+        if (a[i] > m) {
+            m = a[i];
+        }
+    }
+    return m;
+}
+
+TARGET_AVX2 void avx2_add_i64(const int64_t * a, const int64_t * b,
+        int64_t * out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_si256((__m256i *) (out + i),
+                _mm256_add_epi64(_mm256_loadu_si256((const __m256i *) (a + i)),
+                        _mm256_loadu_si256((const __m256i *) (b + i))));
+    }
+    scalar_add(a + i, b + i, out + i, n - i);
+}
+
+TARGET_AVX2 void avx2_add_f64(const double * a, const double * b,
+        double * out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i,
+                _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    for (; i < n; ++i) {
+        out[i] = a[i] + b[i];
+    }
+}
+
+TARGET_AVX2 void avx2_scale_f64(const double * a, double k, double * out,
+        size_t n)
+{
+    __m256d kk = _mm256_set1_pd(k);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), kk));
+    }
+    for (; i < n; ++i) {
+        out[i] = a[i] * k;
+    }
+}
+
+TARGET_AVX2 void avx2_sub_i64(const int64_t * a, const int64_t * b,
+        int64_t * out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_si256((__m256i *) (out + i),
+                _mm256_sub_epi64(_mm256_loadu_si256((const __m256i *) (a + i)),
+                        _mm256_loadu_si256((const __m256i *) (b + i))));
+    }
+    scalar_sub(a + i, b + i, out + i, n - i);
+}
+
+#define AVX2_BINARY_F64(name, intrinsic, op)                            \
+TARGET_AVX2 void avx2_##name##_f64(const double * a, const double * b,  \
+        double * out, size_t n)                                         \
+{                                                                       \
+    size_t i = 0;                                                       \
+    for (; i + 4 <= n; i += 4) {                                        \
+        _mm256_storeu_pd(out + i,                                       \
+                intrinsic(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i))); \
+    }                                                                   \
+    for (; i < n; ++i) {                                                \
+        out[i] = a[i] op b[i];                                          \
+    }                                                                   \
+}
+AVX2_BINARY_F64(sub, _mm256_sub_pd, -)
+AVX2_BINARY_F64(mul, _mm256_mul_pd, *)
+AVX2_BINARY_F64(div, _mm256_div_pd, /)
+#undef AVX2_BINARY_F64
+
+// `predicate' of _mm256_cmp_pd(), ordered but for `!=', like C
+template<int predicate>
+TARGET_AVX2 void avx2_cmp_f64_loop(const double * a, const double * b,
+        uint8_t * out, size_t n)
+{
+    for (size_t i = 0; i + 4 <= n; i += 4) {
+        mask_to_bytes(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i),
+                _mm256_loadu_pd(b + i), predicate)), out + i, 4);
+    }
+}
+
+TARGET_AVX2 void avx2_cmp_f64(const double * a, const double * b,
+        VectorKernels::cmp_op_t op, uint8_t * out, size_t n)
+{
+    switch (op) {
+        case VectorKernels::cmp_eq:
+            avx2_cmp_f64_loop<_CMP_EQ_OQ>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_ne:
+            avx2_cmp_f64_loop<_CMP_NEQ_UQ>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_lt:
+            avx2_cmp_f64_loop<_CMP_LT_OQ>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_le:
+            avx2_cmp_f64_loop<_CMP_LE_OQ>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_gt:
+            avx2_cmp_f64_loop<_CMP_GT_OQ>(a, b, out, n);
+            break;
+        default:
+            avx2_cmp_f64_loop<_CMP_GE_OQ>(a, b, out, n);
+            break;
+    }
+    size_t done = n & ~static_cast<size_t>(3);
+    scalar_cmp(a + done, b + done, op, out + done, n - done);
+}
+
+// there are only `==' and `>' for 64-bit integers, the others are derived,
+// `negate' the mask for `!=', `<=' and `>='
+template<bool swap, bool equal, bool negate>
+TARGET_AVX2 void avx2_cmp_i64_loop(const int64_t * a, const int64_t * b,
+        uint8_t * out, size_t n)
+{
+    for (size_t i = 0; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *) (b + i));
+        __m256i m = equal ? _mm256_cmpeq_epi64(x, y)
+                : swap ? _mm256_cmpgt_epi64(y, x) : _mm256_cmpgt_epi64(x, y);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(m));
+        mask_to_bytes(negate ? ~mask : mask, out + i, 4);
+    }
+}
+
+TARGET_AVX2 void avx2_cmp_i64(const int64_t * a, const int64_t * b,
+        VectorKernels::cmp_op_t op, uint8_t * out, size_t n)
+{
+    switch (op) {
+        case VectorKernels::cmp_eq:
+            avx2_cmp_i64_loop<false, true, false>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_ne:
+            avx2_cmp_i64_loop<false, true, true>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_lt:
+            avx2_cmp_i64_loop<true, false, false>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_le:
+            avx2_cmp_i64_loop<false, false, true>(a, b, out, n);
+            break;
+        case VectorKernels::cmp_gt:
+            avx2_cmp_i64_loop<false, false, false>(a, b, out, n);
+            break;
+        default:
+            avx2_cmp_i64_loop<true, false, true>(a, b, out, n);
+            break;
+    }
+    size_t done = n & ~static_cast<size_t>(3);
+    scalar_cmp(a + done, b + done, op, out + done, n - done);
+}
+
+#endif // SWL_X86_KERNELS
+
+const VectorKernels kernel_tables[VectorKernels::NUM_OF_ISAS] = {
+    {
+        VectorKernels::isa_scalar,
+        scalar_sum<int64_t>, scalar_sum<double>,
+        scalar_dot<int64_t>, scalar_dot<double>,
+        scalar_min<int64_t>, scalar_min<double>,
+        scalar_max<int64_t>, scalar_max<double>,
+        scalar_add<int64_t>, scalar_add<double>,
+        scalar_scale<int64_t>, scalar_scale<double>,
+        scalar_sub<int64_t>, scalar_sub<double>,
+        scalar_mul<int64_t>, scalar_mul<double>, scalar_div<double>,
+        scalar_cmp<int64_t>, scalar_cmp<double>,
+    },
+#ifdef SWL_X86_KERNELS
+    {
+        VectorKernels::isa_sse2,
+        sse2_sum_i64, sse2_sum_f64,
+        scalar_dot<int64_t>, sse2_dot_f64,
+        scalar_min<int64_t>, sse2_min_f64,
+        scalar_max<int64_t>, sse2_max_f64,
+        sse2_add_i64, sse2_add_f64,
+        scalar_scale<int64_t>, sse2_scale_f64,
+        sse2_sub_i64, sse2_sub_f64,
+        scalar_mul<int64_t>, sse2_mul_f64, sse2_div_f64,
+        scalar_cmp<int64_t>, sse2_cmp_f64,
+    },
+    {
+        VectorKernels::isa_avx2,
+        avx2_sum_i64, avx2_sum_f64,
+        scalar_dot<int64_t>, avx2_dot_f64,
+        avx2_min_i64, avx2_min_f64,
+        avx2_max_i64, avx2_max_f64,
+        avx2_add_i64, avx2_add_f64,
+        scalar_scale<int64_t>, avx2_scale_f64,
+        avx2_sub_i64, avx2_sub_f64,
+        scalar_mul<int64_t>, avx2_mul_f64, avx2_div_f64,
+        avx2_cmp_i64, avx2_cmp_f64,
+    },
+#endif
+};
+
+VectorKernels::isa_t detect_isa()
+{
+#ifdef SWL_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return VectorKernels::isa_avx2;
+    }
+    return VectorKernels::isa_sse2;
+#else
+    return VectorKernels::isa_scalar;
+#endif
+}
+
+} // anonymous namespace
+
+const char * VectorKernels::isa_name(isa_t isa)
+{
+    switch (isa) {
+        case isa_scalar:
+            return "scalar";
+        case isa_sse2:
+            return "sse2";
+        case isa_avx2:
+            return "avx2";
+        default:
+            return "unknown";
+    }
+}
+
+VectorKernels::isa_t VectorKernels::best_isa()
+{
+    // thread-safe initialization of local statics is guaranteed by C++11
+    static const isa_t best = detect_isa();
+    return best;
+}
+
+const VectorKernels & VectorKernels::get(isa_t isa)
+{
+    isa_t best = best_isa();
+    return kernel_tables[isa < best ? isa : best];
+}
+
+} // namespace SolarWindLisp
@@ -0,0 +1,661 @@
+/*
+ * file name:           src/worker_pool.cc
+ *
+ * author:              Brian Yi ZHANG
+ * email:               brianlions@gmail.com
+ * date created:        Tue Oct 20 03:05:41 2026 CST
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <deque>
+#include <list>
+#include <thread>
+#include "worker_pool.h"
+#include "interpreter.h"
+#include "matter.h"
+#include "pretty_message.h"
+
+namespace SolarWindLisp
+{
+
+namespace
+{
+
+// response of a request, see Client
+struct Slot
+{
+    bool ready;
+    std::string response;
+};
+
+struct Client
+{
+    int fd;
+    // the last line, not complete yet
+    std::string input;
+    std::string output;
+    // responses, in the order of the requests, sent as soon as the ones
+    // before them are
+    std::deque<Slot> slots;
+    // requests queued or being executed
+    size_t pending;
+    bool eof;
+    bool broken;
+};
+
+struct Job
+{
+    // NULL for WorkerPool::execute()
+    Client * client;
+    // NULL if there is no job
+    Slot * slot;
+    std::string request;
+};
+
+bool write_all(int fd, const char * data, size_t length)
+{
+    while (length > 0) {
+        ssize_t written = send(fd, data, length, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= written;
+    }
+    return true;
+}
+
+bool read_all(int fd, char * data, size_t length)
+{
+    while (length > 0) {
+        ssize_t got = read(fd, data, length);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            return false;
+        }
+        data += got;
+        length -= got;
+    }
+    return true;
+}
+
+// a frame between the parent and a worker is the length of the payload, and
+// the payload
+bool write_frame(int fd, const std::string &payload)
+{
+    uint32_t length = payload.size();
+    std::string frame(reinterpret_cast<const char *>(&length), sizeof(length));
+    frame += payload;
+    return write_all(fd, frame.data(), frame.size());
+}
+
+bool read_frame(int fd, std::string &payload)
+{
+    uint32_t length;
+    if (!read_all(fd, reinterpret_cast<char *>(&length), sizeof(length))) {
+        return false;
+    }
+
+    payload.resize(length);
+    return length == 0 || read_all(fd, &payload[0], length);
+}
+
+/*
+ * Description:
+ *   Move the first frame of `buffer' to `payload'.
+ * Return value:
+ *   false if the frame is not complete yet.
+ */
+bool take_frame(std::string &buffer, std::string &payload)
+{
+    uint32_t length;
+    if (buffer.size() < sizeof(length)) {
+        return false;
+    }
+
+    memcpy(&length, buffer.data(), sizeof(length));
+    if (buffer.size() - sizeof(length) < length) {
+        return false;
+    }
+
+    payload.assign(buffer, sizeof(length), length);
+    buffer.erase(0, sizeof(length) + length);
+    return true;
+}
+
+std::string response_line(bool ok, const std::string &text)
+{
+    std::string line(ok ? "ok" : "error");
+    if (!text.empty()) {
+        line += ' ';
+    }
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\n') {
+            line += "\\n";
+        }
+        else if (text[i] == '\\') {
+            line += "\\\\";
+        }
+        else {
+            line += text[i];
+        }
+    }
+    return line;
+}
+
+void flush_ready(Client &client)
+{
+    while (!client.slots.empty() && client.slots.front().ready) {
+        if (!client.broken) {
+            client.output += client.slots.front().response;
+            client.output += '\n';
+        }
+        client.slots.pop_front();
+    }
+}
+
+void write_client(Client &client)
+{
+    if (client.broken || client.output.empty()) {
+        return;
+    }
+
+    ssize_t written = send(client.fd, client.output.data(),
+            client.output.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (written < 0) {
+        if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+            client.broken = true;
+            client.output.clear();
+        }
+        return;
+    }
+    client.output.erase(0, written);
+}
+
+} // anonymous namespace
+
+struct WorkerPool::Dispatch
+{
+    // -1 for execute()
+    int listener;
+    const volatile sig_atomic_t * stop;
+    std::deque<Job> queue;
+    // job of every worker
+    std::vector<Job> running;
+    // incomplete frames of the workers
+    std::vector<std::string> replies;
+    std::list<Client> clients;
+    // requests of execute() not done
+    size_t outstanding;
+
+    Dispatch(size_t workers, int fd, const volatile sig_atomic_t * flag) :
+            listener(fd), stop(flag), running(workers), replies(workers),
+            outstanding(0)
+    {
+        for (size_t i = 0; i < running.size(); ++i) {
+            running[i].client = NULL;
+            running[i].slot = NULL;
+        }
+    }
+
+    void add(Client * client, Slot * slot, const std::string &request)
+    {
+        Job job = { client, slot, request };
+        slot->ready = false;
+        queue.push_back(job);
+        if (client) {
+            ++client->pending;
+        }
+        else {
+            ++outstanding;
+        }
+    }
+
+    void finish(Job &job, const std::string &response)
+    {
+        job.slot->response = response;
+        job.slot->ready = true;
+        if (job.client) {
+            --job.client->pending;
+            flush_ready(*job.client);
+        }
+        else {
+            --outstanding;
+        }
+        job.client = NULL;
+        job.slot = NULL;
+        job.request.clear();
+    }
+
+    void read_client(Client &client)
+    {
+        char buffer[64 * 1024];
+        ssize_t got = recv(client.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (got < 0) {
+            if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+                client.broken = true;
+            }
+            return;
+        }
+
+        if (got == 0) {
+            // the last line may have no new line
+            client.eof = true;
+            add_line(client, client.input);
+            client.input.clear();
+            return;
+        }
+
+        size_t start = 0;
+        size_t end = client.input.size();
+        client.input.append(buffer, got);
+        while ((end = client.input.find('\n', end)) != std::string::npos) {
+            add_line(client, client.input.substr(start, end - start));
+            start = ++end;
+        }
+        client.input.erase(0, start);
+
+        if (client.input.size() > MAX_REQUEST_SIZE) {
+            client.input.clear();
+            client.eof = true;
+            Slot refused = { true, response_line(false, "request too long") };
+            client.slots.push_back(refused);
+            flush_ready(client);
+        }
+    }
+
+    void add_line(Client &client, std::string line)
+    {
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+        if (line.find_first_not_of(" \t") == std::string::npos) {
+            return;
+        }
+
+        client.slots.push_back(Slot());
+        add(&client, &client.slots.back(), line);
+    }
+
+    void drop_queue()
+    {
+        for (size_t i = 0; i < queue.size(); ++i) {
+            if (queue[i].client) {
+                --queue[i].client->pending;
+            }
+            else {
+                --outstanding;
+            }
+        }
+        queue.clear();
+    }
+
+    std::vector<int> descriptors() const
+    {
+        std::vector<int> fds;
+        if (listener >= 0) {
+            fds.push_back(listener);
+        }
+        for (std::list<Client>::const_iterator it = clients.begin();
+                it != clients.end(); ++it) {
+            fds.push_back(it->fd);
+        }
+        return fds;
+    }
+};
+
+WorkerPool::WorkerPool(InterpreterIF * interpreter, size_t workers) :
+        _interpreter(interpreter), _size(workers)
+{
+    if (!_size) {
+        _size = std::thread::hardware_concurrency();
+        _size = _size ? _size : 1;
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    stop();
+}
+
+bool WorkerPool::start()
+{
+    if (!_workers.empty()) {
+        return false;
+    }
+
+    Worker none = { -1, -1 };
+    _workers.assign(_size, none);
+    for (size_t i = 0; i < _size; ++i) {
+        if (!_spawn(i, std::vector<int>())) {
+            stop();
+            return false;
+        }
+    }
+    return true;
+}
+
+void WorkerPool::stop()
+{
+    // the idle workers exit as soon as their sockets are closed
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        if (_workers[i].fd >= 0) {
+            close(_workers[i].fd);
+            _workers[i].fd = -1;
+        }
+    }
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        _reap(i);
+    }
+    _workers.clear();
+}
+
+bool WorkerPool::_spawn(size_t index, const std::vector<int> &inherited)
+{
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+        PRETTY_MESSAGE(stderr, "socketpair() failed: %s", strerror(errno));
+        return false;
+    }
+
+    // not to be flushed by the worker too
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        PRETTY_MESSAGE(stderr, "fork() failed: %s", strerror(errno));
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        close(fds[0]);
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            if (_workers[i].fd >= 0) {
+                close(_workers[i].fd);
+            }
+        }
+        for (size_t i = 0; i < inherited.size(); ++i) {
+            close(inherited[i]);
+        }
+        // the parent stops the workers
+        signal(SIGINT, SIG_IGN);
+        signal(SIGTERM, SIG_DFL);
+        _work(fds[1]);
+    }
+
+    close(fds[1]);
+    _workers[index].pid = pid;
+    _workers[index].fd = fds[0];
+    return true;
+}
+
+void WorkerPool::_reap(size_t index)
+{
+    Worker &worker = _workers[index];
+    if (worker.fd >= 0) {
+        close(worker.fd);
+        worker.fd = -1;
+    }
+    if (worker.pid > 0) {
+        int status;
+        // a busy worker does not see its socket closed
+        if (waitpid(worker.pid, &status, WNOHANG) == 0) {
+            kill(worker.pid, SIGTERM);
+            while (waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {
+            }
+        }
+        worker.pid = -1;
+    }
+}
+
+void WorkerPool::_work(int fd)
+{
+    std::string request;
+    while (read_frame(fd, request)) {
+        MatterPtr result = NULL;
+        std::string reply(1, '0');
+        if (_interpreter->execute(result, request.data(), request.size())) {
+            reply[0] = '1';
+            if (result) {
+                reply += result->to_string();
+            }
+        }
+        if (!write_frame(fd, reply)) {
+            break;
+        }
+    }
+
+    // the objects are left to the kernel, like the files of the parent
+    fflush(stdout);
+    _exit(EXIT_SUCCESS);
+}
+
+bool WorkerPool::_dispatch(Dispatch &dispatch)
+{
+    bool stopping = false;
+    std::vector<struct pollfd> fds;
+    while (true) {
+        if (!stopping && dispatch.stop && *dispatch.stop) {
+            // the requests being executed are waited for, not the others
+            stopping = true;
+            dispatch.drop_queue();
+        }
+
+        size_t busy = 0;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            busy += dispatch.running[i].slot ? 1 : 0;
+        }
+        if (stopping ? busy == 0
+                : dispatch.listener < 0 && dispatch.outstanding == 0) {
+            return true;
+        }
+
+        for (size_t i = 0; i < _workers.size() && !dispatch.queue.empty();
+                ++i) {
+            if (dispatch.running[i].slot) {
+                continue;
+            }
+            if (!write_frame(_workers[i].fd, dispatch.queue.front().request)) {
+                // died while idle, the request goes to the one forked again,
+                // or to another worker
+                _reap(i);
+                dispatch.replies[i].clear();
+                if (!_spawn(i, dispatch.descriptors())) {
+                    return false;
+                }
+                continue;
+            }
+            dispatch.running[i] = dispatch.queue.front();
+            dispatch.queue.pop_front();
+        }
+
+        fds.clear();
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            struct pollfd worker = { _workers[i].fd, POLLIN, 0 };
+            fds.push_back(worker);
+        }
+        size_t listener_index = fds.size();
+        struct pollfd listener = { stopping ? -1 : dispatch.listener, POLLIN,
+                0 };
+        fds.push_back(listener);
+        for (std::list<Client>::iterator it = dispatch.clients.begin();
+                it != dispatch.clients.end(); ++it) {
+            short events = 0;
+            if (!it->eof && !it->broken && !stopping) {
+                events |= POLLIN;
+            }
+            if (!it->broken && !it->output.empty()) {
+                events |= POLLOUT;
+            }
+            // POLLHUP is reported anyway, ignored until there is a response
+            struct pollfd client = { events ? it->fd : -1, events, 0 };
+            fds.push_back(client);
+        }
+
+        if (poll(&fds[0], fds.size(),
+                dispatch.stop ? POLL_TIMEOUT_MS : -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            PRETTY_MESSAGE(stderr, "poll() failed: %s", strerror(errno));
+            return false;
+        }
+
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            if (!fds[i].revents) {
+                continue;
+            }
+
+            char buffer[64 * 1024];
+            ssize_t got = recv(_workers[i].fd, buffer, sizeof(buffer), 0);
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            if (got <= 0) {
+                if (dispatch.running[i].slot) {
+                    dispatch.finish(dispatch.running[i],
+                            response_line(false, "worker died"));
+                }
+                _reap(i);
+                dispatch.replies[i].clear();
+                if (!_spawn(i, dispatch.descriptors())) {
+                    return false;
+                }
+                continue;
+            }
+
+            dispatch.replies[i].append(buffer, got);
+            std::string reply;
+            if (take_frame(dispatch.replies[i], reply)
+                    && dispatch.running[i].slot) {
+                dispatch.finish(dispatch.running[i],
+                        response_line(!reply.empty() && reply[0] == '1',
+                                reply.empty() ? reply : reply.substr(1)));
+            }
+        }
+
+        size_t index = listener_index + 1;
+        for (std::list<Client>::iterator it = dispatch.clients.begin();
+                it != dispatch.clients.end(); ++index) {
+            if (fds[index].revents & (POLLIN | POLLHUP | POLLERR)
+                    && !it->eof && !it->broken) {
+                dispatch.read_client(*it);
+            }
+            write_client(*it);
+
+            // the slots of the jobs left are referred to
+            if ((it->eof || it->broken) && it->pending == 0
+                    && it->output.empty()) {
+                close(it->fd);
+                it = dispatch.clients.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        if (fds[listener_index].revents & POLLIN) {
+            int fd;
+            while ((fd = accept(dispatch.listener, NULL, NULL)) >= 0) {
+                Client client;
+                client.fd = fd;
+                client.pending = 0;
+                client.eof = false;
+                client.broken = false;
+                dispatch.clients.push_back(client);
+            }
+        }
+    }
+}
+
+bool WorkerPool::execute(const std::vector<std::string> &requests,
+        std::vector<std::string> &responses)
+{
+    if (_workers.empty()) {
+        return false;
+    }
+
+    Dispatch dispatch(_workers.size(), -1, NULL);
+    std::vector<Slot> slots(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        dispatch.add(NULL, &slots[i], requests[i]);
+    }
+
+    if (!_dispatch(dispatch)) {
+        // replies of the jobs left would be taken for the ones of the next
+        stop();
+        return false;
+    }
+
+    for (size_t i = 0; i < slots.size(); ++i) {
+        responses.push_back(slots[i].response);
+    }
+    return true;
+}
+
+bool WorkerPool::serve(const char * path,
+        const volatile sig_atomic_t * stopped)
+{
+    if (_workers.empty()) {
+        return false;
+    }
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        PRETTY_MESSAGE(stderr, "socket path `%s' is too long", path);
+        return false;
+    }
+    strcpy(address.sun_path, path);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        PRETTY_MESSAGE(stderr, "socket() failed: %s", strerror(errno));
+        return false;
+    }
+
+    unlink(path);
+    if (bind(listener, reinterpret_cast<struct sockaddr *>(&address),
+            sizeof(address)) < 0 || listen(listener, SOMAXCONN) < 0
+            || fcntl(listener, F_SETFL, O_NONBLOCK) < 0) {
+        PRETTY_MESSAGE(stderr, "cannot listen on `%s': %s", path,
+                strerror(errno));
+        close(listener);
+        return false;
+    }
+
+    Dispatch dispatch(_workers.size(), listener, stopped);
+    bool ok = _dispatch(dispatch);
+    if (!ok) {
+        stop();
+    }
+
+    for (std::list<Client>::iterator it = dispatch.clients.begin();
+            it != dispatch.clients.end(); ++it) {
+        close(it->fd);
+    }
+    close(listener);
+    unlink(path);
+    return ok;
+}
+
+} // namespace SolarWindLisp
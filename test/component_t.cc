@@ -7,14 +7,30 @@
  */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
 #include "solarwindlisp.h"
 
 using SolarWindLisp::MatterIF;
 using SolarWindLisp::Atom;
+using SolarWindLisp::CompositeExpr;
 using SolarWindLisp::SimpleMatterFactory;
 using SolarWindLisp::MatterPtr;
 using SolarWindLisp::AtomPtr;
 using SolarWindLisp::CompositeExprPtr;
+using SolarWindLisp::Pair;
+using SolarWindLisp::PairPtr;
+using SolarWindLisp::Vector;
+using SolarWindLisp::VectorPtr;
+using SolarWindLisp::VectorKernels;
+using SolarWindLisp::HashMap;
+using SolarWindLisp::HashMapPtr;
+using SolarWindLisp::AtomKey;
+using SolarWindLisp::PersistentMap;
+using SolarWindLisp::PersistentMapPtr;
+using SolarWindLisp::SymbolTable;
 
 class ExprTS: public testing::Test
 {
@@ -159,12 +175,12 @@ TEST_F(ExprTS, parseC)
     }
 
     EXPECT_EQ(_composite_expr->size(), array_size(expr_list));
-    EXPECT_TRUE(_composite_expr->rewind());
     size_t counter = 0;
     int32_t i32 = 0;
     uint32_t u32 = 0;
-    while (_composite_expr->has_next()) {
-        MatterPtr temp = _composite_expr->get_next();
+    for (CompositeExpr::const_iterator it = _composite_expr->begin();
+            it != _composite_expr->end(); ++it) {
+        MatterPtr temp = *it;
         EXPECT_TRUE(temp != NULL);
         EXPECT_TRUE(temp->is_atom());
         EXPECT_FALSE(temp->is_composite_expr());
@@ -215,3 +231,705 @@ TEST_F(ExprTS, parseC)
         }
     }
 }
+
+namespace
+{
+
+/*
+ * `fast' was parsed by Atom::parse(), `slow' by Atom::parse_generic().
+ */
+void expect_same_atom(const Atom &fast, const Atom &slow, const char * input)
+{
+    ASSERT_EQ(fast.atom_type(), slow.atom_type()) << "input: " << input;
+    if (fast.is_cstr()) {
+        EXPECT_STREQ(fast.to_cstr(), slow.to_cstr()) << "input: " << input;
+        EXPECT_EQ(fast.is_quoted_cstr(), slow.is_quoted_cstr());
+    }
+    else if (fast.is_real()) {
+        long double a = 0;
+        long double b = 0;
+        EXPECT_TRUE(fast.to_long_double(a) && slow.to_long_double(b));
+        // bitwise, so -0.0 and 0.0 differ, NaN equals NaN
+        EXPECT_TRUE(!memcmp(&a, &b, 10)) << "input: " << input;
+    }
+    else {
+        uint64_t a = 0;
+        uint64_t b = 0;
+        if (fast.is_i32() || fast.is_i64()) {
+            int64_t i = 0;
+            int64_t j = 0;
+            EXPECT_TRUE(fast.to_i64(i) && slow.to_i64(j));
+            a = static_cast<uint64_t>(i);
+            b = static_cast<uint64_t>(j);
+        }
+        else {
+            EXPECT_TRUE(fast.to_u64(a) && slow.to_u64(b));
+        }
+        EXPECT_EQ(a, b) << "input: " << input;
+    }
+}
+
+} // anonymous namespace
+
+TEST_F(ExprTS, parseFastPath)
+{
+    struct tuple
+    {
+        const char * input;
+        Atom::atom_type_t atom_type;
+    } cases[] = { //
+            { "0", Atom::atom_i32 }, //
+            { "-12", Atom::atom_i32 }, //
+            { "+12", Atom::atom_i32 }, //
+            { "2147483647", Atom::atom_i32 }, //
+            { "-2147483648", Atom::atom_i32 }, //
+            { "2147483648", Atom::atom_i64 }, //
+            { "9223372036854775807", Atom::atom_i64 }, //
+            { "-9223372036854775808", Atom::atom_i64 }, //
+            { "9223372036854775808", Atom::atom_double }, //
+            { "99999999999999999999", Atom::atom_double }, //
+            { "-0000000000000000000000001", Atom::atom_i32 }, //
+            { "0x1F", Atom::atom_u32 }, //
+            { "0XFFFFFFFFFFFFFFFF", Atom::atom_u64 }, //
+            { "0x1p3", Atom::atom_double }, //
+            { "-0x10", Atom::atom_double }, //
+            { "017", Atom::atom_u32 }, //
+            { "00", Atom::atom_u32 }, //
+            { "0777777777777", Atom::atom_u64 }, //
+            { "08", Atom::atom_double }, //
+            { "0.5", Atom::atom_double }, //
+            { ".5", Atom::atom_double }, //
+            { "5.", Atom::atom_double }, //
+            { "-0.0", Atom::atom_double }, //
+            { "1e5", Atom::atom_double }, //
+            { "1.25E-3", Atom::atom_double }, //
+            { "0.1", Atom::atom_double }, //
+            { "123456789.123456789", Atom::atom_double }, //
+            { "1e-300", Atom::atom_double }, //
+            { "inf", Atom::atom_double }, //
+            { "-Infinity", Atom::atom_double }, //
+            { "nan", Atom::atom_double }, //
+            { "info", Atom::atom_cstr }, //
+            { "nil", Atom::atom_cstr }, //
+            { "+", Atom::atom_cstr }, //
+            { "-", Atom::atom_cstr }, //
+            { "...", Atom::atom_cstr }, //
+            { "1e", Atom::atom_cstr }, //
+            { "1e+", Atom::atom_cstr }, //
+            { "12abc", Atom::atom_cstr }, //
+            { "0x", Atom::atom_cstr }, //
+            { "0xg", Atom::atom_cstr }, //
+            { "true", Atom::atom_bool }, //
+            { "false", Atom::atom_bool }, //
+            { "trueish", Atom::atom_cstr }, //
+            { "f", Atom::atom_cstr }, //
+            { "lambda", Atom::atom_cstr }, //
+            { "\"42\"", Atom::atom_cstr }, //
+            };
+
+    for (size_t i = 0; i < array_size(cases); ++i) {
+        const char * input = cases[i].input;
+        AtomPtr slow = Atom::create();
+        ASSERT_TRUE(slow != NULL);
+        EXPECT_TRUE(_expr->parse(input, strlen(input)));
+        EXPECT_TRUE(slow->parse_generic(input, strlen(input)));
+        EXPECT_EQ(_expr->atom_type(), cases[i].atom_type) << "input: " << input;
+        expect_same_atom(*_expr, *slow, input);
+    }
+
+    // not NUL terminated
+    const char * text = "(+ 12 3.5)";
+    EXPECT_TRUE(_expr->parse(text + 3, 2));
+    int32_t i32 = 0;
+    EXPECT_TRUE(_expr->is_i32() && _expr->to_i32(i32) && i32 == 12);
+    EXPECT_TRUE(_expr->parse(text + 6, 3));
+    double d = 0;
+    EXPECT_TRUE(_expr->is_double() && _expr->to_double(d) && d == 3.5);
+    EXPECT_TRUE(_expr->parse(text + 6, 2));
+    EXPECT_TRUE(_expr->is_double() && _expr->to_double(d) && d == 3.0);
+}
+
+TEST_F(ExprTS, parseFastPathRandom)
+{
+    static const char alphabet[] = "0123456789+-.eExX0123456789abfinty";
+    AtomPtr slow = Atom::create();
+    ASSERT_TRUE(slow != NULL);
+
+    unsigned int seed = 20261019;
+    char buf[32];
+    for (size_t round = 0; round < 200000; ++round) {
+        size_t length = 1 + (seed = seed * 1103515245 + 12345) % 24;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245 + 12345;
+            buf[i] = alphabet[(seed >> 8) % (sizeof(alphabet) - 1)];
+        }
+        buf[length] = '\0';
+
+        EXPECT_TRUE(_expr->parse(buf, length));
+        EXPECT_TRUE(slow->parse_generic(buf, length));
+        expect_same_atom(*_expr, *slow, buf);
+        if (HasFailure()) {
+            break;
+        }
+    }
+}
+
+TEST_F(ExprTS, compositeExprCapacity)
+{
+    // inline storage, then spill over to the heap
+    size_t inline_capacity = _composite_expr->capacity();
+    EXPECT_TRUE(_composite_expr->is_inline());
+    for (size_t i = 0; i < 3 * inline_capacity + 1; ++i) {
+        AtomPtr e = _matter_factory.create_atom();
+        e->set_i64(static_cast<int64_t>(i));
+        EXPECT_TRUE(_composite_expr->append_expr(e));
+        EXPECT_EQ(_composite_expr->is_inline(), i < inline_capacity);
+    }
+
+    EXPECT_EQ(_composite_expr->size(), 3 * inline_capacity + 1);
+    for (size_t i = 0; i < _composite_expr->size(); ++i) {
+        MatterPtr temp = _composite_expr->get(i);
+        EXPECT_TRUE(temp != NULL && temp->is_atom());
+        int64_t i64 = 0;
+        EXPECT_TRUE(static_cast<const Atom *>(temp.get())->to_i64(i64));
+        EXPECT_EQ(i64, static_cast<int64_t>(i));
+    }
+    EXPECT_TRUE(_composite_expr->get(_composite_expr->size()) == NULL);
+
+    // pre-sized, never grows
+    CompositeExprPtr sized = _matter_factory.create_composite_expr(100);
+    EXPECT_TRUE(sized != NULL);
+    EXPECT_FALSE(sized->is_inline());
+    EXPECT_EQ(sized->capacity(), 100U);
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(sized->append_expr(_expr));
+    }
+    EXPECT_EQ(sized->capacity(), 100U);
+    EXPECT_EQ(sized->size(), 100U);
+}
+
+TEST_F(ExprTS, pairList)
+{
+    EXPECT_TRUE(Pair::nil() != NULL);
+    EXPECT_TRUE(Pair::nil()->is_pair());
+    EXPECT_TRUE(Pair::nil()->is_nil());
+    EXPECT_EQ(Pair::nil()->length(), 0);
+    EXPECT_EQ(Pair::nil()->to_string(), "()");
+
+    // (1 2 3)
+    MatterPtr list = Pair::nil();
+    for (int64_t i = 3; i > 0; --i) {
+        AtomPtr e = _matter_factory.create_atom();
+        e->set_i64(i);
+        list = _matter_factory.create_pair(e, list);
+        EXPECT_TRUE(list != NULL);
+    }
+
+    const Pair * p = static_cast<const Pair *>(list.get());
+    EXPECT_FALSE(p->is_nil());
+    EXPECT_EQ(p->length(), 3);
+    EXPECT_EQ(p->to_string(), "(1 2 3)");
+    EXPECT_TRUE(p->car()->is_atom());
+    EXPECT_TRUE(p->cdr()->is_pair());
+    EXPECT_EQ(static_cast<const Pair *>(p->cdr().get())->length(), 2);
+
+    // (1 . 2) is not a proper list
+    AtomPtr one = Atom::create("1", 1);
+    AtomPtr two = Atom::create("2", 1);
+    PairPtr dotted = _matter_factory.create_pair(one, two);
+    EXPECT_EQ(dotted->length(), -1);
+    EXPECT_EQ(dotted->to_string(), "(1 . 2)");
+}
+
+TEST_F(ExprTS, pairLongList)
+{
+    // releasing a long list must not overflow the stack
+    MatterPtr list = Pair::nil();
+    for (size_t i = 0; i < 1000 * 1000; ++i) {
+        list = _matter_factory.create_pair(_expr, list);
+    }
+    EXPECT_EQ(static_cast<const Pair *>(list.get())->length(), 1000 * 1000);
+    list = NULL;
+    EXPECT_TRUE(Pair::nil()->is_nil());
+}
+
+TEST_F(ExprTS, vectorStorage)
+{
+    VectorPtr empty = _matter_factory.create_vector(Vector::elem_i64, 0);
+    EXPECT_TRUE(empty != NULL);
+    EXPECT_TRUE(empty->is_vector());
+    EXPECT_EQ(empty->size(), 0U);
+    EXPECT_EQ(empty->to_string(), "[]");
+
+    VectorPtr v = _matter_factory.create_vector(Vector::elem_double, 37);
+    EXPECT_TRUE(v != NULL);
+    EXPECT_TRUE(v->is_double());
+    EXPECT_EQ(v->size(), 37U);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v->double_data())
+            % Vector::VECTOR_ALIGNMENT, 0U);
+    for (size_t i = 0; i < v->size(); ++i) {
+        EXPECT_EQ(v->double_data()[i], 0);
+    }
+
+    VectorPtr w = _matter_factory.create_vector(Vector::elem_i64, 3);
+    w->i64_data()[0] = 1;
+    w->i64_data()[1] = -2;
+    w->i64_data()[2] = 3;
+    EXPECT_EQ(w->to_string(), "[1 -2 3]");
+    EXPECT_EQ(w->as_double(1), -2.0);
+
+    // too large, even if the bytes overflow only when rounded up
+    size_t max_size = std::numeric_limits<size_t>::max();
+    EXPECT_TRUE(Vector::create(Vector::elem_i64, max_size) == NULL);
+    EXPECT_TRUE(Vector::create(Vector::elem_i64, max_size / 8) == NULL);
+    EXPECT_TRUE(Vector::create(Vector::elem_double,
+            (max_size - Vector::VECTOR_ALIGNMENT + 1) / 8 + 1) == NULL);
+}
+
+TEST_F(ExprTS, vectorKernels)
+{
+    // every supported instruction set must agree with the scalar version,
+    // for all sizes around the register width, including the tails.
+    const VectorKernels &scalar = VectorKernels::get(VectorKernels::isa_scalar);
+    EXPECT_EQ(scalar.isa, VectorKernels::isa_scalar);
+
+    for (int isa = 0; isa < VectorKernels::NUM_OF_ISAS; ++isa) {
+        VectorKernels::isa_t t = static_cast<VectorKernels::isa_t>(isa);
+        if (!VectorKernels::is_supported(t)) {
+            continue;
+        }
+
+        const VectorKernels &k = VectorKernels::get(t);
+        EXPECT_EQ(k.isa, t);
+        for (size_t n = 0; n < 40; ++n) {
+            int64_t a[40], b[40], out_i[40], expected_i[40];
+            double x[40], y[40], out_d[40], expected_d[40];
+            for (size_t i = 0; i < n; ++i) {
+                // small integers only, so the double results are exact
+                a[i] = static_cast<int64_t>((i * 7919) % 97) - 48;
+                b[i] = static_cast<int64_t>((i * 104729) % 31) - 15;
+                x[i] = a[i] * 0.5;
+                y[i] = b[i] * 0.25;
+            }
+
+            EXPECT_EQ(k.sum_i64(a, n), scalar.sum_i64(a, n));
+            EXPECT_EQ(k.sum_f64(x, n), scalar.sum_f64(x, n));
+            EXPECT_EQ(k.dot_i64(a, b, n), scalar.dot_i64(a, b, n));
+            EXPECT_EQ(k.dot_f64(x, y, n), scalar.dot_f64(x, y, n));
+            if (n) {
+                EXPECT_EQ(k.min_i64(a, n), scalar.min_i64(a, n));
+                EXPECT_EQ(k.max_i64(a, n), scalar.max_i64(a, n));
+                EXPECT_EQ(k.min_f64(x, n), scalar.min_f64(x, n));
+                EXPECT_EQ(k.max_f64(x, n), scalar.max_f64(x, n));
+            }
+
+            k.add_i64(a, b, out_i, n);
+            scalar.add_i64(a, b, expected_i, n);
+            EXPECT_EQ(0, memcmp(out_i, expected_i, n * sizeof(int64_t)));
+            k.scale_i64(a, -3, out_i, n);
+            scalar.scale_i64(a, -3, expected_i, n);
+            EXPECT_EQ(0, memcmp(out_i, expected_i, n * sizeof(int64_t)));
+            k.add_f64(x, y, out_d, n);
+            scalar.add_f64(x, y, expected_d, n);
+            EXPECT_EQ(0, memcmp(out_d, expected_d, n * sizeof(double)));
+            k.scale_f64(x, 1.5, out_d, n);
+            scalar.scale_f64(x, 1.5, expected_d, n);
+            EXPECT_EQ(0, memcmp(out_d, expected_d, n * sizeof(double)));
+
+            k.sub_i64(a, b, out_i, n);
+            scalar.sub_i64(a, b, expected_i, n);
+            EXPECT_EQ(0, memcmp(out_i, expected_i, n * sizeof(int64_t)));
+            k.mul_i64(a, b, out_i, n);
+            scalar.mul_i64(a, b, expected_i, n);
+            EXPECT_EQ(0, memcmp(out_i, expected_i, n * sizeof(int64_t)));
+            k.sub_f64(x, y, out_d, n);
+            scalar.sub_f64(x, y, expected_d, n);
+            EXPECT_EQ(0, memcmp(out_d, expected_d, n * sizeof(double)));
+            k.mul_f64(x, y, out_d, n);
+            scalar.mul_f64(x, y, expected_d, n);
+            EXPECT_EQ(0, memcmp(out_d, expected_d, n * sizeof(double)));
+            k.div_f64(x, y, out_d, n);
+            scalar.div_f64(x, y, expected_d, n);
+            EXPECT_EQ(0, memcmp(out_d, expected_d, n * sizeof(double)));
+
+            // 64-bit integers wrap around on overflow
+            int64_t big[40];
+            uint64_t sum = 0;
+            uint64_t dot = 0;
+            for (size_t i = 0; i < n; ++i) {
+                big[i] = std::numeric_limits<int64_t>::max()
+                        - static_cast<int64_t>(i);
+                sum += static_cast<uint64_t>(big[i]);
+                dot += static_cast<uint64_t>(big[i])
+                        * static_cast<uint64_t>(a[i]);
+                expected_i[i] = static_cast<int64_t>(
+                        static_cast<uint64_t>(big[i]) * 2);
+            }
+            EXPECT_EQ(k.sum_i64(big, n), static_cast<int64_t>(sum));
+            EXPECT_EQ(k.dot_i64(big, a, n), static_cast<int64_t>(dot));
+            k.add_i64(big, big, out_i, n);
+            EXPECT_EQ(0, memcmp(out_i, expected_i, n * sizeof(int64_t)));
+            k.scale_i64(big, 2, out_i, n);
+            EXPECT_EQ(0, memcmp(out_i, expected_i, n * sizeof(int64_t)));
+
+            // some NaNs, which compare unequal to everything
+            for (size_t i = 3; i < n; i += 5) {
+                y[i] = std::numeric_limits<double>::quiet_NaN();
+            }
+            if (n) {
+                // the first NaN, wherever it is, -NaN to tell which one
+                for (size_t at = 0; at < n; ++at) {
+                    double z[40];
+                    memcpy(z, x, n * sizeof(double));
+                    z[at] = -std::numeric_limits<double>::quiet_NaN();
+                    for (size_t i = at + 3; i < n; i += 5) {
+                        z[i] = std::numeric_limits<double>::quiet_NaN();
+                    }
+                    double lo = k.min_f64(z, n);
+                    double hi = k.max_f64(z, n);
+                    EXPECT_TRUE(std::isnan(lo) && std::signbit(lo))
+                            << "isa " << isa << " n " << n << " at " << at;
+                    EXPECT_TRUE(std::isnan(hi) && std::signbit(hi))
+                            << "isa " << isa << " n " << n << " at " << at;
+                }
+                EXPECT_TRUE(std::isnan(k.min_f64(y, n)) == (n > 3));
+                EXPECT_TRUE(std::isnan(k.max_f64(y, n)) == (n > 3));
+            }
+            for (int op = 0; op < VectorKernels::NUM_OF_CMP_OPS; ++op) {
+                VectorKernels::cmp_op_t o =
+                        static_cast<VectorKernels::cmp_op_t>(op);
+                uint8_t out_b[40], expected_b[40];
+                k.cmp_i64(a, b, o, out_b, n);
+                scalar.cmp_i64(a, b, o, expected_b, n);
+                EXPECT_EQ(0, memcmp(out_b, expected_b, n)) << "i64 op " << op;
+                k.cmp_f64(x, y, o, out_b, n);
+                scalar.cmp_f64(x, y, o, expected_b, n);
+                EXPECT_EQ(0, memcmp(out_b, expected_b, n)) << "f64 op " << op;
+            }
+        }
+    }
+}
+
+TEST_F(ExprTS, atomKey)
+{
+    AtomPtr i32 = Atom::create("1", 1);
+    AtomPtr i64 = _matter_factory.create_atom();
+    i64->set_i64(1);
+    AtomPtr real = Atom::create("1.0", 3);
+    AtomPtr str = Atom::create("\"abc\"", 5);
+    AtomPtr sym = Atom::create("abc", 3);
+    AtomPtr sym2 = Atom::create("abc", 3);
+
+    EXPECT_TRUE(AtomKey::is_valid(i32));
+    EXPECT_TRUE(AtomKey::is_valid(str));
+    EXPECT_TRUE(AtomKey::is_valid(sym));
+    EXPECT_FALSE(AtomKey::is_valid(_composite_expr));
+    EXPECT_FALSE(AtomKey::is_valid(MatterPtr()));
+
+    // integers are compared by value, whatever the width is
+    EXPECT_TRUE(AtomKey::equal(i32, i64));
+    EXPECT_EQ(AtomKey::hash(i32), AtomKey::hash(i64));
+    EXPECT_FALSE(AtomKey::equal(i32, real));
+    EXPECT_FALSE(AtomKey::equal(str, sym));
+    EXPECT_TRUE(AtomKey::equal(sym, sym2));
+    EXPECT_EQ(AtomKey::hash(sym), AtomKey::hash(sym2));
+    EXPECT_NE(AtomKey::hash(sym), 0U);
+}
+
+TEST_F(ExprTS, hashMap)
+{
+    HashMapPtr m = _matter_factory.create_hash_map();
+    EXPECT_TRUE(m != NULL);
+    EXPECT_TRUE(m->is_hash_map());
+    EXPECT_EQ(m->size(), 0U);
+    EXPECT_EQ(m->to_string(), "{}");
+
+    static const int64_t N = 10000;
+    for (int64_t i = 0; i < N; ++i) {
+        AtomPtr key = _matter_factory.create_atom();
+        AtomPtr value = _matter_factory.create_atom();
+        key->set_i64(i);
+        value->set_i64(i * 2);
+        EXPECT_TRUE(m->insert(key, value));
+    }
+    EXPECT_EQ(m->size(), static_cast<size_t>(N));
+    EXPECT_LE(m->size(), m->capacity() / 4 * 3);
+
+    // replace an existing value, the size does not change
+    AtomPtr key = Atom::create("7", 1);
+    EXPECT_TRUE(m->insert(key, key));
+    EXPECT_EQ(m->size(), static_cast<size_t>(N));
+    EXPECT_EQ(m->find(key)->get(), key.get());
+
+    // remove the even keys, the odd ones must still be found
+    for (int64_t i = 0; i < N; i += 2) {
+        key = _matter_factory.create_atom();
+        key->set_i64(i);
+        EXPECT_TRUE(m->erase(key));
+        EXPECT_FALSE(m->erase(key));
+    }
+    EXPECT_EQ(m->size(), static_cast<size_t>(N / 2));
+    for (int64_t i = 0; i < N; ++i) {
+        key = _matter_factory.create_atom();
+        key->set_i64(i);
+        const MatterPtr * value = m->find(key);
+        if (i % 2) {
+            int64_t v = 0;
+            ASSERT_TRUE(value != NULL);
+            EXPECT_TRUE(static_cast<const Atom *>(value->get())->to_i64(v));
+            EXPECT_EQ(v, i == 7 ? 7 : i * 2);
+        }
+        else {
+            EXPECT_TRUE(value == NULL);
+        }
+    }
+
+    // strings and symbols
+    AtomPtr str = Atom::create("\"abc\"", 5);
+    AtomPtr sym = Atom::create("abc", 3);
+    EXPECT_TRUE(m->insert(str, str));
+    EXPECT_TRUE(m->insert(sym, sym));
+    EXPECT_EQ(m->find(Atom::create("abc", 3))->get(), sym.get());
+    EXPECT_EQ(m->find(Atom::create("\"abc\"", 5))->get(), str.get());
+}
+
+static int64_t value_of(const MatterPtr * m)
+{
+    int64_t v = -1;
+    if (m && *m && (*m)->is_atom()) {
+        static_cast<const Atom *>(m->get())->to_i64(v);
+    }
+    return v;
+}
+
+TEST_F(ExprTS, persistentMap)
+{
+    PersistentMapPtr empty = _matter_factory.create_persistent_map();
+    EXPECT_TRUE(empty != NULL);
+    EXPECT_TRUE(empty->is_persistent_map());
+    EXPECT_EQ(empty->size(), 0U);
+    EXPECT_EQ(empty->to_string(), "{}");
+
+    static const int64_t N = 20000;
+    std::vector<AtomPtr> keys;
+    PersistentMapPtr m = empty;
+    for (int64_t i = 0; i < N; ++i) {
+        AtomPtr key = _matter_factory.create_atom();
+        key->set_i64(i);
+        keys.push_back(key);
+        PersistentMapPtr next = m->assoc(key, key);
+        ASSERT_TRUE(next != NULL);
+        // the previous version does not change
+        EXPECT_EQ(m->size(), static_cast<size_t>(i));
+        EXPECT_TRUE(m->find(key) == NULL);
+        m = next;
+    }
+    EXPECT_EQ(m->size(), static_cast<size_t>(N));
+    EXPECT_EQ(empty->size(), 0U);
+    EXPECT_LE(m->depth(), 8U);
+
+    // a new version copies the path to the key only
+    AtomPtr minus = Atom::create("-1", 2);
+    PersistentMapPtr derived = m->assoc(keys[5], minus);
+    EXPECT_EQ(derived->size(), m->size());
+    EXPECT_EQ(value_of(derived->find(keys[5])), -1);
+    EXPECT_EQ(value_of(m->find(keys[5])), 5);
+    EXPECT_EQ(derived->node_count(), m->node_count());
+
+    // the same value, nothing to copy
+    EXPECT_EQ(m->assoc(keys[7], keys[7])->find(keys[7])->get(), keys[7].get());
+
+    // remove the odd keys
+    PersistentMapPtr even = m;
+    for (int64_t i = 1; i < N; i += 2) {
+        even = even->dissoc(keys[i]);
+        ASSERT_TRUE(even != NULL);
+    }
+    EXPECT_EQ(even->size(), static_cast<size_t>(N / 2));
+    EXPECT_EQ(m->size(), static_cast<size_t>(N));
+    for (int64_t i = 0; i < N; ++i) {
+        EXPECT_EQ(value_of(m->find(keys[i])), i);
+        EXPECT_EQ(value_of(even->find(keys[i])), i % 2 ? -1 : i);
+    }
+
+    // removing a missing key keeps the size
+    EXPECT_EQ(even->dissoc(keys[1])->size(), even->size());
+
+    // remove all of them
+    for (int64_t i = 0; i < N; i += 2) {
+        even = even->dissoc(keys[i]);
+    }
+    EXPECT_EQ(even->size(), 0U);
+    EXPECT_EQ(even->node_count(), 0U);
+}
+
+TEST_F(ExprTS, persistentMapTransient)
+{
+    PersistentMapPtr base = _matter_factory.create_persistent_map();
+    base = base->assoc(Atom::create("\"base\"", 6), _expr);
+
+    static const int64_t N = 5000;
+    std::vector<AtomPtr> keys;
+    PersistentMap::Transient transient(base);
+    for (int64_t i = 0; i < N; ++i) {
+        AtomPtr key = _matter_factory.create_atom();
+        key->set_i64(i);
+        keys.push_back(key);
+        EXPECT_TRUE(transient.assoc(key, key));
+    }
+    EXPECT_TRUE(transient.dissoc(keys[0]));
+    EXPECT_TRUE(transient.dissoc(Atom::create("\"base\"", 6)));
+    EXPECT_EQ(transient.size(), static_cast<size_t>(N - 1));
+
+    PersistentMapPtr built = transient.persistent();
+    ASSERT_TRUE(built != NULL);
+    EXPECT_EQ(built->size(), static_cast<size_t>(N - 1));
+    EXPECT_TRUE(built->find(keys[0]) == NULL);
+    EXPECT_EQ(value_of(built->find(keys[N - 1])), N - 1);
+
+    // the source is not affected
+    EXPECT_EQ(base->size(), 1U);
+    EXPECT_TRUE(base->find(Atom::create("\"base\"", 6)) != NULL);
+    EXPECT_TRUE(base->find(keys[1]) == NULL);
+
+    // the transient can not be used any more, and the result is frozen
+    EXPECT_FALSE(transient.assoc(keys[0], keys[0]));
+    EXPECT_TRUE(transient.persistent() == NULL);
+    PersistentMapPtr updated = built->assoc(keys[1], _expr);
+    EXPECT_EQ(value_of(built->find(keys[1])), 1);
+    EXPECT_TRUE(updated->find(keys[1])->get() == _expr.get());
+}
+
+TEST_F(ExprTS, persistentMapCollisions)
+{
+    // keys of the same low 10 bits of hash, in one subtree of the root
+    static const size_t N = 4;
+    std::vector<AtomPtr> keys;
+    uint64_t prefix = 0;
+    for (int64_t i = 0; keys.size() < N; ++i) {
+        AtomPtr key = _matter_factory.create_atom();
+        key->set_i64(i);
+        uint64_t low = AtomKey::hash(key) & 0x3ff;
+        if (keys.empty()) {
+            prefix = low;
+        }
+        if (low == prefix) {
+            keys.push_back(key);
+        }
+    }
+
+    PersistentMapPtr m = _matter_factory.create_persistent_map();
+    AtomPtr other = Atom::create("\"other\"", 7);
+    m = m->assoc(other, other);
+    for (size_t i = 0; i < N; ++i) {
+        m = m->assoc(keys[i], keys[i]);
+    }
+    ASSERT_EQ(m->size(), N + 1);
+
+    // remove each of them, in both orders, by the transient
+    for (int reverse = 0; reverse < 2; ++reverse) {
+        PersistentMap::Transient transient(m);
+        for (size_t i = 0; i < N; ++i) {
+            EXPECT_TRUE(transient.dissoc(keys[reverse ? N - 1 - i : i]));
+        }
+        PersistentMapPtr left = transient.persistent();
+        ASSERT_TRUE(left != NULL);
+        EXPECT_EQ(left->size(), 1U);
+        EXPECT_EQ(left->node_count(), 1U);
+        EXPECT_TRUE(left->find(other) != NULL);
+        for (size_t i = 0; i < N; ++i) {
+            EXPECT_TRUE(left->find(keys[i]) == NULL);
+        }
+    }
+
+    // and by dissoc
+    PersistentMapPtr left = m;
+    for (size_t i = 0; i < N; ++i) {
+        left = left->dissoc(keys[i]);
+        ASSERT_TRUE(left != NULL);
+        EXPECT_EQ(left->size(), N - i);
+    }
+    EXPECT_EQ(left->node_count(), 1U);
+    EXPECT_TRUE(left->find(other) != NULL);
+    EXPECT_EQ(m->size(), N + 1);
+
+    // the last key of the map, too
+    PersistentMap::Transient transient(left);
+    EXPECT_TRUE(transient.dissoc(other));
+    PersistentMapPtr empty = transient.persistent();
+    EXPECT_EQ(empty->size(), 0U);
+    EXPECT_EQ(empty->node_count(), 0U);
+}
+
+TEST_F(ExprTS, symbolTable)
+{
+    SymbolTable table;
+    const char * abc = table.intern("abcdef", 3);
+    ASSERT_TRUE(abc != NULL);
+    EXPECT_STREQ(abc, "abc");
+    EXPECT_EQ(table.intern("abc", 3), abc);
+    EXPECT_NE(table.intern("abd", 3), abc);
+    EXPECT_STREQ(table.intern("", 0), "");
+    EXPECT_EQ(table.size(), 3U);
+
+    // a long one gets a block of its own, the others are not moved
+    std::string long_name(100000, 'x');
+    const char * x = table.intern(long_name.data(), long_name.size());
+    EXPECT_EQ(strlen(x), long_name.size());
+    EXPECT_EQ(table.intern("abc", 3), abc);
+
+    // symbols share the text, strings do not
+    AtomPtr sym = Atom::create("abc", 3, &table);
+    AtomPtr sym2 = Atom::create("abc", 3, &table);
+    AtomPtr str = Atom::create("\"abc\"", 5, &table);
+    AtomPtr num = Atom::create("123", 3, &table);
+    EXPECT_EQ(sym->to_cstr(), abc);
+    EXPECT_EQ(sym2->to_cstr(), abc);
+    EXPECT_TRUE(str->is_quoted_cstr());
+    EXPECT_NE(str->to_cstr(), abc);
+    EXPECT_TRUE(num->is_i32());
+    EXPECT_EQ(table.size(), 4U);
+
+    // an interned text is never written to nor freed by the atom
+    EXPECT_TRUE(sym->parse("\"longer string\"", 15));
+    EXPECT_STREQ(sym->to_cstr(), "longer string");
+    EXPECT_TRUE(sym2->parse("if", 2, &table));
+    EXPECT_STREQ(sym2->to_cstr(), "if");
+    EXPECT_STREQ(abc, "abc");
+}
+
+TEST_F(ExprTS, symbolTableConcurrent)
+{
+    SymbolTable table;
+    const int THREADS = 4;
+    const int N = 20000;
+
+    // every thread interns the same names, in a different order
+    std::vector<std::vector<const char *> > results(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.push_back(std::thread([&table, &results, t, N]() {
+            std::vector<const char *> &texts = results[t];
+            texts.resize(N);
+            for (int k = 0; k < N; ++k) {
+                int i = (k * 7919 + t * 104729) % N;
+                char name[32];
+                int len = snprintf(name, sizeof(name), "symbol-%d", i);
+                texts[i] = table.intern(name, len);
+            }
+        }));
+    }
+    for (int t = 0; t < THREADS; ++t) {
+        threads[t].join();
+    }
+
+    EXPECT_EQ(table.size(), static_cast<size_t>(N));
+    for (int i = 0; i < N; ++i) {
+        char name[32];
+        snprintf(name, sizeof(name), "symbol-%d", i);
+        ASSERT_STREQ(results[0][i], name);
+        for (int t = 1; t < THREADS; ++t) {
+            ASSERT_EQ(results[t][i], results[0][i]);
+        }
+    }
+}
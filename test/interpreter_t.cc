@@ -6,13 +6,34 @@
  * date created:        Sat Nov 22 23:15:18 2014 CST
  */
 
+#include <signal.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include "solarwindlisp.h"
 
 using SolarWindLisp::SimpleInterpreter;
+using SolarWindLisp::SimpleParser;
 using SolarWindLisp::MatterIF;
 using SolarWindLisp::Atom;
 using SolarWindLisp::MatterPtr;
+using SolarWindLisp::CycleCollector;
+using SolarWindLisp::FrameStack;
+using SolarWindLisp::Proc;
+using SolarWindLisp::ScopedEnvPtr;
+using SolarWindLisp::WorkerPool;
+using SolarWindLisp::InterpreterPool;
+using SolarWindLisp::PreparedExpr;
+using SolarWindLisp::ParseCache;
+using SolarWindLisp::BatchExpr;
+using SolarWindLisp::BatchResult;
+using SolarWindLisp::Column;
 
 #define verbose_print(fmt, ...)                                 \
 do {                                                            \
@@ -267,6 +288,11 @@ TEST_F(FunctionalProgrammingTS, case_fcompose_and_closure)
         { "(add-by-10 100)",            100 + 10 },
         { "(add-by-20 100)",            100 + 20 },
         { "((fcompose mul-by-2 add-by-10) 100)",        100 * 2 + 10 },
+        // free variables of nested lambdas, and shadowing
+        { "((((lambda (a) (lambda (b) (lambda (c) (+ a b c)))) 1) 2) 3)", 6 },
+        { "(((lambda (x) (let (x 2) (lambda () x))) 1))", 2 },
+        { "(((lambda (x) (lambda (x) x)) 1) 5)", 5 },
+        { "(((lambda (n) (lambda (v) (let (m (* n 2)) (+ m v)))) 3) 1)", 7 },
 
     };
 
@@ -442,6 +468,13 @@ TEST_F(FunctionalProgrammingTS, case_conditional)
           "    0 111"
           "    false 222"
           "    \"default\" 333)", 333 },
+        // the same truth for all the conditionals
+        { "(if car 444 0)", 444 },
+        { "(when car 444)", 444 },
+        { "(cond car 444 true 0)", 444 },
+        { "(if (list) 0 555)", 555 },
+        { "(cond (list) 0 (list 1) 555)", 555 },
+        { "(when (vector 1) 555)", 555 },
     };
 
     run_lisp_test_cases(lisp_test_cases, array_size(lisp_test_cases));
@@ -464,8 +497,1489 @@ TEST_F(FunctionalProgrammingTS, case_let)
           "    (* a b))", 27 },
         { "(min-add-product 3 5)", 18 },
         { "(min-add-product (+ 3 7) (* 2 6))", 130 },
+        // closures escaping from `let'
+        { "((let (x 5) (lambda () x)))", 5 },
+        { "((let (n 10) (lambda (v) (+ v n))) 5)", 15 },
     };
 
     run_user_forms(forms, array_size(forms));
     run_lisp_test_cases(lisp_test_cases, array_size(lisp_test_cases));
 }
+
+TEST_F(FunctionalProgrammingTS, case_lists)
+{
+    const char * forms[] = {
+        "(define from1to5 (list 1 2 3 4 5))",
+        "(define quoted (quote (10 (20 30) 40)))",
+        "(defn sum-list (l) (if l (+ (car l) (sum-list (cdr l))) 0))",
+        "(defn map-list (f l) (if l (cons (f (car l)) (map-list f (cdr l))) (list)))",
+    };
+
+    LispTestCases lisp_test_cases[] = {
+        { "(car from1to5)", 1 },
+        { "(car (cdr from1to5))", 2 },
+        { "(nth from1to5 2)", 3 },
+        { "(length from1to5)", 5 },
+        { "(length (list))", 0 },
+        { "(length (cons 0 from1to5))", 6 },
+        { "(car (reverse from1to5))", 5 },
+        { "(nth (reverse from1to5) 4)", 1 },
+        { "(sum-list from1to5)", 15 },
+        { "(sum-list (map-list square from1to5))", 55 },
+        { "(if (cdr (list 1)) 1 2)", 2 },
+        { "(length quoted)", 3 },
+        { "(car (nth quoted 1))", 20 },
+        { "(nth (nth quoted 1) 1)", 30 },
+    };
+
+    run_user_forms(forms, array_size(forms));
+    run_lisp_test_cases(lisp_test_cases, array_size(lisp_test_cases));
+
+    const char * bad_cases[] = {
+        "(car (list))",
+        "(cdr 5)",
+        "(nth from1to5 5)",
+        "(nth from1to5 -1)",
+        "(length (cons 1 2))",
+    };
+    for (size_t i = 0; i < array_size(bad_cases); ++i) {
+        MatterPtr result = NULL;
+        EXPECT_FALSE(_interpreter.execute(result, bad_cases[i],
+                strlen(bad_cases[i])));
+    }
+
+    MatterPtr result = NULL;
+    const char * str = "(quote (a (b \"c\") 1.5))";
+    EXPECT_TRUE(_interpreter.execute(result, str, strlen(str)));
+    EXPECT_TRUE(result != NULL && result->is_pair());
+    EXPECT_EQ(result->to_string(), "(`a' (`b' `c') 1.5)");
+}
+
+TEST_F(FunctionalProgrammingTS, case_vectors)
+{
+    const char * forms[] = {
+        "(define ints (vector 1 2 3 4 5 6 7 8 9 10))",
+        "(define reals (vector 0.5 1.5 -2.5))",
+        "(define mixed (vector 1 2.5))",
+        "(define big (make-vector 1000 3))",
+    };
+
+    LispTestCases lisp_test_cases[] = {
+        { "(vec-len ints)", 10 },
+        { "(vec-len (vector))", 0 },
+        { "(vec-ref ints 0)", 1 },
+        { "(vec-ref mixed 0)", 1 },
+        { "(vec-ref mixed 1)", 2.5 },
+        { "(vec-sum ints)", 55 },
+        { "(vec-sum reals)", -0.5 },
+        { "(vec-sum (vector))", 0 },
+        { "(vec-sum big)", 3000 },
+        { "(vec-dot ints ints)", 385 },
+        { "(vec-dot reals (vector 2 2 2))", -1 },
+        { "(vec-min ints)", 1 },
+        { "(vec-max ints)", 10 },
+        { "(vec-min reals)", -2.5 },
+        { "(vec-max reals)", 1.5 },
+        { "(vec-sum (vec-map+ ints ints))", 110 },
+        { "(vec-ref (vec-map+ mixed (vector 1 1)) 1)", 3.5 },
+        { "(vec-sum (vec-scale ints 3))", 165 },
+        { "(vec-sum (vec-scale ints 0.5))", 27.5 },
+        { "(vec-sum (make-vector 4 0.25))", 1 },
+        { "(vec-sum (list->vector (list 1 2 3)))", 6 },
+        { "(if (vector) 1 2)", 2 },
+        { "(if ints 1 2)", 1 },
+    };
+
+    run_user_forms(forms, array_size(forms));
+    run_lisp_test_cases(lisp_test_cases, array_size(lisp_test_cases));
+
+    const char * bad_cases[] = {
+        "(vector 1 \"a\")",
+        "(vec-min (vector))",
+        "(vec-ref ints 10)",
+        "(vec-ref ints -1)",
+        "(vec-dot ints reals)",
+        "(vec-map+ ints 1)",
+        "(vec-sum (list 1 2))",
+        "(make-vector -1)",
+    };
+    for (size_t i = 0; i < array_size(bad_cases); ++i) {
+        MatterPtr result = NULL;
+        EXPECT_FALSE(_interpreter.execute(result, bad_cases[i],
+                strlen(bad_cases[i])));
+    }
+
+    MatterPtr result = NULL;
+    const char * str = "(vec-scale (vector 1 2 3) 2)";
+    EXPECT_TRUE(_interpreter.execute(result, str, strlen(str)));
+    EXPECT_TRUE(result != NULL && result->is_vector());
+    EXPECT_EQ(result->to_string(), "[2 4 6]");
+}
+
+TEST_F(FunctionalProgrammingTS, case_hash_maps)
+{
+    const char * forms[] = {
+        "(define table (hash-map 1 10 \"two\" 20 (quote three) 30 4.5 40))",
+        "(defn fill (m i n) (if (< i n) (fill (assoc! m i (* i i)) (inc i) n) m))",
+        "(define squares (fill (hash-map) 0 1000))",
+    };
+
+    LispTestCases lisp_test_cases[] = {
+        { "(get table 1)", 10 },
+        { "(get table \"two\")", 20 },
+        { "(get table (quote three))", 30 },
+        { "(get table 4.5)", 40 },
+        { "(get table \"three\" 0)", 0 },
+        { "(get table 2 -1)", -1 },
+        { "(if (get table 2) 1 2)", 2 },
+        { "(if (contains? table 1) 1 2)", 1 },
+        { "(if (contains? table \"three\") 1 2)", 2 },
+        { "(count table)", 4 },
+        { "(count squares)", 1000 },
+        { "(get squares 999)", 998001 },
+        { "(count (assoc! (hash-map) 1 1 1 2 2 3))", 2 },
+        { "(get (assoc! (hash-map 1 1) 1 2) 1)", 2 },
+        { "(count (dissoc! (hash-map 1 1 2 2 3 3) 1 3 5))", 1 },
+        { "(count (list 1 2 3))", 3 },
+        { "(count (vector 1 2))", 2 },
+        { "(if (hash-map) 1 2)", 2 },
+    };
+
+    run_user_forms(forms, array_size(forms));
+    run_lisp_test_cases(lisp_test_cases, array_size(lisp_test_cases));
+
+    const char * bad_cases[] = {
+        "(hash-map 1)",
+        "(hash-map (list 1) 2)",
+        "(get (list 1) 1)",
+        "(assoc! table 1)",
+        "(count 5)",
+    };
+    for (size_t i = 0; i < array_size(bad_cases); ++i) {
+        MatterPtr result = NULL;
+        EXPECT_FALSE(_interpreter.execute(result, bad_cases[i],
+                strlen(bad_cases[i])));
+    }
+}
+
+TEST_F(FunctionalProgrammingTS, case_persistent_maps)
+{
+    const char * forms[] = {
+        "(define base (persistent-map \"a\" 1 \"b\" 2 (quote c) 3))",
+        "(define derived (assoc base \"a\" 10 \"d\" 4))",
+        "(define trimmed (dissoc derived \"b\" (quote c)))",
+        "(defn fill (m i n) (if (< i n) (fill (assoc m i (* i 2)) (inc i) n) m))",
+        "(define big (fill (persistent-map) 0 1000))",
+    };
+
+    LispTestCases lisp_test_cases[] = {
+        { "(count base)", 3 },
+        { "(count derived)", 4 },
+        { "(count trimmed)", 2 },
+        { "(get base \"a\")", 1 },
+        { "(get derived \"a\")", 10 },
+        { "(get trimmed \"a\")", 10 },
+        { "(get base \"d\" -1)", -1 },
+        { "(get base (quote c))", 3 },
+        { "(if (contains? derived \"d\") 1 2)", 1 },
+        { "(if (contains? trimmed \"b\") 1 2)", 2 },
+        { "(count big)", 1000 },
+        { "(get big 999)", 1998 },
+        { "(count (dissoc big 1 2 3 1000))", 997 },
+        { "(count (dissoc (persistent-map 0 0 22 22 30 30) 0 22 30))", 0 },
+        { "(count big)", 1000 },
+        { "(if (persistent-map) 1 2)", 2 },
+        { "(if (dissoc (persistent-map 1 1) 1) 1 2)", 2 },
+    };
+
+    run_user_forms(forms, array_size(forms));
+    run_lisp_test_cases(lisp_test_cases, array_size(lisp_test_cases));
+
+    const char * bad_cases[] = {
+        "(persistent-map 1)",
+        "(assoc (hash-map) 1 1)",
+        "(assoc base (list 1) 1)",
+        "(dissoc 1 1)",
+    };
+    for (size_t i = 0; i < array_size(bad_cases); ++i) {
+        MatterPtr result = NULL;
+        EXPECT_FALSE(_interpreter.execute(result, bad_cases[i],
+                strlen(bad_cases[i])));
+    }
+}
+
+TEST(SharedFormsTS, reentrantAndConcurrent)
+{
+    // the parsed forms are immutable, evaluate the same tree recursively, and
+    // from several threads at the same time.
+    const char * str =
+        "(defn sum-to (n) (if (= n 0) 0 (+ n (sum-to (- n 1)))))"
+        "(defn fibonacci (n)"
+        "    (if (<= n 2)"
+        "        1"
+        "        (+ (fibonacci (- n 1)) (fibonacci (- n 2)))))"
+        "(+ (sum-to 100) (fibonacci 15))";
+    SimpleParser parser;
+    MatterPtr forms = parser.parse(str, strlen(str));
+    ASSERT_TRUE(forms != NULL);
+
+    static const size_t N_THREADS = 4;
+    std::vector<long double> values(N_THREADS, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < N_THREADS; ++i) {
+        threads.push_back(std::thread([&forms, &values, i]() {
+            SimpleInterpreter interpreter;
+            MatterPtr result = NULL;
+            if (interpreter.initialize()
+                    && interpreter.execute_multi_expr(result, forms)
+                    && result && result->is_atom()) {
+                static_cast<const Atom *>(result.get())->to_long_double(
+                        values[i]);
+            }
+        }));
+    }
+
+    for (size_t i = 0; i < N_THREADS; ++i) {
+        threads[i].join();
+        EXPECT_EQ(values[i], 5050 + 610);
+    }
+}
+
+TEST(CycleCollectorTS, collectCycles)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    interpreter.collector().set_threshold(0);
+
+    // a closure which refers to itself through the env of `let'
+    MatterPtr result = NULL;
+    const char * str = "(let (g (lambda (x) (if (> x 0) (g (- x 1)) 0))) g)";
+    ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    ASSERT_TRUE(result != NULL && result->is_proc());
+
+    boost::weak_ptr<MatterIF> closure = result;
+    result = NULL;
+    EXPECT_FALSE(closure.expired());
+    EXPECT_GE(interpreter.collector().collect(), 2U);
+    EXPECT_TRUE(closure.expired());
+
+    // procs and envs referenced from the global env are alive
+    const char * defs = "(defn countdown (n) (if (> n 0) (countdown (- n 1)) 0))";
+    EXPECT_TRUE(interpreter.execute(result, defs, strlen(defs)));
+    interpreter.collector().collect();
+    str = "(countdown 10)";
+    EXPECT_TRUE(interpreter.execute(result, str, strlen(str)));
+    EXPECT_TRUE(result != NULL && result->is_atom());
+
+    const CycleCollector::Stats &stats = interpreter.collector().stats();
+    EXPECT_EQ(stats.collections, 2U);
+    EXPECT_GE(stats.collected, 2U);
+    EXPECT_GE(stats.total_pause_usec, stats.max_pause_usec);
+}
+
+TEST(CycleCollectorTS, automaticCollection)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    interpreter.collector().set_threshold(500);
+
+    const char * str = "(let (loop (lambda (n) (if (> n 0) (loop (- n 1)) 0))) (loop 5))";
+    size_t max_tracked = 0;
+    for (int i = 0; i < 2000; ++i) {
+        MatterPtr result = NULL;
+        EXPECT_TRUE(interpreter.execute(result, str, strlen(str)));
+        if (interpreter.collector().stats().tracked > max_tracked) {
+            max_tracked = interpreter.collector().stats().tracked;
+        }
+    }
+
+    // the garbage does not pile up
+    const CycleCollector::Stats &stats = interpreter.collector().stats();
+    EXPECT_GT(stats.collections, 10U);
+    EXPECT_GT(stats.collected, 2000U);
+    EXPECT_LT(max_tracked, 500U);
+
+    // disabled
+    interpreter.collector().set_threshold(0);
+    size_t collections = stats.collections;
+    for (int i = 0; i < 1000; ++i) {
+        MatterPtr result = NULL;
+        EXPECT_TRUE(interpreter.execute(result, str, strlen(str)));
+    }
+    EXPECT_EQ(stats.collections, collections);
+}
+
+TEST(FrameStackTS, stackFrames)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+
+    MatterPtr result = NULL;
+    const char * str =
+        "(defn sum-to (n) (if (= n 0) 0 (+ n (sum-to (- n 1)))))"
+        "(sum-to 500)";
+    ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    ASSERT_TRUE(result != NULL && result->is_atom());
+    long double value = 0;
+    static_cast<const Atom *>(result.get())->to_long_double(value);
+    EXPECT_EQ(value, 125250);
+
+    const FrameStack::Stats &stats = interpreter.frames().stats();
+    EXPECT_EQ(stats.frames, 501U);
+    EXPECT_EQ(stats.retirements, 0U);
+
+    // the chunks are reused
+    size_t chunks = stats.chunks;
+    str = "(sum-to 10)";
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    }
+    EXPECT_EQ(stats.chunks, chunks);
+    EXPECT_EQ(stats.frames, 501U + 100 * 11);
+}
+
+TEST(FrameStackTS, capturingFrames)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+
+    // frames captured by closures are on the heap
+    MatterPtr result = NULL;
+    const char * str =
+        "(defn make-adder (n) (lambda (x) (+ x n)))"
+        "(define add3 (make-adder 3))"
+        "(add3 4)";
+    ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    ASSERT_TRUE(result != NULL && result->is_atom());
+    int64_t value = 0;
+    static_cast<const Atom *>(result.get())->to_i64(value);
+    EXPECT_EQ(value, 7);
+    // only the frame of add3 is on the stack
+    EXPECT_EQ(interpreter.frames().stats().frames, 1U);
+
+    // the frame of `wrap' escapes in the unrealized result of `ident'
+    str = "(defn ident (x) x)"
+        "(defn wrap (y) (ident (+ y 1)))"
+        "(+ (wrap 1) (wrap 2))";
+    ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    ASSERT_TRUE(result != NULL && result->is_atom());
+    static_cast<const Atom *>(result.get())->to_i64(value);
+    EXPECT_EQ(value, 5);
+    EXPECT_EQ(interpreter.frames().stats().retirements, 2U);
+}
+
+TEST(FlatClosureTS, captureFreeVariablesOnly)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+
+    MatterPtr result = NULL;
+    const char * str =
+        "(defn make-adder (n)"
+        "    (let (big (make-vector 10000 0) delta (* n 2))"
+        "        (lambda (v) (+ delta v))))"
+        "(make-adder 5)";
+    ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    ASSERT_TRUE(result != NULL && result->is_proc());
+
+    // only `delta' is captured, the frame of make-adder, `big' and `n' are
+    // not referenced
+    ScopedEnvPtr env = NULL;
+    static_cast<Proc *>(result.get())->get_env(env);
+    MatterPtr value = NULL;
+    EXPECT_TRUE(env->lookup_local("delta", value));
+    EXPECT_FALSE(env->lookup_local("big", value));
+    EXPECT_FALSE(env->lookup_local("n", value));
+    EXPECT_FALSE(env->lookup_local("v", value));
+    EXPECT_TRUE(env->external() == interpreter.env());
+
+    // no free variables, the global env is used
+    str = "((lambda () (lambda (x) (+ x 1))))";
+    ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    ASSERT_TRUE(result != NULL && result->is_proc());
+    static_cast<Proc *>(result.get())->get_env(env);
+    EXPECT_TRUE(env == interpreter.env());
+
+    // recursive lambdas of `let' refer to names not bound yet, not converted
+    str = "(let (f (lambda (n) (if (> n 0) (f (- n 1)) 0))) f)";
+    ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    ASSERT_TRUE(result != NULL && result->is_proc());
+    static_cast<Proc *>(result.get())->get_env(env);
+    EXPECT_TRUE(env->lookup_local("f", value));
+
+    // nor if a global name may be hidden by a local binding made later
+    str = "(let (inc (lambda (n) (if (> n 0) (inc (- n 1)) 0))) (inc 3))";
+    ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    ASSERT_TRUE(result != NULL);
+    EXPECT_EQ(result->to_string(), "0");
+    str = "(define x 1)"
+          "(defn outer () (do (define f (lambda () x)) (define x 2) (f)))"
+          "(outer)";
+    ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    ASSERT_TRUE(result != NULL);
+    EXPECT_EQ(result->to_string(), "2");
+    str = "(defn outer2 (y) (let (g (lambda () (+ x y))) (define x 5) (g)))"
+          "(outer2 10)";
+    ASSERT_TRUE(interpreter.execute(result, str, strlen(str)));
+    ASSERT_TRUE(result != NULL);
+    EXPECT_EQ(result->to_string(), "15");
+}
+
+namespace
+{
+
+std::string temp_snapshot_name()
+{
+    char name[] = "/tmp/swl-snapshot-t-XXXXXX";
+    int fd = mkstemp(name);
+    if (fd >= 0) {
+        close(fd);
+    }
+    return name;
+}
+
+// of every kind of object, shared ones, cycles, and an unrealized future
+const char * SNAPSHOT_DEFINITIONS =
+    "(define answer 42)"
+    "(define greeting \"hello, world\")"
+    "(define big 12345678901234)"
+    "(define half 0.5)"
+    "(define third (/ 1 3))"
+    "(define yes true)"
+    "(defn fact (n) (if (<= n 1) 1 (* n (fact (- n 1)))))"
+    "(defn make-adder (n) (lambda (x) (+ x n)))"
+    "(define add3 (make-adder 3))"
+    "(define counter (let (step 2 next (lambda (v) (+ v step))) next))"
+    "(define lst (quote (1 2 (3 4) \"five\" six)))"
+    "(define squares (list 1 4 9 16))"
+    "(define vec (make-vector 100 7))"
+    "(define reals (vector 0.5 1.5 2.5))"
+    "(define table (hash-map 1 10 \"two\" 20))"
+    "(assoc! table 3 table)"
+    "(define pm (persistent-map 1 (quote (a b)) 2 add3))"
+    "(define plus +)"
+    "(defn ident (x) x)"
+    "(define lazy (ident (+ 1 2)))";
+
+} // anonymous namespace
+
+TEST(HeapSnapshotTS, roundTrip)
+{
+    SimpleInterpreter original;
+    ASSERT_TRUE(original.initialize());
+    MatterPtr result = NULL;
+    ASSERT_TRUE(original.execute(result, SNAPSHOT_DEFINITIONS));
+
+    std::string snapshot = temp_snapshot_name();
+    ASSERT_TRUE(original.save_snapshot(snapshot.c_str()));
+
+    SimpleInterpreter restored;
+    ASSERT_TRUE(restored.initialize(snapshot.c_str()));
+    EXPECT_EQ(restored.env()->size(), original.env()->size());
+
+    const char * exprs[] = {
+        "answer", "greeting", "big", "half", "third", "yes", "math-pi",
+        "(fact 10)", "(add3 4)", "(counter 5)", "(max3 1 5 3)", "(xor true false)",
+        "(length lst)", "(car (cdr (cdr lst)))", "(nth lst 4)", "(nth squares 3)",
+        "(vec-sum vec)", "(vec-ref reals 2)",
+        "(get table 1)", "(get (get (get table 3) 3) \"two\")",
+        "(count pm)", "(car (cdr (get pm 1)))", "((get pm 2) 10)",
+        "(plus 1 2)", "lazy", "(+ lazy 1)",
+    };
+    for (size_t i = 0; i < array_size(exprs); ++i) {
+        MatterPtr expected = NULL;
+        MatterPtr actual = NULL;
+        ASSERT_TRUE(original.execute(expected, exprs[i])) << exprs[i];
+        ASSERT_TRUE(restored.execute(actual, exprs[i])) << exprs[i];
+        ASSERT_TRUE(expected != NULL && actual != NULL) << exprs[i];
+        EXPECT_EQ(actual->to_string(), expected->to_string()) << exprs[i];
+        EXPECT_EQ(actual->matter_type(), expected->matter_type()) << exprs[i];
+    }
+
+    // the cycle through the hash map, and the primitives, are kept
+    MatterPtr table = NULL;
+    ASSERT_TRUE(restored.execute(table, "table"));
+    ASSERT_TRUE(restored.execute(result, "(get table 3)"));
+    EXPECT_TRUE(result == table);
+    MatterPtr plus = NULL;
+    ASSERT_TRUE(restored.execute(plus, "plus"));
+    ASSERT_TRUE(restored.execute(result, "+"));
+    EXPECT_TRUE(result == plus);
+
+    // the closure converted env refers to the global env restored
+    ASSERT_TRUE(restored.execute(result, "counter"));
+    ASSERT_TRUE(result != NULL && result->is_proc());
+    ScopedEnvPtr env = NULL;
+    static_cast<Proc *>(result.get())->get_env(env);
+    EXPECT_TRUE(env->external() == restored.env());
+
+    // and the restored interpreter works as usual
+    ASSERT_TRUE(restored.execute(result, "(define y (fact 5)) (+ y answer)"));
+    ASSERT_TRUE(result != NULL && result->is_atom());
+    int64_t value = 0;
+    static_cast<const Atom *>(result.get())->to_i64(value);
+    EXPECT_EQ(value, 162);
+
+    // a snapshot of the restored one is the same
+    std::string again = temp_snapshot_name();
+    EXPECT_TRUE(restored.save_snapshot(again.c_str()));
+    SimpleInterpreter third;
+    EXPECT_TRUE(third.initialize(again.c_str()));
+    ASSERT_TRUE(third.execute(result, "(+ y (fact 6))"));
+    static_cast<const Atom *>(result.get())->to_i64(value);
+    EXPECT_EQ(value, 840);
+
+    // cycles through maps are not collected
+    EXPECT_TRUE(original.execute(result, "(dissoc! table 3)"));
+    EXPECT_TRUE(restored.execute(result, "(dissoc! table 3)"));
+    EXPECT_TRUE(third.execute(result, "(dissoc! table 3)"));
+    unlink(snapshot.c_str());
+    unlink(again.c_str());
+}
+
+TEST(HeapSnapshotTS, builtinEnvNotSaved)
+{
+    SimpleInterpreter original;
+    ASSERT_TRUE(original.initialize());
+    MatterPtr result = NULL;
+    ASSERT_TRUE(original.execute(result, "(define my-inc inc) (define c 1)"));
+    std::string snapshot = temp_snapshot_name();
+    ASSERT_TRUE(original.save_snapshot(snapshot.c_str()));
+
+    SimpleInterpreter restored;
+    ASSERT_TRUE(restored.initialize(snapshot.c_str()));
+    EXPECT_TRUE(restored.env()->external() == SimpleInterpreter::builtin_env());
+    EXPECT_EQ(restored.env()->size(), 2u);
+    ASSERT_TRUE(restored.execute(result, "(my-inc (inc c))"));
+    EXPECT_EQ(result->to_string(), "3");
+
+    // the builtin env alone is not a snapshot
+    EXPECT_FALSE(SolarWindLisp::HeapSnapshot::save(snapshot.c_str(),
+            SimpleInterpreter::builtin_env(),
+            SimpleInterpreter::builtin_env()));
+    unlink(snapshot.c_str());
+}
+
+TEST(HeapSnapshotTS, staleOrCorrupted)
+{
+    SimpleInterpreter original;
+    ASSERT_TRUE(original.initialize());
+    MatterPtr result = NULL;
+    ASSERT_TRUE(original.execute(result, SNAPSHOT_DEFINITIONS));
+
+    std::string snapshot = temp_snapshot_name();
+    ASSERT_TRUE(original.save_snapshot(snapshot.c_str()));
+
+    {
+        SimpleInterpreter missing;
+        EXPECT_FALSE(missing.initialize("/nonexistent/x.swls"));
+        EXPECT_TRUE(missing.initialize());
+        // there is a global env already
+        EXPECT_FALSE(missing.initialize(snapshot.c_str()));
+    }
+
+    // every byte flipped in turn, or the file truncated
+    FILE * fp = fopen(snapshot.c_str(), "rb");
+    ASSERT_TRUE(fp != NULL);
+    std::string content;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        content.append(buf, n);
+    }
+    fclose(fp);
+
+    std::string corrupted_name = temp_snapshot_name();
+    for (size_t i = 0; i < content.size(); i += 1 + i / 16) {
+        for (int truncate = 0; truncate < 2; ++truncate) {
+            std::string corrupted = truncate ? content.substr(0, i) : content;
+            if (!truncate) {
+                corrupted[i] ^= 0x40;
+            }
+            fp = fopen(corrupted_name.c_str(), "wb");
+            ASSERT_TRUE(fp != NULL);
+            fwrite(corrupted.data(), 1, corrupted.size(), fp);
+            fclose(fp);
+            SimpleInterpreter interpreter;
+            ASSERT_FALSE(interpreter.initialize(corrupted_name.c_str()))
+                    << "byte " << i;
+        }
+    }
+
+    EXPECT_TRUE(original.execute(result, "(dissoc! table 3)"));
+    unlink(snapshot.c_str());
+    unlink(corrupted_name.c_str());
+}
+
+TEST(WorkerPoolTS, freeze)
+{
+    SimpleInterpreter original;
+    ASSERT_TRUE(original.initialize());
+    MatterPtr result = NULL;
+    ASSERT_TRUE(original.execute(result, SNAPSHOT_DEFINITIONS));
+    SimpleInterpreter frozen;
+    ASSERT_TRUE(frozen.initialize());
+    ASSERT_TRUE(frozen.execute(result, SNAPSHOT_DEFINITIONS));
+    ScopedEnvPtr before = frozen.env();
+    MatterPtr table = NULL;
+    ASSERT_TRUE(frozen.execute(table, "table"));
+    ASSERT_TRUE(frozen.freeze());
+    EXPECT_TRUE(frozen.env() != before);
+    EXPECT_EQ(frozen.env()->size(), original.env()->size());
+
+    const char * exprs[] = {
+        "answer", "greeting", "third", "math-pi", "(fact 10)", "(add3 4)",
+        "(counter 5)", "(max3 1 5 3)", "(nth lst 4)", "(vec-sum vec)",
+        "(get (get (get table 3) 3) \"two\")", "((get pm 2) 10)", "lazy",
+        "(define y (fact 5))", "(+ y answer)",
+    };
+    for (size_t i = 0; i < array_size(exprs); ++i) {
+        MatterPtr expected = NULL;
+        MatterPtr actual = NULL;
+        ASSERT_TRUE(original.execute(expected, exprs[i])) << exprs[i];
+        ASSERT_TRUE(frozen.execute(actual, exprs[i])) << exprs[i];
+        ASSERT_EQ(expected == NULL, actual == NULL) << exprs[i];
+        if (expected) {
+            EXPECT_EQ(actual->to_string(), expected->to_string()) << exprs[i];
+        }
+    }
+
+    // the procedures of the frozen env refer to it
+    ASSERT_TRUE(frozen.execute(result, "counter"));
+    ASSERT_TRUE(result != NULL && result->is_proc());
+    ScopedEnvPtr env = NULL;
+    static_cast<Proc *>(result.get())->get_env(env);
+    EXPECT_TRUE(env->external() == frozen.env());
+
+    // the table copied is another one, cycles through maps are not collected
+    ASSERT_TRUE(frozen.execute(result, "(get table 3)"));
+    EXPECT_TRUE(result != table);
+    ASSERT_TRUE(frozen.execute(result, "3"));
+    EXPECT_TRUE(static_cast<SolarWindLisp::HashMap *>(table.get())
+            ->erase(result));
+    EXPECT_TRUE(original.execute(result, "(dissoc! table 3)"));
+}
+
+TEST(WorkerPoolTS, execute)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    MatterPtr result = NULL;
+    ASSERT_TRUE(interpreter.execute(result,
+            "(defn sq (x) (* x x)) (define base 10)"));
+    ASSERT_TRUE(interpreter.freeze());
+
+    WorkerPool pool(&interpreter, 2);
+    std::vector<std::string> requests;
+    std::vector<std::string> responses;
+    EXPECT_FALSE(pool.execute(requests, responses));
+    ASSERT_TRUE(pool.start());
+    EXPECT_FALSE(pool.start());
+    ASSERT_EQ(pool.workers(), 2u);
+
+    requests.push_back("(sq 7)");
+    requests.push_back("(+ base 1)");
+    requests.push_back("(no-such-proc 1)");
+    requests.push_back("(let (z 2) (* z (sq 3)))");
+    requests.push_back("\"two\\nlines\"");
+    requests.push_back("(list 1 2 3)");
+    ASSERT_TRUE(pool.execute(requests, responses));
+    ASSERT_EQ(responses.size(), requests.size());
+    EXPECT_EQ(responses[0], "ok 49");
+    EXPECT_EQ(responses[1], "ok 11");
+    EXPECT_EQ(responses[2].substr(0, 5), "error");
+    EXPECT_EQ(responses[3], "ok 18");
+    EXPECT_EQ(responses[5], "ok (1 2 3)");
+
+    // nothing is executed by the parent
+    std::vector<std::string> define(1, "(define z 2)");
+    responses.clear();
+    ASSERT_TRUE(pool.execute(define, responses));
+    EXPECT_EQ(responses[0], "ok");
+    EXPECT_FALSE(interpreter.execute(result, "z"));
+
+    // a worker killed is forked again, as initialized, the request sent to
+    // it before it is gone fails
+    pid_t killed = pool.worker_pid(0);
+    ASSERT_EQ(kill(killed, SIGKILL), 0);
+    for (int round = 0; round < 3; ++round) {
+        responses.clear();
+        ASSERT_TRUE(pool.execute(requests, responses));
+        ASSERT_EQ(responses.size(), requests.size());
+        const char * died = round == 0 ? "error worker died" : "";
+        EXPECT_TRUE(responses[0] == "ok 49" || responses[0] == died);
+        EXPECT_TRUE(responses[3] == "ok 18" || responses[3] == died);
+    }
+    EXPECT_NE(pool.worker_pid(0), killed);
+    EXPECT_GT(pool.worker_pid(0), 0);
+
+    pool.stop();
+    EXPECT_EQ(pool.worker_pid(0), -1);
+    EXPECT_FALSE(pool.execute(requests, responses));
+}
+
+TEST(WorkerPoolTS, serve)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    MatterPtr result = NULL;
+    ASSERT_TRUE(interpreter.execute(result, "(defn sq (x) (* x x))"));
+
+    std::string path = temp_snapshot_name();
+    unlink(path.c_str());
+    WorkerPool pool(&interpreter, 2);
+    ASSERT_TRUE(pool.start());
+    volatile sig_atomic_t stopped = 0;
+    bool served = false;
+    std::thread server([&]() {
+        served = pool.serve(path.c_str(), &stopped);
+    });
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path.c_str());
+    const size_t CLIENTS = 3;
+    int fds[CLIENTS];
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        fds[i] = socket(AF_UNIX, SOCK_STREAM, 0);
+        ASSERT_GE(fds[i], 0);
+        int tries = 0;
+        while (connect(fds[i], reinterpret_cast<struct sockaddr *>(&address),
+                sizeof(address)) < 0 && ++tries < 500) {
+            usleep(10 * 1000);
+        }
+        ASSERT_LT(tries, 500);
+    }
+
+    // many requests per client, blank lines and a last line with no new line
+    std::string expected[CLIENTS];
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        std::string requests;
+        for (size_t n = 0; n < 50; ++n) {
+            char line[64];
+            snprintf(line, sizeof(line), "(sq %zu)\n%s", i * 100 + n,
+                    n % 10 ? "" : "\n");
+            requests += line;
+            snprintf(line, sizeof(line), "ok %zu\n", (i * 100 + n)
+                    * (i * 100 + n));
+            expected[i] += line;
+        }
+        requests += "(undefined-name)";
+        expected[i] += "error\n";
+        ASSERT_EQ(write(fds[i], requests.data(), requests.size()),
+                (ssize_t) requests.size());
+        shutdown(fds[i], SHUT_WR);
+    }
+
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        std::string responses;
+        char buffer[4096];
+        ssize_t got;
+        while ((got = read(fds[i], buffer, sizeof(buffer))) > 0) {
+            responses.append(buffer, got);
+        }
+        EXPECT_EQ(responses, expected[i]);
+        close(fds[i]);
+    }
+
+    stopped = 1;
+    server.join();
+    EXPECT_TRUE(served);
+    EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
+
+TEST(BuiltinEnvTS, shared)
+{
+    ScopedEnvPtr builtins = SimpleInterpreter::builtin_env();
+    ASSERT_TRUE(builtins != NULL);
+    EXPECT_TRUE(SimpleInterpreter::builtin_env() == builtins);
+    size_t names = builtins->size();
+    MatterPtr value = NULL;
+    EXPECT_TRUE(builtins->lookup_local("+", value));
+    EXPECT_TRUE(builtins->lookup_local("xor", value));
+    EXPECT_TRUE(builtins->lookup_local("math-pi", value));
+
+    SimpleInterpreter first;
+    SimpleInterpreter second;
+    ASSERT_TRUE(first.initialize());
+    ASSERT_TRUE(second.initialize());
+    EXPECT_TRUE(first.env() != second.env());
+    EXPECT_TRUE(first.env()->external() == builtins);
+    EXPECT_TRUE(second.env()->external() == builtins);
+    EXPECT_EQ(first.env()->size(), 0u);
+
+    // definitions go to the global env, and may shadow the builtin ones
+    MatterPtr result = NULL;
+    ASSERT_TRUE(first.execute(result,
+            "(define inc (lambda (x) (+ x 100))) (define only-first 1)"));
+    ASSERT_TRUE(first.execute(result, "(inc 1)"));
+    EXPECT_EQ(result->to_string(), "101");
+    ASSERT_TRUE(second.execute(result, "(inc 1)"));
+    EXPECT_EQ(result->to_string(), "2");
+    EXPECT_FALSE(second.execute(result, "only-first"));
+    EXPECT_EQ(builtins->size(), names);
+
+    // decided before any call, the procedures are never written to
+    struct Check
+    {
+        static bool decided(const std::string &name, const MatterPtr &value,
+                void * arg)
+        {
+            if (value->is_proc() && static_cast<Proc *>(value.get())
+                    ->frame_kind() == Proc::frame_unknown) {
+                ++*static_cast<size_t *>(arg);
+            }
+            return true;
+        }
+    };
+    size_t undecided = 0;
+    builtins->for_each(Check::decided, &undecided);
+    EXPECT_EQ(undecided, 0u);
+
+    // a private one, for an env given to the constructor
+    ScopedEnvPtr own = SimpleInterpreter::create_builtin_env();
+    ASSERT_TRUE(own != NULL && own != builtins);
+    EXPECT_EQ(own->size(), names);
+    own->clear();
+}
+
+TEST(BuiltinEnvTS, threads)
+{
+    const size_t THREADS = 8;
+    const size_t ROUNDS = 100;
+    std::vector<size_t> failures(THREADS, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.push_back(std::thread([t, &failures]() {
+            for (size_t i = 0; i < ROUNDS; ++i) {
+                SimpleInterpreter interpreter;
+                MatterPtr result = NULL;
+                char expr[128];
+                snprintf(expr, sizeof(expr), "(defn f (x) (max3 x (inc %zu) "
+                        "(min2 x 3))) (f %zu)", t, i);
+                if (!interpreter.initialize()
+                        || !interpreter.execute(result, expr) || !result
+                        || result->to_string() != std::to_string(
+                                std::max(i, t + 1))) {
+                    ++failures[t];
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads[t].join();
+        EXPECT_EQ(failures[t], 0u) << "thread " << t;
+    }
+}
+
+TEST(InterpreterPoolTS, checkpointAndReset)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    EXPECT_FALSE(interpreter.reset());
+
+    MatterPtr result = NULL;
+    ASSERT_TRUE(interpreter.execute(result,
+            "(define base 10) (defn add-base (x) (+ x base)) "
+            "(define table (hash-map 1 2))"));
+    ASSERT_TRUE(interpreter.checkpoint());
+
+    for (int round = 0; round < 3; ++round) {
+        ASSERT_TRUE(interpreter.execute(result,
+                "(define base 20) (defn twice (x) (* 2 x)) "
+                "(twice (add-base 1))"));
+        EXPECT_EQ(result->to_string(), "22");
+        ASSERT_TRUE(interpreter.reset());
+        // the definitions since the checkpoint are gone
+        EXPECT_FALSE(interpreter.execute(result, "(twice 1)"));
+        ASSERT_TRUE(interpreter.execute(result, "base"));
+        EXPECT_EQ(result->to_string(), "10");
+        ASSERT_TRUE(interpreter.reset());
+    }
+
+    // objects of the checkpoint modified in place stay modified
+    ASSERT_TRUE(interpreter.execute(result, "(assoc! table 3 4)"));
+    ASSERT_TRUE(interpreter.reset());
+    ASSERT_TRUE(interpreter.execute(result, "(count table)"));
+    EXPECT_EQ(result->to_string(), "2");
+    ASSERT_TRUE(interpreter.execute(result, "(dissoc! table 3)"));
+}
+
+TEST(InterpreterPoolTS, leases)
+{
+    InterpreterPool uninitialized(2);
+    EXPECT_FALSE(uninitialized.acquire());
+    InterpreterPool failing(2, "(undefined-proc 1)");
+    EXPECT_FALSE(failing.initialize());
+
+    InterpreterPool pool(2, "(define answer 42)");
+    ASSERT_TRUE(pool.initialize());
+    EXPECT_FALSE(pool.initialize());
+    EXPECT_EQ(pool.size(), 2u);
+
+    InterpreterPool::Lease first = pool.acquire();
+    InterpreterPool::Lease second = pool.try_acquire();
+    ASSERT_TRUE(first && second);
+    EXPECT_TRUE(first.get() != second.get());
+    EXPECT_FALSE(pool.try_acquire());
+
+    MatterPtr result = NULL;
+    ASSERT_TRUE(first->execute(result, "(define answer 0) answer"));
+    EXPECT_EQ(result->to_string(), "0");
+    ASSERT_TRUE(second->execute(result, "answer"));
+    EXPECT_EQ(result->to_string(), "42");
+
+    // returned, and reset
+    SolarWindLisp::InterpreterIF * interpreter = first.get();
+    first.release();
+    EXPECT_FALSE(first);
+    InterpreterPool::Lease third = pool.try_acquire();
+    ASSERT_TRUE(third);
+    EXPECT_TRUE(third.get() == interpreter);
+    ASSERT_TRUE(third->execute(result, "answer"));
+    EXPECT_EQ(result->to_string(), "42");
+
+    InterpreterPool::Lease moved(std::move(third));
+    EXPECT_FALSE(third);
+    EXPECT_TRUE(moved.get() == interpreter);
+
+    InterpreterPool::Stats stats = pool.stats();
+    EXPECT_EQ(stats.acquisitions, 3u);
+    EXPECT_EQ(stats.waits, 0u);
+    EXPECT_EQ(stats.in_use, 2u);
+    EXPECT_EQ(stats.max_in_use, 2u);
+    EXPECT_GT(stats.utilization, 0);
+    EXPECT_LE(stats.utilization, 1);
+}
+
+TEST(InterpreterPoolTS, threads)
+{
+    const size_t THREADS = 8;
+    const size_t ROUNDS = 200;
+    InterpreterPool pool(3, "(defn scale (x) (* x 10))");
+    ASSERT_TRUE(pool.initialize());
+
+    std::vector<size_t> failures(THREADS, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.push_back(std::thread([t, &pool, &failures]() {
+            for (size_t i = 0; i < ROUNDS; ++i) {
+                InterpreterPool::Lease lease = pool.acquire();
+                MatterPtr result = NULL;
+                char expr[128];
+                // a leftover `offset' of another request would be seen
+                snprintf(expr, sizeof(expr), "(define offset %zu) "
+                        "(+ offset (scale %zu))", t, i);
+                if (!lease || !lease->execute(result, expr) || !result
+                        || result->to_string() != std::to_string(
+                                t + i * 10)
+                        || lease->env()->size() != 1) {
+                    ++failures[t];
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads[t].join();
+        EXPECT_EQ(failures[t], 0u) << "thread " << t;
+    }
+
+    InterpreterPool::Stats stats = pool.stats();
+    EXPECT_EQ(stats.acquisitions, THREADS * ROUNDS);
+    EXPECT_EQ(stats.in_use, 0u);
+    EXPECT_LE(stats.max_in_use, 3u);
+    EXPECT_LE(stats.waits, stats.acquisitions);
+    EXPECT_GE(stats.total_wait_usec, stats.max_wait_usec);
+    EXPECT_GT(stats.utilization, 0);
+}
+
+TEST(PreparedExprTS, evalWithBindings)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    MatterPtr result = NULL;
+    ASSERT_TRUE(interpreter.execute(result, "(define rate 10)"));
+    size_t names = interpreter.env()->size();
+
+    std::vector<std::string> params;
+    params.push_back("x");
+    params.push_back("y");
+    PreparedExpr rule = interpreter.prepare("(+ (* x rate) y)", params);
+    ASSERT_TRUE(rule);
+    EXPECT_TRUE(rule.interpreter() == &interpreter);
+    EXPECT_EQ(rule.params().size(), 2u);
+
+    for (int64_t i = 0; i < 100; ++i) {
+        SolarWindLisp::AtomPtr x = Atom::create();
+        SolarWindLisp::AtomPtr y = Atom::create();
+        x->set_i64(i);
+        y->set_i64(-i);
+        std::vector<MatterPtr> args;
+        args.push_back(x);
+        args.push_back(y);
+        ASSERT_TRUE(interpreter.eval(rule, result, args));
+        EXPECT_EQ(result->to_string(), std::to_string(i * 9));
+    }
+    // the parameters are not in the global env, its names are looked up
+    // when evaluated
+    EXPECT_EQ(interpreter.env()->size(), names);
+    EXPECT_FALSE(interpreter.execute(result, "x"));
+    PreparedExpr later = interpreter.prepare("(+ x y rate bonus)", params);
+    ASSERT_TRUE(later);
+    std::vector<MatterPtr> args;
+    args.push_back(Atom::create("2", 1));
+    args.push_back(Atom::create("3", 1));
+    EXPECT_FALSE(interpreter.eval(later, result, args));
+    ASSERT_TRUE(interpreter.execute(result, "(define bonus 100)"));
+    ASSERT_TRUE(interpreter.eval(later, result, args));
+    EXPECT_EQ(result->to_string(), "115");
+    names = interpreter.env()->size();
+
+    // several forms, the definitions go to the frame
+    PreparedExpr forms = interpreter.prepare(
+            "(define twice (* 2 x)) (defn add (a) (+ a twice)) (add x)",
+            std::vector<std::string>(1, "x"));
+    ASSERT_TRUE(forms);
+    args.resize(1);
+    ASSERT_TRUE(interpreter.eval(forms, result, args));
+    EXPECT_EQ(result->to_string(), "6");
+    EXPECT_FALSE(interpreter.execute(result, "twice"));
+    EXPECT_EQ(interpreter.env()->size(), names);
+
+    // no parameters
+    PreparedExpr constant = interpreter.prepare("(inc rate)",
+            std::vector<std::string>());
+    ASSERT_TRUE(constant);
+    ASSERT_TRUE(interpreter.eval(constant, result, std::vector<MatterPtr>()));
+    EXPECT_EQ(result->to_string(), "11");
+}
+
+TEST(PreparedExprTS, errors)
+{
+    SimpleInterpreter interpreter;
+    SimpleInterpreter other;
+    std::vector<std::string> params(1, "x");
+    EXPECT_FALSE(interpreter.prepare("(inc x)", params));
+    ASSERT_TRUE(interpreter.initialize());
+    ASSERT_TRUE(other.initialize());
+
+    EXPECT_FALSE(interpreter.prepare("(inc x", params));
+    EXPECT_FALSE(interpreter.prepare("", params));
+    EXPECT_FALSE(interpreter.prepare("(inc x)",
+            std::vector<std::string>(2, "x")));
+    EXPECT_FALSE(interpreter.prepare("(inc x)",
+            std::vector<std::string>(1, "1")));
+    EXPECT_FALSE(interpreter.prepare("(inc x)",
+            std::vector<std::string>(1, "x y")));
+    EXPECT_FALSE(interpreter.prepare("(inc x)",
+            std::vector<std::string>(1, "")));
+
+    PreparedExpr inc = interpreter.prepare("(inc x)", params);
+    ASSERT_TRUE(inc);
+    MatterPtr result = NULL;
+    std::vector<MatterPtr> args;
+    EXPECT_FALSE(interpreter.eval(inc, result, args));
+    args.push_back(Atom::create("1", 1));
+    EXPECT_FALSE(other.eval(inc, result, args));
+    EXPECT_FALSE(interpreter.eval(PreparedExpr(), result, args));
+    ASSERT_TRUE(interpreter.eval(inc, result, args));
+    EXPECT_EQ(result->to_string(), "2");
+
+    PreparedExpr failing = interpreter.prepare("(undefined-proc x)", params);
+    ASSERT_TRUE(failing);
+    EXPECT_FALSE(interpreter.eval(failing, result, args));
+    ASSERT_TRUE(interpreter.eval(inc, result, args));
+    EXPECT_EQ(result->to_string(), "2");
+}
+
+TEST(ParseCacheTS, leastRecentlyUsed)
+{
+    ParseCache cache(2, 16);
+    MatterPtr forms = NULL;
+    MatterPtr a = SolarWindLisp::CompositeExpr::create();
+    MatterPtr b = SolarWindLisp::CompositeExpr::create();
+    MatterPtr c = SolarWindLisp::CompositeExpr::create();
+
+    EXPECT_FALSE(cache.find("(a)", 3, forms));
+    cache.insert("(a)", 3, a);
+    cache.insert("(b)", 3, b);
+    ASSERT_TRUE(cache.find("(a)", 3, forms));
+    EXPECT_TRUE(forms == a);
+    // `(b)' is the least recently used one
+    cache.insert("(c)", 3, c);
+    EXPECT_FALSE(cache.find("(b)", 3, forms));
+    ASSERT_TRUE(cache.find("(c)", 3, forms));
+    EXPECT_TRUE(forms == c);
+    ASSERT_TRUE(cache.find("(a)", 3, forms));
+    // a prefix is another input
+    EXPECT_FALSE(cache.find("(a)", 2, forms));
+
+    // too long, never cached
+    cache.insert("(a 1 2 3 4 5 6 7 8)", 19, b);
+    EXPECT_FALSE(cache.find("(a 1 2 3 4 5 6 7 8)", 19, forms));
+
+    ParseCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 3u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_EQ(stats.bytes, 6u);
+
+    cache.set_capacity(1);
+    EXPECT_EQ(cache.stats().evictions, 2u);
+    EXPECT_TRUE(cache.find("(a)", 3, forms));
+    cache.set_capacity(0);
+    EXPECT_FALSE(cache.find("(a)", 3, forms));
+    EXPECT_EQ(cache.stats().entries, 0u);
+    EXPECT_EQ(cache.stats().misses, 3u);
+}
+
+TEST(ParseCacheTS, execute)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    MatterPtr result = NULL;
+    ASSERT_TRUE(interpreter.execute(result, "(+ 1 2)"));
+    EXPECT_EQ(interpreter.parse_cache().stats().misses, 0u);
+
+    interpreter.set_parse_cache(8);
+    ASSERT_TRUE(interpreter.execute(result, "(define n 5)"));
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(interpreter.execute(result, "(* n (+ 1 2))"));
+        EXPECT_EQ(result->to_string(), "15");
+    }
+    // a length given, the same input
+    ASSERT_TRUE(interpreter.execute(result, "(* n (+ 1 2)) ignored", 13));
+    EXPECT_EQ(result->to_string(), "15");
+    // parse errors are not cached
+    EXPECT_FALSE(interpreter.execute(result, "(* n"));
+    EXPECT_FALSE(interpreter.execute(result, "(* n"));
+
+    ParseCache::Stats stats = interpreter.parse_cache().stats();
+    EXPECT_EQ(stats.hits, 10u);
+    EXPECT_EQ(stats.misses, 4u);
+    EXPECT_EQ(stats.entries, 2u);
+}
+
+TEST(BatchExprTS, sameAsRowByRow)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    MatterPtr result = NULL;
+    ASSERT_TRUE(interpreter.execute(result, "(define rate 2.5)"));
+
+    // more than a chunk, and a tail
+    const size_t ROWS = BatchExpr::CHUNK_ROWS * 2 + 37;
+    std::vector<int64_t> x(ROWS);
+    std::vector<double> y(ROWS);
+    bool f[ROWS];
+    std::vector<std::string> s(ROWS);
+    for (size_t i = 0; i < ROWS; ++i) {
+        x[i] = static_cast<int64_t>((i * 7919) % 101) - 20;
+        y[i] = static_cast<double>((i * 104729) % 61) * 0.25 - 3;
+        f[i] = (i * 31) % 7 < 3;
+        s[i] = i % 5 ? std::string(i % 5, 'a') : std::string();
+    }
+    std::vector<std::string> names;
+    names.push_back("x");
+    names.push_back("y");
+    names.push_back("f");
+    names.push_back("s");
+    std::vector<Column> columns;
+    columns.push_back(Column(&x[0], ROWS));
+    columns.push_back(Column(&y[0], ROWS));
+    columns.push_back(Column(f, ROWS));
+    columns.push_back(Column(&s[0], ROWS));
+
+    static const char * exprs[] = {
+        "(+ x 1 (* x 2))",
+        "(- x)",
+        "(- y x 3)",
+        "(* x y rate)",
+        "(/ x (- x 5))",
+        "(/ x)",
+        "(< x 10)",
+        "(>= y x)",
+        "(= x 5)",
+        "(!= f true)",
+        "(+ f x)",
+        "(or (= x 0) (> (/ 100 x) 3))",
+        "(and (!= x 0) (> (/ 100 x) 3))",
+        "(if f (inc x) (dec y))",
+        "(if (> x 50) s \"low\")",
+        "(not s)",
+        "(xor f (> y 0.5))",
+        "(if (= x 0) (/ 1 x) 0)",
+        "(if (< y 0) (= (/ y x) 1) f)",
+        "7",
+    };
+    for (size_t e = 0; e < array_size(exprs); ++e) {
+        SCOPED_TRACE(exprs[e]);
+        BatchExpr batch;
+        ASSERT_TRUE(batch.compile(&interpreter, exprs[e], names));
+        BatchResult out;
+        ASSERT_TRUE(batch.evaluate(columns, out));
+        ASSERT_EQ(out.rows, ROWS);
+        PreparedExpr prepared = interpreter.prepare(exprs[e], names);
+        ASSERT_TRUE(prepared);
+
+        size_t invalid = 0;
+        for (size_t i = 0; i < ROWS; ++i) {
+            std::vector<MatterPtr> args;
+            SolarWindLisp::AtomPtr atom = Atom::create();
+            atom->set_i64(x[i]);
+            args.push_back(atom);
+            atom = Atom::create();
+            atom->set_double(y[i]);
+            args.push_back(atom);
+            atom = Atom::create();
+            atom->set_bool(f[i]);
+            args.push_back(atom);
+            atom = Atom::create();
+            atom->set_cstr(s[i].data(), s[i].size(), true);
+            args.push_back(atom);
+            result = NULL;
+            if (!interpreter.eval(prepared, result, args)) {
+                ++invalid;
+                EXPECT_FALSE(out.is_selected(i)) << "row " << i;
+                continue;
+            }
+            ASSERT_TRUE(result && result->is_atom()) << "row " << i;
+            const Atom * a = static_cast<const Atom *>(result.get());
+            EXPECT_EQ(out.is_selected(i), a->not_empty()) << "row " << i;
+            long double v = 0;
+            switch (out.type) {
+                case Column::column_i64:
+                    ASSERT_TRUE(a->is_integer()) << "row " << i;
+                    a->to_long_double(v);
+                    EXPECT_EQ(out.i64[i], static_cast<int64_t>(v))
+                            << "row " << i;
+                    break;
+                case Column::column_double:
+                    ASSERT_TRUE(a->to_long_double(v)) << "row " << i;
+                    EXPECT_NEAR(out.f64[i], static_cast<double>(v), 1e-9)
+                            << "row " << i;
+                    break;
+                case Column::column_bool:
+                    ASSERT_TRUE(a->is_bool()) << "row " << i;
+                    EXPECT_EQ(out.bools[i] != 0, a->not_empty())
+                            << "row " << i;
+                    break;
+                default:
+                    ASSERT_TRUE(a->is_quoted_cstr()) << "row " << i;
+                    EXPECT_EQ(out.strings[i],
+                            std::string(a->to_cstr(), a->cstr_length()))
+                            << "row " << i;
+                    break;
+            }
+        }
+        EXPECT_EQ(out.invalid, invalid);
+    }
+}
+
+TEST(BatchExprTS, errors)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    std::vector<std::string> names(1, "x");
+    BatchExpr batch;
+    EXPECT_FALSE(batch.compiled());
+    EXPECT_FALSE(batch.compile(NULL, "(+ x 1)", names));
+    EXPECT_FALSE(batch.compile(&interpreter, "(+ x 1", names));
+    EXPECT_FALSE(batch.compile(&interpreter, "(+ x 1) (- x 1)", names));
+    EXPECT_FALSE(batch.compile(&interpreter, "(max2 x 1)", names));
+    EXPECT_FALSE(batch.compile(&interpreter, "(if x 1)", names));
+    EXPECT_FALSE(batch.compile(&interpreter, "(< x 1 2)", names));
+    EXPECT_FALSE(batch.compile(&interpreter, "(+ x unbound)", names));
+    EXPECT_FALSE(batch.compile(&interpreter, "(x 1)", names));
+
+    // the builtin ones only
+    MatterPtr result = NULL;
+    ASSERT_TRUE(interpreter.execute(result,
+            "(define inc (lambda (x) (+ x 100)))"));
+    EXPECT_FALSE(batch.compile(&interpreter, "(inc x)", names));
+    ASSERT_TRUE(batch.compile(&interpreter, "(dec x)", names));
+    EXPECT_TRUE(batch.compiled());
+
+    // types known when evaluated
+    std::string strings[2] = { "a", "b" };
+    int64_t numbers[3] = { 1, 2, 3 };
+    BatchResult out;
+    EXPECT_FALSE(batch.evaluate(std::vector<Column>(), out));
+    EXPECT_FALSE(batch.evaluate(std::vector<Column>(1,
+            Column(strings, 2)), out));
+    ASSERT_TRUE(batch.evaluate(std::vector<Column>(1,
+            Column(numbers, 3)), out));
+    EXPECT_EQ(out.type, Column::column_i64);
+    EXPECT_EQ(out.selected, 2u);
+    EXPECT_FALSE(out.is_selected(0));
+    Column column = out.column();
+    ASSERT_EQ(column.size, 3u);
+    EXPECT_EQ(column.i64()[2], 2);
+
+    ASSERT_TRUE(batch.compile(&interpreter, "(if (= x 1) \"one\" x)",
+            names));
+    EXPECT_FALSE(batch.evaluate(std::vector<Column>(1,
+            Column(numbers, 3)), out));
+}
+
+namespace
+{
+
+int64_t add_i64(int64_t a, int64_t b)
+{
+    return a + b;
+}
+
+} // namespace
+
+TEST(NativeFnTS, unboxing)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    MatterPtr result = NULL;
+
+    ASSERT_TRUE(interpreter.register_fn("clamp",
+            [](double x, double lo, double hi) {
+                return x < lo ? lo : (x > hi ? hi : x);
+            }));
+    ASSERT_TRUE(interpreter.execute(result, "(clamp 1.5 0 1)"));
+    EXPECT_EQ(result->to_string(), "1");
+    ASSERT_TRUE(interpreter.execute(result, "(clamp (- 0 2) -1.5 1)"));
+    EXPECT_EQ(result->to_string(), "-1.5");
+    ASSERT_TRUE(interpreter.execute(result, "(clamp 0.25 0 1)"));
+    EXPECT_EQ(result->to_string(), "0.25");
+
+    // a function, called like any procedure
+    ASSERT_TRUE(interpreter.register_fn("add", add_i64));
+    ASSERT_TRUE(interpreter.execute(result,
+            "(defn twice (x) (add x x)) (twice (add 20 1))"));
+    EXPECT_EQ(result->to_string(), "42");
+
+    ASSERT_TRUE(interpreter.register_fn("greet",
+            [](const std::string &who) { return "hello, " + who; }));
+    ASSERT_TRUE(interpreter.execute(result, "(greet \"world\")"));
+    ASSERT_TRUE(result->is_atom());
+    const Atom * atom = static_cast<const Atom *>(result.get());
+    ASSERT_TRUE(atom->is_quoted_cstr());
+    EXPECT_EQ(std::string(atom->to_cstr(), atom->cstr_length()),
+            "hello, world");
+
+    ASSERT_TRUE(interpreter.register_fn("negative?",
+            [](int32_t x) { return x < 0; }));
+    ASSERT_TRUE(interpreter.execute(result,
+            "(if (negative? -3) \"yes\" \"no\")"));
+    EXPECT_EQ(result->to_string(), "`yes'");
+    ASSERT_TRUE(interpreter.register_fn("flip", [](bool b) { return !b; }));
+    ASSERT_TRUE(interpreter.execute(result, "(flip (negative? 3))"));
+    EXPECT_EQ(result->to_string(), "true");
+
+    // nothing returned, state captured
+    int calls = 0;
+    ASSERT_TRUE(interpreter.register_fn("tick!", [&calls]() { ++calls; }));
+    ASSERT_TRUE(interpreter.execute(result, "(tick!) (tick!) (tick!)"));
+    EXPECT_EQ(calls, 3);
+
+    // objects as they are
+    ASSERT_TRUE(interpreter.register_fn("first-of",
+            [](const MatterPtr &a, const MatterPtr &b UNUSED) { return a; }));
+    ASSERT_TRUE(interpreter.execute(result, "(first-of (list 1 2) 3)"));
+    EXPECT_EQ(result->to_string(), "(1 2)");
+
+    uint8_t widest = 0;
+    ASSERT_TRUE(interpreter.register_fn("byte",
+            [&widest](uint8_t v) -> uint64_t {
+                widest = v > widest ? v : widest;
+                return v;
+            }));
+    ASSERT_TRUE(interpreter.execute(result, "(byte 255)"));
+    EXPECT_EQ(result->to_string(), "255");
+    EXPECT_EQ(widest, 255);
+}
+
+TEST(NativeFnTS, errors)
+{
+    SimpleInterpreter interpreter;
+    EXPECT_FALSE(interpreter.register_fn("nop", []() {}));
+    ASSERT_TRUE(interpreter.initialize());
+    MatterPtr result = NULL;
+
+    ASSERT_TRUE(interpreter.register_fn("add", add_i64));
+    // defined already, or not a name
+    EXPECT_FALSE(interpreter.register_fn("add", add_i64));
+    EXPECT_FALSE(interpreter.register_fn("1", add_i64));
+    EXPECT_FALSE(interpreter.register_fn("a b", add_i64));
+    EXPECT_FALSE(interpreter.register_fn(NULL, add_i64));
+    ASSERT_TRUE(interpreter.execute(result, "(define later 1)"));
+    EXPECT_FALSE(interpreter.register_fn("later", add_i64));
+
+    // arity
+    EXPECT_FALSE(interpreter.execute(result, "(add 1)"));
+    EXPECT_FALSE(interpreter.execute(result, "(add 1 2 3)"));
+    // types
+    EXPECT_FALSE(interpreter.execute(result, "(add 1 2.5)"));
+    EXPECT_FALSE(interpreter.execute(result, "(add true 2)"));
+    EXPECT_FALSE(interpreter.execute(result, "(add \"1\" 2)"));
+    EXPECT_FALSE(interpreter.execute(result, "(add 1 (list 2))"));
+
+    // ranges
+    ASSERT_TRUE(interpreter.register_fn("byte",
+            [](uint8_t v) { return v; }));
+    EXPECT_FALSE(interpreter.execute(result, "(byte 256)"));
+    EXPECT_FALSE(interpreter.execute(result, "(byte -1)"));
+    ASSERT_TRUE(interpreter.register_fn("i32", [](int32_t v) { return v; }));
+    EXPECT_FALSE(interpreter.execute(result, "(i32 2147483648)"));
+    ASSERT_TRUE(interpreter.execute(result, "(i32 -2147483648)"));
+    EXPECT_EQ(result->to_string(), "-2147483648");
+
+    // strings, not names; booleans, not numbers
+    ASSERT_TRUE(interpreter.register_fn("len",
+            [](const std::string &s) { return s.size(); }));
+    EXPECT_FALSE(interpreter.execute(result, "(len 'abc)"));
+    ASSERT_TRUE(interpreter.execute(result, "(len \"abc\")"));
+    EXPECT_EQ(result->to_string(), "3");
+    ASSERT_TRUE(interpreter.register_fn("flip", [](bool b) { return !b; }));
+    EXPECT_FALSE(interpreter.execute(result, "(flip 0)"));
+
+    // a NULL object returned
+    ASSERT_TRUE(interpreter.register_fn("null",
+            []() { return MatterPtr(); }));
+    EXPECT_FALSE(interpreter.execute(result, "(null)"));
+
+    ASSERT_TRUE(interpreter.execute(result, "(add 1 2)"));
+    EXPECT_EQ(result->to_string(), "3");
+    ASSERT_TRUE(interpreter.execute(result, "add"));
+    EXPECT_EQ(result->to_string(), "instance of NativeProc `add'");
+    EXPECT_EQ(result->debug_string(), "NativeProc{add}");
+}
+
+TEST(NativeFnTS, freezeAndSnapshot)
+{
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    MatterPtr result = NULL;
+    ASSERT_TRUE(interpreter.register_fn("add", add_i64));
+    // a native named like a builtin, in the global env
+    ASSERT_TRUE(interpreter.register_fn("inc",
+            [](int64_t x) { return x + 100; }));
+    ASSERT_TRUE(interpreter.execute(result,
+            "(defn add3 (a b c) (add a (add b c)))"
+            "(define ops (list add inc +))"));
+
+    // the same procedures in the frozen env
+    ASSERT_TRUE(interpreter.freeze());
+    ASSERT_TRUE(interpreter.execute(result, "(add3 1 2 (inc 3))"));
+    EXPECT_EQ(result->to_string(), "106");
+    ASSERT_TRUE(interpreter.execute(result, "((car (cdr ops)) 1)"));
+    EXPECT_EQ(result->to_string(), "101");
+    ASSERT_TRUE(interpreter.execute(result, "((nth ops 2) 1 2)"));
+    EXPECT_EQ(result->to_string(), "3");
+
+    // saved by name, not restored
+    std::string name = temp_snapshot_name();
+    ASSERT_TRUE(interpreter.save_snapshot(name.c_str()));
+    SimpleInterpreter restored;
+    EXPECT_FALSE(restored.initialize(name.c_str()));
+    unlink(name.c_str());
+}
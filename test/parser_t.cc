@@ -6,10 +6,14 @@
  * date created:        Sat Nov 22 01:49:21 2014 CST
  */
 
+#include <stdio.h>
 #include <iostream>
 #include <gtest/gtest.h>
 #include "expr.h"
 #include "parser.h"
+#include "parallel_loader.h"
+#include "structural_index.h"
+#include "symbol_table.h"
 #include "utils.h"
 
 using SolarWindLisp::MatterIF;
@@ -18,6 +22,8 @@ using SolarWindLisp::CompositeExpr;
 using SolarWindLisp::ParserIF;
 using SolarWindLisp::SimpleParser;
 using SolarWindLisp::MatterPtr;
+using SolarWindLisp::ParallelLoader;
+using SolarWindLisp::SymbolTable;
 
 class ParserTokenizeTS: public testing::Test
 {
@@ -142,3 +148,469 @@ TEST_F(ParserTokenizeTS, parseExpr)
         }
     }
 }
+
+TEST_F(ParserTokenizeTS, tokenViews)
+{
+    const char * form_str = "(say \"a \\\"b\\\"\" 'c d' 3.5)x";
+    ParserIF::token_views views;
+    ASSERT_TRUE(ParserIF::tokenize(&views, form_str, strlen(form_str)));
+
+    struct {
+        size_t offset;
+        size_t length;
+        int kind;
+        const char * text;
+    } expected[] = {
+        { 0, 1, ParserIF::token_lparen, "(" },
+        { 1, 3, ParserIF::token_atom, "say" },
+        { 5, 9, ParserIF::token_escaped_atom, "\"a \"b\"\"" },
+        { 15, 5, ParserIF::token_atom, "'c d'" },
+        { 21, 3, ParserIF::token_atom, "3.5" },
+        { 24, 1, ParserIF::token_rparen, ")" },
+        { 25, 1, ParserIF::token_atom, "x" },
+    };
+
+    ASSERT_EQ(views.size(), array_size(expected));
+    std::string text;
+    for (size_t i = 0; i < views.size(); ++i) {
+        EXPECT_EQ(views[i].offset, expected[i].offset);
+        EXPECT_EQ(views[i].length, expected[i].length);
+        EXPECT_EQ(views[i].kind, expected[i].kind);
+        ParserIF::token_text(form_str, views[i], text);
+        EXPECT_EQ(text, expected[i].text);
+    }
+
+    // the views refer to the input, NUL terminated or not
+    ParserIF::token_views views2;
+    ASSERT_TRUE(ParserIF::tokenize(&views2, form_str));
+    ASSERT_EQ(views2.size(), views.size());
+    for (size_t i = 0; i < views.size(); ++i) {
+        EXPECT_EQ(views2[i].offset, views[i].offset);
+        EXPECT_EQ(views2[i].length, views[i].length);
+    }
+
+    // capacity is reused
+    const ParserIF::Token * data = views.data();
+    ASSERT_TRUE(ParserIF::tokenize(&views, "(a b)"));
+    EXPECT_EQ(views.size(), 4U);
+    EXPECT_EQ(views.data(), data);
+
+    EXPECT_FALSE(ParserIF::tokenize(&views, "  \n "));
+    EXPECT_TRUE(views.empty());
+}
+
+TEST(ParserTS, deepNesting)
+{
+    static const size_t DEPTH = 100000;
+    std::string str(DEPTH, '(');
+    str += "x";
+    str += std::string(DEPTH, ')');
+
+    SimpleParser parser;
+    MatterPtr forms = parser.parse(str.c_str(), str.size());
+    ASSERT_TRUE(forms != NULL);
+    EXPECT_TRUE(parser.error_message() == NULL);
+
+    size_t depth = 0;
+    MatterPtr e = forms;
+    while (e->is_composite_expr()) {
+        const CompositeExpr * ce = static_cast<const CompositeExpr *>(e.get());
+        ASSERT_EQ(ce->size(), 1U);
+        e = (*ce)[0];
+        ++depth;
+    }
+    EXPECT_EQ(depth, DEPTH + 1);
+    EXPECT_TRUE(e->is_atom());
+
+    // released without recursion
+    e = NULL;
+    forms = NULL;
+}
+
+TEST(ParserTS, errorOffsets)
+{
+    struct {
+        const char * str;
+        size_t offset;
+    } cases[] = {
+        { "(a b))", 5 },
+        { ")", 0 },
+        { "(a (b c)\n (d", 10 },
+        // parentheses are not quoted by the tokenizer
+        { "(a \"(b\" c", 4 },
+        { "(define x 1) (x (y) (z", 20 },
+    };
+
+    SimpleParser parser;
+    for (size_t i = 0; i < array_size(cases); ++i) {
+        EXPECT_TRUE(parser.parse(cases[i].str) == NULL) << cases[i].str;
+        EXPECT_TRUE(parser.error_message() != NULL) << cases[i].str;
+        EXPECT_EQ(parser.error_offset(), cases[i].offset) << cases[i].str;
+    }
+
+    // no form is not an error
+    EXPECT_TRUE(parser.parse("  \n") == NULL);
+    EXPECT_TRUE(parser.error_message() == NULL);
+
+    // the error is cleared
+    EXPECT_TRUE(parser.parse("(a) (b)") != NULL);
+    EXPECT_TRUE(parser.error_message() == NULL);
+}
+
+TEST(ParserTS, escapedParens)
+{
+    // an escaped paren alone in quotes is a paren
+    struct {
+        const char * str;
+        const char * same;
+    } cases[] = {
+        { "\"(\\)", "\"()" },
+        { "e9(; (\"(-\n\t 2 a)\\))", "e9(; (\"(-\n\t 2 a)))" },
+        { "\"(\\()x\")", "\"(()x\")" },
+    };
+
+    SimpleParser parser;
+    for (size_t i = 0; i < array_size(cases); ++i) {
+        MatterPtr forms = parser.parse(cases[i].str);
+        MatterPtr same = parser.parse(cases[i].same);
+        ASSERT_TRUE(forms != NULL) << cases[i].str;
+        ASSERT_TRUE(same != NULL) << cases[i].same;
+        EXPECT_EQ(forms->debug_string(true), same->debug_string(true))
+                << cases[i].str;
+    }
+
+    EXPECT_TRUE(parser.parse("01a'(\\()0\\a9'ab") == NULL);
+    EXPECT_TRUE(parser.error_message() != NULL);
+
+    // not alone, part of an atom
+    EXPECT_TRUE(parser.parse("\"(\\)x)") != NULL);
+    EXPECT_TRUE(parser.parse("\"(a\\))") != NULL);
+}
+
+TEST(StructuralIndexTS, classifiers)
+{
+    using SolarWindLisp::StructuralIndex;
+    using SolarWindLisp::VectorKernels;
+
+    // every byte value, at every position of a block
+    char block[StructuralIndex::BLOCK_SIZE * 4];
+    for (size_t i = 0; i < sizeof(block); ++i) {
+        block[i] = static_cast<char>(i * 7 + i / 64);
+    }
+
+    for (size_t offset = 0; offset + 64 <= sizeof(block); offset += 61) {
+        uint64_t expected[StructuralIndex::NUM_OF_CLASSES];
+        StructuralIndex::classifier(VectorKernels::isa_scalar)(block + offset,
+                expected);
+        for (size_t i = 0; i < 64; ++i) {
+            unsigned char c = block[offset + i];
+            bool space = c == ' ' || (c >= '\t' && c <= '\r');
+            EXPECT_EQ((expected[StructuralIndex::class_space] >> i) & 1,
+                    space ? 1U : 0U) << "char " << static_cast<int>(c);
+            EXPECT_EQ((expected[StructuralIndex::class_paren] >> i) & 1,
+                    (c == '(' || c == ')') ? 1U : 0U);
+        }
+
+        for (int isa = 0; isa < VectorKernels::NUM_OF_ISAS; ++isa) {
+            VectorKernels::isa_t t = static_cast<VectorKernels::isa_t>(isa);
+            if (!VectorKernels::is_supported(t)) {
+                continue;
+            }
+            uint64_t masks[StructuralIndex::NUM_OF_CLASSES];
+            StructuralIndex::classifier(t)(block + offset, masks);
+            for (int k = 0; k < StructuralIndex::NUM_OF_CLASSES; ++k) {
+                EXPECT_EQ(masks[k], expected[k])
+                        << VectorKernels::isa_name(t) << ", class " << k;
+            }
+        }
+    }
+}
+
+TEST(StructuralIndexTS, find)
+{
+    using SolarWindLisp::StructuralIndex;
+
+    std::string input(200, 'x');
+    input[3] = '(';
+    input[64] = ' ';
+    input[65] = '\n';
+    input[130] = '"';
+    input += "  ";
+
+    StructuralIndex index(input.c_str(), input.size());
+    EXPECT_EQ(index.find(0, StructuralIndex::PAREN), 3U);
+    EXPECT_EQ(index.find(4, StructuralIndex::PAREN), input.size());
+    EXPECT_EQ(index.find(4, StructuralIndex::SPACE), 64U);
+    EXPECT_EQ(index.find(65, StructuralIndex::SPACE), 65U);
+    EXPECT_EQ(index.find(66, StructuralIndex::SPACE), 200U);
+    EXPECT_EQ(index.find(0, StructuralIndex::NEWLINE), 65U);
+    EXPECT_EQ(index.find(0, StructuralIndex::QUOTE), 130U);
+    EXPECT_EQ(index.find_not(64, StructuralIndex::SPACE), 66U);
+    EXPECT_EQ(index.find_not(200, StructuralIndex::SPACE), input.size());
+    // backwards, e.g. another scanner of the same input
+    EXPECT_EQ(index.find(0, StructuralIndex::SPACE), 64U);
+    EXPECT_EQ(index.find(0, StructuralIndex::COMMENT), input.size());
+
+    StructuralIndex empty;
+    EXPECT_EQ(empty.find(0, StructuralIndex::PAREN), 0U);
+}
+
+namespace
+{
+
+std::string forms_string(const std::vector<MatterPtr> &forms)
+{
+    std::string result;
+    for (size_t i = 0; i < forms.size(); ++i) {
+        result += forms[i]->debug_string(true);
+        result += "\n";
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+TEST(ParserStreamTS, anyChunks)
+{
+    const char * script =
+            "(define pi 3.14159)\n"
+            "(defn area (r)\n"
+            "    (* pi (* r r)))\n"
+            "pi 'a single quoted string' \"with \\\"escaped\\\" quotes\"\n"
+            "(str-cat \"not; a list\" 'x')\n"
+            "(((nested) list) of-atoms 12 -3.5 0x1F)\n"
+            "last-atom";
+
+    SimpleParser parser;
+    MatterPtr whole = parser.parse(script);
+    ASSERT_TRUE(whole != NULL);
+    const CompositeExpr * ce = static_cast<const CompositeExpr *>(whole.get());
+    std::vector<MatterPtr> expected(ce->begin(), ce->end());
+    std::string expected_str = forms_string(expected);
+
+    size_t length = strlen(script);
+    for (size_t chunk = 1; chunk <= length; ++chunk) {
+        std::vector<MatterPtr> forms;
+        for (size_t off = 0; off < length; off += chunk) {
+            size_t n = std::min(chunk, length - off);
+            ASSERT_TRUE(parser.feed(script + off, n, forms));
+            EXPECT_TRUE(parser.in_progress() || off + n == length
+                    || forms.size() > 0);
+        }
+        // the last atom has no space after it
+        EXPECT_TRUE(parser.in_progress());
+        ASSERT_TRUE(parser.finish(forms));
+        EXPECT_FALSE(parser.in_progress());
+        EXPECT_EQ(forms_string(forms), expected_str) << "chunk " << chunk;
+    }
+}
+
+TEST(ParserStreamTS, formsAsSoonAsComplete)
+{
+    SimpleParser parser;
+    std::vector<MatterPtr> forms;
+    EXPECT_TRUE(parser.feed("(a (b", 5, forms));
+    EXPECT_EQ(forms.size(), 0U);
+    EXPECT_TRUE(parser.in_progress());
+    EXPECT_TRUE(parser.feed(" c)) d", 6, forms));
+    EXPECT_EQ(forms.size(), 1U);
+    EXPECT_TRUE(parser.feed("\n", 1, forms));
+    ASSERT_EQ(forms.size(), 2U);
+    EXPECT_TRUE(forms[1]->is_atom());
+    EXPECT_FALSE(parser.in_progress());
+    EXPECT_TRUE(parser.finish(forms));
+    EXPECT_EQ(forms.size(), 2U);
+}
+
+TEST(ParserStreamTS, comments)
+{
+    const char * script =
+            "; a comment line (\n"
+            "(a ; not a comment\n"
+            "   ; a comment line )\n"
+            " b)\n"
+            "  ;; indented comment\n"
+            "\"a\n;quoted\"\n";
+
+    SimpleParser parser;
+    for (size_t chunk = 1; chunk <= strlen(script); chunk += 3) {
+        std::vector<MatterPtr> forms;
+        for (size_t off = 0; off < strlen(script); off += chunk) {
+            size_t n = std::min(chunk, strlen(script) - off);
+            ASSERT_TRUE(parser.feed(script + off, n, forms));
+        }
+        ASSERT_TRUE(parser.finish(forms));
+        ASSERT_EQ(forms.size(), 2U) << "chunk " << chunk;
+        ASSERT_TRUE(forms[0]->is_composite_expr());
+        const CompositeExpr * ce =
+                static_cast<const CompositeExpr *>(forms[0].get());
+        // a ; not a comment b
+        EXPECT_EQ(ce->size(), 6U);
+        ASSERT_TRUE(forms[1]->is_atom());
+        EXPECT_STREQ(static_cast<const Atom *>(forms[1].get())->to_cstr(),
+                "a\n;quoted");
+    }
+}
+
+TEST(ParserStreamTS, errors)
+{
+    SimpleParser parser;
+    std::vector<MatterPtr> forms;
+
+    // offsets from the start of the stream
+    EXPECT_TRUE(parser.feed("(a b", 4, forms));
+    EXPECT_FALSE(parser.feed(" c)) (d)", 8, forms));
+    EXPECT_EQ(forms.size(), 1U);
+    EXPECT_STREQ(parser.error_message(), "unmatched close parenthesis");
+    EXPECT_EQ(parser.error_offset(), 7U);
+    EXPECT_FALSE(parser.in_progress());
+
+    // a new stream after an error
+    forms.clear();
+    EXPECT_TRUE(parser.feed("(x (y", 5, forms));
+    EXPECT_TRUE(parser.error_message() == NULL);
+    EXPECT_FALSE(parser.finish(forms));
+    EXPECT_STREQ(parser.error_message(), "unclosed parenthesis");
+    EXPECT_EQ(parser.error_offset(), 3U);
+    EXPECT_EQ(forms.size(), 0U);
+
+    // parse() abandons the stream
+    EXPECT_TRUE(parser.feed("(x (y", 5, forms));
+    EXPECT_TRUE(parser.parse("(z)") != NULL);
+    EXPECT_FALSE(parser.in_progress());
+    EXPECT_TRUE(parser.finish(forms));
+    EXPECT_EQ(forms.size(), 0U);
+}
+
+namespace
+{
+
+/*
+ * Forms with the tricky parts for splitting: parens, newlines and escaped
+ * quotes inside strings, quotes and parens in comment lines, `;' which is
+ * not a comment, atoms at the top level.
+ */
+std::string tricky_script(size_t size)
+{
+    std::string script;
+    char buf[512];
+    for (unsigned i = 0; script.size() < size; ++i) {
+        snprintf(buf, sizeof(buf),
+                "; comment %u with \"quotes' and (parens\n"
+                "(define name-%u \"a string\n(with parens)\n\\\"and\\\" "
+                "quotes\")\n"
+                "  ;; (indented comment \"\n"
+                "(defn proc-%u (x)\n"
+                "    ; a comment inside a list\n"
+                "    (+ x %u))\n"
+                "top-level-%u 'single %u' %u.5\n",
+                i, i, i, i, i, i, i);
+        script += buf;
+    }
+    return script;
+}
+
+std::string stream_forms(const std::string &script)
+{
+    SimpleParser parser;
+    std::vector<MatterPtr> forms;
+    EXPECT_TRUE(parser.feed(script.data(), script.size(), forms));
+    EXPECT_TRUE(parser.finish(forms));
+    return forms_string(forms);
+}
+
+} // anonymous namespace
+
+TEST(ParallelLoaderTS, split)
+{
+    std::string script = tricky_script(20000);
+    std::string expected = stream_forms(script);
+
+    for (size_t piece_size = 1; piece_size < 4096; piece_size *= 3) {
+        std::vector<size_t> starts;
+        ParserIF::split(script.data(), script.size(), piece_size, starts);
+        ASSERT_GT(starts.size(), 1U);
+        EXPECT_EQ(starts[0], 0U);
+
+        std::string pieces;
+        for (size_t i = 0; i < starts.size(); ++i) {
+            size_t end = i + 1 < starts.size() ? starts[i + 1] : script.size();
+            ASSERT_LT(starts[i], end);
+            EXPECT_EQ(script[starts[i] - (i ? 1 : 0)], i ? '\n' : ';');
+            pieces += stream_forms(script.substr(starts[i], end - starts[i]));
+        }
+        EXPECT_EQ(pieces, expected) << "piece size " << piece_size;
+    }
+
+    // an escaped paren alone in quotes is a paren
+    std::string escaped = "\"(\\()x\")\n(b)\n(c)\n";
+    std::vector<size_t> pieces;
+    ParserIF::split(escaped.data(), escaped.size(), 1, pieces);
+    ASSERT_EQ(pieces.size(), 3U);
+    EXPECT_EQ(pieces[1], 9U);
+    EXPECT_EQ(stream_forms(escaped.substr(0, 9)) + stream_forms(
+            escaped.substr(9, 4)) + stream_forms(escaped.substr(13)),
+            stream_forms(escaped));
+
+    // stops at an unmatched close paren
+    std::string bad = "(a)\n(b))\n(c)\n(d)\n";
+    std::vector<size_t> starts;
+    ParserIF::split(bad.data(), bad.size(), 1, starts);
+    ASSERT_EQ(starts.size(), 2U);
+    EXPECT_EQ(starts[1], 4U);
+}
+
+TEST(ParallelLoaderTS, load)
+{
+    std::string script = tricky_script(2 * 1024 * 1024);
+    std::string expected = stream_forms(script);
+
+    SymbolTable symbols;
+    for (size_t threads = 1; threads <= 4; threads *= 2) {
+        ParallelLoader loader(threads, &symbols);
+        std::vector<MatterPtr> forms;
+        ASSERT_TRUE(loader.load(script.data(), script.size(), forms));
+        EXPECT_TRUE(loader.error_message() == NULL);
+        EXPECT_GT(loader.batches(), threads);
+        EXPECT_EQ(forms_string(forms), expected) << threads << " threads";
+
+        // names of every batch are interned in the same table
+        const CompositeExpr * define =
+                static_cast<const CompositeExpr *>(forms[0].get());
+        const Atom * keyword = static_cast<const Atom *>((*define)[0].get());
+        EXPECT_EQ(keyword->to_cstr(), symbols.intern("define", 6));
+    }
+}
+
+TEST(ParallelLoaderTS, errors)
+{
+    std::string script = tricky_script(1024 * 1024);
+    size_t good = script.size();
+    script += "(unmatched))\n";
+    script += tricky_script(1024 * 1024);
+
+    ParallelLoader loader(3);
+    size_t handled = 0;
+    EXPECT_FALSE(loader.load(script.data(), script.size(),
+            [&handled](const MatterPtr &form) {
+                ++handled;
+                return true;
+            }));
+    EXPECT_STREQ(loader.error_message(), "unmatched close parenthesis");
+    EXPECT_EQ(loader.error_offset(), good + 11);
+
+    // every form before the error
+    SimpleParser parser;
+    std::vector<MatterPtr> forms;
+    EXPECT_FALSE(parser.feed(script.data(), script.size(), forms));
+    EXPECT_EQ(handled, forms.size());
+
+    // stopped by the handler
+    handled = 0;
+    EXPECT_FALSE(loader.load(script.data(), good,
+            [&handled](const MatterPtr &form) {
+                return ++handled < 100;
+            }));
+    EXPECT_EQ(handled, 100U);
+    EXPECT_TRUE(loader.error_message() == NULL);
+}
@@ -8,11 +8,25 @@
 
 #include <unistd.h>
 #include <stdio.h>
+#include <sys/stat.h>
+#include <string>
+#include <thread>
 #include <gtest/gtest.h>
 #include "script_reader.h"
+#include "script_cache.h"
+#include "parser.h"
+#include "interpreter.h"
+#include "symbol_table.h"
 #include "utils.h"
 
 using SolarWindLisp::ScriptFileReader;
+using SolarWindLisp::ScriptCache;
+using SolarWindLisp::SimpleParser;
+using SolarWindLisp::SimpleInterpreter;
+using SolarWindLisp::SymbolTable;
+using SolarWindLisp::MatterPtr;
+using SolarWindLisp::Atom;
+using SolarWindLisp::CompositeExpr;
 
 class ScriptFileReaderTS: public testing::Test
 {
@@ -96,3 +110,401 @@ TEST_F(ScriptFileReaderTS, case01)
         EXPECT_STREQ(forms[i], _stmt_buf);
     }
 }
+
+TEST_F(ScriptFileReaderTS, statementViews)
+{
+    save_to_file( //
+            "; a comment before everything\n"
+            "(define pi 3.14159)(define e 2.71828)\n"
+            "\n"
+            "   pi\n"
+            "(defn one-two-other (n)\n"
+            "    ; a comment line inside the list\n"
+            "    (cond\n"
+            "        (= n 1) \"a; b\"\n"
+            "        :default 300))\n"
+            "(print \"\\\";\" ';x')\n"
+            "e");
+
+    const char * forms[] = { //
+        "(define pi 3.14159)", //
+        "(define e 2.71828)", //
+        "pi", //
+        "(defn one-two-other (n)\n"
+        "    \n"
+        "    (cond\n"
+        "        (= n 1) \"a; b\"\n"
+        "        :default 300))",
+        // quoted semicolons, and an escaped quote
+        "(print \"\\\";\" ';x')",
+        // the last line has no newline
+        "e",
+    };
+    size_t lines[] = { 2, 2, 4, 9, 10, 11, };
+
+    EXPECT_TRUE(_sfr.initialize(_script_file_name));
+    EXPECT_TRUE(_sfr.is_mapped());
+    for (size_t i = 0; i < array_size(forms); ++i) {
+        const char * stmt = NULL;
+        ssize_t len = _sfr.next_statement(&stmt);
+        ASSERT_GT(len, 0) << "statement " << i;
+        EXPECT_EQ(std::string(stmt, len), forms[i]);
+        EXPECT_EQ(_sfr.line_number(), lines[i]) << "statement " << i;
+    }
+
+    const char * stmt = NULL;
+    EXPECT_EQ(_sfr.next_statement(&stmt), -1);
+    EXPECT_TRUE(_sfr.eof());
+}
+
+TEST_F(ScriptFileReaderTS, statementErrors)
+{
+    const char * stmt = NULL;
+
+    save_to_file("(a b)\n  ) (c)\n");
+    {
+        ScriptFileReader reader;
+        EXPECT_TRUE(reader.initialize(_script_file_name));
+        EXPECT_EQ(reader.next_statement(&stmt), 5);
+        EXPECT_EQ(reader.next_statement(&stmt), -1);
+        EXPECT_FALSE(reader.eof());
+        EXPECT_EQ(reader.line_number(), 2U);
+    }
+
+    save_to_file("(a b)\n(c (d)\n");
+    {
+        ScriptFileReader reader;
+        EXPECT_TRUE(reader.initialize(_script_file_name));
+        EXPECT_EQ(reader.next_statement(&stmt), 5);
+        EXPECT_EQ(reader.next_statement(&stmt), -1);
+        EXPECT_FALSE(reader.eof());
+    }
+
+    save_to_file("  \n; nothing but a comment");
+    {
+        ScriptFileReader reader;
+        EXPECT_TRUE(reader.initialize(_script_file_name));
+        EXPECT_EQ(reader.next_statement(&stmt), -1);
+        EXPECT_TRUE(reader.eof());
+    }
+}
+
+TEST_F(ScriptFileReaderTS, pipeInChunks)
+{
+    // larger than a read chunk, and written in pieces of odd sizes
+    std::string script;
+    size_t count = 0;
+    while (script.size() < ScriptFileReader::READ_CHUNK_SIZE * 3) {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "(define v%zu\n  \"value %zu\")\nv%zu\n",
+                count, count, count);
+        script += buf;
+        ++count;
+    }
+    script += "(long";
+    script += std::string(ScriptFileReader::READ_CHUNK_SIZE * 2, ' ');
+    script += "list)\n";
+
+    unlink(_script_file_name);
+    ASSERT_EQ(mkfifo(_script_file_name, 0600), 0);
+    std::thread writer([&script]() {
+        FILE * fh = fopen(_script_file_name, "w");
+        for (size_t off = 0; off < script.size(); off += 4093) {
+            size_t n = std::min<size_t>(4093, script.size() - off);
+            fwrite(script.data() + off, 1, n, fh);
+            fflush(fh);
+        }
+        fclose(fh);
+    });
+
+    EXPECT_TRUE(_sfr.initialize(_script_file_name));
+    EXPECT_FALSE(_sfr.is_mapped());
+    const char * stmt = NULL;
+    ssize_t len = 0;
+    for (size_t i = 0; i < count; ++i) {
+        char expected[128];
+        snprintf(expected, sizeof(expected), "(define v%zu\n  \"value %zu\")",
+                i, i);
+        ASSERT_GT(len = _sfr.next_statement(&stmt), 0);
+        ASSERT_EQ(std::string(stmt, len), expected);
+        snprintf(expected, sizeof(expected), "v%zu", i);
+        ASSERT_GT(len = _sfr.next_statement(&stmt), 0);
+        ASSERT_EQ(std::string(stmt, len), expected);
+    }
+
+    ASSERT_GT(len = _sfr.next_statement(&stmt), 0);
+    EXPECT_EQ(static_cast<size_t>(len),
+            ScriptFileReader::READ_CHUNK_SIZE * 2 + 10);
+    EXPECT_EQ(_sfr.line_number(), count * 3 + 1);
+    EXPECT_EQ(_sfr.next_statement(&stmt), -1);
+    EXPECT_TRUE(_sfr.eof());
+    writer.join();
+}
+
+TEST_F(ScriptFileReaderTS, runFileStopsAtParseError)
+{
+    // the file is one stream: the forms before the error are executed, the
+    // statements after it are not skipped to, unlike get_next_statement()
+    const char * script = "(define a 1)\n(+ a 1))\n(define b 2)\nb\n";
+    std::vector<std::string> executed;
+    auto execute = [&executed](const MatterPtr &form) {
+        executed.push_back(form->debug_string(true));
+        return true;
+    };
+
+    SimpleInterpreter interpreter;
+    ASSERT_TRUE(interpreter.initialize());
+    save_to_file(script);
+    EXPECT_FALSE(SimpleInterpreter::_run_file(&interpreter,
+            _script_file_name, execute));
+    ASSERT_EQ(executed.size(), 2U);
+    EXPECT_STREQ(interpreter.parser()->error_message(),
+            "unmatched close parenthesis");
+    EXPECT_EQ(interpreter.parser()->error_offset(), 20U);
+
+    // the same of a pipe, read in chunks
+    unlink(_script_file_name);
+    ASSERT_EQ(mkfifo(_script_file_name, 0600), 0);
+    std::thread writer([script]() {
+        FILE * fh = fopen(_script_file_name, "w");
+        fputs(script, fh);
+        fclose(fh);
+    });
+    std::vector<std::string> piped;
+    piped.swap(executed);
+    EXPECT_FALSE(SimpleInterpreter::_run_file(&interpreter,
+            _script_file_name, execute));
+    writer.join();
+    EXPECT_EQ(executed, piped);
+
+    // a list still open at the end of the file
+    executed.clear();
+    unlink(_script_file_name);
+    save_to_file("(define c 3)\n(+ c\n");
+    EXPECT_FALSE(SimpleInterpreter::_run_file(&interpreter,
+            _script_file_name, execute));
+    EXPECT_EQ(executed.size(), 1U);
+    EXPECT_STREQ(interpreter.parser()->error_message(),
+            "unclosed parenthesis");
+}
+
+namespace
+{
+
+std::string forms_string(const std::vector<MatterPtr> &forms)
+{
+    std::string result;
+    for (size_t i = 0; i < forms.size(); ++i) {
+        result += forms[i]->debug_string(true);
+        result += "\n";
+    }
+    return result;
+}
+
+// every kind of atom, an empty list, and deep nesting
+std::string cache_script()
+{
+    std::string script =
+            "(define pi 3.14159)\n"
+            "(defn area (r) (* pi (* r r)))\n"
+            "(quote (true false -7 2147483648 4294967296 -4294967296 "
+            "18446744073709551615 2.5 0x1F \"str\\\"ing\" 'single'))\n"
+            "; a comment\n"
+            "(() (area 2) \"str\\\"ing\" area)\n"
+            "top-level-atom\n";
+    script += std::string(1000, '(') + "deep" + std::string(1000, ')');
+    return script;
+}
+
+std::string temp_cache_name()
+{
+    char name[] = "/tmp/swl-cache-t-XXXXXX";
+    int fd = mkstemp(name);
+    if (fd >= 0) {
+        close(fd);
+    }
+    return name;
+}
+
+} // anonymous namespace
+
+TEST(ScriptCacheTS, cacheFilename)
+{
+    EXPECT_EQ(ScriptCache::cache_filename("rules.swl"), "rules.swlc");
+    EXPECT_EQ(ScriptCache::cache_filename("dir/rules.lisp"),
+            "dir/rules.lisp.swlc");
+    EXPECT_EQ(ScriptCache::cache_filename(".swl"), ".swl.swlc");
+}
+
+TEST(ScriptCacheTS, roundTrip)
+{
+    std::string script = cache_script();
+    SimpleParser parser;
+    std::vector<MatterPtr> parsed;
+    ASSERT_TRUE(parser.feed(script.data(), script.size(), parsed));
+    ASSERT_TRUE(parser.finish(parsed));
+
+    // the parser makes no long double
+    SolarWindLisp::AtomPtr ld = Atom::create();
+    ld->set_long_double(1.0L / 3);
+    SolarWindLisp::CompositeExprPtr list = CompositeExpr::create();
+    list->append_expr(ld);
+    list->append_expr(ld);
+    parsed.push_back(list);
+
+    std::string cache = temp_cache_name();
+    ASSERT_TRUE(ScriptCache::write(cache.c_str(), script.data(),
+            script.size(), parsed));
+
+    SymbolTable symbols;
+    std::vector<MatterPtr> loaded;
+    ASSERT_TRUE(ScriptCache::load(cache.c_str(), script.data(),
+            script.size(), loaded, &symbols));
+    ASSERT_EQ(loaded.size(), parsed.size());
+    EXPECT_EQ(forms_string(loaded), forms_string(parsed));
+
+    // an atom per distinct symbol or constant, symbols interned
+    const CompositeExpr * quote =
+            static_cast<const CompositeExpr *>(loaded[2].get());
+    const CompositeExpr * quoted =
+            static_cast<const CompositeExpr *>((*quote)[1].get());
+    const CompositeExpr * last =
+            static_cast<const CompositeExpr *>(loaded[3].get());
+    EXPECT_EQ((*quoted)[9].get(), (*last)[2].get());
+    const CompositeExpr * define =
+            static_cast<const CompositeExpr *>(loaded[1].get());
+    EXPECT_EQ((*define)[1].get(), (*last)[3].get());
+    EXPECT_EQ(static_cast<const Atom *>((*define)[1].get())->to_cstr(),
+            symbols.intern("area", 4));
+
+    // the types of the atoms are kept
+    const CompositeExpr * parsed_quote =
+            static_cast<const CompositeExpr *>(parsed[2].get());
+    const CompositeExpr * parsed_quoted =
+            static_cast<const CompositeExpr *>((*parsed_quote)[1].get());
+    ASSERT_EQ(quoted->size(), parsed_quoted->size());
+    for (size_t i = 0; i < quoted->size(); ++i) {
+        EXPECT_EQ(static_cast<const Atom *>((*quoted)[i].get())->atom_type(),
+                static_cast<const Atom *>((*parsed_quoted)[i].get())
+                        ->atom_type()) << "atom " << i;
+    }
+    EXPECT_TRUE(static_cast<const Atom *>((*quoted)[9].get())
+            ->is_quoted_cstr());
+    const CompositeExpr * lds =
+            static_cast<const CompositeExpr *>(loaded.back().get());
+    long double v = 0;
+    EXPECT_TRUE(static_cast<const Atom *>((*lds)[0].get())->is_long_double());
+    EXPECT_TRUE(static_cast<const Atom *>((*lds)[0].get())->to_long_double(v));
+    EXPECT_EQ(v, 1.0L / 3);
+
+    unlink(cache.c_str());
+}
+
+TEST(ScriptCacheTS, staleOrCorrupted)
+{
+    std::string script = cache_script();
+    SimpleParser parser;
+    std::vector<MatterPtr> parsed;
+    ASSERT_TRUE(parser.feed(script.data(), script.size(), parsed));
+    ASSERT_TRUE(parser.finish(parsed));
+
+    std::string cache = temp_cache_name();
+    std::vector<MatterPtr> loaded;
+    EXPECT_FALSE(ScriptCache::load("/nonexistent/x.swlc", script.data(),
+            script.size(), loaded));
+    ASSERT_TRUE(ScriptCache::write(cache.c_str(), script.data(),
+            script.size(), parsed));
+
+    // the script changed
+    std::string changed = script;
+    changed[10] = 'X';
+    EXPECT_FALSE(ScriptCache::load(cache.c_str(), changed.data(),
+            changed.size(), loaded));
+    EXPECT_FALSE(ScriptCache::load(cache.c_str(), script.data(),
+            script.size() - 1, loaded));
+    EXPECT_TRUE(loaded.empty());
+
+    // every byte flipped in turn, or the file truncated
+    FILE * fp = fopen(cache.c_str(), "rb");
+    ASSERT_TRUE(fp != NULL);
+    std::string content;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        content.append(buf, n);
+    }
+    fclose(fp);
+
+    std::string corrupted_name = temp_cache_name();
+    for (size_t i = 0; i < content.size(); i += 1 + i / 16) {
+        for (int truncate = 0; truncate < 2; ++truncate) {
+            std::string corrupted = truncate ? content.substr(0, i) : content;
+            if (!truncate) {
+                corrupted[i] ^= 0x40;
+            }
+            fp = fopen(corrupted_name.c_str(), "wb");
+            ASSERT_TRUE(fp != NULL);
+            fwrite(corrupted.data(), 1, corrupted.size(), fp);
+            fclose(fp);
+            ASSERT_FALSE(ScriptCache::load(corrupted_name.c_str(),
+                    script.data(), script.size(), loaded)) << "byte " << i;
+        }
+    }
+    EXPECT_TRUE(loaded.empty());
+
+    // and still fine
+    EXPECT_TRUE(ScriptCache::load(cache.c_str(), script.data(),
+            script.size(), loaded));
+    EXPECT_EQ(forms_string(loaded), forms_string(parsed));
+
+    // not made of atoms and lists
+    std::vector<MatterPtr> others(1);
+    EXPECT_FALSE(ScriptCache::write(corrupted_name.c_str(), script.data(),
+            script.size(), others));
+
+    unlink(cache.c_str());
+    unlink(corrupted_name.c_str());
+}
+
+TEST(ScriptCacheTS, enabledOnly)
+{
+    char dir[] = "/tmp/swl-cache-t-XXXXXX";
+    ASSERT_TRUE(mkdtemp(dir) != NULL);
+    std::string script_name = std::string(dir) + "/run.swl";
+    std::string cache = ScriptCache::cache_filename(script_name.c_str());
+    FILE * fp = fopen(script_name.c_str(), "w");
+    ASSERT_TRUE(fp != NULL);
+    fputs("(define x 42)\n(defn twice (n) (* 2 n))\n", fp);
+    fclose(fp);
+
+    // in a new interpreter each time, the names are defined once
+    auto run = [&script_name]() {
+        SimpleInterpreter interpreter;
+        MatterPtr result = NULL;
+        return interpreter.initialize()
+                && interpreter.load_script(script_name.c_str())
+                && interpreter.execute(result, "(twice x)") && result
+                && result->to_string() == "84";
+    };
+
+    // disabled by default, nothing written next to the script
+    struct stat st;
+    EXPECT_FALSE(ScriptCache::enabled());
+    EXPECT_TRUE(run());
+    EXPECT_NE(stat(cache.c_str(), &st), 0);
+
+    ScriptCache::set_enabled(true);
+    EXPECT_TRUE(run());
+    EXPECT_EQ(stat(cache.c_str(), &st), 0);
+    EXPECT_TRUE(run());
+    unlink(cache.c_str());
+
+    // a cache which cannot be written, the script is run anyway
+    ASSERT_EQ(mkdir(cache.c_str(), 0700), 0);
+    EXPECT_TRUE(run());
+    ScriptCache::set_enabled(false);
+
+    rmdir(cache.c_str());
+    unlink(script_name.c_str());
+    rmdir(dir);
+}